@@ -11,12 +11,25 @@
  * Copyright:       See LICENSE file
  */
 
+#include "hopi/halo.hpp"
 #include "hopi/mpixx.hpp"
+#include "hopi/parallel_targets.hpp"
 #include "hopi/partition.hpp"
-
+#include "hopi/pipeline.hpp"
+#include "hopi/profile_report.hpp"
+#include "hopi/rbf_interpolator.hpp"
+#include "hopi/sfc_partition.hpp"
+#include "hopi/unique.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <numeric>
 #include <random>
+#include <string>
 
 template<typename T, typename IndexedType>
 void
@@ -97,10 +110,6 @@ main(int argc, char* argv[])
     //                 End Bogus Data (Testing Only)
     // ============================================================
 
-    // ----------------------------------------------------------
-    // Remove Duplicates
-    // ----------------------------------------------------------
-
     // ----------------------------------------------------------
     // Create Search Data Structure for Targets
     // ----------------------------------------------------------
@@ -110,6 +119,102 @@ main(int argc, char* argv[])
 
     partition.report(Nt, target_xyz.data(), ND, target_xyz.data() + 1, ND, target_xyz.data() + 2, ND, nullptr, 1);
 
+    // Single pass alternative along the Hilbert curve
+    hopi::SFCPartition<UserTypes> sfc_partition(world);
+    sfc_partition.init(Nt, target_xyz.data(), ND, target_xyz.data() + 1, ND, target_xyz.data() + 2, ND, nullptr, 1);
+
+    sfc_partition.report(Nt, target_xyz.data(), ND, target_xyz.data() + 1, ND, target_xyz.data() + 2, ND, nullptr, 1);
+
+    // ----------------------------------------------------------
+    // Remove Duplicates
+    // ----------------------------------------------------------
+
+    // Identical targets are owned by the same rank so duplicates on
+    // different ranks are removed once the targets are redistributed
+    const auto              redistributed_targets = partition.redistribute(Nt, target_xyz.data(), ND, target_xyz.data() + 1, ND, target_xyz.data() + 2, ND, nullptr, 1);
+    const auto&             redistributed_xyz     = redistributed_targets.xyz;
+    hopi::Unique<UserTypes> target_unique;
+    target_unique.setup(redistributed_targets.weight.size(), redistributed_xyz.data(), ND, redistributed_xyz.data() + 1, ND, redistributed_xyz.data() + 2, ND);
+
+    const std::size_t                       Nto = target_unique.num_unique();
+    std::vector<UserTypes::coordinate_type> owned_target_xyz(Nto * ND);
+    for (std::size_t d = 0; d < ND; ++d) {
+        target_unique.reduce_to_unique(redistributed_xyz.data() + d, ND, owned_target_xyz.data() + d, ND);
+    }
+
+    // ----------------------------------------------------------
+    // Interpolate Targets streamed from a File
+    // ----------------------------------------------------------
+
+    // Targets written to a Binary HOPI File in rank order
+    const std::string        target_file = "hopi_targets.bin";
+    const std::string        result_file = "hopi_results.bin";
+    const std::size_t        Ntg         = mpixx::all_reduce(world, Nto, std::plus<std::size_t>());
+    std::vector<std::size_t> target_index(Nto);
+    std::iota(target_index.begin(), target_index.end(), mpixx::scan(world, Nto, std::plus<std::size_t>()) - Nto);
+    hopi::write_results_parallel(world, target_file, Ntg, target_index, ND, owned_target_xyz, 0, std::vector<UserTypes::coordinate_type>());
+
+    // Sources moved to their owner plus the ghosts completing the stencil of each owned target
+    const hopi::RBFOptions rbf_options;
+    const auto owned         = partition.redistribute(Ns, source_xyz.data(), ND, source_xyz.data() + 1, ND, source_xyz.data() + 2, ND, nullptr, 1);
+    const auto Nso           = owned.weight.size();
+    const auto ghosts        = hopi::Halo<UserTypes>(partition).exchange_adaptive(Nto, owned_target_xyz.data(), ND, owned_target_xyz.data() + 1, ND, owned_target_xyz.data() + 2, ND,
+                                                                           Nso, owned.xyz.data(), ND, owned.xyz.data() + 1, ND, owned.xyz.data() + 2, ND,
+                                                                           {}, rbf_options.neighbors, 0);
+    const auto Ngh           = mpixx::all_reduce(world, ghosts.size(), std::plus<std::size_t>());
+    if (my_rank == 0) {
+        // A source near the bounds of several ranks is a ghost on each of them
+        std::cout << "Halo Ghosts = " << Ngh << " over " << num_ranks << " Ranks for Sources = " << Ns * num_ranks << " Rounds = " << ghosts.rounds << std::endl;
+    }
+    std::vector<UserTypes::coordinate_type> local_source_xyz(owned.xyz);
+    local_source_xyz.insert(local_source_xyz.end(), ghosts.xyz.begin(), ghosts.xyz.end());
+    const std::size_t Nsl = local_source_xyz.size() / ND;
+
+    // Linear field which the appended polynomial reproduces exactly
+    auto                field = [](const double x, const double y, const double z) { return x + 2 * y - z; };
+    std::vector<double> source_field(Nsl);
+    for (std::size_t i = 0; i < Nsl; ++i) {
+        source_field[i] = field(local_source_xyz[i * ND], local_source_xyz[i * ND + 1], local_source_xyz[i * ND + 2]);
+    }
+
+    hopi::RBFInterpolator<UserTypes> interpolator(rbf_options);
+    interpolator.set_sources(Nsl, local_source_xyz.data(), ND, local_source_xyz.data() + 1, ND, local_source_xyz.data() + 2, ND);
+
+    hopi::PipelineOptions pipeline_options;
+    pipeline_options.block_points = 1024;
+    hopi::TargetPipeline<UserTypes> pipeline(partition, interpolator, pipeline_options);
+    pipeline.run(target_file, 1, source_field.data(), result_file);
+
+    // Check the results read back from the file
+    const auto results  = hopi::read_targets_parallel<double>(world, result_file);
+    double     my_error = 0;
+    for (std::size_t i = 0; i < results.count; ++i) {
+        const double exact = field(results.coordinate(0)[i], results.coordinate(1)[i], results.coordinate(2)[i]);
+        my_error           = std::max(my_error, std::abs(results.variable(0)[i] - exact));
+    }
+    const double max_error = mpixx::all_reduce(world, my_error, mpixx::maximum<double>());
+    world.barrier();
+    if (my_rank == 0) {
+        std::cout << "Pipeline Targets = " << Ntg << " Max Error = " << max_error << std::endl;
+        std::remove(target_file.c_str());
+        std::remove(result_file.c_str());
+    }
+
+    // ----------------------------------------------------------
+    // Rebalance the Partition by the measured cost of each Target
+    // ----------------------------------------------------------
+    interpolator.set_targets(Nto, owned_target_xyz.data(), ND, owned_target_xyz.data() + 1, ND, owned_target_xyz.data() + 2, ND);
+    const auto& costs = interpolator.costs();
+    if (partition.rebalance(Nto, owned_target_xyz.data(), ND, owned_target_xyz.data() + 1, ND, owned_target_xyz.data() + 2, ND, costs.data(), 1)) {
+        partition.report(Nto, owned_target_xyz.data(), ND, owned_target_xyz.data() + 1, ND, owned_target_xyz.data() + 2, ND, costs.data(), 1);
+    }
+
+    // Timers and counters of a HOPI_USE_PROFILE build
+    if constexpr (hopi::profile::enabled) {
+        hopi::profile::write_json(world, "hopi_profile.json");
+        hopi::profile::write_trace(world, "hopi_trace.json");
+    }
+
     std::cout << "P:" << my_rank << " -- DONE-- " << std::endl;
     return EXIT_SUCCESS;
 }
\ No newline at end of file
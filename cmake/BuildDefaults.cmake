@@ -28,6 +28,7 @@ set(DEFAULT_BUILD_TYPE               "Debug")    # => CMAKE_BUILD_TYPE
 option(HOPI_BUILD_APPS               "Build Applications"             TRUE )
 option(HOPI_BUILD_UNIT               "Build Unit Tests"               FALSE )
 option(HOPI_BUILD_SCRATCH            "Build Scratch Tests"            FALSE )
+option(HOPI_BUILD_BENCH              "Build Benchmarks"               FALSE )
 option(HOPI_BUILD_DOXYGEN            "Use Doxygen to generate docs"   FALSE )
 
 #
@@ -42,6 +43,11 @@ option(HOPI_BUILD_DOXYGEN            "Use Doxygen to generate docs"   FALSE )
 option(HOPI_USE_NO_UNIQUE_ADDRESS    "Save Memory using [[no_unique_address]]"  TRUE )
 option(HOPI_USE_INLINE               "Inline Marked Functions"                  TRUE )
 option(HOPI_USE_FORCE_INLINE         "Force Inline Marked Functions"            TRUE )
+option(HOPI_USE_NATIVE_ARCH          "Compile SIMD Kernels for the Build CPU"   FALSE )
+option(HOPI_USE_OPENMP               "Run Batched Queries on all Cores"         TRUE )
+option(HOPI_USE_PROFILE              "Collect Timers and Counters (hopi::profile)" FALSE )
+option(HOPI_USE_OFFLOAD              "Offload Stencil Search and Apply (OpenMP target)" FALSE )
+set(HOPI_OFFLOAD_FLAGS "" CACHE STRING "Compiler flags naming the offload device (ex. -foffload=nvptx-none)")
 
 #
 # =============================================================================
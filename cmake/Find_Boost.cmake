@@ -46,7 +46,9 @@ message(VERBOSE "BOOST_LIBRARYDIR = ${BOOST_LIBRARYDIR}")
 
 
 set(Boost_DEBUG                  OFF) # Enable debug output from FIND_PACKAGE
-set(Boost_NO_SYSTEM_PATHS        ON)  # Do not search system paths before BOOST_ROOT
+if( BOOST_ROOT )
+	set(Boost_NO_SYSTEM_PATHS    ON)  # Do not search system paths before BOOST_ROOT
+endif()
 set(Boost_USE_DEBUG_LIBS         OFF) # Use debug libs
 set(Boost_USE_RELEASE_LIBS       ON)  # Use release libs
 set(Boost_USE_MULTITHREADED      ON)  # Use Boost multi-threaded code
@@ -27,6 +27,24 @@ function(set_common_properties name)
         target_compile_options(${name} PRIVATE -Wpedantic)
     endif()
 
+    # Enable the SIMD instructions (AVX2, AVX-512, NEON) of the build CPU
+    if(HOPI_USE_NATIVE_ARCH)
+        target_compile_options(${name} PRIVATE -march=native)
+    endif()
+
+    # Compile in the hopi::profile timers and counters
+    if(HOPI_USE_PROFILE)
+        target_compile_definitions(${name} PUBLIC HOPI_USE_PROFILE)
+    endif()
+
+    # Run the kernels of hopi/offload.hpp as OpenMP target regions
+    if(HOPI_USE_OFFLOAD)
+        separate_arguments(offload_flags NATIVE_COMMAND "${HOPI_OFFLOAD_FLAGS}")
+        target_compile_definitions(${name} PUBLIC HOPI_USE_OFFLOAD)
+        target_compile_options(${name} PUBLIC ${offload_flags})
+        target_link_options(${name} PUBLIC ${offload_flags})
+    endif()
+
     # Clang Compiler
     # if(CMAKE_CXX_COMPILER_ID STREQUAL "Clang")
     # 
@@ -166,6 +184,47 @@ function(add_cxx_test name)
     endif()
 endfunction()
 
+#
+# add_cxx_tests(name SOURCES ... [DEPENDS ...])
+#
+# Adds a single test executable built from many Catch2 test files. Each
+# file holds its own TEST_CASEs which share the Catch2 provided main.
+#
+# Arguments:
+#   - `name`: name of the test executable
+#   - `SOURCES`: test files to build into the executable
+#   - `DEPENDS`: libraries the tests link against
+#
+function(add_cxx_tests name)
+
+    # Parse the function arguments
+    cmake_parse_arguments(CXX "" "WORK_DIRECTORY" "SOURCES;DEPENDS" ${ARGN})
+
+    if(NOT CXX_SOURCES)
+        return()
+    endif()
+
+    add_executable(${name} ${CXX_SOURCES})
+    if(CXX_DEPENDS)
+        target_link_libraries(${name} ${CXX_DEPENDS})
+    endif()
+    target_link_libraries(${name} Catch2WithMain)
+
+    # Header only parts of the library need the same includes
+    target_link_libraries(${name}
+            "$<$<BOOL:${Boost_SERIALIZATION_FOUND}>:Boost::serialization>"
+		    "$<$<BOOL:${Boost_MPI_FOUND}>:Boost::mpi>"
+            "$<$<BOOL:${OpenMP_CXX_FOUND}>:OpenMP::OpenMP_CXX>"
+            "$<$<BOOL:${MPI_CXX_FOUND}>:MPI::MPI_CXX>"
+    )
+
+    if(NOT CXX_WORK_DIRECTORY)
+        add_test(NAME ${name} COMMAND ${name})
+    else()
+        add_test(NAME ${name} COMMAND ${name} WORKING_DIRECTORY ${CXX_WORK_DIRECTORY})
+    endif()
+endfunction()
+
 #
 # add_cxx_executable(name [LENGTHY])
 #
@@ -183,5 +242,14 @@ function(add_cxx_executable name)
     if(EXE_DEPENDS)
         target_link_libraries(${name} LINK_PUBLIC ${EXE_DEPENDS})
     endif()
+
+    # Header only parts of the library need the same includes
+    target_link_libraries(${name} 
+        PRIVATE
+            "$<$<BOOL:${Boost_SERIALIZATION_FOUND}>:Boost::serialization>"
+		    "$<$<BOOL:${Boost_MPI_FOUND}>:Boost::mpi>"
+            "$<$<BOOL:${OpenMP_CXX_FOUND}>:OpenMP::OpenMP_CXX>"
+            "$<$<BOOL:${MPI_CXX_FOUND}>:MPI::MPI_CXX>"
+    )
 endfunction()
 
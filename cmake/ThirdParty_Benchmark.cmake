@@ -0,0 +1,54 @@
+#
+########################################################################
+#
+# ThirdParty Configuration
+#
+# Google Benchmark - Micro Benchmark Framework
+#
+########################################################################
+#
+
+#
+# Parameters
+#
+SET(LIBRAY_NAME "benchmark")
+SET(GIT_WEBSITE "https://github.com/google/benchmark.git")
+SET(GIT_VERSION "v1.8.3")
+
+#
+# Use an installed version when available
+#
+find_package(${LIBRAY_NAME} QUIET)
+if( ${LIBRAY_NAME}_FOUND )
+	MESSAGE(VERBOSE "Found installed ${LIBRAY_NAME} ${${LIBRAY_NAME}_VERSION}")
+	return()
+endif()
+
+#
+# Display our message
+#
+MESSAGE(VERBOSE " ")
+MESSAGE(VERBOSE "Fetching ... ")
+MESSAGE(VERBOSE "Library : ${LIBRAY_NAME}")
+MESSAGE(VERBOSE "GitHub  : ${GIT_WEBSITE}")
+MESSAGE(VERBOSE "Version : ${GIT_VERSION}")
+
+#
+# Set benchmark environment variables
+#
+set(BENCHMARK_ENABLE_TESTING  OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_INSTALL  OFF CACHE BOOL "" FORCE)
+
+#
+# DownLoad (if not already done)
+#
+include(FetchContent)
+FetchContent_Declare(
+	${LIBRAY_NAME}
+    GIT_REPOSITORY ${GIT_WEBSITE}
+	GIT_TAG        ${GIT_VERSION}
+)
+FetchContent_MakeAvailable(${LIBRAY_NAME})
+
+MESSAGE(VERBOSE "Done")
@@ -5,98 +5,318 @@
  * Date:            Sep 30, 2022
  * Author:          Bryan Flynt
  * -----
- * Last Modified:   Dec 6, 2022
+ * Last Modified:   Oct 14, 2026
  * Modified By:     Bryan Flynt
  * -----
  * Copyright:       See LICENSE file
  */
 
 #include "hopi/ascii_targets.hpp"
+#include "hopi/profile.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <cstring>
 #include <fstream>
-#include <iomanip>
 #include <iostream>
-#include <sstream>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 namespace hopi {
 
+namespace {
+
+[[noreturn]] void
+ascii_file_error(const std::string& message, const std::string& file_name)
+{
+    std::cerr << "ERROR: " << message << std::endl;
+    std::cerr << "Filename: " << file_name << std::endl;
+    std::exit(EXIT_FAILURE);
+}
+
+bool
+is_space(const char c)
+{
+    return (c == ' ') or (c == '\n') or (c == '\t') or (c == '\r') or (c == '\v') or (c == '\f');
+}
+
+const char*
+skip_space(const char* first, const char* last)
+{
+    while ((first != last) and is_space(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+const char*
+skip_token(const char* first, const char* last)
+{
+    while ((first != last) and not is_space(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+// Parse the next whitespace separated value as operator>> would
+template<typename T>
+const char*
+parse_token(const char* first, const char* last, T& value)
+{
+    first = skip_space(first, last);
+    if ((first != last) and (*first == '+')) {
+        ++first;
+    }
+    const auto result = std::from_chars(first, last, value);
+    if ((result.ec != std::errc()) or ((result.ptr != last) and not is_space(*result.ptr))) {
+        return nullptr;
+    }
+    return result.ptr;
+}
+
+// Right justify the value in width characters
+template<typename... Args>
+char*
+format_token(char* out, const std::size_t width, Args... args)
+{
+    char        buffer[64];
+    const auto  result = std::to_chars(buffer, buffer + sizeof(buffer), args...);
+    const auto  length = std::size_t(result.ptr - buffer);
+    if (length < width) {
+        out = std::fill_n(out, width - length, ' ');
+    }
+    return std::copy(buffer, result.ptr, out);
+}
+
+// Read only mapping of a whole file
+class MappedFile final {
+   public:
+    explicit MappedFile(const std::string& file_name)
+    {
+        const int fd = ::open(file_name.c_str(), O_RDONLY);
+        if (fd < 0) {
+            ascii_file_error("File Did Not Open", file_name);
+        }
+        struct stat file_stat;
+        if (::fstat(fd, &file_stat) != 0) {
+            ::close(fd);
+            ascii_file_error("File Did Not Open", file_name);
+        }
+        m_bytes = std::size_t(file_stat.st_size);
+        if (m_bytes > 0) {
+            void* map = ::mmap(nullptr, m_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                ::close(fd);
+                ascii_file_error("File Did Not Map", file_name);
+            }
+            m_data = static_cast<const char*>(map);
+            ::madvise(map, m_bytes, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile& other)            = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    ~MappedFile()
+    {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<char*>(m_data), m_bytes);
+        }
+    }
+
+    const char* begin() const noexcept { return m_data; }
+    const char* end() const noexcept { return m_data + m_bytes; }
+
+   private:
+    const char* m_data  = nullptr;
+    std::size_t m_bytes = 0;
+};
+
+}  // namespace
+
 /// Read Target ASCII File
 /**
+ * The file is mapped and split into line aligned chunks. Threads
+ * first count the values in each chunk and then parse their chunk
+ * directly into place.
  */
+template<typename T>
 void
-read_target_file(const std::string& file_name, std::size_t& ndim, std::size_t& npoints, std::vector<double>& xyz)
+read_target_file(const std::string& file_name, std::size_t& ndim, std::size_t& npoints, std::vector<T>& xyz)
 {
-    std::ifstream file(file_name);
-    if (not file) {
-        std::cerr << "ERROR: File Did Not Open" << std::endl;
-        std::cerr << "Filename: " << file_name << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-
-    // Read whole file into buffer
-    std::stringstream file_stream;
-    file_stream << file.rdbuf();
-    file.close();
+    HOPI_PROFILE_SCOPE("io.read_ascii");
+    const MappedFile file(file_name);
+    const char*      last = file.end();
 
     // Parse Header
-    file_stream >> ndim;
+    const char* first = parse_token(file.begin(), last, ndim);
+    if (first == nullptr) {
+        ascii_file_error("Bad Header In File", file_name);
+    }
     if (ndim > 3) {
         std::cerr << "ERROR: Wrong Number of Dimensions In File" << std::endl;
         std::cerr << "Number of Dimensions = " << ndim << std::endl;
         std::exit(EXIT_FAILURE);
     }
-    file_stream >> npoints;
+    first = parse_token(first, last, npoints);
+    if (first == nullptr) {
+        ascii_file_error("Bad Header In File", file_name);
+    }
+    const std::size_t num_values = ndim * npoints;
+
+    // Split on line boundaries
+    std::size_t num_chunks = 1;
+#if defined(_OPENMP)
+    num_chunks = std::size_t(omp_get_max_threads());
+#endif
+    const std::size_t        body_bytes = std::size_t(last - first);
+    std::vector<const char*> chunk(num_chunks + 1, last);
+    chunk[0] = first;
+    for (std::size_t c = 1; c < num_chunks; ++c) {
+        const char* split = std::max(chunk[c - 1], first + (body_bytes * c) / num_chunks);
+        split             = std::find(split, last, '\n');
+        chunk[c]          = (split == last) ? last : split + 1;
+    }
+
+    // Count values within each chunk
+    std::vector<std::size_t> chunk_offset(num_chunks + 1, 0);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for (std::size_t c = 0; c < num_chunks; ++c) {
+        std::size_t count = 0;
+        const char* pos   = skip_space(chunk[c], chunk[c + 1]);
+        while (pos != chunk[c + 1]) {
+            pos = skip_space(skip_token(pos, chunk[c + 1]), chunk[c + 1]);
+            ++count;
+        }
+        chunk_offset[c + 1] = count;
+    }
+    for (std::size_t c = 0; c < num_chunks; ++c) {
+        chunk_offset[c + 1] += chunk_offset[c];
+    }
+    if (chunk_offset[num_chunks] < num_values) {
+        ascii_file_error("File Is Truncated", file_name);
+    }
 
     // Parse Data
-    xyz.resize(ndim * npoints);
-    for (std::size_t i = 0; i < npoints; ++i) {
-        for (std::size_t j = 0; j < ndim; ++j) {
-            file_stream >> xyz[i * ndim + j];
+    xyz.resize(num_values);
+    bool bad_value = false;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static, 1) reduction(|| : bad_value)
+#endif
+    for (std::size_t c = 0; c < num_chunks; ++c) {
+        const char* pos = chunk[c];
+        for (std::size_t n = chunk_offset[c]; n < std::min(chunk_offset[c + 1], num_values); ++n) {
+            pos = parse_token(pos, chunk[c + 1], xyz[n]);
+            if (pos == nullptr) {
+                bad_value = true;
+                break;
+            }
         }
     }
+    if (bad_value) {
+        ascii_file_error("Bad Value In File", file_name);
+    }
 }
 
 /// Write Target ASCII File
 /**
+ * Rows are formatted in parallel into large buffers which are
+ * written in order.
  */
+template<typename T, typename V>
 void
-write_target_file(const std::string&         file_name,
-                  const std::size_t&         ndim,
-                  const std::size_t&         npoints,
-                  const std::vector<double>& xyz,
-                  const std::size_t&         nvar,
-                  const std::vector<double>& var)
+write_target_file(const std::string&    file_name,
+                  const std::size_t&    ndim,
+                  const std::size_t&    npoints,
+                  const std::vector<T>& xyz,
+                  const std::size_t&    nvar,
+                  const std::vector<V>& var)
 {
-    assert(npoints == xyz.size() / ndim);
-    assert(npoints == var.size() / nvar);
+    HOPI_PROFILE_SCOPE("io.write_ascii");
+    assert(xyz.size() == ndim * npoints);
+    assert(var.size() == nvar * npoints);
 
-    std::ofstream file(file_name);
+    std::ofstream file(file_name, std::ios::binary);
     if (not file) {
-        std::cerr << "ERROR: File Did Not Open" << std::endl;
-        std::cerr << "Filename: " << file_name << std::endl;
-        std::exit(EXIT_FAILURE);
+        ascii_file_error("File Did Not Open", file_name);
     }
 
     // Write Header
-    file << std::setw(10) << ndim;
-    file << std::setw(10) << npoints;
-    file << std::setw(10) << nvar;
-    file << std::endl;
+    std::string header(64, ' ');
+    char*       out = header.data();
+    out             = format_token(out, 10, ndim);
+    out             = format_token(out, 10, npoints);
+    out             = format_token(out, 10, nvar);
+    *out++          = '\n';
+    file.write(header.data(), out - header.data());
 
     // Write Data
-    for (std::size_t i = 0; i < npoints; ++i) {
-        for (std::size_t j = 0; j < ndim; ++j) {
-            file << std::setw(15) << std::setprecision(8) << std::scientific << xyz[i * ndim + j];
+    // - Each value takes at least 15 characters
+    constexpr std::size_t    rows_per_block = 16 * 1024;
+    constexpr std::size_t    max_value_size = 32;
+    const std::size_t        row_size       = (ndim + nvar) * max_value_size + 1;
+    std::size_t              num_blocks     = 1;
+#if defined(_OPENMP)
+    num_blocks = std::size_t(omp_get_max_threads());
+#endif
+    std::vector<std::string> buffer(num_blocks, std::string(rows_per_block * row_size, ' '));
+    std::vector<std::size_t> buffer_size(num_blocks, 0);
+
+    for (std::size_t begin_row = 0; begin_row < npoints; begin_row += num_blocks * rows_per_block) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static, 1)
+#endif
+        for (std::size_t b = 0; b < num_blocks; ++b) {
+            const std::size_t first = std::min(npoints, begin_row + b * rows_per_block);
+            const std::size_t last  = std::min(npoints, first + rows_per_block);
+            char*             pos   = buffer[b].data();
+            for (std::size_t i = first; i < last; ++i) {
+                for (std::size_t j = 0; j < ndim; ++j) {
+                    pos = format_token(pos, 15, xyz[i * ndim + j], std::chars_format::scientific, 8);
+                }
+                for (std::size_t j = 0; j < nvar; ++j) {
+                    pos = format_token(pos, 15, var[i * nvar + j], std::chars_format::scientific, 8);
+                }
+                *pos++ = '\n';
+            }
+            buffer_size[b] = std::size_t(pos - buffer[b].data());
         }
-        for (std::size_t j = 0; j < nvar; ++j) {
-            file << std::setw(15) << std::setprecision(8) << std::scientific << var[i * ndim + j];
+        for (std::size_t b = 0; b < num_blocks; ++b) {
+            file.write(buffer[b].data(), std::streamsize(buffer_size[b]));
         }
-        file << std::endl;
+    }
+
+    if (not file) {
+        ascii_file_error("File Write Failed", file_name);
     }
 
     // Close file
     file.close();
 }
 
-} /* namespace hopi */
\ No newline at end of file
+template void read_target_file<float>(const std::string&, std::size_t&, std::size_t&, std::vector<float>&);
+template void read_target_file<double>(const std::string&, std::size_t&, std::size_t&, std::vector<double>&);
+
+template void write_target_file<float, float>(const std::string&, const std::size_t&, const std::size_t&,
+                                              const std::vector<float>&, const std::size_t&, const std::vector<float>&);
+template void write_target_file<float, double>(const std::string&, const std::size_t&, const std::size_t&,
+                                               const std::vector<float>&, const std::size_t&, const std::vector<double>&);
+template void write_target_file<double, float>(const std::string&, const std::size_t&, const std::size_t&,
+                                               const std::vector<double>&, const std::size_t&, const std::vector<float>&);
+template void write_target_file<double, double>(const std::string&, const std::size_t&, const std::size_t&,
+                                                const std::vector<double>&, const std::size_t&, const std::vector<double>&);
+
+} /* namespace hopi */
@@ -20,17 +20,21 @@ namespace hopi {
 
 /// Read Target ASCII File
 /**
+ * Coordinates are parsed directly into T (float or double)
  */
-void read_target_file(const std::string& file_name, std::size_t& ndim, std::size_t& npoints, std::vector<double>& xyz);
+template<typename T>
+void read_target_file(const std::string& file_name, std::size_t& ndim, std::size_t& npoints, std::vector<T>& xyz);
 
 /// Write Target ASCII File
 /**
+ * Coordinates T and variables V may each be float or double
  */
-void write_target_file(const std::string&         file_name,
-                       const std::size_t&         ndim,
-                       const std::size_t&         npoints,
-                       const std::vector<double>& xyz,
-                       const std::size_t&         nvar,
-                       const std::vector<double>& var);
+template<typename T, typename V>
+void write_target_file(const std::string&    file_name,
+                       const std::size_t&    ndim,
+                       const std::size_t&    npoints,
+                       const std::vector<T>& xyz,
+                       const std::size_t&    nvar,
+                       const std::vector<V>& var);
 
 } /* namespace hopi */
\ No newline at end of file
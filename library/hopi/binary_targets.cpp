@@ -0,0 +1,280 @@
+/// @file binary_targets.cpp
+/*
+ * Project:         HOPI
+ * File:            binary_targets.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/binary_targets.hpp"
+#include "hopi/ascii_targets.hpp"
+#include "hopi/profile.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hopi {
+
+namespace {
+
+[[noreturn]] void
+binary_file_error(const std::string& message, const std::string& file_name)
+{
+    std::cerr << "ERROR: " << message << std::endl;
+    std::cerr << "Filename: " << file_name << std::endl;
+    std::exit(EXIT_FAILURE);
+}
+
+std::uint64_t
+round_up(const std::uint64_t bytes, const std::uint64_t alignment)
+{
+    return ((bytes + alignment - 1) / alignment) * alignment;
+}
+
+}  // namespace
+
+/// Header describing the layout for a new Binary HOPI File
+/**
+ */
+BinaryTargetHeader
+make_binary_target_header(const std::size_t ndim,
+                          const std::size_t npoints,
+                          const std::size_t nvar,
+                          const std::size_t value_bytes)
+{
+    assert((value_bytes == sizeof(float)) or (value_bytes == sizeof(double)));
+    BinaryTargetHeader head{};
+    std::memcpy(head.magic, BinaryTargetHeader::magic_value, sizeof(head.magic));
+    head.version           = BinaryTargetHeader::version_value;
+    head.header_bytes      = sizeof(BinaryTargetHeader);
+    head.byte_order        = BinaryTargetHeader::byte_order_value;
+    head.value_bytes       = std::uint32_t(value_bytes);
+    head.ndim              = ndim;
+    head.npoints           = npoints;
+    head.nvar              = nvar;
+    head.alignment         = BinaryTargetHeader::alignment_value;
+    head.block_stride      = round_up(npoints * value_bytes, head.alignment);
+    head.coordinate_offset = round_up(sizeof(BinaryTargetHeader), head.alignment);
+    head.variable_offset   = head.coordinate_offset + ndim * head.block_stride;
+    return head;
+}
+
+/// Exit with a message if the header does not describe a valid file
+/**
+ */
+void
+check_binary_target_header(const BinaryTargetHeader& head, const std::size_t file_bytes, const std::string& file_name)
+{
+    if (std::memcmp(head.magic, BinaryTargetHeader::magic_value, sizeof(head.magic)) != 0) {
+        binary_file_error("Not A Binary HOPI File", file_name);
+    }
+    if (head.version > BinaryTargetHeader::version_value) {
+        binary_file_error("Unsupported Binary HOPI Version", file_name);
+    }
+    if (head.byte_order != BinaryTargetHeader::byte_order_value) {
+        binary_file_error("Wrong Byte Order In File", file_name);
+    }
+    if ((head.value_bytes != sizeof(float)) and (head.value_bytes != sizeof(double))) {
+        binary_file_error("Wrong Value Size In File", file_name);
+    }
+    if (head.ndim > 3) {
+        std::cerr << "ERROR: Wrong Number of Dimensions In File" << std::endl;
+        std::cerr << "Number of Dimensions = " << head.ndim << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    const auto required = head.variable_offset + head.nvar * head.block_stride;
+    if ((head.block_stride < head.npoints * head.value_bytes) or (file_bytes < required)) {
+        binary_file_error("File Is Truncated", file_name);
+    }
+}
+
+MappedTargetFile::MappedTargetFile(const std::string& file_name)
+{
+    HOPI_PROFILE_SCOPE("io.map_binary");
+    const int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        binary_file_error("File Did Not Open", file_name);
+    }
+
+    struct stat file_stat;
+    if ((::fstat(fd, &file_stat) != 0) or (std::size_t(file_stat.st_size) < sizeof(BinaryTargetHeader))) {
+        ::close(fd);
+        binary_file_error("File Too Small For Header", file_name);
+    }
+    m_bytes = std::size_t(file_stat.st_size);
+
+    void* map = ::mmap(nullptr, m_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        m_bytes = 0;
+        binary_file_error("File Did Not Map", file_name);
+    }
+    m_data = static_cast<const std::byte*>(map);
+
+    check_binary_target_header(this->header(), m_bytes, file_name);
+}
+
+MappedTargetFile::MappedTargetFile(MappedTargetFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_bytes(std::exchange(other.m_bytes, 0))
+{
+}
+
+MappedTargetFile&
+MappedTargetFile::operator=(MappedTargetFile&& other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_bytes, other.m_bytes);
+    return *this;
+}
+
+MappedTargetFile::~MappedTargetFile()
+{
+    if (m_data != nullptr) {
+        ::munmap(const_cast<std::byte*>(m_data), m_bytes);
+    }
+}
+
+const BinaryTargetHeader&
+MappedTargetFile::header() const noexcept
+{
+    return *reinterpret_cast<const BinaryTargetHeader*>(m_data);
+}
+
+std::size_t
+MappedTargetFile::ndim() const noexcept
+{
+    return this->header().ndim;
+}
+
+std::size_t
+MappedTargetFile::npoints() const noexcept
+{
+    return this->header().npoints;
+}
+
+std::size_t
+MappedTargetFile::nvar() const noexcept
+{
+    return this->header().nvar;
+}
+
+std::size_t
+MappedTargetFile::value_bytes() const noexcept
+{
+    return this->header().value_bytes;
+}
+
+const std::byte*
+MappedTargetFile::coordinate_bytes(const std::size_t dim) const noexcept
+{
+    const auto& head = this->header();
+    if (dim >= head.ndim) {
+        return nullptr;
+    }
+    return m_data + head.coordinate_offset + dim * head.block_stride;
+}
+
+const std::byte*
+MappedTargetFile::variable_bytes(const std::size_t var) const noexcept
+{
+    const auto& head = this->header();
+    if (var >= head.nvar) {
+        return nullptr;
+    }
+    return m_data + head.variable_offset + var * head.block_stride;
+}
+
+/// Write Binary HOPI File
+/**
+ */
+template<typename T>
+void
+write_binary_target_file(const std::string&    file_name,
+                         const std::size_t&    ndim,
+                         const std::size_t&    npoints,
+                         const std::vector<T>& xyz,
+                         const std::size_t&    nvar,
+                         const std::vector<T>& var)
+{
+    HOPI_PROFILE_SCOPE("io.write_binary");
+    assert(xyz.size() == ndim * npoints);
+    assert(var.size() == nvar * npoints);
+
+    std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+    if (not file) {
+        binary_file_error("File Did Not Open", file_name);
+    }
+
+    const BinaryTargetHeader head = make_binary_target_header(ndim, npoints, nvar, sizeof(T));
+    file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+    // Write each strided column as a padded block
+    // - Transposed through a small buffer so memory stays bounded
+    constexpr std::size_t  chunk_size = 64 * 1024;
+    std::vector<T>          chunk(std::min(npoints, chunk_size));
+    const std::vector<char> padding(head.alignment, 0);
+    auto write_block = [&](const std::vector<T>& values, const std::size_t column, const std::size_t stride) {
+        for (std::size_t first = 0; first < npoints; first += chunk_size) {
+            const std::size_t count = std::min(chunk_size, npoints - first);
+            for (std::size_t i = 0; i < count; ++i) {
+                chunk[i] = values[(first + i) * stride + column];
+            }
+            file.write(reinterpret_cast<const char*>(chunk.data()), std::streamsize(count * sizeof(T)));
+        }
+        file.write(padding.data(), std::streamsize(head.block_stride - npoints * sizeof(T)));
+    };
+
+    file.write(padding.data(), std::streamsize(head.coordinate_offset - sizeof(head)));
+    for (std::size_t j = 0; j < ndim; ++j) {
+        write_block(xyz, j, ndim);
+    }
+    for (std::size_t j = 0; j < nvar; ++j) {
+        write_block(var, j, nvar);
+    }
+
+    if (not file) {
+        binary_file_error("File Write Failed", file_name);
+    }
+    file.close();
+}
+
+/// Convert Target ASCII File into a Binary HOPI File
+/**
+ */
+void
+convert_target_file(const std::string& ascii_file_name, const std::string& binary_file_name, const std::size_t value_bytes)
+{
+    std::size_t ndim    = 0;
+    std::size_t npoints = 0;
+    if (value_bytes == sizeof(float)) {
+        std::vector<float> xyz;
+        read_target_file(ascii_file_name, ndim, npoints, xyz);
+        write_binary_target_file(binary_file_name, ndim, npoints, xyz, 0, std::vector<float>());
+    }
+    else {
+        std::vector<double> xyz;
+        read_target_file(ascii_file_name, ndim, npoints, xyz);
+        write_binary_target_file(binary_file_name, ndim, npoints, xyz, 0, std::vector<double>());
+    }
+}
+
+template void write_binary_target_file<float>(const std::string&, const std::size_t&, const std::size_t&,
+                                              const std::vector<float>&, const std::size_t&, const std::vector<float>&);
+template void write_binary_target_file<double>(const std::string&, const std::size_t&, const std::size_t&,
+                                               const std::vector<double>&, const std::size_t&, const std::vector<double>&);
+
+} /* namespace hopi */
@@ -0,0 +1,137 @@
+/// @file binary_targets.hpp
+/*
+ * Project:         HOPI
+ * File:            binary_targets.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace hopi {
+
+/// Header of a Binary HOPI File
+/**
+ * The header is followed by one block per coordinate and then one
+ * block per variable. Every block holds npoints values of value_bytes
+ * (4 for float or 8 for double) and starts on a multiple of alignment so the mapped file can be handed
+ * directly to Partition::init with an increment of 1.
+ *
+ * Values are in native byte order which is recorded in byte_order.
+ * Unused trailing space is zero so later versions can add fields.
+ */
+struct BinaryTargetHeader {
+    static constexpr char          magic_value[8]   = { 'H', 'O', 'P', 'I', 'B', 'I', 'N', '\0' };
+    static constexpr std::uint32_t version_value    = 1;
+    static constexpr std::uint32_t byte_order_value = 0x01020304;
+    static constexpr std::uint64_t alignment_value  = 4096;
+
+    char          magic[8];           ///< Always magic_value
+    std::uint32_t version;            ///< Format version
+    std::uint32_t header_bytes;       ///< Size of this header in bytes
+    std::uint32_t byte_order;         ///< Reads as byte_order_value on a matching machine
+    std::uint32_t value_bytes;        ///< Bytes per stored value
+    std::uint64_t ndim;               ///< Number of coordinate blocks
+    std::uint64_t npoints;            ///< Number of values in each block
+    std::uint64_t nvar;               ///< Number of variable blocks
+    std::uint64_t alignment;          ///< Byte alignment of each block
+    std::uint64_t block_stride;       ///< Bytes from the start of one block to the next
+    std::uint64_t coordinate_offset;  ///< Byte offset of the first coordinate block
+    std::uint64_t variable_offset;    ///< Byte offset of the first variable block
+    std::uint64_t reserved[22];       ///< Zero, room for later fields
+};
+static_assert(sizeof(BinaryTargetHeader) == 256, "Binary header must stay 256 bytes");
+
+/// Header describing the layout for a new Binary HOPI File
+/**
+ */
+BinaryTargetHeader make_binary_target_header(const std::size_t ndim,
+                                             const std::size_t npoints,
+                                             const std::size_t nvar,
+                                             const std::size_t value_bytes = sizeof(double));
+
+/// Exit with a message if the header does not describe a valid file
+/**
+ */
+void check_binary_target_header(const BinaryTargetHeader& head, const std::size_t file_bytes, const std::string& file_name);
+
+/// Read only Memory Map of a Binary HOPI File
+/**
+ * Pages are only read from disk when first touched so opening a
+ * file costs the same regardless of its size.
+ */
+class MappedTargetFile final {
+   public:
+    MappedTargetFile()                              = delete;
+    MappedTargetFile(const MappedTargetFile& other) = delete;
+    MappedTargetFile(MappedTargetFile&& other) noexcept;
+    explicit MappedTargetFile(const std::string& file_name);
+    ~MappedTargetFile();
+
+    MappedTargetFile& operator=(const MappedTargetFile& other) = delete;
+    MappedTargetFile& operator=(MappedTargetFile&& other) noexcept;
+
+    const BinaryTargetHeader& header() const noexcept;
+
+    std::size_t ndim() const noexcept;
+    std::size_t npoints() const noexcept;
+    std::size_t nvar() const noexcept;
+    std::size_t value_bytes() const noexcept;
+
+    /// Contiguous values of coordinate dim or nullptr if dim >= ndim() or T is not the stored type
+    template<typename T = double>
+    const T*
+    coordinate(const std::size_t dim) const noexcept
+    {
+        return (sizeof(T) == this->value_bytes()) ? reinterpret_cast<const T*>(this->coordinate_bytes(dim)) : nullptr;
+    }
+
+    /// Contiguous values of variable var or nullptr if var >= nvar() or T is not the stored type
+    template<typename T = double>
+    const T*
+    variable(const std::size_t var) const noexcept
+    {
+        return (sizeof(T) == this->value_bytes()) ? reinterpret_cast<const T*>(this->variable_bytes(var)) : nullptr;
+    }
+
+   private:
+    const std::byte* coordinate_bytes(const std::size_t dim) const noexcept;
+    const std::byte* variable_bytes(const std::size_t var) const noexcept;
+
+    const std::byte* m_data  = nullptr;  ///< Start of the mapping
+    std::size_t      m_bytes = 0;        ///< Length of the mapping
+};
+
+/// Write Binary HOPI File
+/**
+ * Coordinates and variables are interleaved per point as in
+ * write_target_file and are stored as separate blocks of T
+ * (float or double).
+ */
+template<typename T>
+void write_binary_target_file(const std::string&    file_name,
+                              const std::size_t&    ndim,
+                              const std::size_t&    npoints,
+                              const std::vector<T>& xyz,
+                              const std::size_t&    nvar,
+                              const std::vector<T>& var);
+
+/// Convert Target ASCII File into a Binary HOPI File
+/**
+ * Values are stored with value_bytes (4 for float or 8 for double)
+ */
+void convert_target_file(const std::string& ascii_file_name,
+                         const std::string& binary_file_name,
+                         const std::size_t  value_bytes = sizeof(double));
+
+} /* namespace hopi */
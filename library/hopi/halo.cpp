@@ -0,0 +1,19 @@
+/// @file halo.cpp
+/*
+ * Project:         HOPI
+ * File:            halo.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/halo.hpp"
+
+namespace hopi {
+
+
+} /* namespace hopi */
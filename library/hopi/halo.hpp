@@ -0,0 +1,520 @@
+/// @file halo.hpp
+/*
+ * Project:         HOPI
+ * File:            halo.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/mpixx.hpp"
+#include "hopi/partition.hpp"
+#include "hopi/profile.hpp"
+#include "hopi/rtree.hpp"
+
+#include "boost/mpi/exception.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace hopi {
+
+/**
+ * Exchange of ghost sources between neighboring ranks
+ *
+ * Each rank receives the sources of other ranks which fall within
+ * its own Partition bound grown by a search radius. Only ranks whose
+ * regions overlap communicate, using a distributed graph communicator
+ * and MPI_Ineighbor_alltoallv, so the cost scales with the number of
+ * neighbors instead of the number of ranks. The graph is kept between
+ * exchanges and only rebuilt when a radius or source bound changes.
+ */
+template<typename InputAdaptor>
+class Halo final {
+    // ----------------------------------------------------------
+    // Types
+    // ----------------------------------------------------------
+    static constexpr auto NDim = InputAdaptor::NDim;
+
+   public:
+    using partition_type  = Partition<InputAdaptor>;
+    using size_type       = typename InputAdaptor::size_type;
+    using difference_type = typename InputAdaptor::difference_type;
+    using coordinate_type = typename InputAdaptor::coordinate_type;
+    using rank_type       = typename InputAdaptor::rank_type;
+    using box_type        = typename partition_type::box_type;
+    using box_array       = typename partition_type::box_array;
+    using Payload         = typename partition_type::Payload;
+
+    /**
+     * Sources received from other ranks
+     */
+    struct Ghosts {
+        std::vector<coordinate_type>        xyz;      ///< NDim coordinates of each ghost
+        std::vector<rank_type>              rank;     ///< Rank each ghost came from
+        std::vector<std::vector<std::byte>> payload;  ///< Each Payload column packed contiguously
+        coordinate_type                     radius;   ///< Radius the bound was grown by
+        size_type                           rounds;   ///< Exchanges needed to reach radius
+
+        size_type size() const noexcept { return rank.size(); }
+    };
+
+    // ----------------------------------------------------------
+    // Constructors and Operators
+    // ----------------------------------------------------------
+   public:
+    Halo()                  = delete;
+    Halo(const Halo& other) = default;
+    Halo(Halo&& other)      = default;
+    ~Halo()                 = default;
+    Halo& operator=(const Halo& other) = default;
+    Halo& operator=(Halo&& other)      = default;
+
+    /**
+     * Halo about the bounds of an initialized Partition
+     */
+    explicit Halo(const partition_type& partition);
+
+    // ----------------------------------------------------------
+    // Methods
+    // ----------------------------------------------------------
+   public:
+    /**
+     * Receive the sources within radius of my bound
+     *
+     * Collective, each rank may use its own radius.
+     */
+    Ghosts exchange(const size_type             source_count,
+                    const coordinate_type*      x,
+                    const difference_type       xinc,
+                    const coordinate_type*      y,
+                    const difference_type       yinc,
+                    const coordinate_type*      z,
+                    const difference_type       zinc,
+                    const std::vector<Payload>& payload,
+                    const coordinate_type       radius);
+
+    /**
+     * Receive enough sources to complete the K nearest of each target
+     *
+     * Starts from radius and grows it wherever the K'th nearest source
+     * of a local target (found from my sources and the ghosts) reaches
+     * further than my grown bound. Stops once no rank needs to grow or
+     * after max_rounds exchanges. Later rounds only send the sources
+     * between the previous and the grown radius.
+     */
+    Ghosts exchange_adaptive(const size_type             target_count,
+                             const coordinate_type*      tx,
+                             const difference_type       txinc,
+                             const coordinate_type*      ty,
+                             const difference_type       tyinc,
+                             const coordinate_type*      tz,
+                             const difference_type       tzinc,
+                             const size_type             source_count,
+                             const coordinate_type*      x,
+                             const difference_type       xinc,
+                             const coordinate_type*      y,
+                             const difference_type       yinc,
+                             const coordinate_type*      z,
+                             const difference_type       zinc,
+                             const std::vector<Payload>& payload,
+                             const size_type             k,
+                             const coordinate_type       radius,
+                             const size_type             max_rounds = 8);
+
+    // ----------------------------------------------------------
+    // [PRIVATE]
+    // ----------------------------------------------------------
+   private:
+    using index_type = hopi::spatial::TreeIndex<box_array, size_type>;  ///< Point values so Leafs hold a single corner
+    using splitting  = typename hopi::spatial::splitting_of<InputAdaptor>::type;  ///< InputAdaptor::rtree_splitting_type or Quadratic
+    using RTree      = hopi::spatial::RTree<index_type, hopi::spatial::ArenaAllocator<index_type>, splitting>;
+
+    static box_type grow(const box_type& box, const coordinate_type radius) noexcept;
+
+    /**
+     * Exchange skipping sources each rank received from an earlier
+     * exchange with sent_radius, which is then replaced by the radii
+     * of this exchange (empty to send all)
+     */
+    Ghosts exchange_(const size_type               source_count,
+                     const coordinate_type*        x,
+                     const difference_type         xinc,
+                     const coordinate_type*        y,
+                     const difference_type         yinc,
+                     const coordinate_type*        z,
+                     const difference_type         zinc,
+                     const std::vector<Payload>&   payload,
+                     const coordinate_type         radius,
+                     std::vector<coordinate_type>& sent_radius);
+
+    mpixx::communicator   m_comm;    ///< Communicator for everyone participating
+    std::vector<box_type> m_bounds;  ///< Bound owned by each Rank
+
+    std::optional<mpixx::communicator> m_graph;                ///< Graph of my Neighbors (built by exchange)
+    std::vector<coordinate_type>       m_graph_radius;         ///< Radius of each Rank when m_graph was built
+    std::vector<box_type>              m_graph_source_bounds;  ///< Source Bound of each Rank when m_graph was built
+    std::vector<int>                   m_sources;              ///< Ranks with sources inside my grown bound
+    std::vector<int>                   m_destinations;         ///< Ranks whose grown bound holds some of my sources
+    std::vector<box_type>              m_destination_regions;  ///< Grown bound of each destination
+};
+
+template<typename A>
+Halo<A>::Halo(const partition_type& partition) : m_comm(partition.comm()), m_bounds(partition.bounds())
+{
+}
+
+template<typename A>
+typename Halo<A>::box_type
+Halo<A>::grow(const box_type& box, const coordinate_type radius) noexcept
+{
+    box_array min_corner = box.min_corner();
+    box_array max_corner = box.max_corner();
+    for (size_type d = 0; d < NDim; ++d) {
+        min_corner[d] -= radius;
+        max_corner[d] += radius;
+    }
+    return box_type(min_corner, max_corner);
+}
+
+template<typename A>
+typename Halo<A>::Ghosts
+Halo<A>::exchange(const size_type             source_count,
+                  const coordinate_type*      x,
+                  const difference_type       xinc,
+                  const coordinate_type*      y,
+                  const difference_type       yinc,
+                  const coordinate_type*      z,
+                  const difference_type       zinc,
+                  const std::vector<Payload>& payload,
+                  const coordinate_type       radius)
+{
+    std::vector<coordinate_type> sent_radius;
+    return this->exchange_(source_count, x, xinc, y, yinc, z, zinc, payload, radius, sent_radius);
+}
+
+template<typename A>
+typename Halo<A>::Ghosts
+Halo<A>::exchange_(const size_type               source_count,
+                   const coordinate_type*        x,
+                   const difference_type         xinc,
+                   const coordinate_type*        y,
+                   const difference_type         yinc,
+                   const coordinate_type*        z,
+                   const difference_type         zinc,
+                   const std::vector<Payload>&   payload,
+                   const coordinate_type         radius,
+                   std::vector<coordinate_type>& sent_radius)
+{
+    using hopi::spatial::bound::Intersects;
+    HOPI_PROFILE_SCOPE("halo.exchange");
+
+    const rank_type my_rank   = m_comm.rank();
+    const size_type num_ranks = m_comm.size();
+
+    // Share the Radius of each Rank while bounding my Sources
+    std::vector<coordinate_type> radius_by_rank;
+    auto                         radius_request = mpixx::iall_gather(m_comm, radius, radius_by_rank);
+
+    box_type my_source_bound;
+    my_source_bound.reset();
+    for (size_type i = 0; i < source_count; ++i) {
+        const box_array point = { x[i * xinc], y[i * yinc], z[i * zinc] };
+        my_source_bound.stretch(box_type(point, point));
+    }
+
+    // Share the Source Bound of each Rank
+    std::vector<box_type> source_bound_by_rank;
+    mpixx::iall_gather(m_comm, my_source_bound, source_bound_by_rank).wait();
+    radius_request.wait();
+
+    // Find my Neighbors and their Graph
+    // - Every rank holds the same radii and source bounds so all
+    //   agree on when the collective graph must be rebuilt
+    if (not m_graph or (radius_by_rank != m_graph_radius) or (source_bound_by_rank != m_graph_source_bounds)) {
+        const box_type my_region = grow(m_bounds[my_rank], radius);
+        m_sources.clear();
+        m_destinations.clear();
+        m_destination_regions.clear();
+        for (size_type r = 0; r < num_ranks; ++r) {
+            if (rank_type(r) == my_rank) {
+                continue;
+            }
+            if (Intersects(my_region, source_bound_by_rank[r])) {
+                m_sources.push_back(int(r));
+            }
+            const box_type region = grow(m_bounds[r], radius_by_rank[r]);
+            if ((source_count > 0) and Intersects(region, my_source_bound)) {
+                m_destinations.push_back(int(r));
+                m_destination_regions.push_back(region);
+            }
+        }
+
+        MPI_Comm graph_comm;
+        BOOST_MPI_CHECK_RESULT(MPI_Dist_graph_create_adjacent,
+                               (MPI_Comm(m_comm),
+                                int(m_sources.size()), m_sources.data(), MPI_UNWEIGHTED,
+                                int(m_destinations.size()), m_destinations.data(), MPI_UNWEIGHTED,
+                                MPI_INFO_NULL, 0, &graph_comm));
+        m_graph.emplace(graph_comm, mpixx::comm_take_ownership);
+        m_graph_radius        = radius_by_rank;
+        m_graph_source_bounds = source_bound_by_rank;
+    }
+    const auto& sources      = m_sources;
+    const auto& destinations = m_destinations;
+    const auto  graph_comm   = MPI_Comm(*m_graph);
+
+    // Region of each destination which already holds my sources
+    // - Radii only grow between exchanges so the sent region is within the new one
+    const bool            was_sent = not sent_radius.empty();
+    std::vector<box_type> sent_regions;
+    std::vector<char>     has_new(destinations.size(), 1);
+    for (size_type n = 0; was_sent and (n < destinations.size()); ++n) {
+        const auto r = destinations[n];
+        sent_regions.push_back(grow(m_bounds[r], sent_radius[r]));
+        has_new[n] = (sent_radius[r] < radius_by_rank[r]) ? 1 : 0;
+    }
+
+    // Sources within each destination region in one pass over my sources
+    // - Bounds do not overlap so a source deeper inside my bound than
+    //   the largest destination radius can not be in any region
+    coordinate_type max_radius = 0;
+    for (const auto r : destinations) {
+        max_radius = std::max(max_radius, radius_by_rank[r]);
+    }
+    const box_type                      my_interior = grow(m_bounds[my_rank], -max_radius);
+    std::vector<std::vector<size_type>> send_lists(destinations.size());
+    for (size_type i = 0; i < source_count; ++i) {
+        const box_array point = { x[i * xinc], y[i * yinc], z[i * zinc] };
+        bool            interior = true;
+        for (size_type d = 0; d < NDim; ++d) {
+            interior = interior and (my_interior.min(d) < point[d]) and (point[d] < my_interior.max(d));
+        }
+        if (interior) {
+            continue;
+        }
+        const box_type point_box(point, point);
+        for (size_type n = 0; n < destinations.size(); ++n) {
+            if (has_new[n] and Intersects(m_destination_regions[n], point_box) and not(was_sent and Intersects(sent_regions[n], point_box))) {
+                send_lists[n].push_back(i);
+            }
+        }
+    }
+    sent_radius = radius_by_rank;
+    std::vector<int>       send_counts(destinations.size(), 0);
+    std::vector<int>       send_displs(destinations.size(), 0);
+    std::vector<size_type> send_index;
+    for (size_type n = 0; n < destinations.size(); ++n) {
+        send_displs[n] = int(send_index.size());
+        send_counts[n] = int(send_lists[n].size());
+        send_index.insert(send_index.end(), send_lists[n].begin(), send_lists[n].end());
+    }
+
+    // Exchange counts with Neighbors
+    std::vector<int> recv_counts(sources.size(), 0);
+    std::vector<int> recv_displs(sources.size(), 0);
+    {
+        HOPI_PROFILE_MPI("mpi.neighbor_alltoall", send_counts.size() * sizeof(int));
+        BOOST_MPI_CHECK_RESULT(MPI_Neighbor_alltoall, (send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, graph_comm));
+    }
+    std::exclusive_scan(recv_counts.begin(), recv_counts.end(), recv_displs.begin(), 0);
+    const size_type recv_size = std::accumulate(recv_counts.begin(), recv_counts.end(), size_type(0));
+
+    // Layout of a single record
+    // - Coordinates, Payload[0], Payload[1], ...
+    std::vector<size_type> payload_offset(payload.size());
+    size_type              record_bytes = NDim * sizeof(coordinate_type);
+    for (size_type c = 0; c < payload.size(); ++c) {
+        payload_offset[c] = record_bytes;
+        record_bytes += payload[c].bytes;
+    }
+
+    // Pack records in send order
+    std::vector<std::byte> send_buffer(send_index.size() * record_bytes);
+    for (size_type n = 0; n < send_index.size(); ++n) {
+        const auto      i      = send_index[n];
+        std::byte*      record = send_buffer.data() + n * record_bytes;
+        const box_array point  = { x[i * xinc], y[i * yinc], z[i * zinc] };
+        std::memcpy(record, point.data(), NDim * sizeof(coordinate_type));
+        for (size_type c = 0; c < payload.size(); ++c) {
+            const auto* column = static_cast<const std::byte*>(payload[c].data);
+            std::memcpy(record + payload_offset[c], column + i * payload[c].inc * payload[c].bytes, payload[c].bytes);
+        }
+    }
+
+    // Exchange records with Neighbors
+    std::vector<std::byte> recv_buffer(recv_size * record_bytes);
+    MPI_Datatype           record_type;
+    MPI_Request            request;
+    BOOST_MPI_CHECK_RESULT(MPI_Type_contiguous, (int(record_bytes), MPI_BYTE, &record_type));
+    BOOST_MPI_CHECK_RESULT(MPI_Type_commit, (&record_type));
+    {
+        HOPI_PROFILE_MPI("mpi.ineighbor_alltoallv", send_buffer.size());
+        BOOST_MPI_CHECK_RESULT(MPI_Ineighbor_alltoallv,
+                               (send_buffer.data(), send_counts.data(), send_displs.data(), record_type,
+                                recv_buffer.data(), recv_counts.data(), recv_displs.data(), record_type,
+                                graph_comm, &request));
+    }
+
+    // Size the results while the records are in flight
+    Ghosts ghosts;
+    ghosts.radius = radius;
+    ghosts.rounds = 1;
+    ghosts.xyz.resize(recv_size * NDim);
+    ghosts.rank.resize(recv_size);
+    ghosts.payload.resize(payload.size());
+    for (size_type c = 0; c < payload.size(); ++c) {
+        ghosts.payload[c].resize(recv_size * payload[c].bytes);
+    }
+    for (size_type n = 0; n < sources.size(); ++n) {
+        std::fill_n(std::next(ghosts.rank.begin(), recv_displs[n]), recv_counts[n], rank_type(sources[n]));
+    }
+
+    {
+        HOPI_PROFILE_SCOPE("mpi.wait");
+        BOOST_MPI_CHECK_RESULT(MPI_Wait, (&request, MPI_STATUS_IGNORE));
+    }
+    BOOST_MPI_CHECK_RESULT(MPI_Type_free, (&record_type));
+
+    // Unpack records into columns
+    for (size_type n = 0; n < recv_size; ++n) {
+        const std::byte* record = recv_buffer.data() + n * record_bytes;
+        std::memcpy(ghosts.xyz.data() + n * NDim, record, NDim * sizeof(coordinate_type));
+        for (size_type c = 0; c < payload.size(); ++c) {
+            std::memcpy(ghosts.payload[c].data() + n * payload[c].bytes, record + payload_offset[c], payload[c].bytes);
+        }
+    }
+    return ghosts;
+}
+
+template<typename A>
+typename Halo<A>::Ghosts
+Halo<A>::exchange_adaptive(const size_type             target_count,
+                           const coordinate_type*      tx,
+                           const difference_type       txinc,
+                           const coordinate_type*      ty,
+                           const difference_type       tyinc,
+                           const coordinate_type*      tz,
+                           const difference_type       tzinc,
+                           const size_type             source_count,
+                           const coordinate_type*      x,
+                           const difference_type       xinc,
+                           const coordinate_type*      y,
+                           const difference_type       yinc,
+                           const coordinate_type*      z,
+                           const difference_type       zinc,
+                           const std::vector<Payload>& payload,
+                           const size_type             k,
+                           const coordinate_type       radius,
+                           const size_type             max_rounds)
+{
+    HOPI_PROFILE_SCOPE("halo.exchange_adaptive");
+    const rank_type my_rank = m_comm.rank();
+    const box_type& my_bound = m_bounds[my_rank];
+
+    // My Sources are the start of every search
+    std::vector<index_type> local_sources;
+    local_sources.reserve(source_count);
+    for (size_type i = 0; i < source_count; ++i) {
+        const box_array point = { x[i * xinc], y[i * yinc], z[i * zinc] };
+        local_sources.emplace_back(point, i);
+    }
+
+    // Sources can never be found beyond the bound of all sources
+    box_type my_sources;
+    my_sources.reset();
+    for (const auto& source : local_sources) {
+        my_sources.stretch(box_type(source.first, source.first));
+    }
+    box_type all_sources;
+    auto     union_request = mpixx::iall_reduce(m_comm, &my_sources, 1, &all_sources, mpixx::box_union<box_type>());
+
+    // Targets as point bounds for searching
+    std::vector<box_type> targets;
+    targets.reserve(target_count);
+    for (size_type i = 0; i < target_count; ++i) {
+        const box_array point = { tx[i * txinc], ty[i * tyinc], tz[i * tzinc] };
+        targets.emplace_back(point, point);
+    }
+    union_request.wait();
+
+    // Each round only receives the sources beyond the previous radius
+    Ghosts                       ghosts;
+    std::vector<index_type>      all_indices(local_sources);
+    std::vector<coordinate_type> sent_radius;
+    coordinate_type              my_radius = radius;
+    ghosts.payload.resize(payload.size());
+    for (size_type round = 1;; ++round) {
+        const auto received = this->exchange_(source_count, x, xinc, y, yinc, z, zinc, payload, my_radius, sent_radius);
+        for (size_type n = 0; n < received.size(); ++n) {
+            box_array point;
+            std::copy_n(received.xyz.data() + n * NDim, NDim, point.begin());
+            all_indices.emplace_back(point, source_count + ghosts.size() + n);
+        }
+        ghosts.xyz.insert(ghosts.xyz.end(), received.xyz.begin(), received.xyz.end());
+        ghosts.rank.insert(ghosts.rank.end(), received.rank.begin(), received.rank.end());
+        for (size_type c = 0; c < payload.size(); ++c) {
+            ghosts.payload[c].insert(ghosts.payload[c].end(), received.payload[c].begin(), received.payload[c].end());
+        }
+        ghosts.radius = my_radius;
+        ghosts.rounds = round;
+        if (round >= max_rounds) {
+            break;
+        }
+
+        // Find the K'th nearest of my Sources & Ghosts for each Target
+
+        // Radius needed so the ball about each Target reaching its K'th
+        // nearest (clipped to all sources) fits within my grown bound
+        coordinate_type needed = 0;
+        if (target_count > 0) {
+            if (all_indices.size() < k) {
+                needed = std::max(coordinate_type(2) * my_radius, std::numeric_limits<coordinate_type>::min());
+            }
+            else {
+                RTree                   rtree(all_indices.begin(), all_indices.end(), hopi::spatial::STRPacking());
+                std::vector<size_type>  offsets;
+                std::vector<index_type> neighbors;
+                rtree.query_batch(targets, k, offsets, neighbors);
+
+                // Grown by the rounding error of the metric so values tied
+                // with the K'th in coordinate_type are also received
+                constexpr auto slack = 1 + hopi::spatial::bound::distance_error_bound<coordinate_type, NDim>();
+                for (size_type i = 0; i < target_count; ++i) {
+                    const auto& kth  = neighbors[offsets[i + 1] - 1].first;
+                    const auto  dist = coordinate_type(std::sqrt(slack * hopi::spatial::bound::Nearest(kth, targets[i])));
+                    for (size_type d = 0; d < NDim; ++d) {
+                        const auto lo = std::max(targets[i].min(d) - dist, all_sources.min(d));
+                        const auto hi = std::min(targets[i].max(d) + dist, all_sources.max(d));
+                        needed        = std::max({ needed, my_bound.min(d) - lo, hi - my_bound.max(d) });
+                    }
+                }
+            }
+        }
+
+        // Grow if needed by anyone
+        const int must_grow = (needed > my_radius) ? 1 : 0;
+        if (must_grow) {
+            my_radius = needed;
+        }
+        if (mpixx::all_reduce(m_comm, must_grow, MPI_LOR) == 0) {
+            break;
+        }
+    }
+    return ghosts;
+}
+
+} /* namespace hopi */
@@ -5,7 +5,7 @@
  * Date:            Dec 6, 2022
  * Author:          Bryan Flynt
  * -----
- * Last Modified:   Dec 6, 2022
+ * Last Modified:   Oct 14, 2026
  * Modified By:     Bryan Flynt
  * -----
  * Copyright:       See LICENSE file
@@ -14,6 +14,8 @@
 #include "hopi/mpixx.hpp"
 
 #include <cstdlib> // exit()
+#include <mutex>
+#include <vector>
 
 namespace hopi {
 
@@ -22,4 +24,64 @@ void mpixx_abort_handler(){
 	world.abort(EXIT_FAILURE);
 }
 
-} // namespace hopi
\ No newline at end of file
+} // namespace hopi
+
+namespace mpixx {
+namespace detail {
+namespace {
+
+// Datatypes and operations to free at MPI_Finalize
+struct Registry {
+	std::mutex                mutex;
+	std::vector<MPI_Datatype> types;
+	std::vector<MPI_Op>       ops;
+	int                       keyval = MPI_KEYVAL_INVALID;
+};
+
+Registry& registry(){
+	static Registry reg;
+	return reg;
+}
+
+// MPI_Finalize deletes the attributes of MPI_COMM_SELF first
+int free_registered(MPI_Comm, int, void*, void*){
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	for(auto& type : reg.types){
+		MPI_Type_free(&type);
+	}
+	for(auto& op : reg.ops){
+		MPI_Op_free(&op);
+	}
+	reg.types.clear();
+	reg.ops.clear();
+	MPI_Comm_free_keyval(&reg.keyval);
+	return MPI_SUCCESS;
+}
+
+// Attach the cleanup to MPI_COMM_SELF once
+void attach_cleanup(Registry& reg){
+	if( reg.keyval == MPI_KEYVAL_INVALID ){
+		BOOST_MPI_CHECK_RESULT(MPI_Comm_create_keyval, (MPI_COMM_NULL_COPY_FN, free_registered, &reg.keyval, nullptr));
+		BOOST_MPI_CHECK_RESULT(MPI_Comm_set_attr, (MPI_COMM_SELF, reg.keyval, nullptr));
+	}
+}
+
+} // namespace
+
+void free_at_finalize(MPI_Datatype type){
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	attach_cleanup(reg);
+	reg.types.push_back(type);
+}
+
+void free_at_finalize(MPI_Op op){
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	attach_cleanup(reg);
+	reg.ops.push_back(op);
+}
+
+} // namespace detail
+} // namespace mpixx
@@ -5,7 +5,7 @@
  * Date:            Dec 6, 2022
  * Author:          Bryan Flynt
  * -----
- * Last Modified:   Dec 8, 2022
+ * Last Modified:   Oct 14, 2026
  * Modified By:     Bryan Flynt
  * -----
  * Copyright:       See LICENSE file
@@ -13,12 +13,22 @@
 #pragma once
 
 #include "boost/mpi.hpp"
+#include "boost/mpi/exception.hpp"
 
 // To enable Boost Serialization for MPI
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/utility.hpp>
 
-namespace mpixx = boost::mpi;
+#include "hopi/profile.hpp"
+#include "hopi/spatial/bound/box.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace hopi {
 
@@ -26,6 +36,292 @@ void mpixx_abort_handler();
 
 } // namespace hopi
 
+/**
+ * Boost.MPI plus a thin typed layer
+ *
+ * Boost.MPI serializes any type it does not know to be an MPI
+ * datatype and reduces it with the user operation on the root.
+ * The typed layer instead maps trivially copyable types onto
+ * committed MPI_Datatype's and MPI_Op's so collectives go straight
+ * to the MPI library without an archive in between.
+ */
+namespace mpixx {
+
+using namespace boost::mpi;
+using boost::mpi::all_reduce;
+
+namespace detail {
+
+/**
+ * Free the datatype when MPI_Finalize is called
+ */
+void free_at_finalize(MPI_Datatype type);
+
+/**
+ * Free the operation when MPI_Finalize is called
+ */
+void free_at_finalize(MPI_Op op);
+
+} // namespace detail
+
+/**
+ * Layout of a type as a count of a single MPI datatype
+ *
+ * Specialized for the aggregates exchanged by HOPI. Any other
+ * trivially copyable type is sent as raw bytes, which is fine
+ * for copying but can only be reduced with a custom MPI_Op.
+ */
+template<typename T>
+struct datatype_traits {
+    static constexpr bool is_native = boost::mpi::is_mpi_datatype<T>::value;
+    static_assert(std::is_trivially_copyable_v<T>, "MPI datatype requires a trivially copyable type");
+    using element_type                 = std::conditional_t<is_native, T, std::byte>;
+    static constexpr std::size_t count = is_native ? 1 : sizeof(T);
+    static MPI_Datatype element()
+    {
+        if constexpr (is_native) {
+            return boost::mpi::get_mpi_datatype<T>();
+        }
+        else {
+            return MPI_BYTE;
+        }
+    }
+};
+
+template<typename T, std::size_t N>
+struct datatype_traits<std::array<T, N>> {
+    using element_type                 = typename datatype_traits<T>::element_type;
+    static constexpr std::size_t count = N * datatype_traits<T>::count;
+    static MPI_Datatype element() { return datatype_traits<T>::element(); }
+};
+
+template<typename T>
+struct datatype_traits<std::pair<T, T>> {
+    using element_type                 = typename datatype_traits<T>::element_type;
+    static constexpr std::size_t count = 2 * datatype_traits<T>::count;
+    static MPI_Datatype element() { return datatype_traits<T>::element(); }
+};
+
+template<typename T, std::size_t N>
+struct datatype_traits<hopi::spatial::bound::Box<T, N>> {
+    using element_type                 = typename datatype_traits<T>::element_type;
+    static constexpr std::size_t count = 2 * N * datatype_traits<T>::count;
+    static MPI_Datatype element() { return datatype_traits<T>::element(); }
+};
+
+/**
+ * Committed MPI datatype for T
+ *
+ * Created on first use and freed by MPI_Finalize.
+ */
+template<typename T>
+MPI_Datatype
+datatype()
+{
+    using traits = datatype_traits<T>;
+    static_assert(sizeof(T) == traits::count * sizeof(typename traits::element_type), "Type has padding");
+    if constexpr (boost::mpi::is_mpi_datatype<T>::value) {
+        return boost::mpi::get_mpi_datatype<T>();
+    }
+    else {
+        static const MPI_Datatype type = [] {
+            MPI_Datatype ans;
+            BOOST_MPI_CHECK_RESULT(MPI_Type_contiguous, (int(traits::count), traits::element(), &ans));
+            BOOST_MPI_CHECK_RESULT(MPI_Type_commit, (&ans));
+            detail::free_at_finalize(ans);
+            return ans;
+        }();
+        return type;
+    }
+}
+
+/**
+ * MPI_Op for the union of boxes
+ */
+template<typename Box>
+MPI_Op
+box_union()
+{
+    static const MPI_Op op = [] {
+        MPI_Op ans;
+        auto   function = [](void* in, void* inout, int* len, MPI_Datatype*) {
+            const auto* a = static_cast<const Box*>(in);
+            auto*       b = static_cast<Box*>(inout);
+            for (int i = 0; i < *len; ++i) {
+                b[i].stretch(a[i]);
+            }
+        };
+        BOOST_MPI_CHECK_RESULT(MPI_Op_create, (function, 1, &ans));
+        detail::free_at_finalize(ans);
+        return ans;
+    }();
+    return op;
+}
+
+/**
+ * MPI_Op summing each member of a pair, array or box
+ */
+template<typename T>
+MPI_Op
+pairwise_sum()
+{
+    using element_type = typename datatype_traits<T>::element_type;
+    static_assert(std::is_arithmetic_v<element_type>, "Sum requires arithmetic members");
+    static const MPI_Op op = [] {
+        MPI_Op ans;
+        auto   function = [](void* in, void* inout, int* len, MPI_Datatype*) {
+            const auto*     a = static_cast<const element_type*>(in);
+            auto*           b = static_cast<element_type*>(inout);
+            const std::size_t n = std::size_t(*len) * datatype_traits<T>::count;
+            for (std::size_t i = 0; i < n; ++i) {
+                b[i] += a[i];
+            }
+        };
+        BOOST_MPI_CHECK_RESULT(MPI_Op_create, (function, 1, &ans));
+        detail::free_at_finalize(ans);
+        return ans;
+    }();
+    return op;
+}
+
+/**
+ * Handle to a non-blocking collective
+ *
+ * The buffers passed to the collective must stay alive until
+ * wait() returns. Destroying an incomplete handle waits.
+ */
+class irequest final {
+   public:
+    irequest() = default;
+    irequest(const irequest& other) = delete;
+    irequest(irequest&& other) noexcept : m_request(std::exchange(other.m_request, MPI_REQUEST_NULL)) {}
+    explicit irequest(MPI_Request request) : m_request(request) {}
+    ~irequest() { MPI_Wait(&m_request, MPI_STATUS_IGNORE); }
+
+    irequest& operator=(const irequest& other) = delete;
+    irequest& operator=(irequest&& other) noexcept
+    {
+        std::swap(m_request, other.m_request);
+        return *this;
+    }
+
+    /**
+     * Block until the collective completes
+     */
+    void wait()
+    {
+        HOPI_PROFILE_SCOPE("mpi.wait");
+        BOOST_MPI_CHECK_RESULT(MPI_Wait, (&m_request, MPI_STATUS_IGNORE));
+    }
+
+    /**
+     * Returns true once the collective has completed
+     */
+    bool test()
+    {
+        int flag = 0;
+        BOOST_MPI_CHECK_RESULT(MPI_Test, (&m_request, &flag, MPI_STATUS_IGNORE));
+        return flag != 0;
+    }
+
+   private:
+    MPI_Request m_request = MPI_REQUEST_NULL;
+};
+
+/**
+ * Reduce n values of T across all ranks with an MPI_Op
+ */
+template<typename T>
+void
+all_reduce(const communicator& comm, const T* in_values, int n, T* out_values, MPI_Op op)
+{
+    HOPI_PROFILE_MPI("mpi.allreduce", std::uint64_t(n) * sizeof(T));
+    BOOST_MPI_CHECK_RESULT(MPI_Allreduce, (in_values, out_values, n, datatype<T>(), op, MPI_Comm(comm)));
+}
+
+/**
+ * Reduce a single T across all ranks with an MPI_Op
+ */
+template<typename T>
+T
+all_reduce(const communicator& comm, const T& in_value, MPI_Op op)
+{
+    T ans;
+    mpixx::all_reduce(comm, &in_value, 1, &ans, op);
+    return ans;
+}
+
+/**
+ * Start reducing n values of T across all ranks
+ */
+template<typename T>
+irequest
+iall_reduce(const communicator& comm, const T* in_values, int n, T* out_values, MPI_Op op)
+{
+    HOPI_PROFILE_MPI("mpi.iallreduce", std::uint64_t(n) * sizeof(T));
+    MPI_Request request;
+    BOOST_MPI_CHECK_RESULT(MPI_Iallreduce, (in_values, out_values, n, datatype<T>(), op, MPI_Comm(comm), &request));
+    return irequest(request);
+}
+
+/**
+ * Start gathering one T from every rank
+ *
+ * out_values is sized to the number of ranks before returning.
+ */
+template<typename T>
+irequest
+iall_gather(const communicator& comm, const T& in_value, std::vector<T>& out_values)
+{
+    HOPI_PROFILE_MPI("mpi.iallgather", sizeof(T));
+    out_values.resize(comm.size());
+    MPI_Request request;
+    BOOST_MPI_CHECK_RESULT(
+        MPI_Iallgather, (&in_value, 1, datatype<T>(), out_values.data(), 1, datatype<T>(), MPI_Comm(comm), &request));
+    return irequest(request);
+}
+
+/**
+ * Start exchanging n values of T with every rank
+ *
+ * Values in_values[r * n] to in_values[r * n + n - 1] are sent to rank r.
+ */
+template<typename T>
+irequest
+iall_to_all(const communicator& comm, const T* in_values, int n, T* out_values)
+{
+    HOPI_PROFILE_MPI("mpi.ialltoall", std::uint64_t(n) * comm.size() * sizeof(T));
+    MPI_Request request;
+    BOOST_MPI_CHECK_RESULT(MPI_Ialltoall, (in_values, n, datatype<T>(), out_values, n, datatype<T>(), MPI_Comm(comm), &request));
+    return irequest(request);
+}
+
+/**
+ * Start exchanging a varying number of T with every rank
+ *
+ * Counts and displacements are in units of T and must stay
+ * alive along with the buffers until the request completes.
+ */
+template<typename T>
+irequest
+iall_to_allv(const communicator&     comm,
+             const T*                in_values,
+             const std::vector<int>& in_counts,
+             const std::vector<int>& in_displs,
+             T*                      out_values,
+             const std::vector<int>& out_counts,
+             const std::vector<int>& out_displs)
+{
+    HOPI_PROFILE_MPI("mpi.ialltoallv", std::accumulate(in_counts.begin(), in_counts.end(), std::uint64_t(0)) * sizeof(T));
+    MPI_Request request;
+    BOOST_MPI_CHECK_RESULT(MPI_Ialltoallv,
+                           (in_values, in_counts.data(), in_displs.data(), datatype<T>(), out_values, out_counts.data(),
+                            out_displs.data(), datatype<T>(), MPI_Comm(comm), &request));
+    return irequest(request);
+}
+
+} // namespace mpixx
+
 //
 // Enable serialization of std::tuple
 //
@@ -0,0 +1,48 @@
+/// @file offload.cpp
+/*
+ * Project:         HOPI
+ * File:            offload.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/offload.hpp"
+
+namespace hopi {
+
+OffloadMatrix::OffloadMatrix(const std::vector<size_type>& offsets,
+                             const std::vector<size_type>& columns,
+                             const std::vector<double>&    weights,
+                             const size_type               num_columns)
+    : m_offsets(offsets), m_columns(columns), m_weights(weights), m_num_columns(num_columns)
+{
+    assert(not m_offsets.empty());
+    assert(m_columns.size() == m_weights.size());
+#if defined(HOPI_USE_OFFLOAD)
+    [[maybe_unused]] const size_type nr = m_offsets.size();
+    [[maybe_unused]] const size_type nw = m_weights.size();
+    [[maybe_unused]] const auto*     o  = m_offsets.data();
+    [[maybe_unused]] const auto*     c  = m_columns.data();
+    [[maybe_unused]] const auto*     w  = m_weights.data();
+#pragma omp target enter data map(to : o[0 : nr], c[0 : nw], w[0 : nw])
+#endif
+}
+
+OffloadMatrix::~OffloadMatrix()
+{
+#if defined(HOPI_USE_OFFLOAD)
+    [[maybe_unused]] const size_type nr = m_offsets.size();
+    [[maybe_unused]] const size_type nw = m_weights.size();
+    [[maybe_unused]] const auto*     o  = m_offsets.data();
+    [[maybe_unused]] const auto*     c  = m_columns.data();
+    [[maybe_unused]] const auto*     w  = m_weights.data();
+#pragma omp target exit data map(delete : o[0 : nr], c[0 : nw], w[0 : nw])
+#endif
+}
+
+} /* namespace hopi */
@@ -0,0 +1,399 @@
+/// @file offload.hpp
+/*
+ * Project:         HOPI
+ * File:            offload.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace hopi {
+
+/**
+ * Offload of the stencil search and weight apply of RBFInterpolator
+ *
+ * Built with HOPI_USE_OFFLOAD the kernels are OpenMP target regions
+ * which run on the device chosen by the offload flags of the
+ * compiler (or the host when no device is present). The tree, the
+ * sources and the weights are mapped to the device once when built
+ * and stay there until destroyed. Otherwise the same kernels are
+ * spread over the host cores.
+ */
+
+/**
+ * Pointer-free copy of a point R-tree for stackless kNN traversal
+ *
+ * Nodes are stored in depth first order so the first child of node
+ * i is node i + 1 and skip[i] is the node following its subtree. A
+ * node without child nodes is a bucket holding the points within
+ * [first, last) which are stored in the order of the tree. Each
+ * target walks the nodes in order, jumping over any subtree whose
+ * bound is further than its K'th nearest point so far, and keeps
+ * the K nearest in a sorted array of at most MaxK entries.
+ */
+template<typename T, std::size_t N, std::size_t MaxK = 64>
+class OffloadTree final {
+   public:
+    using coordinate_type = T;
+    using size_type       = std::size_t;
+    using node_index      = std::uint32_t;
+
+    static constexpr size_type max_neighbors = MaxK;  ///< Largest K of query_batch
+
+    OffloadTree()                         = delete;
+    OffloadTree(const OffloadTree& other) = delete;
+    OffloadTree(OffloadTree&& other)      = delete;
+    OffloadTree& operator=(const OffloadTree& other) = delete;
+    OffloadTree& operator=(OffloadTree&& other)      = delete;
+
+    /**
+     * Flatten an RTree of TreeIndex<std::array<T,N>,Key> point values
+     */
+    template<typename RTree>
+    explicit OffloadTree(const RTree& tree);
+
+    ~OffloadTree();
+
+    size_type num_nodes() const noexcept { return m_skip.size(); }
+    size_type num_points() const noexcept { return m_index.size(); }
+
+    /**
+     * Find the k nearest points of each target
+     *
+     * Targets hold N interleaved coordinates per point. The neighbors
+     * of target t are the keys columns[offsets[t]] to columns[offsets[t+1]]
+     * nearest first, as returned by Frozen::parallel_query_batch.
+     * Distances are measured in double.
+     */
+    void query_batch(const size_type         count,
+                     const T*                targets,
+                     const size_type         k,
+                     std::vector<size_type>& offsets,
+                     std::vector<size_type>& columns) const;
+
+   private:
+    static void nearest_(const T*          target,
+                         const size_type   found,
+                         const size_type   num_nodes,
+                         const T*          lower,
+                         const T*          upper,
+                         const node_index* skip,
+                         const node_index* first,
+                         const node_index* last,
+                         const T*          points,
+                         const size_type*  index,
+                         size_type*        columns);
+
+    std::vector<T>          m_lower;   ///< N minimum coordinates of each node
+    std::vector<T>          m_upper;   ///< N maximum coordinates of each node
+    std::vector<node_index> m_skip;    ///< Node following the subtree of each node
+    std::vector<node_index> m_first;   ///< First point within each node
+    std::vector<node_index> m_last;    ///< One past the last point within each node
+    std::vector<T>          m_points;  ///< N coordinates of each point in tree order
+    std::vector<size_type>  m_index;   ///< Key of each point in tree order
+};
+
+/**
+ * CSR weight matrix kept on the device for repeated apply
+ */
+class OffloadMatrix final {
+   public:
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    OffloadMatrix()                           = delete;
+    OffloadMatrix(const OffloadMatrix& other) = delete;
+    OffloadMatrix(OffloadMatrix&& other)      = delete;
+    OffloadMatrix& operator=(const OffloadMatrix& other) = delete;
+    OffloadMatrix& operator=(OffloadMatrix&& other)      = delete;
+
+    OffloadMatrix(const std::vector<size_type>& offsets,
+                  const std::vector<size_type>& columns,
+                  const std::vector<double>&    weights,
+                  const size_type               num_columns);
+
+    ~OffloadMatrix();
+
+    size_type num_rows() const noexcept { return m_offsets.size() - 1; }
+    size_type num_columns() const noexcept { return m_num_columns; }
+
+    /**
+     * Interpolate nvar fields with the layout of RBFInterpolator::apply
+     *
+     * Source values are mapped to the device for the call unless the
+     * caller already mapped them, and only the interpolated values
+     * are copied back.
+     */
+    template<typename T>
+    void apply(const size_type       nvar,
+               const T*              source_values,
+               const difference_type sinc,
+               const difference_type svar,
+               T*                    target_values,
+               const difference_type tinc,
+               const difference_type tvar) const;
+
+   private:
+    std::vector<size_type> m_offsets;      ///< First weight of each row
+    std::vector<size_type> m_columns;      ///< Column of each weight
+    std::vector<double>    m_weights;      ///< Weights of each row
+    size_type              m_num_columns;  ///< Sources within each row
+};
+
+// ----------------------------------------------------------
+// OffloadTree
+// ----------------------------------------------------------
+
+template<typename T, std::size_t N, std::size_t K>
+template<typename RTree>
+OffloadTree<T, N, K>::OffloadTree(const RTree& tree)
+{
+    // Lay out the nodes in depth first order
+    // - An extra root covers a tree holding a single Leaf
+    std::vector<node_index> open;
+    auto                    enter = [&](const auto& bound) {
+        open.push_back(node_index(m_skip.size()));
+        for (size_type d = 0; d < N; ++d) {
+            m_lower.push_back(bound.min_corner()[d]);
+            m_upper.push_back(bound.max_corner()[d]);
+        }
+        m_skip.push_back(0);
+        m_first.push_back(node_index(m_index.size()));
+        m_last.push_back(0);
+    };
+    auto leave = [&]() {
+        const auto node = open.back();
+        open.pop_back();
+        m_skip[node] = node_index(m_skip.size());
+        m_last[node] = node_index(m_index.size());
+    };
+    auto leaf = [&](const auto& value) {
+        assert((m_skip.size() == open.back() + 1) and "Points must only be held by buckets");
+        for (size_type d = 0; d < N; ++d) {
+            m_points.push_back(value.first[d]);
+        }
+        m_index.push_back(size_type(value.second));
+    };
+    if (not tree.empty()) {
+        enter(tree.bounds());
+        tree.walk(enter, leave, leaf);
+        leave();
+    }
+
+#if defined(HOPI_USE_OFFLOAD)
+    [[maybe_unused]] const size_type   nn     = this->num_nodes();
+    [[maybe_unused]] const size_type   np     = this->num_points();
+    [[maybe_unused]] const T*          lower  = m_lower.data();
+    [[maybe_unused]] const T*          upper  = m_upper.data();
+    [[maybe_unused]] const node_index* skip   = m_skip.data();
+    [[maybe_unused]] const node_index* first  = m_first.data();
+    [[maybe_unused]] const node_index* last   = m_last.data();
+    [[maybe_unused]] const T*          points = m_points.data();
+    [[maybe_unused]] const size_type*  index  = m_index.data();
+#pragma omp target enter data map(to : lower[0 : nn * N], upper[0 : nn * N], skip[0 : nn], first[0 : nn], last[0 : nn], \
+                                      points[0 : np * N], index[0 : np])
+#endif
+}
+
+template<typename T, std::size_t N, std::size_t K>
+OffloadTree<T, N, K>::~OffloadTree()
+{
+#if defined(HOPI_USE_OFFLOAD)
+    [[maybe_unused]] const size_type   nn     = this->num_nodes();
+    [[maybe_unused]] const size_type   np     = this->num_points();
+    [[maybe_unused]] const T*          lower  = m_lower.data();
+    [[maybe_unused]] const T*          upper  = m_upper.data();
+    [[maybe_unused]] const node_index* skip   = m_skip.data();
+    [[maybe_unused]] const node_index* first  = m_first.data();
+    [[maybe_unused]] const node_index* last   = m_last.data();
+    [[maybe_unused]] const T*          points = m_points.data();
+    [[maybe_unused]] const size_type*  index  = m_index.data();
+#pragma omp target exit data map(delete : lower[0 : nn * N], upper[0 : nn * N], skip[0 : nn], first[0 : nn], last[0 : nn], \
+                                     points[0 : np * N], index[0 : np])
+#endif
+}
+
+template<typename T, std::size_t N, std::size_t K>
+void
+OffloadTree<T, N, K>::query_batch(const size_type         count,
+                                  const T*                targets,
+                                  const size_type         k,
+                                  std::vector<size_type>& offsets,
+                                  std::vector<size_type>& columns) const
+{
+    assert(k <= max_neighbors);
+    const size_type found = std::min(k, this->num_points());
+    offsets.resize(count + 1);
+    for (size_type t = 0; t <= count; ++t) {
+        offsets[t] = t * found;
+    }
+    columns.resize(count * found);
+    if ((count == 0) or (found == 0)) {
+        return;
+    }
+
+    const size_type                    nn     = this->num_nodes();
+    [[maybe_unused]] const size_type   np     = this->num_points();
+    const T*                           lower  = m_lower.data();
+    const T*                           upper  = m_upper.data();
+    const node_index*                  skip   = m_skip.data();
+    const node_index*                  first  = m_first.data();
+    const node_index*                  last   = m_last.data();
+    const T*                           points = m_points.data();
+    const size_type*                   index  = m_index.data();
+    size_type*                         out    = columns.data();
+#if defined(HOPI_USE_OFFLOAD)
+#pragma omp target teams distribute parallel for map(to : targets[0 : count * N]) map(from : out[0 : count * found]) \
+    map(to : lower[0 : nn * N], upper[0 : nn * N], skip[0 : nn], first[0 : nn], last[0 : nn], points[0 : np * N], index[0 : np])
+#elif defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (size_type t = 0; t < count; ++t) {
+        nearest_(targets + t * N, found, nn, lower, upper, skip, first, last, points, index, out + t * found);
+    }
+}
+
+#if defined(HOPI_USE_OFFLOAD)
+#pragma omp declare target
+#endif
+template<typename T, std::size_t N, std::size_t K>
+void
+OffloadTree<T, N, K>::nearest_(const T*          target,
+                               const size_type   found,
+                               const size_type   num_nodes,
+                               const T*          lower,
+                               const T*          upper,
+                               const node_index* skip,
+                               const node_index* first,
+                               const node_index* last,
+                               const T*          points,
+                               const size_type*  index,
+                               size_type*        columns)
+{
+    // Fixed size sorted heap of the nearest points so far
+    double     best_distance[K];
+    node_index best_point[K];
+    size_type  num_best = 0;
+    double     worst    = std::numeric_limits<double>::max();
+
+    std::array<double, N> query;
+    for (size_type d = 0; d < N; ++d) {
+        query[d] = target[d];
+    }
+
+    node_index node = 0;
+    while (node < num_nodes) {
+        // Skip the subtree if its bound is further than the K'th nearest
+        double bound_distance = 0;
+        for (size_type d = 0; d < N; ++d) {
+            const double lo     = lower[node * N + d];
+            const double hi     = upper[node * N + d];
+            const double excess = (query[d] < lo) ? lo - query[d] : ((query[d] > hi) ? query[d] - hi : 0.0);
+            bound_distance += excess * excess;
+        }
+        if (bound_distance > worst) {
+            node = skip[node];
+            continue;
+        }
+        if (skip[node] != node + 1) {
+            ++node;
+            continue;
+        }
+
+        // Bucket of points
+        for (node_index p = first[node]; p < last[node]; ++p) {
+            double distance = 0;
+            for (size_type d = 0; d < N; ++d) {
+                const double delta = double(points[p * N + d]) - query[d];
+                distance += delta * delta;
+            }
+            if ((num_best == found) and (distance >= worst)) {
+                continue;
+            }
+            size_type j = (num_best < found) ? num_best++ : found - 1;
+            while ((j > 0) and (best_distance[j - 1] > distance)) {
+                best_distance[j] = best_distance[j - 1];
+                best_point[j]    = best_point[j - 1];
+                --j;
+            }
+            best_distance[j] = distance;
+            best_point[j]    = p;
+            if (num_best == found) {
+                worst = best_distance[found - 1];
+            }
+        }
+        node = skip[node];
+    }
+
+    for (size_type j = 0; j < found; ++j) {
+        columns[j] = index[best_point[j]];
+    }
+}
+#if defined(HOPI_USE_OFFLOAD)
+#pragma omp end declare target
+#endif
+
+// ----------------------------------------------------------
+// OffloadMatrix
+// ----------------------------------------------------------
+
+template<typename T>
+void
+OffloadMatrix::apply(const size_type       nvar,
+                     const T*              source_values,
+                     const difference_type sinc,
+                     const difference_type svar,
+                     T*                    target_values,
+                     const difference_type tinc,
+                     const difference_type tvar) const
+{
+    const size_type rows = this->num_rows();
+    if ((rows == 0) or (nvar == 0)) {
+        return;
+    }
+
+    // Interpolated values are gathered contiguously so only they are copied back
+    std::vector<T>                   result(rows * nvar);
+    T*                               out     = result.data();
+    [[maybe_unused]] const size_type extent  = (m_num_columns == 0) ? 0 : (m_num_columns - 1) * sinc + (nvar - 1) * svar + 1;
+    [[maybe_unused]] const size_type nw      = m_weights.size();
+    const auto*                      offsets = m_offsets.data();
+    const auto*                      columns = m_columns.data();
+    const auto*                      weights = m_weights.data();
+#if defined(HOPI_USE_OFFLOAD)
+#pragma omp target teams distribute parallel for map(to : source_values[0 : extent]) map(from : out[0 : rows * nvar]) \
+    map(to : offsets[0 : rows + 1], columns[0 : nw], weights[0 : nw])
+#elif defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_type t = 0; t < rows; ++t) {
+        for (size_type v = 0; v < nvar; ++v) {
+            T sum = 0;
+            for (size_type n = offsets[t]; n < offsets[t + 1]; ++n) {
+                sum += T(weights[n]) * source_values[columns[n] * sinc + v * svar];
+            }
+            out[t * nvar + v] = sum;
+        }
+    }
+
+    for (size_type t = 0; t < rows; ++t) {
+        for (size_type v = 0; v < nvar; ++v) {
+            target_values[t * tinc + v * tvar] = result[t * nvar + v];
+        }
+    }
+}
+
+} /* namespace hopi */
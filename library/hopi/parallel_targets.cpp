@@ -0,0 +1,212 @@
+/// @file parallel_targets.cpp
+/*
+ * Project:         HOPI
+ * File:            parallel_targets.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/parallel_targets.hpp"
+#include "hopi/profile.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <iostream>
+#include <numeric>
+
+namespace hopi {
+
+namespace {
+
+[[noreturn]] void
+parallel_file_error(const mpixx::communicator& comm, const std::string& message, const std::string& file_name)
+{
+    std::cerr << "P:" << comm.rank() << " ERROR: " << message << std::endl;
+    std::cerr << "P:" << comm.rank() << " Filename: " << file_name << std::endl;
+    comm.abort(EXIT_FAILURE);
+    std::exit(EXIT_FAILURE);
+}
+
+// Count passed to a single MPI call
+int
+checked_count(const mpixx::communicator& comm, const std::size_t count, const std::string& file_name)
+{
+    if (count > std::size_t(INT_MAX)) {
+        parallel_file_error(comm, "Too Many Values For One MPI Call", file_name);
+    }
+    return int(count);
+}
+
+// Elementary MPI type of a stored value
+MPI_Datatype
+value_datatype(const std::size_t value_bytes)
+{
+    return (value_bytes == sizeof(float)) ? MPI_FLOAT : MPI_DOUBLE;
+}
+
+}  // namespace
+
+/// Collectively read a Binary HOPI File
+/**
+ */
+template<typename T>
+TargetSlice<T>
+read_targets_parallel(const mpixx::communicator& comm, const std::string& file_name)
+{
+    HOPI_PROFILE_SCOPE("io.read_parallel");
+    MPI_File file;
+    if (MPI_File_open(MPI_Comm(comm), file_name.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        parallel_file_error(comm, "File Did Not Open", file_name);
+    }
+
+    // Rank 0 reads the Header for everyone
+    TargetSlice<T> slice;
+    MPI_Offset     file_bytes = 0;
+    if (comm.rank() == 0) {
+        BOOST_MPI_CHECK_RESULT(MPI_File_get_size, (file, &file_bytes));
+        if (std::size_t(file_bytes) >= sizeof(BinaryTargetHeader)) {
+            BOOST_MPI_CHECK_RESULT(MPI_File_read_at,
+                                   (file, 0, &slice.header, int(sizeof(BinaryTargetHeader)), MPI_BYTE, MPI_STATUS_IGNORE));
+        }
+        else {
+            parallel_file_error(comm, "File Too Small For Header", file_name);
+        }
+        check_binary_target_header(slice.header, std::size_t(file_bytes), file_name);
+    }
+    BOOST_MPI_CHECK_RESULT(MPI_Bcast, (&slice.header, int(sizeof(BinaryTargetHeader)), MPI_BYTE, 0, MPI_Comm(comm)));
+    const auto& head = slice.header;
+
+    // My contiguous slice of points
+    const std::size_t num_ranks = comm.size();
+    const std::size_t my_rank   = comm.rank();
+    slice.first                 = (head.npoints * my_rank) / num_ranks;
+    slice.count                 = (head.npoints * (my_rank + 1)) / num_ranks - slice.first;
+
+    // View of my slice within every block
+    const int          num_blocks  = checked_count(comm, head.ndim + head.nvar, file_name);
+    const int          slice_count = checked_count(comm, slice.count, file_name);
+    const MPI_Datatype value_type  = value_datatype(head.value_bytes);
+    MPI_Datatype       slice_type;
+    MPI_Datatype       file_type;
+    BOOST_MPI_CHECK_RESULT(MPI_Type_contiguous, (slice_count, value_type, &slice_type));
+    BOOST_MPI_CHECK_RESULT(MPI_Type_create_hvector,
+                           (num_blocks, 1, MPI_Aint(head.block_stride), slice_type, &file_type));
+    BOOST_MPI_CHECK_RESULT(MPI_Type_commit, (&slice_type));
+    BOOST_MPI_CHECK_RESULT(MPI_Type_commit, (&file_type));
+
+    const MPI_Offset displacement = MPI_Offset(head.coordinate_offset + slice.first * head.value_bytes);
+    BOOST_MPI_CHECK_RESULT(MPI_File_set_view,
+                           (file, displacement, value_type, file_type, const_cast<char*>("native"), MPI_INFO_NULL));
+
+    // Everyone reads together
+    // - Through a buffer of the stored type when it is not T
+    slice.values.resize(std::size_t(num_blocks) * slice.count);
+    auto read_converted = [&](auto stored) {
+        stored.resize(slice.values.size());
+        BOOST_MPI_CHECK_RESULT(MPI_File_read_at_all, (file, 0, stored.data(), num_blocks, slice_type, MPI_STATUS_IGNORE));
+        std::copy(stored.cbegin(), stored.cend(), slice.values.begin());
+    };
+    if (head.value_bytes == sizeof(T)) {
+        BOOST_MPI_CHECK_RESULT(MPI_File_read_at_all, (file, 0, slice.values.data(), num_blocks, slice_type, MPI_STATUS_IGNORE));
+    }
+    else if (head.value_bytes == sizeof(float)) {
+        read_converted(std::vector<float>());
+    }
+    else {
+        read_converted(std::vector<double>());
+    }
+
+    BOOST_MPI_CHECK_RESULT(MPI_Type_free, (&file_type));
+    BOOST_MPI_CHECK_RESULT(MPI_Type_free, (&slice_type));
+    BOOST_MPI_CHECK_RESULT(MPI_File_close, (&file));
+    return slice;
+}
+
+/// Collectively write a Binary HOPI File
+/**
+ */
+template<typename T>
+void
+write_results_parallel(const mpixx::communicator&      comm,
+                       const std::string&              file_name,
+                       const std::size_t&              global_count,
+                       const std::vector<std::size_t>& global_index,
+                       const std::size_t&              ndim,
+                       const std::vector<T>&           xyz,
+                       const std::size_t&              nvar,
+                       const std::vector<T>&           var)
+{
+    HOPI_PROFILE_SCOPE("io.write_parallel");
+    const std::size_t local_count = global_index.size();
+    assert(xyz.size() == ndim * local_count);
+    assert(var.size() == nvar * local_count);
+
+    MPI_File  file;
+    const int mode = MPI_MODE_WRONLY | MPI_MODE_CREATE;
+    if (MPI_File_open(MPI_Comm(comm), file_name.c_str(), mode, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        parallel_file_error(comm, "File Did Not Open", file_name);
+    }
+
+    // Size the file and let Rank 0 write the Header
+    const BinaryTargetHeader head       = make_binary_target_header(ndim, global_count, nvar, sizeof(T));
+    const std::size_t        num_blocks = ndim + nvar;
+    BOOST_MPI_CHECK_RESULT(MPI_File_set_size, (file, MPI_Offset(head.coordinate_offset + num_blocks * head.block_stride)));
+    if (comm.rank() == 0) {
+        BOOST_MPI_CHECK_RESULT(MPI_File_write_at, (file, 0, &head, int(sizeof(head)), MPI_BYTE, MPI_STATUS_IGNORE));
+    }
+
+    // Order my points by global index
+    // - File view displacements must increase monotonically
+    std::vector<std::size_t> order(local_count);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::sort(order.begin(), order.end(), [&](const auto a, const auto b) { return global_index[a] < global_index[b]; });
+
+    // Pack values and their file locations block by block
+    std::vector<T>        values(num_blocks * local_count);
+    std::vector<MPI_Aint> location(num_blocks * local_count);
+    for (std::size_t b = 0; b < num_blocks; ++b) {
+        const bool          is_coordinate = (b < ndim);
+        const auto&         source        = is_coordinate ? xyz : var;
+        const std::size_t   stride        = is_coordinate ? ndim : nvar;
+        const std::size_t   column        = is_coordinate ? b : b - ndim;
+        for (std::size_t n = 0; n < local_count; ++n) {
+            const auto i                     = order[n];
+            values[b * local_count + n]      = source[i * stride + column];
+            location[b * local_count + n]    = MPI_Aint(b * head.block_stride + global_index[i] * sizeof(T));
+        }
+    }
+
+    // One location per value so both are limited by the int count of MPI
+    const int          value_count = checked_count(comm, values.size(), file_name);
+    const MPI_Datatype value_type  = value_datatype(sizeof(T));
+    MPI_Datatype       file_type;
+    BOOST_MPI_CHECK_RESULT(MPI_Type_create_hindexed_block, (value_count, 1, location.data(), value_type, &file_type));
+    BOOST_MPI_CHECK_RESULT(MPI_Type_commit, (&file_type));
+    BOOST_MPI_CHECK_RESULT(MPI_File_set_view,
+                           (file, MPI_Offset(head.coordinate_offset), value_type, file_type, const_cast<char*>("native"),
+                            MPI_INFO_NULL));
+
+    // Everyone writes together
+    BOOST_MPI_CHECK_RESULT(MPI_File_write_at_all, (file, 0, values.data(), value_count, value_type, MPI_STATUS_IGNORE));
+
+    BOOST_MPI_CHECK_RESULT(MPI_Type_free, (&file_type));
+    BOOST_MPI_CHECK_RESULT(MPI_File_close, (&file));
+}
+
+template TargetSlice<float>  read_targets_parallel<float>(const mpixx::communicator&, const std::string&);
+template TargetSlice<double> read_targets_parallel<double>(const mpixx::communicator&, const std::string&);
+
+template void write_results_parallel<float>(const mpixx::communicator&, const std::string&, const std::size_t&,
+                                            const std::vector<std::size_t>&, const std::size_t&, const std::vector<float>&,
+                                            const std::size_t&, const std::vector<float>&);
+template void write_results_parallel<double>(const mpixx::communicator&, const std::string&, const std::size_t&,
+                                             const std::vector<std::size_t>&, const std::size_t&, const std::vector<double>&,
+                                             const std::size_t&, const std::vector<double>&);
+
+} /* namespace hopi */
@@ -0,0 +1,81 @@
+/// @file parallel_targets.hpp
+/*
+ * Project:         HOPI
+ * File:            parallel_targets.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/binary_targets.hpp"
+#include "hopi/mpixx.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hopi {
+
+/// Contiguous slice of a Binary HOPI File held by one Rank
+/**
+ * Values are stored as the file stores them, one block of count
+ * values for each coordinate followed by one for each variable.
+ */
+template<typename T = double>
+struct TargetSlice {
+    BinaryTargetHeader header;  ///< Header of the whole file
+    std::size_t        first;   ///< Global index of the first local point
+    std::size_t        count;   ///< Number of local points
+    std::vector<T>     values;  ///< (ndim + nvar) blocks of count values
+
+    /// Contiguous local values of coordinate dim or nullptr if dim >= ndim
+    const T* coordinate(const std::size_t dim) const noexcept
+    {
+        return (dim < header.ndim) ? values.data() + dim * count : nullptr;
+    }
+
+    /// Contiguous local values of variable var or nullptr if var >= nvar
+    const T* variable(const std::size_t var) const noexcept
+    {
+        return (var < header.nvar) ? values.data() + (header.ndim + var) * count : nullptr;
+    }
+};
+
+/// Collectively read a Binary HOPI File
+/**
+ * Each Rank reads only its own near equal contiguous slice of
+ * points using MPI-IO file views, so memory per Rank is O(N/P).
+ * Use Partition::redistribute to move the points to their owners.
+ *
+ * Values are converted to T (float or double) when the file
+ * stores the other precision.
+ */
+template<typename T = double>
+TargetSlice<T> read_targets_parallel(const mpixx::communicator& comm, const std::string& file_name);
+
+/// Collectively write a Binary HOPI File
+/**
+ * Each Rank provides any subset of the global_count points along
+ * with their global index. Every global index must be written by
+ * exactly one Rank. Points are placed by global index so the file
+ * is identical whatever the number of Ranks.
+ *
+ * Coordinates and variables are interleaved per point as in
+ * write_binary_target_file and are stored as T (float or double).
+ */
+template<typename T>
+void write_results_parallel(const mpixx::communicator&      comm,
+                            const std::string&              file_name,
+                            const std::size_t&              global_count,
+                            const std::vector<std::size_t>& global_index,
+                            const std::size_t&              ndim,
+                            const std::vector<T>&           xyz,
+                            const std::size_t&              nvar,
+                            const std::vector<T>&           var);
+
+} /* namespace hopi */
@@ -13,15 +13,91 @@
 #pragma once
 
 #include "hopi/mpixx.hpp"
+#include "hopi/profile.hpp"
 #include "hopi/rtree.hpp"
+#include "hopi/snapshot.hpp"
 
+#include "boost/mpi/exception.hpp"
+
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <numeric>
 #include <set>
+#include <span>
+#include <string>
 #include <tuple>
 #include <vector>
 
 namespace hopi {
 
+namespace detail {
+
+/**
+ * Weighted selection within a range
+ *
+ * Reorders [first,last) and returns the element at which the running
+ * weight, taken in order of key, first exceeds target. This is the
+ * element a full sort followed by a partial sum and upper_bound would
+ * find, but each step only uses std::nth_element on the half holding
+ * the answer so the cost is O(n) on average.
+ *
+ * The range must not be empty. Returns the last element by key if the
+ * total weight never exceeds target.
+ */
+template<typename Iterator, typename WeightType, typename KeyOp, typename WeightOp>
+Iterator
+weighted_select(Iterator first, Iterator last, WeightType target, KeyOp key, WeightOp weight)
+{
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    auto key_less    = [&](const value_type& a, const value_type& b) { return key(a) < key(b); };
+
+    while (std::distance(first, last) > 1) {
+        auto middle = std::next(first, std::distance(first, last) / 2);
+        std::nth_element(first, middle, last, key_less);
+
+        const auto low_weight = std::accumulate(first, middle, WeightType(0), [&](const auto sum, const value_type& v) {
+            return sum + weight(v);
+        });
+        if (low_weight > target) {
+            last = middle;
+        }
+        else {
+            target -= low_weight;
+            first = middle;
+        }
+    }
+    return first;
+}
+
+} // namespace detail
+
+/**
+ * Method used to find the split location of each box
+ *
+ * - MedianAverage = Average of the local weighted medians weighted by the local weights
+ * - Histogram     = Global weighted median from histograms refined until within tolerance
+ */
+enum class SplitMethod { MedianAverage, Histogram };
+
+/**
+ * Options controlling how Partition splits the domain
+ */
+struct PartitionOptions {
+    SplitMethod method     = SplitMethod::Histogram;
+    std::size_t num_bins   = 64;    ///< Histogram bins per box in each round
+    std::size_t max_rounds = 4;     ///< Maximum histogram rounds (ie. Allreduce calls) per level
+    double      tolerance  = 1e-3;  ///< Allowed weight error of a split as a fraction of the box weight
+    double      rebalance_threshold = 1.1;  ///< Imbalance (ie. maximum / mean rank weight) which triggers rebalance
+};
+
 template<typename InputAdaptor>
 class Partition final {
     // ----------------------------------------------------------
@@ -35,6 +111,8 @@ class Partition final {
     using coordinate_type = typename InputAdaptor::coordinate_type;
     using rank_type       = typename InputAdaptor::rank_type;
     using weight_type     = typename InputAdaptor::weight_type;
+    using box_type        = hopi::spatial::BoundBox<coordinate_type, NDim>;
+    using box_array       = typename box_type::array_type;
 
     // ----------------------------------------------------------
     // Constructors and Operators
@@ -47,7 +125,7 @@ class Partition final {
     Partition& operator=(const Partition& other) = default;
     Partition& operator=(Partition&& other)      = default;
 
-    Partition(const mpixx::communicator& comm);
+    Partition(const mpixx::communicator& comm, const PartitionOptions& options = PartitionOptions());
 
     // ----------------------------------------------------------
     // Methods
@@ -63,6 +141,29 @@ class Partition final {
               const weight_type*     w,
               const difference_type  winc);
 
+    /**
+     * Move the splits to balance a measured cost of each point
+     *
+     * Weights are the measured cost of each point (ie. RBFInterpolator::costs)
+     * and may be held by any rank. Does nothing unless the imbalance of
+     * the cost owned by each rank exceeds PartitionOptions::rebalance_threshold.
+     * The tree keeps the dimension of each split and the rank of each
+     * final box so only points near a moved plane change owner. The
+     * histogram of each split starts about its current value and only
+     * widens towards where the missing weight lies, so a plane which
+     * needs to move a little costs a round or two per level.
+     * Returns true if the splits moved.
+     */
+    bool rebalance(const size_type        local_count,
+                   const coordinate_type* x,
+                   const difference_type  xinc,
+                   const coordinate_type* y,
+                   const difference_type  yinc,
+                   const coordinate_type* z,
+                   const difference_type  zinc,
+                   const weight_type*     w,
+                   const difference_type  winc);
+
     void report(const size_type        local_count,
                 const coordinate_type* x,
                 const difference_type  xinc,
@@ -73,23 +174,185 @@ class Partition final {
                 const weight_type*     w,
                 const difference_type  winc) const;
 
+    /**
+     * Communicator of all ranks within the Partition
+     */
+    const mpixx::communicator& comm() const noexcept { return m_comm; }
+
+    /**
+     * Bound owned by each rank (valid after init)
+     */
+    const std::vector<box_type>& bounds() const noexcept { return m_bounds; }
+
+    /**
+     * Rank owning a location
+     *
+     * Walks the tree of splits built by init in O(log P).
+     */
+    rank_type owner(const std::array<coordinate_type, NDim>& point) const noexcept;
+
+    /**
+     * Column of extra data moved along with each point
+     *
+     * Element i is the bytes at data + i * inc * bytes
+     */
+    struct Payload {
+        const void*     data;  ///< Address of first element
+        size_type       bytes; ///< Bytes within each element
+        difference_type inc;   ///< Stride between elements in units of elements
+    };
+
+    /**
+     * Plan of where points were sent and received from
+     *
+     * Points are sent grouped by destination rank and received
+     * grouped by source rank. Counts are in points.
+     */
+    struct Exchange {
+        std::vector<int>       send_counts;  ///< Points sent to each rank
+        std::vector<int>       send_displs;  ///< Offset of points sent to each rank
+        std::vector<int>       recv_counts;  ///< Points received from each rank
+        std::vector<int>       recv_displs;  ///< Offset of points received from each rank
+        std::vector<size_type> send_index;   ///< Local index of each point in send order
+
+        size_type send_size() const noexcept { return send_index.size(); }
+        size_type recv_size() const noexcept { return recv_displs.empty() ? 0 : size_type(recv_displs.back() + recv_counts.back()); }
+
+        /// Offset of points received from each rank once recv_counts are known
+        void set_recv_displs()
+        {
+            recv_displs.assign(recv_counts.size(), 0);
+            std::exclusive_scan(recv_counts.begin(), recv_counts.end(), recv_displs.begin(), 0);
+        }
+    };
+
+    /**
+     * Points received from redistribute
+     */
+    struct Redistributed {
+        std::vector<coordinate_type>        xyz;      ///< NDim coordinates of each point
+        std::vector<weight_type>            weight;   ///< Weight of each point
+        std::vector<std::vector<std::byte>> payload;  ///< Each Payload column packed contiguously
+        Exchange                            plan;     ///< Plan to send results back to the original ranks
+    };
+
+    /**
+     * Plan for moving each point to the rank owning it
+     *
+     * Counts are exchanged with every rank so the plan is complete
+     * but no points are moved.
+     */
+    Exchange exchange_plan(const size_type        local_count,
+                           const coordinate_type* x,
+                           const difference_type  xinc,
+                           const coordinate_type* y,
+                           const difference_type  yinc,
+                           const coordinate_type* z,
+                           const difference_type  zinc) const;
+
+    /**
+     * Start exchange_plan without waiting for the counts
+     *
+     * The send side of plan is complete on return while recv_counts
+     * arrive with the request. Call Exchange::set_recv_displs once
+     * it completes. The plan must stay alive until then.
+     */
+    mpixx::irequest iexchange_plan(const size_type        local_count,
+                                   const coordinate_type* x,
+                                   const difference_type  xinc,
+                                   const coordinate_type* y,
+                                   const difference_type  yinc,
+                                   const coordinate_type* z,
+                                   const difference_type  zinc,
+                                   Exchange&              plan) const;
+
+    /**
+     * Move each point to the rank owning it
+     *
+     * Coordinates, weights and payload columns are packed into a single
+     * record per point and exchanged with one MPI_Alltoallv.
+     */
+    Redistributed redistribute(const size_type             local_count,
+                               const coordinate_type*      x,
+                               const difference_type       xinc,
+                               const coordinate_type*      y,
+                               const difference_type       yinc,
+                               const coordinate_type*      z,
+                               const difference_type       zinc,
+                               const weight_type*          w,
+                               const difference_type       winc,
+                               const std::vector<Payload>& payload = {}) const;
+
+    /**
+     * Return one value per received point to the original ranks
+     *
+     * Values are placed at the original local index of each point
+     * so received[i] of redistribute ends up at original[j] where
+     * j was the input index of the point.
+     */
+    template<typename T>
+    void reverse(const Exchange& plan, const T* received, T* original) const;
+
+    /**
+     * Write the splits and a plan from redistribute to a snapshot file
+     *
+     * Every rank holds the same splits but the plan belongs to the
+     * rank which redistributed so each rank writes its own file.
+     */
+    void save(const std::string& file_name, const Exchange& plan = Exchange()) const;
+
+    /**
+     * Replace the splits by those within a snapshot file
+     *
+     * Returns the plan saved along with them which remains valid
+     * for the same points on the same rank. Aborts if the splits
+     * were made for a different number of ranks.
+     */
+    Exchange load(const std::string& file_name);
+
     // ----------------------------------------------------------
     // [PRIVATE]
     // ----------------------------------------------------------
    private:
     // Define Types
-    using box_type   = hopi::spatial::BoundBox<coordinate_type, NDim>;
-    using box_array  = typename box_type::array_type;
-    using index_type = hopi::spatial::TreeIndex<box_type, size_type>;
-    using RTree      = hopi::spatial::RTree<index_type>;
-
-    mpixx::communicator m_comm;  ///< Communicator for everyone participating
-    // std::vector<rank_type> m_ranks;  ///< Final Ranks for input points
-    std::vector<box_type> m_bounds;  ///< Final Bounds for each Rank (ie. size == m_comm.size())
+    using index_type = hopi::spatial::TreeIndex<box_array, size_type>;  ///< Point values so Leafs hold a single corner
+    using splitting  = typename hopi::spatial::splitting_of<InputAdaptor>::type;  ///< InputAdaptor::rtree_splitting_type or Quadratic
+    using RTree      = hopi::spatial::RTree<index_type, hopi::spatial::ArenaAllocator<index_type>, splitting>;
+
+    using box_nrank_range = std::tuple<box_type, rank_type, size_type, size_type, std::int64_t, size_type>;  ///< {Box, NRanks, First, Last, Slot, Dim}
+
+    /**
+     * Node of the tree of splits
+     *
+     * Children below zero are the final box of rank (-child - 1)
+     */
+    struct split_node {
+        size_type       dim;       ///< Dimension split
+        coordinate_type value;     ///< Location of split
+        std::int64_t    child[2];  ///< Below and at or above the split
+    };
+
+    static constexpr std::uint64_t snapshot_signature() noexcept;
+
+    std::vector<coordinate_type> split_median_average(const std::vector<box_nrank_range>& boxes,
+                                                      std::vector<size_type>&             permutation,
+                                                      const std::vector<box_array>&       points,
+                                                      const std::vector<weight_type>&     weight) const;
+
+    std::vector<coordinate_type> split_histogram(const std::vector<box_nrank_range>& boxes,
+                                                 const std::vector<size_type>&       permutation,
+                                                 const std::vector<box_array>&       points,
+                                                 const std::vector<weight_type>&     weight,
+                                                 const std::vector<coordinate_type>& guess = {}) const;
+
+    mpixx::communicator m_comm;     ///< Communicator for everyone participating
+    PartitionOptions    m_options;  ///< Options controlling the splits
+    std::vector<box_type>   m_bounds;      ///< Final Bounds for each Rank (ie. size == m_comm.size())
+    std::vector<split_node> m_split_tree;  ///< Splits leading to each Bound (empty for 1 Rank)
 };
 
 template<typename A>
-Partition<A>::Partition(const mpixx::communicator& comm) : m_comm(comm)
+Partition<A>::Partition(const mpixx::communicator& comm, const PartitionOptions& options) : m_comm(comm), m_options(options)
 {
 }
 
@@ -110,28 +373,48 @@ Partition<A>::init(const size_type        local_count,
                    const weight_type*     w,
                    const difference_type  winc)
 {
+    HOPI_PROFILE_SCOPE("partition.init");
+
+    // Copy the Points and get their Bounding Box
+    std::vector<box_array> points(local_count);
+    box_type               my_bound;
+    my_bound.reset();
+    for (size_type i = 0; i < local_count; ++i) {
+        points[i] = { x[i * xinc], y[i * yinc], z[i * zinc] };
+        my_bound.stretch(box_type(points[i], points[i]));
+    }
+
+    // Start gathering the Bounding Box of all Ranks
+    std::vector<box_type> bounds_by_rank;
+    auto                  bounds_request = mpixx::iall_gather(m_comm, my_bound, bounds_by_rank);
+
     // Copy the Weights or assign 1
     std::vector<weight_type> weight(local_count, 1);
     if (nullptr != w) {
-        for (auto i = 0; i < local_count; ++i) {
+        for (size_type i = 0; i < local_count; ++i) {
             weight[i] = w[i * winc];
         }
     }
 
-    // Build an RTree of Points to Partition
-    RTree rtree;
-    for (size_type i = 0; i < local_count; ++i) {
-        box_array point = { x[i * xinc], y[i * yinc], z[i * zinc] };
-        box_type  box(point, point);
-        rtree.insert(index_type(box, i));
-    }
+    // Permutation of my Points
+    // - The points within each box to split are contiguous
+    // - Each split partitions the range of a box in place
+    std::vector<size_type> permutation(local_count);
+    std::iota(std::begin(permutation), std::end(permutation), size_type(0));
 
-    // Get Global Bounding Box for all Ranks
-    std::vector<box_type> bounds_by_rank;
-    const auto            my_bound = rtree.bounds();
-    mpixx::all_gather(m_comm, my_bound, bounds_by_rank);
+    // Create Our Processing Arrays
+    //  - boxes_to_split = Vector of {Box, NRanks, First, Last, Slot, Dim} that still need to be split
+    //  - final_boxes    = Ordered set of the final boxes
+    //  - final_slots    = Split tree Slot (2*node+side) of each final box
+    //
+    std::vector<box_nrank_range>                boxes_to_split;
+    std::set<box_type, typename box_type::less> final_boxes;
+    std::vector<std::pair<std::int64_t, box_type>> final_slots;
+    m_split_tree.clear();
+    m_split_tree.reserve(m_comm.size());
 
     // Determine Global Domain from each ranks Domain
+    bounds_request.wait();
     box_type global_box = bounds_by_rank[0];
     for (size_type i = 1; i < bounds_by_rank.size(); ++i) {
         global_box.stretch(bounds_by_rank[i]);
@@ -140,101 +423,57 @@ Partition<A>::init(const size_type        local_count,
     // Expand Slightly so we don't have any points on edges of domain
     global_box.next_larger();
 
-    // Create Our Processing Arrays
-    //  - boxes_to_split = Vector of {Box, NRanks} that still need to be split
-    //  - final_boxes    = Ordered set of the final boxes
-    //
-    using box_nrank_pair = std::pair<box_type, rank_type>;
-    std::vector<box_nrank_pair>                 boxes_to_split;
-    std::set<box_type, typename box_type::less> final_boxes;
-
     // Assign how many bounds (partitions) we should build
     const size_type total_partitions = m_comm.size();
     if (total_partitions == 1) {
         final_boxes.insert(global_box);
     }
     else {
-        boxes_to_split.push_back(std::make_pair(global_box, total_partitions));
+        boxes_to_split.emplace_back(global_box, total_partitions, 0, local_count, -1, global_box.longest_dimension());
     }
 
     //
     // While we have boxes that need to be split
-    // - Find the Median for this rank
-    // - Pack our median and weight to share with others
+    // - Find the global split location of each box
+    // - Split each box and my points within it
     //
     while (boxes_to_split.size() > 0) {
-        std::vector<std::pair<coordinate_type, weight_type>> local_split_list;
-        local_split_list.reserve(boxes_to_split.size());
-
-        // For each Box
-        // - Find the weighted median
-        // - Exchange & Average
-        for (auto box_index = 0; box_index < boxes_to_split.size(); ++box_index) {
+        const size_type num_boxes = boxes_to_split.size();
 
-            // Get handle to this Box & calc partition fractions
-            const box_type& search_box = std::get<0>(boxes_to_split[box_index]);
-            const auto total_partition = std::get<1>(boxes_to_split[box_index]);
-            const auto small_partition = rank_type(total_partition / 2);
-            const auto large_partition = rank_type(total_partition - small_partition);
-            const auto ratio_partition = double(small_partition) / double(total_partition); // Used to split weights
+        std::vector<coordinate_type> split_value;
+        if (m_options.method == SplitMethod::MedianAverage) {
+            split_value = this->split_median_average(boxes_to_split, permutation, points, weight);
+        }
+        else {
+            split_value = this->split_histogram(boxes_to_split, permutation, points, weight);
+        }
 
-            // Get all my points found within the box
-            std::vector<index_type> contained_points;  // TODO: std::list might be faster
-            using hopi::spatial::shared::predicate::ContainedByNonInclusive;
-            rtree.query(ContainedByNonInclusive(search_box), std::back_inserter(contained_points));
+        // For each Box
+        // - Partition my points about the split
+        std::vector<size_type> split_index(num_boxes);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (size_type index = 0; index < num_boxes; ++index) {
+            const size_type long_dim = std::get<5>(boxes_to_split[index]);
 
-            // Sort returned points along longest dimension
-            const size_type long_dim = search_box.longest_dimension();
-            std::sort(std::begin(contained_points), std::end(contained_points), [long_dim](const index_type& a, const index_type& b) {
-                return (std::get<0>(a).center(long_dim) < std::get<0>(b).center(long_dim));
+            const auto first = std::next(std::begin(permutation), std::get<2>(boxes_to_split[index]));
+            const auto last  = std::next(std::begin(permutation), std::get<3>(boxes_to_split[index]));
+            const auto split = std::partition(first, last, [&](const size_type i) {
+                return points[i][long_dim] < split_value[index];
             });
-
-            // Build a Weighted List of Points
-            std::vector<weight_type> contained_weights;
-            contained_weights.reserve(contained_points.size());
-            for (auto i = 0; i < contained_points.size(); ++i) {
-                contained_weights.push_back(weight[std::get<1>(contained_points[i])]);
-            }
-
-            // Perform a Partial Sum on the Weights & get Median
-            // - Use the ratio of the NRanks split to determine where the median should be
-            //
-            std::partial_sum(std::begin(contained_weights), std::end(contained_weights), std::begin(contained_weights));
-            auto median_iter  = std::upper_bound(std::begin(contained_weights), std::end(contained_weights), ratio_partition*contained_weights.back());
-            auto median_index = std::distance(std::begin(contained_weights), median_iter);
-            auto median_value = contained_points[median_index].first.center(long_dim);
-
-            // Pack our splits for reduction
-            // const auto low_weight = contained_weights[median_index];
-            // const auto hgh_weight = contained_weights.back()-contained_weights[median_index];
-            const auto total_weight = contained_weights.back();
-            local_split_list.emplace_back(median_value * total_weight, total_weight);
-
+            split_index[index] = std::distance(std::begin(permutation), split);
         }
 
-        // Reduce Across All Processors
-        std::vector<std::pair<coordinate_type, weight_type>> global_split_list;
-        mpixx::all_reduce(m_comm, local_split_list, global_split_list, [](const auto& a, const auto& b) {
-            auto ans = a;
-            for (auto n = 0; n < ans.size(); ++n) {
-                std::get<0>(ans[n]) = std::get<0>(b[n]);
-                std::get<1>(ans[n]) = std::get<1>(b[n]);
-            }
-            return ans;
-        });
-
         // For each Box
-        // - Find the weighted median
         // - Split the BoundBox
-        // - ReAssign Ranks to each resulting Box
-        std::vector<box_nrank_pair> new_boxes_to_split;
-        for (auto index = 0; index < boxes_to_split.size(); ++index) {
+        // - ReAssign Ranks & Points to each resulting Box
+        std::vector<box_nrank_range> new_boxes_to_split;
+        for (size_type index = 0; index < num_boxes; ++index) {
             // Get handle to this Box
             const box_type& search_box = std::get<0>(boxes_to_split[index]);
-            const size_type long_dim   = search_box.longest_dimension();
-
-            // Determine the weighted average split location
-            const auto weighted_split = global_split_list[index].first / global_split_list[index].second;
+            const size_type long_dim   = std::get<5>(boxes_to_split[index]);
+            const auto weighted_split  = split_value[index];
 
             // Build 2 Boxes
             box_type  hgh_bound      = search_box;
@@ -252,21 +491,36 @@ Partition<A>::init(const size_type        local_count,
             const auto small_partition = rank_type(total_partition / 2);
             const auto large_partition = rank_type(total_partition - small_partition);
 
+            // Split the points
+            const auto first = std::get<2>(boxes_to_split[index]);
+            const auto split = split_index[index];
+            const auto last  = std::get<3>(boxes_to_split[index]);
+
+            // Record the split within the tree
+            const auto node = std::int64_t(m_split_tree.size());
+            const auto slot = std::get<4>(boxes_to_split[index]);
+            m_split_tree.push_back(split_node{ long_dim, weighted_split, { 0, 0 } });
+            if (slot >= 0) {
+                m_split_tree[slot / 2].child[slot % 2] = node;
+            }
+
             if (1 == small_partition) {
                 final_boxes.insert(low_bound);
+                final_slots.emplace_back(2 * node + 0, low_bound);
             }
             else {
-                new_boxes_to_split.emplace_back(low_bound, small_partition);
+                new_boxes_to_split.emplace_back(low_bound, small_partition, first, split, 2 * node + 0, low_bound.longest_dimension());
             }
             if (1 == large_partition) {
                 final_boxes.insert(hgh_bound);
+                final_slots.emplace_back(2 * node + 1, hgh_bound);
             }
             else {
-                new_boxes_to_split.emplace_back(hgh_bound, large_partition);
+                new_boxes_to_split.emplace_back(hgh_bound, large_partition, split, last, 2 * node + 1, hgh_bound.longest_dimension());
             }
 
         }
-        boxes_to_split = new_boxes_to_split;
+        boxes_to_split = std::move(new_boxes_to_split);
     }
 
     // Copy the "sorted" set to the final vector
@@ -274,6 +528,629 @@ Partition<A>::init(const size_type        local_count,
     m_bounds.reserve(final_boxes.size());
     std::copy(std::begin(final_boxes), std::end(final_boxes), std::back_inserter(m_bounds));
 
+    // Point the split tree at the rank of each final box
+    for (const auto& [slot, box] : final_slots) {
+        const auto rank = std::distance(std::begin(final_boxes), final_boxes.find(box));
+        m_split_tree[slot / 2].child[slot % 2] = -(std::int64_t(rank) + 1);
+    }
+}
+
+template<typename A>
+bool
+Partition<A>::rebalance(const size_type        local_count,
+                        const coordinate_type* x,
+                        const difference_type  xinc,
+                        const coordinate_type* y,
+                        const difference_type  yinc,
+                        const coordinate_type* z,
+                        const difference_type  zinc,
+                        const weight_type*     w,
+                        const difference_type  winc)
+{
+    HOPI_PROFILE_SCOPE("partition.rebalance");
+    if (m_split_tree.empty()) {
+        return false;
+    }
+
+    // Copy the Points and the Weights or assign 1
+    std::vector<box_array>   points(local_count);
+    std::vector<weight_type> weight(local_count, 1);
+    for (size_type i = 0; i < local_count; ++i) {
+        points[i] = { x[i * xinc], y[i * yinc], z[i * zinc] };
+    }
+    if (nullptr != w) {
+        for (size_type i = 0; i < local_count; ++i) {
+            weight[i] = w[i * winc];
+        }
+    }
+
+    // Sum the weight owned by each rank
+    const size_type          num_ranks = m_comm.size();
+    std::vector<weight_type> local_weight_total(num_ranks, 0);
+    for (size_type i = 0; i < local_count; ++i) {
+        local_weight_total[this->owner(points[i])] += weight[i];
+    }
+    std::vector<weight_type> global_weight_total(num_ranks);
+    mpixx::all_reduce(m_comm, local_weight_total.data(), int(num_ranks), global_weight_total.data(), MPI_SUM);
+
+    // Only rebalance once the imbalance crosses the threshold
+    const double sum_weight = std::accumulate(global_weight_total.begin(), global_weight_total.end(), 0.0);
+    const double max_weight = *std::max_element(global_weight_total.begin(), global_weight_total.end());
+    const double imbalance  = (sum_weight > 0) ? max_weight * double(num_ranks) / sum_weight : 1.0;
+    HOPI_PROFILE_COUNT("partition.imbalance", imbalance);
+    if (not(imbalance > m_options.rebalance_threshold)) {
+        return false;
+    }
+
+    // Ranks below each node of the tree
+    // - Children are always recorded after their parent
+    std::vector<rank_type> node_ranks(m_split_tree.size(), 0);
+    for (auto node = std::int64_t(m_split_tree.size()) - 1; node >= 0; --node) {
+        for (const auto child : m_split_tree[node].child) {
+            node_ranks[node] += (child < 0) ? rank_type(1) : node_ranks[child];
+        }
+    }
+
+    // Domain covered by the tree stretched over any new points
+    box_type my_bound;
+    my_bound.reset();
+    for (const auto& point : points) {
+        my_bound.stretch(box_type(point, point));
+    }
+    box_type global_box = mpixx::all_reduce(m_comm, my_bound, mpixx::box_union<box_type>());
+    for (const auto& bound : m_bounds) {
+        global_box.stretch(bound);
+    }
+    global_box.next_larger();
+
+    // Permutation of my Points (see init)
+    std::vector<size_type> permutation(local_count);
+    std::iota(std::begin(permutation), std::end(permutation), size_type(0));
+
+    //
+    // Walk the existing tree one level at a time
+    // - Move the split of each node along its original dimension
+    // - Split each box and my points within it
+    // - split_nodes = Node of the tree splitting each box (Slots are not used)
+    //
+    std::vector<box_nrank_range> boxes_to_split;
+    std::vector<std::int64_t>    split_nodes;
+    boxes_to_split.emplace_back(global_box, num_ranks, 0, local_count, -1, m_split_tree[0].dim);
+    split_nodes.push_back(0);
+    while (boxes_to_split.size() > 0) {
+        const size_type num_boxes = boxes_to_split.size();
+
+        // Histograms start about the current split and only widen if needed
+        std::vector<coordinate_type> split_value;
+        if (m_options.method == SplitMethod::MedianAverage) {
+            split_value = this->split_median_average(boxes_to_split, permutation, points, weight);
+        }
+        else {
+            std::vector<coordinate_type> current(num_boxes);
+            for (size_type index = 0; index < num_boxes; ++index) {
+                current[index] = m_split_tree[split_nodes[index]].value;
+            }
+            split_value = this->split_histogram(boxes_to_split, permutation, points, weight, current);
+        }
+
+        std::vector<box_nrank_range> new_boxes_to_split;
+        std::vector<std::int64_t>    new_split_nodes;
+        for (size_type index = 0; index < num_boxes; ++index) {
+            const auto& [search_box, nranks, first, last, slot, dim] = boxes_to_split[index];
+            const auto node                                           = split_nodes[index];
+            m_split_tree[node].value                                  = split_value[index];
+
+            const auto split = std::distance(
+                std::begin(permutation),
+                std::partition(std::next(std::begin(permutation), first), std::next(std::begin(permutation), last),
+                               [&](const size_type i) { return points[i][dim] < split_value[index]; }));
+
+            box_type  low_bound      = search_box;
+            box_array new_max_corner = low_bound.max_corner();
+            new_max_corner[dim]      = split_value[index];
+            low_bound.set(low_bound.min_corner(), new_max_corner);
+
+            box_type  hgh_bound      = search_box;
+            box_array new_min_corner = hgh_bound.min_corner();
+            new_min_corner[dim]      = split_value[index];
+            hgh_bound.set(new_min_corner, hgh_bound.max_corner());
+
+            const std::array<box_type, 2>  child_bound = { low_bound, hgh_bound };
+            const std::array<size_type, 3> range       = { first, size_type(split), last };
+            for (std::size_t side = 0; side < 2; ++side) {
+                const auto child = m_split_tree[node].child[side];
+                if (child < 0) {
+                    m_bounds[-child - 1] = child_bound[side];
+                }
+                else {
+                    new_boxes_to_split.emplace_back(child_bound[side], node_ranks[child], range[side], range[side + 1], -1,
+                                                    m_split_tree[child].dim);
+                    new_split_nodes.push_back(child);
+                }
+            }
+        }
+        boxes_to_split = std::move(new_boxes_to_split);
+        split_nodes    = std::move(new_split_nodes);
+    }
+    return true;
+}
+
+template<typename A>
+typename Partition<A>::rank_type
+Partition<A>::owner(const std::array<coordinate_type, NDim>& point) const noexcept
+{
+    if (m_split_tree.empty()) {
+        return 0;
+    }
+    std::int64_t node = 0;
+    while (node >= 0) {
+        const auto& split = m_split_tree[node];
+        node              = split.child[(point[split.dim] < split.value) ? 0 : 1];
+    }
+    return rank_type(-node - 1);
+}
+
+template<typename A>
+typename Partition<A>::Exchange
+Partition<A>::exchange_plan(const size_type        local_count,
+                            const coordinate_type* x,
+                            const difference_type  xinc,
+                            const coordinate_type* y,
+                            const difference_type  yinc,
+                            const coordinate_type* z,
+                            const difference_type  zinc) const
+{
+    Exchange plan;
+    this->iexchange_plan(local_count, x, xinc, y, yinc, z, zinc, plan).wait();
+    plan.set_recv_displs();
+    return plan;
+}
+
+template<typename A>
+mpixx::irequest
+Partition<A>::iexchange_plan(const size_type        local_count,
+                             const coordinate_type* x,
+                             const difference_type  xinc,
+                             const coordinate_type* y,
+                             const difference_type  yinc,
+                             const coordinate_type* z,
+                             const difference_type  zinc,
+                             Exchange&              plan) const
+{
+    const size_type num_ranks = m_comm.size();
+
+    // Find the owner of each point
+    std::vector<rank_type> owners(local_count);
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+    for (size_type i = 0; i < local_count; ++i) {
+        owners[i] = this->owner(box_array{ x[i * xinc], y[i * yinc], z[i * zinc] });
+    }
+
+    // Group points by owner (counting sort keeps local order within each rank)
+    plan.send_counts.assign(num_ranks, 0);
+    plan.send_displs.assign(num_ranks, 0);
+    for (const auto rank : owners) {
+        ++plan.send_counts[rank];
+    }
+    std::exclusive_scan(plan.send_counts.begin(), plan.send_counts.end(), plan.send_displs.begin(), 0);
+    plan.send_index.resize(local_count);
+    {
+        auto next = plan.send_displs;
+        for (size_type i = 0; i < local_count; ++i) {
+            plan.send_index[next[owners[i]]++] = i;
+        }
+    }
+
+    // Start exchanging counts
+    plan.recv_counts.assign(num_ranks, 0);
+    plan.recv_displs.clear();
+    return mpixx::iall_to_all(m_comm, plan.send_counts.data(), 1, plan.recv_counts.data());
+}
+
+template<typename A>
+typename Partition<A>::Redistributed
+Partition<A>::redistribute(const size_type             local_count,
+                           const coordinate_type*      x,
+                           const difference_type       xinc,
+                           const coordinate_type*      y,
+                           const difference_type       yinc,
+                           const coordinate_type*      z,
+                           const difference_type       zinc,
+                           const weight_type*          w,
+                           const difference_type       winc,
+                           const std::vector<Payload>& payload) const
+{
+    HOPI_PROFILE_SCOPE("partition.redistribute");
+    Redistributed result;
+    Exchange&     plan      = result.plan;
+    plan                    = this->exchange_plan(local_count, x, xinc, y, yinc, z, zinc);
+    const auto    recv_size = plan.recv_size();
+
+    // Layout of a single record
+    // - Coordinates, Weight, Payload[0], Payload[1], ...
+    std::vector<size_type> payload_offset(payload.size());
+    size_type              record_bytes = NDim * sizeof(coordinate_type) + sizeof(weight_type);
+    for (size_type c = 0; c < payload.size(); ++c) {
+        payload_offset[c] = record_bytes;
+        record_bytes += payload[c].bytes;
+    }
+
+    // Pack records in send order
+    std::vector<std::byte> send_buffer(local_count * record_bytes);
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+    for (size_type n = 0; n < local_count; ++n) {
+        const auto        i      = plan.send_index[n];
+        std::byte*        record = send_buffer.data() + n * record_bytes;
+        const box_array   point  = { x[i * xinc], y[i * yinc], z[i * zinc] };
+        const weight_type weight = (nullptr == w) ? weight_type(1) : w[i * winc];
+        std::memcpy(record, point.data(), NDim * sizeof(coordinate_type));
+        std::memcpy(record + NDim * sizeof(coordinate_type), &weight, sizeof(weight_type));
+        for (size_type c = 0; c < payload.size(); ++c) {
+            const auto* column = static_cast<const std::byte*>(payload[c].data);
+            std::memcpy(record + payload_offset[c], column + i * payload[c].inc * payload[c].bytes, payload[c].bytes);
+        }
+    }
+
+    // Single exchange of all records
+    std::vector<std::byte> recv_buffer(recv_size * record_bytes);
+    MPI_Datatype           record_type;
+    BOOST_MPI_CHECK_RESULT(MPI_Type_contiguous, (int(record_bytes), MPI_BYTE, &record_type));
+    BOOST_MPI_CHECK_RESULT(MPI_Type_commit, (&record_type));
+    {
+        HOPI_PROFILE_MPI("mpi.alltoallv", send_buffer.size());
+        BOOST_MPI_CHECK_RESULT(MPI_Alltoallv,
+                               (send_buffer.data(), plan.send_counts.data(), plan.send_displs.data(), record_type,
+                                recv_buffer.data(), plan.recv_counts.data(), plan.recv_displs.data(), record_type,
+                                MPI_Comm(m_comm)));
+    }
+    BOOST_MPI_CHECK_RESULT(MPI_Type_free, (&record_type));
+
+    // Unpack records into columns
+    result.xyz.resize(recv_size * NDim);
+    result.weight.resize(recv_size);
+    result.payload.resize(payload.size());
+    for (size_type c = 0; c < payload.size(); ++c) {
+        result.payload[c].resize(recv_size * payload[c].bytes);
+    }
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+    for (size_type n = 0; n < recv_size; ++n) {
+        const std::byte* record = recv_buffer.data() + n * record_bytes;
+        std::memcpy(result.xyz.data() + n * NDim, record, NDim * sizeof(coordinate_type));
+        std::memcpy(result.weight.data() + n, record + NDim * sizeof(coordinate_type), sizeof(weight_type));
+        for (size_type c = 0; c < payload.size(); ++c) {
+            std::memcpy(result.payload[c].data() + n * payload[c].bytes, record + payload_offset[c], payload[c].bytes);
+        }
+    }
+    return result;
+}
+
+template<typename A>
+template<typename T>
+void
+Partition<A>::reverse(const Exchange& plan, const T* received, T* original) const
+{
+    // Send back along the reverse of the plan
+    HOPI_PROFILE_MPI("mpi.alltoallv", plan.recv_size() * sizeof(T));
+    std::vector<T> returned(plan.send_size());
+    BOOST_MPI_CHECK_RESULT(MPI_Alltoallv,
+                           (received, plan.recv_counts.data(), plan.recv_displs.data(), mpixx::datatype<T>(),
+                            returned.data(), plan.send_counts.data(), plan.send_displs.data(), mpixx::datatype<T>(),
+                            MPI_Comm(m_comm)));
+
+    // Place at original location
+    for (size_type n = 0; n < returned.size(); ++n) {
+        original[plan.send_index[n]] = returned[n];
+    }
+}
+
+template<typename A>
+constexpr std::uint64_t
+Partition<A>::snapshot_signature() noexcept
+{
+    return hopi::snapshot_signature({ sizeof(box_type), sizeof(split_node), sizeof(size_type), sizeof(coordinate_type), NDim });
+}
+
+template<typename A>
+void
+Partition<A>::save(const std::string& file_name, const Exchange& plan) const
+{
+    HOPI_PROFILE_SCOPE("partition.save");
+    hopi::SnapshotWriter writer(file_name, snapshot_signature());
+    writer.write_section(std::span<const box_type>(m_bounds));
+    writer.write_section(std::span<const split_node>(m_split_tree));
+    writer.write_section(std::span<const int>(plan.send_counts));
+    writer.write_section(std::span<const int>(plan.send_displs));
+    writer.write_section(std::span<const int>(plan.recv_counts));
+    writer.write_section(std::span<const int>(plan.recv_displs));
+    writer.write_section(std::span<const size_type>(plan.send_index));
+    writer.close();
+}
+
+template<typename A>
+typename Partition<A>::Exchange
+Partition<A>::load(const std::string& file_name)
+{
+    HOPI_PROFILE_SCOPE("partition.load");
+    const hopi::MappedSnapshot snapshot(file_name, snapshot_signature());
+    const auto                 bounds = snapshot.section_as<const box_type>(0);
+    if ((snapshot.size() != 7) or (bounds.size() != size_type(m_comm.size()))) {
+        std::cerr << "P:" << m_comm.rank() << " ERROR: Partition Snapshot Has Wrong Number Of Ranks" << std::endl;
+        std::cerr << "P:" << m_comm.rank() << " Filename: " << file_name << std::endl;
+        m_comm.abort(EXIT_FAILURE);
+    }
+    auto copy = [&](auto& values, const std::size_t index) {
+        using value_type = typename std::decay_t<decltype(values)>::value_type;
+        const auto saved = snapshot.section_as<const value_type>(index);
+        values.assign(saved.begin(), saved.end());
+    };
+    copy(m_bounds, 0);
+    copy(m_split_tree, 1);
+
+    Exchange plan;
+    copy(plan.send_counts, 2);
+    copy(plan.send_displs, 3);
+    copy(plan.recv_counts, 4);
+    copy(plan.recv_displs, 5);
+    copy(plan.send_index, 6);
+    return plan;
+}
+
+/**
+ * Split at the average of the local weighted medians
+ *
+ * Each rank selects the weighted median of its points within each box
+ * and the medians are averaged using the weight each rank holds. Only
+ * a single Allreduce is needed but skewed distributions can balance
+ * poorly.
+ */
+template<typename A>
+std::vector<typename Partition<A>::coordinate_type>
+Partition<A>::split_median_average(const std::vector<box_nrank_range>& boxes,
+                                   std::vector<size_type>&             permutation,
+                                   const std::vector<box_array>&       points,
+                                   const std::vector<weight_type>&     weight) const
+{
+    HOPI_PROFILE_SCOPE("partition.split_median_average");
+    const size_type num_boxes = boxes.size();
+
+    // Pack {median * weight, weight} of each box for reduction
+    std::vector<double> local_split_list(2 * num_boxes, 0);
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (size_type box_index = 0; box_index < num_boxes; ++box_index) {
+
+        // Calc partition fractions
+        const auto total_partition = std::get<1>(boxes[box_index]);
+        const auto small_partition = rank_type(total_partition / 2);
+        const auto ratio_partition = double(small_partition) / double(total_partition);  // Used to split weights
+        const size_type long_dim   = std::get<5>(boxes[box_index]);
+
+        // Get all my points found within the box
+        const auto first = std::next(std::begin(permutation), std::get<2>(boxes[box_index]));
+        const auto last  = std::next(std::begin(permutation), std::get<3>(boxes[box_index]));
+        if (first == last) {
+            continue;
+        }
+
+        // Select the weighted median along longest dimension
+        // - Use the ratio of the NRanks split to determine where the median should be
+        //
+        const auto total_weight = std::accumulate(first, last, weight_type(0), [&](const auto sum, const size_type i) {
+            return sum + weight[i];
+        });
+        const auto median_iter = detail::weighted_select(
+            first, last, ratio_partition * total_weight,
+            [&](const size_type i) { return points[i][long_dim]; },
+            [&](const size_type i) { return weight[i]; });
+        const auto median_value = points[*median_iter][long_dim];
+
+        local_split_list[2 * box_index + 0] = double(median_value) * double(total_weight);
+        local_split_list[2 * box_index + 1] = double(total_weight);
+    }
+
+    // Sum Across All Processors
+    std::vector<double> global_split_list(local_split_list.size());
+    mpixx::all_reduce(m_comm, local_split_list.data(), int(local_split_list.size()), global_split_list.data(), std::plus<double>());
+
+    // Weighted average of the medians or center if no points
+    std::vector<coordinate_type> split_value(num_boxes);
+    for (size_type box_index = 0; box_index < num_boxes; ++box_index) {
+        const box_type& search_box = std::get<0>(boxes[box_index]);
+        if (global_split_list[2 * box_index + 1] > 0) {
+            split_value[box_index] = global_split_list[2 * box_index + 0] / global_split_list[2 * box_index + 1];
+        }
+        else {
+            split_value[box_index] = search_box.center(std::get<5>(boxes[box_index]));
+        }
+    }
+    return split_value;
+}
+
+/**
+ * Split at the global weighted median found from histograms
+ *
+ * Each round bins the weight of my points within the search window of
+ * each box and sums the histograms of all boxes with one Allreduce.
+ * The bin holding the weighted median becomes the next window until
+ * its weight is within tolerance of the box weight or the maximum
+ * rounds are used. The split is then interpolated within that bin.
+ */
+template<typename A>
+std::vector<typename Partition<A>::coordinate_type>
+Partition<A>::split_histogram(const std::vector<box_nrank_range>& boxes,
+                              const std::vector<size_type>&       permutation,
+                              const std::vector<box_array>&       points,
+                              const std::vector<weight_type>&     weight,
+                              const std::vector<coordinate_type>& guess) const
+{
+    HOPI_PROFILE_SCOPE("partition.split_histogram");
+    const size_type num_boxes  = boxes.size();
+    const size_type num_bins   = std::max<size_type>(m_options.num_bins, 1);
+    const size_type max_rounds = std::max<size_type>(m_options.max_rounds, 1);
+    const size_type num_values = num_bins + 3;  // Bins + weight below & above the window + weight below the guess
+    const bool      has_guess  = not guess.empty();
+
+    // Search window & state of each box
+    // - window_min/max = Range along the split dimension the histogram spans
+    //                    (the whole box or a single bin of it about the guess)
+    // - weight_target  = Global weight which should be below the split (< 0 until measured)
+    // - weight_allowed = Global weight error allowed in the split
+    // - rounds         = Times the window was refined into one of its bins
+    std::vector<coordinate_type> split_value(num_boxes);
+    std::vector<coordinate_type> start_value(num_boxes);
+    std::vector<coordinate_type> window_min(num_boxes);
+    std::vector<coordinate_type> window_max(num_boxes);
+    std::vector<double>          weight_target(num_boxes, -1);
+    std::vector<double>          weight_allowed(num_boxes, 0);
+    std::vector<size_type>       rounds(num_boxes, 0);
+    for (size_type box_index = 0; box_index < num_boxes; ++box_index) {
+        const box_type& search_box = std::get<0>(boxes[box_index]);
+        const size_type long_dim   = std::get<5>(boxes[box_index]);
+        window_min[box_index]      = search_box.min(long_dim);
+        window_max[box_index]      = search_box.max(long_dim);
+        if (has_guess) {
+            const auto half        = (window_max[box_index] - window_min[box_index]) / coordinate_type(num_bins);
+            start_value[box_index] = std::clamp(guess[box_index], window_min[box_index], window_max[box_index]);
+            window_min[box_index]  = std::max(window_min[box_index], start_value[box_index] - half);
+            window_max[box_index]  = std::min(window_max[box_index], start_value[box_index] + half);
+        }
+    }
+
+    // Boxes which have not found their split
+    std::vector<size_type> active(num_boxes);
+    std::iota(std::begin(active), std::end(active), size_type(0));
+
+    while (active.size() > 0) {
+        const size_type num_active = active.size();
+
+        // Bin the weight of my points within the window of each box
+        std::vector<double> local_histogram(num_active * num_values, 0);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (size_type a = 0; a < num_active; ++a) {
+            const auto      box_index = active[a];
+            const size_type long_dim  = std::get<5>(boxes[box_index]);
+            const auto      lo        = window_min[box_index];
+            const auto      hi        = window_max[box_index];
+            const auto      start     = start_value[box_index];
+            const auto      scale     = double(num_bins) / double(hi - lo);
+            double*         histogram = local_histogram.data() + a * num_values;
+
+            const auto first = std::get<2>(boxes[box_index]);
+            const auto last  = std::get<3>(boxes[box_index]);
+            for (size_type n = first; n < last; ++n) {
+                const auto i   = permutation[n];
+                const auto key = points[i][long_dim];
+                if (has_guess and (key < start)) {
+                    histogram[num_bins + 2] += double(weight[i]);
+                }
+                if (key < lo) {
+                    histogram[num_bins] += double(weight[i]);
+                    continue;
+                }
+                if (key >= hi) {
+                    histogram[num_bins + 1] += double(weight[i]);
+                    continue;
+                }
+                const auto bin = std::min(size_type(double(key - lo) * scale), num_bins - 1);
+                histogram[bin] += double(weight[i]);
+            }
+        }
+
+        // Sum Across All Processors
+        std::vector<double> global_histogram(local_histogram.size());
+        mpixx::all_reduce(m_comm, local_histogram.data(), int(local_histogram.size()), global_histogram.data(), std::plus<double>());
+        HOPI_PROFILE_COUNT("partition.histogram_rounds", 1);
+
+        // Find the bin holding the weighted median of each box
+        std::vector<size_type> still_active;
+        for (size_type a = 0; a < num_active; ++a) {
+            const auto      box_index = active[a];
+            const double*   histogram = global_histogram.data() + a * num_values;
+            const double    below     = histogram[num_bins];
+            const double    above     = histogram[num_bins + 1];
+            const double    inside    = std::accumulate(histogram, histogram + num_bins, double(0));
+            const box_type& box       = std::get<0>(boxes[box_index]);
+            const size_type long_dim  = std::get<5>(boxes[box_index]);
+
+            // First round measures the whole box so sets the targets
+            if (weight_target[box_index] < 0) {
+                const auto total_partition = std::get<1>(boxes[box_index]);
+                const auto small_partition = rank_type(total_partition / 2);
+                const auto ratio_partition = double(small_partition) / double(total_partition);
+                const auto total_weight    = below + inside + above;
+                if (total_weight <= 0) {
+                    split_value[box_index] = has_guess ? start_value[box_index] : 0.5 * (window_min[box_index] + window_max[box_index]);
+                    continue;
+                }
+                weight_target[box_index]  = ratio_partition * total_weight;
+                weight_allowed[box_index] = m_options.tolerance * total_weight;
+
+                // Keep a guess which already splits within tolerance
+                if (has_guess and (std::abs(histogram[num_bins + 2] - weight_target[box_index]) <= weight_allowed[box_index])) {
+                    split_value[box_index] = start_value[box_index];
+                    continue;
+                }
+            }
+
+            // Widen a window which does not hold the target towards it
+            // - By the weight missing over the density within the window
+            // - At least doubled so the box edge is reached in a few rounds
+            const auto width   = window_max[box_index] - window_min[box_index];
+            const auto density = inside / double(width);
+            if ((weight_target[box_index] < below) and (window_min[box_index] > box.min(long_dim))) {
+                const auto deficit    = below - weight_target[box_index];
+                const auto shift      = (density > 0) ? coordinate_type(2 * deficit / density) : box.length(long_dim);
+                window_max[box_index] = window_min[box_index];
+                window_min[box_index] = std::max(box.min(long_dim), window_min[box_index] - std::max(shift, 2 * width));
+                still_active.push_back(box_index);
+                continue;
+            }
+            if ((weight_target[box_index] > below + inside) and (window_max[box_index] < box.max(long_dim))) {
+                const auto deficit    = weight_target[box_index] - below - inside;
+                const auto shift      = (density > 0) ? coordinate_type(2 * deficit / density) : box.length(long_dim);
+                window_min[box_index] = window_max[box_index];
+                window_max[box_index] = std::min(box.max(long_dim), window_max[box_index] + std::max(shift, 2 * width));
+                still_active.push_back(box_index);
+                continue;
+            }
+
+            size_type bin          = 0;
+            double    running_sum  = below;
+            while ((bin < num_bins - 1) and (running_sum + histogram[bin] <= weight_target[box_index])) {
+                running_sum += histogram[bin];
+                ++bin;
+            }
+            const auto bin_width = width / coordinate_type(num_bins);
+            const auto bin_min   = window_min[box_index] + coordinate_type(bin) * bin_width;
+            const auto bin_max   = (bin == num_bins - 1) ? window_max[box_index] : bin_min + bin_width;
+
+            if ((histogram[bin] <= weight_allowed[box_index]) or (rounds[box_index] + 1 >= max_rounds)) {
+                auto fraction = 0.5;
+                if (histogram[bin] > 0) {
+                    fraction = std::clamp((weight_target[box_index] - running_sum) / histogram[bin], 0.0, 1.0);
+                }
+                split_value[box_index] = bin_min + coordinate_type(fraction) * (bin_max - bin_min);
+            }
+            else {
+                window_min[box_index] = bin_min;
+                window_max[box_index] = bin_max;
+                ++rounds[box_index];
+                still_active.push_back(box_index);
+            }
+        }
+        active = std::move(still_active);
+    }
+    return split_value;
 }
 
 template<typename A>
@@ -288,6 +1165,8 @@ Partition<A>::report(const size_type        local_count,
                      const weight_type*     w,
                      const difference_type  winc) const
 {
+    HOPI_PROFILE_SCOPE("partition.report");
+
     // Copy the Weights or assign 1
     std::vector<weight_type> weight(local_count, 1);
     if (nullptr != w) {
@@ -297,12 +1176,13 @@ Partition<A>::report(const size_type        local_count,
     }
 
     // Build an RTree of Points to Partition
-    RTree rtree;
+    std::vector<index_type> report_points;
+    report_points.reserve(local_count);
     for (size_type i = 0; i < local_count; ++i) {
         box_array point = { x[i * xinc], y[i * yinc], z[i * zinc] };
-        box_type  box(point, point);
-        rtree.insert(index_type(box, i));
+        report_points.emplace_back(point, i);
     }
+    RTree rtree(report_points.begin(), report_points.end(), hopi::spatial::STRPacking());
 
     // For each partition bound
     // - Find contained points
@@ -322,14 +1202,8 @@ Partition<A>::report(const size_type        local_count,
     }
 
     // Reduce (ie. sum) the weights across all Ranks
-    std::vector<weight_type> global_weight_total;
-    mpixx::all_reduce(m_comm, local_weight_total, global_weight_total, [](const auto& a, const auto& b) {
-        auto ans = a;
-        for (auto n = 0; n < ans.size(); ++n) {
-            ans[n] += b[n];
-        }
-        return ans;
-    });
+    std::vector<weight_type> global_weight_total(local_weight_total.size());
+    mpixx::all_reduce(m_comm, local_weight_total.data(), int(local_weight_total.size()), global_weight_total.data(), MPI_SUM);
 
     auto minmax_weight = std::minmax_element(global_weight_total.begin(), global_weight_total.end());
     auto sum_weight    = std::accumulate(global_weight_total.begin(), global_weight_total.end(), 0);
@@ -0,0 +1,82 @@
+/// @file pipeline.cpp
+/*
+ * Project:         HOPI
+ * File:            pipeline.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/pipeline.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+
+namespace hopi {
+namespace detail {
+
+void
+pipeline_error(const mpixx::communicator& comm, const std::string& message, const std::string& file_name)
+{
+    std::cerr << "P:" << comm.rank() << " ERROR: " << message << std::endl;
+    std::cerr << "P:" << comm.rank() << " Filename: " << file_name << std::endl;
+    comm.abort(EXIT_FAILURE);
+    std::exit(EXIT_FAILURE);
+}
+
+int
+pipeline_count(const mpixx::communicator& comm, const std::size_t count)
+{
+    if (count > std::size_t(INT_MAX)) {
+        std::cerr << "P:" << comm.rank() << " ERROR: Too Many Values For One MPI Call" << std::endl;
+        std::cerr << "P:" << comm.rank() << " Count = " << count << std::endl;
+        comm.abort(EXIT_FAILURE);
+        std::exit(EXIT_FAILURE);
+    }
+    return int(count);
+}
+
+MPI_File
+pipeline_open(const mpixx::communicator& comm, const std::string& file_name, const int mode)
+{
+    MPI_File file;
+    if (MPI_File_open(MPI_Comm(comm), file_name.c_str(), mode, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+        pipeline_error(comm, "File Did Not Open", file_name);
+    }
+    return file;
+}
+
+BinaryTargetHeader
+pipeline_read_header(const mpixx::communicator& comm, MPI_File file, const std::string& file_name)
+{
+    BinaryTargetHeader head;
+    if (comm.rank() == 0) {
+        MPI_Offset file_bytes = 0;
+        BOOST_MPI_CHECK_RESULT(MPI_File_get_size, (file, &file_bytes));
+        if (std::size_t(file_bytes) < sizeof(BinaryTargetHeader)) {
+            pipeline_error(comm, "File Too Small For Header", file_name);
+        }
+        BOOST_MPI_CHECK_RESULT(MPI_File_read_at, (file, 0, &head, int(sizeof(head)), MPI_BYTE, MPI_STATUS_IGNORE));
+        check_binary_target_header(head, std::size_t(file_bytes), file_name);
+    }
+    BOOST_MPI_CHECK_RESULT(MPI_Bcast, (&head, int(sizeof(head)), MPI_BYTE, 0, MPI_Comm(comm)));
+    return head;
+}
+
+void
+pipeline_write_header(const mpixx::communicator& comm, MPI_File file, const BinaryTargetHeader& head)
+{
+    const auto num_blocks = head.ndim + head.nvar;
+    BOOST_MPI_CHECK_RESULT(MPI_File_set_size, (file, MPI_Offset(head.coordinate_offset + num_blocks * head.block_stride)));
+    if (comm.rank() == 0) {
+        BOOST_MPI_CHECK_RESULT(MPI_File_write_at, (file, 0, &head, int(sizeof(head)), MPI_BYTE, MPI_STATUS_IGNORE));
+    }
+}
+
+} /* namespace detail */
+} /* namespace hopi */
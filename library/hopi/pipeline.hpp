@@ -0,0 +1,426 @@
+/// @file pipeline.hpp
+/*
+ * Project:         HOPI
+ * File:            pipeline.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/binary_targets.hpp"
+#include "hopi/mpixx.hpp"
+#include "hopi/partition.hpp"
+#include "hopi/profile.hpp"
+#include "hopi/rbf_interpolator.hpp"
+
+#include "boost/mpi/exception.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hopi {
+
+namespace detail {
+
+/**
+ * Open a file on every rank or abort
+ */
+MPI_File pipeline_open(const mpixx::communicator& comm, const std::string& file_name, const int mode);
+
+/**
+ * Read the header of a Binary HOPI File on rank 0 and share it
+ */
+BinaryTargetHeader pipeline_read_header(const mpixx::communicator& comm, MPI_File file, const std::string& file_name);
+
+/**
+ * Size a new Binary HOPI File and let rank 0 write its header
+ */
+void pipeline_write_header(const mpixx::communicator& comm, MPI_File file, const BinaryTargetHeader& head);
+
+/**
+ * Abort every rank with a message about a file
+ */
+[[noreturn]] void pipeline_error(const mpixx::communicator& comm, const std::string& message, const std::string& file_name);
+
+/**
+ * Count passed to a single MPI call or abort every rank if it exceeds an int
+ */
+int pipeline_count(const mpixx::communicator& comm, const std::size_t count);
+
+} /* namespace detail */
+
+/// Options of TargetPipeline
+struct PipelineOptions {
+    std::size_t block_points = std::size_t(1) << 16;  ///< Targets read by each rank per block
+};
+
+/// Interpolation of a Binary HOPI File of targets one block at a time
+/**
+ * Each rank reads its own contiguous slice of the targets (as in
+ * read_targets_parallel) in blocks of PipelineOptions::block_points.
+ * Every block passes through five stages:
+ *
+ * - read:    non-blocking collective read of the coordinates
+ * - route:   owner of each target and MPI_Ialltoall of the counts
+ * - send:    MPI_Ialltoallv of the targets to their owners under the Partition
+ * - compute: stencils, weights and fields of the received targets,
+ *            then MPI_Ialltoallv of the fields back to the reader
+ * - write:   non-blocking collective write of the coordinates and fields
+ *
+ * Each step starts the next stage of the last five blocks so the
+ * read of one block and the exchanges of three others are in flight
+ * while a fourth is computed. No stage blocks on a collective of its
+ * own block. Memory is held by those five blocks only and does not
+ * grow with the number of targets.
+ *
+ * The interpolator must already hold the sources of this rank
+ * and its halo (see RBFInterpolator::set_sources) so every target
+ * owned by the rank finds its full stencil locally.
+ */
+template<typename InputAdaptor>
+class TargetPipeline final {
+    // ----------------------------------------------------------
+    // Types
+    // ----------------------------------------------------------
+    static constexpr auto NDim = InputAdaptor::NDim;
+    static_assert(NDim == 3, "TargetPipeline routes the x, y and z coordinates of targets");
+
+   public:
+    using size_type         = typename InputAdaptor::size_type;
+    using difference_type   = typename InputAdaptor::difference_type;
+    using coordinate_type   = typename InputAdaptor::coordinate_type;
+    using partition_type    = Partition<InputAdaptor>;
+    using interpolator_type = RBFInterpolator<InputAdaptor>;
+
+    // ----------------------------------------------------------
+    // Constructors and Operators
+    // ----------------------------------------------------------
+   public:
+    TargetPipeline()                            = delete;
+    TargetPipeline(const TargetPipeline& other) = default;
+    TargetPipeline(TargetPipeline&& other)      = default;
+    ~TargetPipeline()                           = default;
+    TargetPipeline& operator=(const TargetPipeline& other) = default;
+    TargetPipeline& operator=(TargetPipeline&& other)      = default;
+
+    TargetPipeline(const partition_type&  partition,
+                   interpolator_type&     interpolator,
+                   const PipelineOptions& options = PipelineOptions());
+
+    // ----------------------------------------------------------
+    // Methods
+    // ----------------------------------------------------------
+   public:
+    /**
+     * Interpolate nvar fields to every target of a Binary HOPI File
+     *
+     * Field v of local source i is source_values[i * nvar + v]. The
+     * result file holds the coordinates of the targets in file order
+     * followed by the nvar fields, all stored as T (float or double).
+     */
+    template<typename T>
+    void run(const std::string& target_file_name,
+             const size_type    nvar,
+             const T*           source_values,
+             const std::string& result_file_name);
+
+    // ----------------------------------------------------------
+    // [PRIVATE]
+    // ----------------------------------------------------------
+   private:
+    using box_array     = typename partition_type::box_array;
+    using exchange_type = typename partition_type::Exchange;
+
+    static constexpr size_type depth = 5;  ///< Blocks in flight, one per stage
+
+    /**
+     * Buffers of one block moving through the stages
+     */
+    template<typename T>
+    struct Block {
+        size_type              first = 0;     ///< Global index of the first target
+        size_type              count = 0;     ///< Targets read by this rank
+        std::vector<std::byte> stored;        ///< Coordinate columns as stored in the file
+        std::vector<box_array> points;        ///< Coordinates in read order
+        exchange_type          plan;          ///< Plan routing the targets to their owners
+        std::vector<box_array> sent;          ///< Coordinates in send order
+        std::vector<box_array> received;      ///< Coordinates of targets owned by this rank
+        std::vector<T>         values;        ///< Fields of the received targets
+        std::vector<T>         returned;      ///< Fields of the sent targets
+        std::vector<int>       value_counts;  ///< Fields returned to each rank
+        std::vector<int>       value_displs;  ///< Offset of the fields returned to each rank
+        std::vector<int>       reply_counts;  ///< Fields returned by each rank
+        std::vector<int>       reply_displs;  ///< Offset of the fields returned by each rank
+        std::vector<T>         columns;       ///< Coordinate and field columns to write
+        std::vector<mpixx::irequest> requests;  ///< Outstanding operations on the buffers (destroyed first)
+
+        /// Complete every outstanding operation
+        void wait()
+        {
+            for (auto& request : requests) {
+                request.wait();
+            }
+            requests.clear();
+        }
+    };
+
+    template<typename T>
+    void read_(MPI_File file, const BinaryTargetHeader& head, Block<T>& block) const;
+
+    template<typename T>
+    void route_(const BinaryTargetHeader& head, Block<T>& block) const;
+
+    template<typename T>
+    void send_(Block<T>& block) const;
+
+    template<typename T>
+    void compute_(const size_type nvar, const T* source_values, Block<T>& block) const;
+
+    template<typename T>
+    void write_(MPI_File file, const BinaryTargetHeader& in_head, const BinaryTargetHeader& out_head, Block<T>& block) const;
+
+    static const coordinate_type* column_(const std::vector<box_array>& points, const size_type dim) noexcept;
+
+    const partition_type* m_partition;     ///< Owner of each target
+    interpolator_type*    m_interpolator;  ///< Holds the sources of this rank and its halo
+    PipelineOptions       m_options;
+};
+
+template<typename A>
+TargetPipeline<A>::TargetPipeline(const partition_type&  partition,
+                                  interpolator_type&     interpolator,
+                                  const PipelineOptions& options)
+    : m_partition(&partition), m_interpolator(&interpolator), m_options(options)
+{
+}
+
+template<typename A>
+template<typename T>
+void
+TargetPipeline<A>::run(const std::string& target_file_name,
+                       const size_type    nvar,
+                       const T*           source_values,
+                       const std::string& result_file_name)
+{
+    HOPI_PROFILE_SCOPE("pipeline.run");
+    const auto& comm = m_partition->comm();
+
+    // Open the targets and create the results
+    MPI_File   in_file = detail::pipeline_open(comm, target_file_name, MPI_MODE_RDONLY);
+    const auto in_head = detail::pipeline_read_header(comm, in_file, target_file_name);
+    if (in_head.ndim != NDim) {
+        detail::pipeline_error(comm, "Targets Have Wrong Dimension", target_file_name);
+    }
+    MPI_File   out_file = detail::pipeline_open(comm, result_file_name, MPI_MODE_WRONLY | MPI_MODE_CREATE);
+    const auto out_head = make_binary_target_header(NDim, in_head.npoints, nvar, sizeof(T));
+    detail::pipeline_write_header(comm, out_file, out_head);
+
+    // My contiguous slice of targets in blocks
+    // - Every rank steps through the same number of blocks so the collectives match
+    const size_type     num_ranks    = comm.size();
+    const size_type     my_rank      = comm.rank();
+    const size_type     first        = (in_head.npoints * my_rank) / num_ranks;
+    const size_type     count        = (in_head.npoints * (my_rank + 1)) / num_ranks - first;
+    const size_type     block_points = std::max<size_type>(m_options.block_points, 1);
+    const std::uint64_t my_blocks    = (count + block_points - 1) / block_points;
+    const size_type     num_blocks   = mpixx::all_reduce(comm, my_blocks, MPI_MAX);
+    HOPI_PROFILE_COUNT("pipeline.blocks", num_blocks);
+
+    // Each step moves the last depth blocks to their next stage
+    // - The read of a block is started first so it overlaps the compute of another
+    std::array<Block<T>, depth> ring;
+    for (size_type step = 0; step < num_blocks + depth - 1; ++step) {
+        auto active = [&](const size_type lag) { return (step >= lag) and (step - lag < num_blocks); };
+        if (active(0)) {
+            auto& block = ring[step % depth];
+            block.wait();
+            const auto begin = std::min(count, step * block_points);
+            const auto end   = std::min(count, (step + 1) * block_points);
+            block.first      = first + begin;
+            block.count      = end - begin;
+            this->read_(in_file, in_head, block);
+        }
+        if (active(1)) {
+            this->route_(in_head, ring[(step - 1) % depth]);
+        }
+        if (active(2)) {
+            this->send_(ring[(step - 2) % depth]);
+        }
+        if (active(3)) {
+            this->compute_(nvar, source_values, ring[(step - 3) % depth]);
+        }
+        if (active(4)) {
+            this->write_(out_file, in_head, out_head, ring[(step - 4) % depth]);
+        }
+    }
+    for (auto& block : ring) {
+        block.wait();
+    }
+
+    BOOST_MPI_CHECK_RESULT(MPI_File_close, (&out_file));
+    BOOST_MPI_CHECK_RESULT(MPI_File_close, (&in_file));
+}
+
+template<typename A>
+template<typename T>
+void
+TargetPipeline<A>::read_(MPI_File file, const BinaryTargetHeader& head, Block<T>& block) const
+{
+    // One collective read per coordinate column
+    HOPI_PROFILE_SCOPE("pipeline.read");
+    const MPI_Datatype value_type = (head.value_bytes == sizeof(float)) ? MPI_FLOAT : MPI_DOUBLE;
+    const size_type    bytes      = block.count * head.value_bytes;
+    const int          count      = detail::pipeline_count(m_partition->comm(), block.count);
+    block.stored.resize(NDim * bytes);
+    for (size_type d = 0; d < NDim; ++d) {
+        const MPI_Offset offset = MPI_Offset(head.coordinate_offset + d * head.block_stride + block.first * head.value_bytes);
+        MPI_Request      request;
+        BOOST_MPI_CHECK_RESULT(MPI_File_iread_at_all,
+                               (file, offset, block.stored.data() + d * bytes, count, value_type, &request));
+        block.requests.emplace_back(request);
+    }
+}
+
+template<typename A>
+template<typename T>
+void
+TargetPipeline<A>::route_(const BinaryTargetHeader& head, Block<T>& block) const
+{
+    block.wait();
+    HOPI_PROFILE_SCOPE("pipeline.route");
+
+    // Convert the stored columns into points
+    block.points.resize(block.count);
+    auto convert = [&](const auto* stored) {
+        for (size_type i = 0; i < block.count; ++i) {
+            for (size_type d = 0; d < NDim; ++d) {
+                block.points[i][d] = coordinate_type(stored[d * block.count + i]);
+            }
+        }
+    };
+    if (head.value_bytes == sizeof(float)) {
+        convert(reinterpret_cast<const float*>(block.stored.data()));
+    }
+    else {
+        convert(reinterpret_cast<const double*>(block.stored.data()));
+    }
+
+    // Group the targets by owner while the counts are exchanged
+    const auto& points = block.points;
+    block.requests.push_back(m_partition->iexchange_plan(block.count, column_(points, 0), NDim, column_(points, 1), NDim,
+                                                         column_(points, 2), NDim, block.plan));
+    block.sent.resize(block.count);
+    for (size_type n = 0; n < block.count; ++n) {
+        block.sent[n] = points[block.plan.send_index[n]];
+    }
+}
+
+template<typename A>
+template<typename T>
+void
+TargetPipeline<A>::send_(Block<T>& block) const
+{
+    block.wait();
+    HOPI_PROFILE_SCOPE("pipeline.send");
+
+    // Send each target to its owner
+    block.plan.set_recv_displs();
+    block.received.resize(block.plan.recv_size());
+    block.requests.push_back(mpixx::iall_to_allv(m_partition->comm(), block.sent.data(), block.plan.send_counts,
+                                                 block.plan.send_displs, block.received.data(), block.plan.recv_counts,
+                                                 block.plan.recv_displs));
+}
+
+template<typename A>
+template<typename T>
+void
+TargetPipeline<A>::compute_(const size_type nvar, const T* source_values, Block<T>& block) const
+{
+    block.wait();
+    HOPI_PROFILE_SCOPE("pipeline.compute");
+
+    // Interpolate the targets owned by this rank
+    const auto& received = block.received;
+    m_interpolator->set_targets(received.size(), column_(received, 0), NDim, column_(received, 1), NDim,
+                                column_(received, 2), NDim);
+    block.values.resize(received.size() * nvar);
+    m_interpolator->apply(nvar, source_values, difference_type(nvar), 1, block.values.data(), difference_type(nvar), 1);
+
+    // Send the fields back along the reverse of the plan
+    // - Displacements of the fields must still fit in an int
+    detail::pipeline_count(m_partition->comm(), received.size() * nvar);
+    detail::pipeline_count(m_partition->comm(), block.count * nvar);
+    const auto& plan  = block.plan;
+    auto        scale = [&](const std::vector<int>& in, std::vector<int>& out) {
+        out.resize(in.size());
+        std::transform(in.begin(), in.end(), out.begin(), [&](const int n) { return n * int(nvar); });
+    };
+    scale(plan.recv_counts, block.value_counts);
+    scale(plan.recv_displs, block.value_displs);
+    scale(plan.send_counts, block.reply_counts);
+    scale(plan.send_displs, block.reply_displs);
+    block.returned.resize(block.count * nvar);
+    block.requests.push_back(mpixx::iall_to_allv(m_partition->comm(), block.values.data(), block.value_counts,
+                                                 block.value_displs, block.returned.data(), block.reply_counts,
+                                                 block.reply_displs));
+}
+
+template<typename A>
+template<typename T>
+void
+TargetPipeline<A>::write_(MPI_File                  file,
+                          const BinaryTargetHeader& in_head,
+                          const BinaryTargetHeader& out_head,
+                          Block<T>&                 block) const
+{
+    block.wait();
+    HOPI_PROFILE_SCOPE("pipeline.write");
+    const size_type count = block.count;
+    const size_type nvar  = out_head.nvar;
+
+    // Columns of coordinates (from the stored values) and fields in read order
+    block.columns.resize((NDim + nvar) * count);
+    auto convert = [&](const auto* stored) {
+        std::transform(stored, stored + NDim * count, block.columns.begin(), [](const auto value) { return T(value); });
+    };
+    if (in_head.value_bytes == sizeof(float)) {
+        convert(reinterpret_cast<const float*>(block.stored.data()));
+    }
+    else {
+        convert(reinterpret_cast<const double*>(block.stored.data()));
+    }
+    for (size_type n = 0; n < count; ++n) {
+        const auto i = block.plan.send_index[n];
+        for (size_type v = 0; v < nvar; ++v) {
+            block.columns[(NDim + v) * count + i] = block.returned[n * nvar + v];
+        }
+    }
+
+    // One collective write per column
+    const int column_count = detail::pipeline_count(m_partition->comm(), count);
+    for (size_type c = 0; c < NDim + nvar; ++c) {
+        const MPI_Offset offset = MPI_Offset(out_head.coordinate_offset + c * out_head.block_stride + block.first * sizeof(T));
+        MPI_Request      request;
+        BOOST_MPI_CHECK_RESULT(MPI_File_iwrite_at_all,
+                               (file, offset, block.columns.data() + c * count, column_count, mpixx::datatype<T>(), &request));
+        block.requests.emplace_back(request);
+    }
+}
+
+template<typename A>
+const typename TargetPipeline<A>::coordinate_type*
+TargetPipeline<A>::column_(const std::vector<box_array>& points, const size_type dim) noexcept
+{
+    return points.empty() ? nullptr : points.front().data() + dim;
+}
+
+} /* namespace hopi */
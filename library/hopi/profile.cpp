@@ -0,0 +1,257 @@
+/// @file profile.cpp
+/*
+ * Project:         HOPI
+ * File:            profile.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/profile.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace hopi {
+namespace profile {
+namespace {
+
+// Origin of the trace timestamps
+const clock::time_point process_start = clock::now();
+
+// Tables written by a single thread
+struct ThreadTables {
+    Snapshot                tables;
+    std::vector<TraceEvent> events;
+};
+
+struct Registry {
+    std::mutex                                 mutex;
+    std::vector<std::unique_ptr<ThreadTables>> threads;
+};
+
+Registry&
+registry()
+{
+    static Registry reg;
+    return reg;
+}
+
+// Tables of this thread, created on first use
+// - Owned by the registry so they outlive the thread
+ThreadTables&
+thread_tables()
+{
+    thread_local ThreadTables* tables = nullptr;
+    if (tables == nullptr) {
+        auto&                       reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        tables = reg.threads.emplace_back(std::make_unique<ThreadTables>()).get();
+    }
+    return *tables;
+}
+
+template<typename Stat>
+Stat&
+find_or_add(std::map<std::string, Stat, std::less<>>& table, const std::string_view name)
+{
+    auto it = table.find(name);
+    if (it == table.end()) {
+        it = table.emplace(std::string(name), Stat()).first;
+    }
+    return it->second;
+}
+
+// Allocations through the global operator new
+std::atomic<std::uint64_t> total_allocations{ 0 };
+std::atomic<std::uint64_t> total_bytes{ 0 };
+thread_local std::uint64_t allocations_of_thread = 0;
+
+} // namespace
+
+void
+record_time(const std::string_view  name,
+            const clock::time_point start,
+            const clock::time_point stop,
+            const std::uint64_t     bytes,
+            const std::uint64_t     allocations)
+{
+    auto& thread = thread_tables();
+    auto  it     = thread.tables.timers.find(name);
+    if (it == thread.tables.timers.end()) {
+        it = thread.tables.timers.emplace(std::string(name), TimerStat()).first;
+    }
+    auto& stat = it->second;
+    stat.calls += 1;
+    stat.seconds += std::chrono::duration<double>(stop - start).count();
+    stat.bytes += bytes;
+    stat.allocations += allocations;
+    if (thread.events.size() < max_trace_events) {
+        thread.events.push_back(TraceEvent{ &it->first, detail::since_start(start), detail::since_start(stop) - detail::since_start(start) });
+    }
+}
+
+void
+record_count(const std::string_view name, const double value)
+{
+    auto& stat = find_or_add(thread_tables().tables.counters, name);
+    stat.samples += 1;
+    stat.sum += value;
+}
+
+void
+record_query(const std::string_view name, const QueryStat& query)
+{
+    auto& stat = find_or_add(thread_tables().tables.queries, name);
+    stat.queries += query.queries;
+    stat.nodes_visited += query.nodes_visited;
+    stat.leaves_tested += query.leaves_tested;
+    stat.found += query.found;
+    stat.pruned += query.pruned;
+}
+
+std::uint64_t
+thread_allocations() noexcept
+{
+    return allocations_of_thread;
+}
+
+void
+reset()
+{
+    auto&                       reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& thread : reg.threads) {
+        thread->tables = Snapshot();
+        thread->events.clear();
+    }
+    total_allocations = 0;
+    total_bytes       = 0;
+}
+
+Snapshot
+snapshot()
+{
+    Snapshot                    ans;
+    auto&                       reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& thread : reg.threads) {
+        for (const auto& [name, stat] : thread->tables.timers) {
+            auto& sum = find_or_add(ans.timers, name);
+            sum.calls += stat.calls;
+            sum.seconds += stat.seconds;
+            sum.bytes += stat.bytes;
+            sum.allocations += stat.allocations;
+        }
+        for (const auto& [name, stat] : thread->tables.counters) {
+            auto& sum = find_or_add(ans.counters, name);
+            sum.samples += stat.samples;
+            sum.sum += stat.sum;
+        }
+        for (const auto& [name, stat] : thread->tables.queries) {
+            auto& sum = find_or_add(ans.queries, name);
+            sum.queries += stat.queries;
+            sum.nodes_visited += stat.nodes_visited;
+            sum.leaves_tested += stat.leaves_tested;
+            sum.found += stat.found;
+            sum.pruned += stat.pruned;
+        }
+    }
+    if constexpr (enabled) {
+        ans.counters["memory.allocations"] = CounterStat{ 1, double(total_allocations.load()) };
+        ans.counters["memory.bytes"]       = CounterStat{ 1, double(total_bytes.load()) };
+    }
+    return ans;
+}
+
+namespace detail {
+
+std::int64_t
+since_start(const clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - process_start).count();
+}
+
+std::size_t
+num_threads()
+{
+    auto&                       reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.threads.size();
+}
+
+const TraceEvent*
+thread_events(const std::size_t thread, std::size_t& count)
+{
+    auto&                       reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const auto&                 events = reg.threads.at(thread)->events;
+    count                              = events.size();
+    return events.data();
+}
+
+} // namespace detail
+
+} // namespace profile
+
+namespace spatial {
+namespace profile {
+
+void
+record_query(const std::string_view name, const QueryStat& query)
+{
+    ::hopi::profile::record_query(name, query);
+}
+
+} // namespace profile
+} // namespace spatial
+} /* namespace hopi */
+
+//
+// Count every allocation in the profile build
+// - The array, nothrow and sized forms call these by default
+//
+#if defined(HOPI_USE_PROFILE)
+
+void*
+operator new(std::size_t size)
+{
+    hopi::profile::allocations_of_thread += 1;
+    hopi::profile::total_allocations.fetch_add(1, std::memory_order_relaxed);
+    hopi::profile::total_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        if (void* ptr = std::malloc(size)) {
+            return ptr;
+        }
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t /* size */) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
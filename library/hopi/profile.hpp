@@ -0,0 +1,181 @@
+/// @file profile.hpp
+/*
+ * Project:         HOPI
+ * File:            profile.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "hopi/spatial/common/profile.hpp"
+
+/**
+ * Phase timers and counters
+ *
+ * Instrumentation is placed with the HOPI_PROFILE_* macros (and
+ * profile::QueryCounter within the spatial indexes) which compile
+ * to nothing unless HOPI_USE_PROFILE is defined by the CMake option
+ * of the same name. The profile build also counts every allocation
+ * made through the global operator new.
+ *
+ * Each thread records into its own tables so timers may be used
+ * from within OpenMP regions. The tables are read by snapshot()
+ * and the writers of profile_report.hpp which must only be called
+ * while no other thread is recording.
+ */
+namespace hopi {
+namespace profile {
+
+#if defined(HOPI_USE_PROFILE)
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+using clock = std::chrono::steady_clock;
+
+/// Totals of a named timer
+struct TimerStat {
+    std::uint64_t calls       = 0;  ///< Number of timed scopes
+    double        seconds     = 0;  ///< Wall clock time within the scopes
+    std::uint64_t bytes       = 0;  ///< Bytes sent by MPI within the scopes
+    std::uint64_t allocations = 0;  ///< Allocations by the timing thread within the scopes
+};
+
+/// Totals of a named counter
+struct CounterStat {
+    std::uint64_t samples = 0;  ///< Number of recorded values
+    double        sum     = 0;  ///< Sum of the recorded values
+};
+
+/// Totals of a named spatial query
+using QueryStat = spatial::profile::QueryStat;
+
+/// A completed timer scope for the trace
+struct TraceEvent {
+    const std::string* name;      ///< Key of the TimerStat
+    std::int64_t       start;     ///< Nanoseconds since the process started
+    std::int64_t       duration;  ///< Nanoseconds
+};
+
+/// Totals of all threads
+struct Snapshot {
+    std::map<std::string, TimerStat, std::less<>>   timers;
+    std::map<std::string, CounterStat, std::less<>> counters;
+    std::map<std::string, QueryStat, std::less<>>   queries;
+};
+
+/// Record a completed timer scope on this thread
+void record_time(std::string_view name, clock::time_point start, clock::time_point stop, std::uint64_t bytes, std::uint64_t allocations);
+
+/// Record a counter value on this thread
+void record_count(std::string_view name, double value);
+
+/// Record a completed spatial query on this thread
+void record_query(std::string_view name, const QueryStat& query);
+
+/// Allocations made by this thread (0 unless HOPI_USE_PROFILE)
+std::uint64_t thread_allocations() noexcept;
+
+/// Clear every timer, counter and trace event
+void reset();
+
+/// Sum the tables of every thread
+/**
+ * The counters include "memory.allocations" and "memory.bytes"
+ * for all threads in the profile build.
+ */
+Snapshot snapshot();
+
+/// Call the function with (thread, event) for every trace event
+/**
+ * Each thread keeps its first max_trace_events events.
+ */
+template<typename Function>
+void for_each_event(Function&& function);
+
+inline constexpr std::size_t max_trace_events = std::size_t(1) << 20;
+
+/// Times a scope on the current thread
+/**
+ * Bytes is the amount sent if the scope wraps an MPI call.
+ * The name must outlive the timer.
+ */
+class ScopedTimer final {
+   public:
+    explicit ScopedTimer(std::string_view name, std::uint64_t bytes = 0)
+        : m_name(name), m_bytes(bytes), m_allocations(thread_allocations()), m_start(clock::now())
+    {
+    }
+    ScopedTimer(const ScopedTimer& other)            = delete;
+    ScopedTimer& operator=(const ScopedTimer& other) = delete;
+    ~ScopedTimer() { record_time(m_name, m_start, clock::now(), m_bytes, thread_allocations() - m_allocations); }
+
+   private:
+    std::string_view  m_name;
+    std::uint64_t     m_bytes;
+    std::uint64_t     m_allocations;
+    clock::time_point m_start;
+};
+
+/// Counts the work of a single spatial query
+/**
+ * Records on destruction in the profile build and is an
+ * empty object which the compiler removes otherwise.
+ */
+using QueryCounter = spatial::profile::QueryCounter;
+
+namespace detail {
+
+/// Nanoseconds from the start of the process to time
+std::int64_t since_start(clock::time_point time);
+
+/// Number of threads which have recorded
+std::size_t num_threads();
+
+/// Trace events of a thread
+const TraceEvent* thread_events(std::size_t thread, std::size_t& count);
+
+} // namespace detail
+
+template<typename Function>
+void
+for_each_event(Function&& function)
+{
+    const auto num_threads = detail::num_threads();
+    for (std::size_t thread = 0; thread < num_threads; ++thread) {
+        std::size_t count  = 0;
+        const auto* events = detail::thread_events(thread, count);
+        for (std::size_t i = 0; i < count; ++i) {
+            function(thread, events[i]);
+        }
+    }
+}
+
+} // namespace profile
+} /* namespace hopi */
+
+#define HOPI_PROFILE_CONCAT_(a, b) a##b
+#define HOPI_PROFILE_NAME_(line) HOPI_PROFILE_CONCAT_(hopi_profile_scope_, line)
+
+#if defined(HOPI_USE_PROFILE)
+#define HOPI_PROFILE_SCOPE(name) const ::hopi::profile::ScopedTimer HOPI_PROFILE_NAME_(__LINE__)(name)
+#define HOPI_PROFILE_MPI(name, bytes) const ::hopi::profile::ScopedTimer HOPI_PROFILE_NAME_(__LINE__)(name, bytes)
+#define HOPI_PROFILE_COUNT(name, value) ::hopi::profile::record_count(name, double(value))
+#else
+#define HOPI_PROFILE_SCOPE(name) ((void)0)
+#define HOPI_PROFILE_MPI(name, bytes) ((void)0)
+#define HOPI_PROFILE_COUNT(name, value) ((void)0)
+#endif
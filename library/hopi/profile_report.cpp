@@ -0,0 +1,243 @@
+/// @file profile_report.cpp
+/*
+ * Project:         HOPI
+ * File:            profile_report.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/profile_report.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace hopi {
+namespace profile {
+
+namespace {
+
+[[noreturn]] void
+profile_file_error(const std::string& message, const std::string& file_name)
+{
+    std::cerr << "ERROR: " << message << std::endl;
+    std::cerr << "Filename: " << file_name << std::endl;
+    std::exit(EXIT_FAILURE);
+}
+
+// Names are identifiers from the source but may hold any character
+std::string
+quoted(const std::string_view text)
+{
+    std::string ans = "\"";
+    for (const char c : text) {
+        if ((c == '"') or (c == '\\')) {
+            ans += '\\';
+        }
+        ans += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+    }
+    ans += '"';
+    return ans;
+}
+
+// Concatenate the text of every rank on rank 0
+std::string
+gather_text(const mpixx::communicator& comm, const std::string& text)
+{
+    const int        num_chars = int(text.size());
+    std::vector<int> counts(comm.size(), 0);
+    BOOST_MPI_CHECK_RESULT(MPI_Gather, (&num_chars, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_Comm(comm)));
+
+    std::vector<int> displs(comm.size(), 0);
+    std::exclusive_scan(counts.begin(), counts.end(), displs.begin(), 0);
+    std::string ans(std::size_t(displs.back() + counts.back()), '\0');
+    BOOST_MPI_CHECK_RESULT(MPI_Gatherv,
+                           (text.data(), num_chars, MPI_CHAR, ans.data(), counts.data(), displs.data(), MPI_CHAR, 0, MPI_Comm(comm)));
+    return ans;
+}
+
+// Sorted union of the names recorded by every rank
+template<typename Stat>
+std::vector<std::string>
+union_of_names(const mpixx::communicator& comm, const std::map<std::string, Stat, std::less<>>& table)
+{
+    std::string local;
+    for (const auto& [name, stat] : table) {
+        local += name;
+        local += '\0';
+    }
+    const int        num_chars = int(local.size());
+    std::vector<int> counts(comm.size(), 0);
+    BOOST_MPI_CHECK_RESULT(MPI_Allgather, (&num_chars, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_Comm(comm)));
+
+    std::vector<int> displs(comm.size(), 0);
+    std::exclusive_scan(counts.begin(), counts.end(), displs.begin(), 0);
+    std::string all(std::size_t(displs.back() + counts.back()), '\0');
+    BOOST_MPI_CHECK_RESULT(MPI_Allgatherv,
+                           (local.data(), num_chars, MPI_CHAR, all.data(), counts.data(), displs.data(), MPI_CHAR, MPI_Comm(comm)));
+
+    std::vector<std::string> ans;
+    for (std::size_t first = 0; first < all.size();) {
+        const auto last = all.find('\0', first);
+        ans.emplace_back(all, first, last - first);
+        first = last + 1;
+    }
+    std::sort(ans.begin(), ans.end());
+    ans.erase(std::unique(ans.begin(), ans.end()), ans.end());
+    return ans;
+}
+
+// Min, max and sum across ranks of each field of each name
+// - fields(stat) returns the fields of one Stat as an array of doubles
+struct Reduced {
+    std::vector<double> min;
+    std::vector<double> max;
+    std::vector<double> sum;
+};
+
+template<typename Stat, typename Fields>
+Reduced
+reduce_fields(const mpixx::communicator&                      comm,
+              const std::map<std::string, Stat, std::less<>>& table,
+              const std::vector<std::string>&                 names,
+              Fields                                          fields)
+{
+    constexpr std::size_t num_fields = decltype(fields(std::declval<Stat>()))().size();
+    std::vector<double>   local(names.size() * num_fields, 0);
+    for (std::size_t n = 0; n < names.size(); ++n) {
+        const auto it = table.find(names[n]);
+        if (it != table.end()) {
+            const auto values = fields(it->second);
+            std::copy(values.begin(), values.end(), local.begin() + n * num_fields);
+        }
+    }
+    Reduced ans;
+    ans.min.resize(local.size());
+    ans.max.resize(local.size());
+    ans.sum.resize(local.size());
+    mpixx::all_reduce(comm, local.data(), int(local.size()), ans.min.data(), MPI_MIN);
+    mpixx::all_reduce(comm, local.data(), int(local.size()), ans.max.data(), MPI_MAX);
+    mpixx::all_reduce(comm, local.data(), int(local.size()), ans.sum.data(), MPI_SUM);
+    return ans;
+}
+
+// Write {"name": {"field": {"min": , "max": , "mean": }, ...}, ...}
+void
+write_fields(std::ostream&                   out,
+             const std::vector<std::string>& names,
+             const std::vector<const char*>& field_names,
+             const Reduced&                  reduced,
+             const int                       num_ranks)
+{
+    // Trailing fields without a name are not written
+    const auto num_fields = names.empty() ? std::size_t(0) : reduced.sum.size() / names.size();
+    out << "{";
+    for (std::size_t n = 0; n < names.size(); ++n) {
+        out << (n == 0 ? "\n" : ",\n") << "    " << quoted(names[n]) << ": {";
+        for (std::size_t f = 0; f < field_names.size(); ++f) {
+            const auto i = n * num_fields + f;
+            out << (f == 0 ? "\n" : ",\n") << "      " << quoted(field_names[f]) << ": {"
+                << "\"min\": " << reduced.min[i] << ", \"max\": " << reduced.max[i] << ", \"mean\": " << reduced.sum[i] / num_ranks << "}";
+        }
+        out << "\n    }";
+    }
+    out << (names.empty() ? "}" : "\n  }");
+}
+
+} // namespace
+
+void
+write_json(const mpixx::communicator& comm, const std::string& file_name)
+{
+    const auto local     = snapshot();
+    const int  num_ranks = comm.size();
+
+    const auto timer_names = union_of_names(comm, local.timers);
+    const auto timers      = reduce_fields(comm, local.timers, timer_names, [](const TimerStat& s) {
+        return std::array<double, 4>{ double(s.calls), s.seconds, double(s.bytes), double(s.allocations) };
+    });
+
+    const auto counter_names = union_of_names(comm, local.counters);
+    const auto counters      = reduce_fields(comm, local.counters, counter_names, [](const CounterStat& s) {
+        return std::array<double, 2>{ double(s.samples), s.sum };
+    });
+
+    const auto query_names = union_of_names(comm, local.queries);
+    const auto queries     = reduce_fields(comm, local.queries, query_names, [](const QueryStat& s) {
+        return std::array<double, 5>{ double(s.queries), double(s.nodes_visited), double(s.leaves_tested), double(s.found), s.pruned };
+    });
+
+    if (comm.rank() != 0) {
+        return;
+    }
+    std::ofstream out(file_name, std::ios::trunc);
+    if (not out) {
+        profile_file_error("File Did Not Open", file_name);
+    }
+    out.precision(9);
+    out << "{\n  \"enabled\": " << (enabled ? "true" : "false") << ",\n  \"ranks\": " << num_ranks << ",\n";
+    out << "  \"timers\": ";
+    write_fields(out, timer_names, { "calls", "seconds", "bytes", "allocations" }, timers, num_ranks);
+    out << ",\n  \"counters\": ";
+    write_fields(out, counter_names, { "samples", "sum" }, counters, num_ranks);
+    out << ",\n  \"queries\": ";
+    write_fields(out, query_names, { "queries", "nodes_visited", "leaves_tested", "found" }, queries, num_ranks);
+
+    // Averages over every query of every rank
+    out << ",\n  \"query_averages\": {";
+    for (std::size_t n = 0; n < query_names.size(); ++n) {
+        const auto* sum         = queries.sum.data() + n * 5;
+        const auto  num_queries = std::max(sum[0], 1.0);
+        out << (n == 0 ? "\n" : ",\n") << "    " << quoted(query_names[n]) << ": {"
+            << "\"nodes_visited\": " << sum[1] / num_queries << ", \"leaves_tested\": " << sum[2] / num_queries
+            << ", \"found\": " << sum[3] / num_queries << ", \"pruning_efficiency\": " << sum[4] / num_queries << "}";
+    }
+    out << (query_names.empty() ? "}" : "\n  }") << "\n}\n";
+}
+
+void
+write_trace(const mpixx::communicator& comm, const std::string& file_name)
+{
+    // Shift my clock so every rank reads the same time leaving the barrier
+    comm.barrier();
+    const std::int64_t mine = detail::since_start(clock::now());
+    std::int64_t       root = mine;
+    BOOST_MPI_CHECK_RESULT(MPI_Bcast, (&root, 1, MPI_INT64_T, 0, MPI_Comm(comm)));
+    const std::int64_t offset = root - mine;
+
+    std::ostringstream events;
+    events.precision(3);
+    events << std::fixed;
+    const int rank = comm.rank();
+    events << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << rank << ", \"args\": {\"name\": \"rank " << rank << "\"}}";
+    for_each_event([&](const std::size_t thread, const TraceEvent& event) {
+        events << ",\n{\"name\": " << quoted(*event.name) << ", \"cat\": \"hopi\", \"ph\": \"X\", \"pid\": " << rank
+               << ", \"tid\": " << thread << ", \"ts\": " << double(event.start + offset) * 1.0e-3
+               << ", \"dur\": " << double(event.duration) * 1.0e-3 << "}";
+    });
+    events << (rank + 1 < comm.size() ? ",\n" : "\n");
+
+    const auto all = gather_text(comm, events.str());
+    if (rank != 0) {
+        return;
+    }
+    std::ofstream out(file_name, std::ios::trunc);
+    if (not out) {
+        profile_file_error("File Did Not Open", file_name);
+    }
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n" << all << "]}\n";
+}
+
+} // namespace profile
+} /* namespace hopi */
@@ -0,0 +1,41 @@
+/// @file profile_report.hpp
+/*
+ * Project:         HOPI
+ * File:            profile_report.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/mpixx.hpp"
+#include "hopi/profile.hpp"
+
+#include <string>
+
+namespace hopi {
+namespace profile {
+
+/// Write the timers and counters of every rank as JSON
+/**
+ * Each value is reported as the min, max and mean across the
+ * ranks of comm, where a rank which never recorded a name counts
+ * as zero. Collective over comm and only rank 0 writes the file.
+ */
+void write_json(const mpixx::communicator& comm, const std::string& file_name);
+
+/// Write the timer scopes of every rank as a Chrome trace
+/**
+ * The file loads into chrome://tracing or Perfetto with one
+ * process per rank and one thread per recording thread. Clocks
+ * are aligned at a barrier within the call. Collective over comm
+ * and only rank 0 writes the file.
+ */
+void write_trace(const mpixx::communicator& comm, const std::string& file_name);
+
+} // namespace profile
+} /* namespace hopi */
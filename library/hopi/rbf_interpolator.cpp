@@ -0,0 +1,19 @@
+/// @file rbf_interpolator.cpp
+/*
+ * Project:         HOPI
+ * File:            rbf_interpolator.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/rbf_interpolator.hpp"
+
+namespace hopi {
+
+
+} /* namespace hopi */
\ No newline at end of file
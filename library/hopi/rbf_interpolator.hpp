@@ -0,0 +1,704 @@
+/// @file rbf_interpolator.hpp
+/*
+ * Project:         HOPI
+ * File:            rbf_interpolator.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/offload.hpp"
+#include "hopi/profile.hpp"
+#include "hopi/rbf_solver.hpp"
+#include "hopi/rtree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace hopi {
+
+/**
+ * Radial basis function used by RBFInterpolator
+ *
+ * Matches the kernels of scipy.interpolate.RBFInterpolator
+ * - Linear          = -r
+ * - ThinPlateSpline = r^2 log(r)
+ * - Cubic           = r^3
+ * - Quintic         = -r^5
+ * - Gaussian        = exp(-(epsilon r)^2)
+ */
+enum class RBFKernel { Linear, ThinPlateSpline, Cubic, Quintic, Gaussian };
+
+/**
+ * Options controlling how RBFInterpolator builds each stencil
+ */
+struct RBFOptions {
+    RBFKernel   kernel         = RBFKernel::ThinPlateSpline;
+    std::size_t neighbors      = 50;     ///< Sources within each stencil
+    int         degree         = 1;      ///< Degree of the appended polynomial (-1, 0 or 1)
+    double      epsilon        = 1;      ///< Shape parameter of the Gaussian kernel
+    double      smoothing      = 0;      ///< Added to the diagonal of each kernel matrix
+    std::size_t tie_candidates = 8;      ///< Extra neighbors re-ranked in double for float coordinates (0 disables)
+    bool        offload        = false;  ///< Search stencils and apply weights with OffloadTree and OffloadMatrix
+};
+
+namespace detail {
+
+/**
+ * Evaluate the radial basis function at distance r
+ */
+inline double
+rbf_kernel(const RBFKernel kernel, const double epsilon, const double r)
+{
+    switch (kernel) {
+        case RBFKernel::Linear:
+            return -r;
+        case RBFKernel::ThinPlateSpline:
+            return (r > 0) ? r * r * std::log(r) : 0.0;
+        case RBFKernel::Cubic:
+            return r * r * r;
+        case RBFKernel::Quintic:
+            return -(r * r) * (r * r) * r;
+        case RBFKernel::Gaussian:
+            return std::exp(-(epsilon * r) * (epsilon * r));
+    }
+    return 0;
+}
+
+} // namespace detail
+
+/**
+ * Radial Basis Function Interpolation with Reusable Weights
+ *
+ * Each target is interpolated from its K nearest sources with a radial
+ * basis function augmented by a polynomial. Because the stencil system
+ * is symmetric its solution against the kernel row of the target gives
+ * weights w such that f(target) = sum_j w_j f(source_j) for any field f.
+ * The weights are found once by setup and stored as a CSR matrix so
+ * interpolating each field afterwards is only a sparse mat-vec.
+ *
+ * Sources are local to the caller, so for distributed data append the
+ * ghosts from Halo to the local sources before calling setup.
+ *
+ * Stencils of equal size are solved together in batches by the backend
+ * named by InputAdaptor::rbf_solver_type (see rbf_solver.hpp) which
+ * defaults to BatchedCholeskySolver<>. Any stencil the backend cannot
+ * solve is retried with DenseLUSolver.
+ *
+ * With RBFOptions::offload the stencil search and apply run through
+ * the kernels of offload.hpp (on the device in a HOPI_USE_OFFLOAD
+ * build) while the stencils are still solved on the host.
+ */
+template<typename InputAdaptor>
+class RBFInterpolator final {
+    // ----------------------------------------------------------
+    // Types
+    // ----------------------------------------------------------
+    static constexpr auto NDim = InputAdaptor::NDim;
+
+   public:
+    using size_type       = typename InputAdaptor::size_type;
+    using difference_type = typename InputAdaptor::difference_type;
+    using coordinate_type = typename InputAdaptor::coordinate_type;
+    using box_type        = hopi::spatial::BoundBox<coordinate_type, NDim>;
+    using box_array       = typename box_type::array_type;
+    using solver_type     = typename detail::rbf_solver<InputAdaptor>::type;
+
+    // ----------------------------------------------------------
+    // Constructors and Operators
+    // ----------------------------------------------------------
+   public:
+    RBFInterpolator(const RBFInterpolator& other) = default;
+    RBFInterpolator(RBFInterpolator&& other)      = default;
+    ~RBFInterpolator()                            = default;
+    RBFInterpolator& operator=(const RBFInterpolator& other) = default;
+    RBFInterpolator& operator=(RBFInterpolator&& other)      = default;
+
+    explicit RBFInterpolator(const RBFOptions& options = RBFOptions());
+
+    // ----------------------------------------------------------
+    // Methods
+    // ----------------------------------------------------------
+   public:
+    /**
+     * Find the stencil and weights of every target
+     *
+     * Same as set_sources followed by set_targets.
+     */
+    void setup(const size_type        source_count,
+               const coordinate_type* sx,
+               const difference_type  sxinc,
+               const coordinate_type* sy,
+               const difference_type  syinc,
+               const coordinate_type* sz,
+               const difference_type  szinc,
+               const size_type        target_count,
+               const coordinate_type* tx,
+               const difference_type  txinc,
+               const coordinate_type* ty,
+               const difference_type  tyinc,
+               const coordinate_type* tz,
+               const difference_type  tzinc);
+
+    /**
+     * Copy the sources and build the tree searched by set_targets
+     */
+    void set_sources(const size_type        source_count,
+                     const coordinate_type* sx,
+                     const difference_type  sxinc,
+                     const coordinate_type* sy,
+                     const difference_type  syinc,
+                     const coordinate_type* sz,
+                     const difference_type  szinc);
+
+    /**
+     * Find the stencil and weights of every target from the sources
+     *
+     * Replaces the weights of any previous targets, so blocks of
+     * targets can be interpolated in turn while the tree of the
+     * sources is only built once.
+     */
+    void set_targets(const size_type        target_count,
+                     const coordinate_type* tx,
+                     const difference_type  txinc,
+                     const coordinate_type* ty,
+                     const difference_type  tyinc,
+                     const coordinate_type* tz,
+                     const difference_type  tzinc);
+
+    /**
+     * Interpolate one field from the sources to the targets
+     */
+    template<typename T>
+    void apply(const T* source_values, const difference_type sinc, T* target_values, const difference_type tinc) const;
+
+    /**
+     * Interpolate nvar fields from the sources to the targets together
+     *
+     * Field v of source i is source_values[i * sinc + v * svar] and of
+     * target t is target_values[t * tinc + v * tvar], so the layout of
+     * write_target_file is sinc = nvar and svar = 1. All fields of a
+     * target are summed in one pass over its weights.
+     */
+    template<typename T>
+    void apply(const size_type       nvar,
+               const T*              source_values,
+               const difference_type sinc,
+               const difference_type svar,
+               T*                    target_values,
+               const difference_type tinc,
+               const difference_type tvar) const;
+
+    size_type num_sources() const noexcept;
+    size_type num_targets() const noexcept;
+
+    /**
+     * CSR weight matrix of num_targets() rows by num_sources() columns
+     */
+    const std::vector<size_type>& offsets() const noexcept;
+    const std::vector<size_type>& columns() const noexcept;
+    const std::vector<double>&    weights() const noexcept;
+
+    /**
+     * Measured seconds spent finding and solving the stencil of each target
+     *
+     * The time of a batch is shared equally by its targets. Pass
+     * as the weights of Partition::rebalance to balance the work.
+     */
+    const std::vector<double>& costs() const noexcept;
+
+    // ----------------------------------------------------------
+    // [PRIVATE]
+    // ----------------------------------------------------------
+   private:
+    using index_type = hopi::spatial::TreeIndex<box_array, size_type>;  ///< Point values so Leafs hold a single corner
+    using splitting  = typename hopi::spatial::splitting_of<InputAdaptor>::type;  ///< InputAdaptor::rtree_splitting_type or Quadratic
+    using RTree      = hopi::spatial::RTree<index_type, hopi::spatial::ArenaAllocator<index_type>, splitting>;
+    using FrozenTree = hopi::spatial::FrozenRTree<index_type, hopi::spatial::ArenaAllocator<index_type>, splitting>;
+    using DeviceTree = OffloadTree<coordinate_type, NDim>;
+
+    static size_type num_polynomial(const int degree) noexcept;
+
+    size_type stencil_polynomial(const size_type stencil_size) const noexcept;
+
+    void assemble_stencil(const std::vector<box_array>& sources,
+                          const box_array&              target,
+                          const size_type*              stencil,
+                          const size_type               stencil_size,
+                          const size_type               width,
+                          const size_type               lane,
+                          double*                       matrix,
+                          double*                       rhs) const;
+
+    void solve_stencil(const std::vector<box_array>& sources,
+                       const box_array&              target,
+                       const size_type*              stencil,
+                       const size_type               stencil_size,
+                       std::vector<double>&          matrix,
+                       double*                       weight) const;
+
+    RBFOptions                m_options;
+    size_type                 m_num_sources = 0;
+    std::vector<box_array>    m_sources;  ///< Copy of the sources
+    std::optional<FrozenTree> m_tree;     ///< Tree of the sources (empty without sources)
+    std::vector<size_type> m_offsets;  ///< Start of each target row
+    std::vector<size_type> m_columns;  ///< Source of each weight
+    std::vector<double>    m_weights;  ///< Weight of each source within a row
+    std::vector<double>    m_costs;    ///< Measured seconds of each target
+
+    std::shared_ptr<const DeviceTree>    m_device_tree;     ///< Offloaded tree of the sources (RBFOptions::offload)
+    std::shared_ptr<const OffloadMatrix> m_device_weights;  ///< Offloaded weights of the targets (RBFOptions::offload)
+};
+
+template<typename A>
+RBFInterpolator<A>::RBFInterpolator(const RBFOptions& options) : m_options(options)
+{
+    assert((m_options.degree >= -1) and (m_options.degree <= 1));
+}
+
+template<typename A>
+typename RBFInterpolator<A>::size_type
+RBFInterpolator<A>::num_polynomial(const int degree) noexcept
+{
+    return (degree < 0) ? 0 : (degree == 0) ? 1 : 1 + NDim;
+}
+
+template<typename A>
+void
+RBFInterpolator<A>::setup(const size_type        source_count,
+                          const coordinate_type* sx,
+                          const difference_type  sxinc,
+                          const coordinate_type* sy,
+                          const difference_type  syinc,
+                          const coordinate_type* sz,
+                          const difference_type  szinc,
+                          const size_type        target_count,
+                          const coordinate_type* tx,
+                          const difference_type  txinc,
+                          const coordinate_type* ty,
+                          const difference_type  tyinc,
+                          const coordinate_type* tz,
+                          const difference_type  tzinc)
+{
+    HOPI_PROFILE_SCOPE("rbf.setup");
+    this->set_sources(source_count, sx, sxinc, sy, syinc, sz, szinc);
+    this->set_targets(target_count, tx, txinc, ty, tyinc, tz, tzinc);
+}
+
+template<typename A>
+void
+RBFInterpolator<A>::set_sources(const size_type        source_count,
+                                const coordinate_type* sx,
+                                const difference_type  sxinc,
+                                const coordinate_type* sy,
+                                const difference_type  syinc,
+                                const coordinate_type* sz,
+                                const difference_type  szinc)
+{
+    HOPI_PROFILE_SCOPE("rbf.sources");
+    const std::array<const coordinate_type*, 3> scoord = { sx, sy, sz };
+    const std::array<difference_type, 3>        sinc   = { sxinc, syinc, szinc };
+
+    // Copy & Index the Sources
+    m_sources.resize(source_count);
+    std::vector<index_type> indices(source_count);
+    for (size_type i = 0; i < source_count; ++i) {
+        for (size_type d = 0; d < NDim; ++d) {
+            m_sources[i][d] = scoord[d][i * sinc[d]];
+        }
+        indices[i] = index_type(m_sources[i], i);
+    }
+    m_num_sources = source_count;
+    m_tree.reset();
+    m_device_tree.reset();
+    m_device_weights.reset();
+    if (source_count > 0) {
+        m_tree.emplace(RTree(indices.begin(), indices.end(), hopi::spatial::STRPacking()));
+        if (m_options.offload) {
+            m_device_tree = std::make_shared<const DeviceTree>(m_tree->index());
+        }
+    }
+    m_offsets.assign(1, 0);
+    m_columns.clear();
+    m_weights.clear();
+}
+
+template<typename A>
+void
+RBFInterpolator<A>::set_targets(const size_type        target_count,
+                                const coordinate_type* tx,
+                                const difference_type  txinc,
+                                const coordinate_type* ty,
+                                const difference_type  tyinc,
+                                const coordinate_type* tz,
+                                const difference_type  tzinc)
+{
+    HOPI_PROFILE_SCOPE("rbf.targets");
+    const std::array<const coordinate_type*, 3> tcoord = { tx, ty, tz };
+    const std::array<difference_type, 3>        tinc   = { txinc, tyinc, tzinc };
+    const auto&                                 sources = m_sources;
+
+    // Copy Targets
+    std::vector<box_array> targets(target_count);
+    std::vector<box_type>  target_boxes(target_count);
+    for (size_type i = 0; i < target_count; ++i) {
+        for (size_type d = 0; d < NDim; ++d) {
+            targets[i][d] = tcoord[d][i * tinc[d]];
+        }
+        target_boxes[i] = box_type(targets[i], targets[i]);
+    }
+
+    // Find the Stencil of each Target
+    m_offsets.assign(target_count + 1, 0);
+    m_columns.clear();
+    m_weights.clear();
+    m_costs.assign(target_count, 0.0);
+    m_device_weights.reset();
+    if ((m_num_sources == 0) or (target_count == 0)) {
+        return;
+    }
+    const auto search_start = profile::clock::now();
+    const bool offload = m_device_tree and (m_options.neighbors <= DeviceTree::max_neighbors);
+    if (offload) {
+        HOPI_PROFILE_SCOPE("rbf.stencils");
+        m_device_tree->query_batch(target_count, targets.front().data(), m_options.neighbors, m_offsets, m_columns);
+    }
+    else {
+        HOPI_PROFILE_SCOPE("rbf.stencils");
+        std::vector<index_type> neighbors;
+        if ((sizeof(coordinate_type) < sizeof(double)) and (m_options.tie_candidates > 0)) {
+            m_tree->parallel_query_batch_exact(target_boxes, m_options.neighbors, m_offsets, neighbors, m_options.tie_candidates);
+        }
+        else {
+            m_tree->parallel_query_batch(target_boxes, m_options.neighbors, m_offsets, neighbors);
+        }
+        m_columns.resize(neighbors.size());
+        for (size_type n = 0; n < neighbors.size(); ++n) {
+            m_columns[n] = neighbors[n].second;
+        }
+    }
+    m_weights.resize(m_columns.size());
+
+    // Searches run as a single batch so each target gets an equal share
+    const std::chrono::duration<double> search_time = profile::clock::now() - search_start;
+    std::fill(m_costs.begin(), m_costs.end(), search_time.count() / double(target_count));
+
+    // Group Targets with equal sized Stencils into batches
+    constexpr size_type    width = solver_type::batch_size;
+    auto                   size  = [&](const size_type t) { return m_offsets[t + 1] - m_offsets[t]; };
+    std::vector<size_type> order(target_count);
+    std::iota(order.begin(), order.end(), size_type(0));
+    std::stable_sort(order.begin(), order.end(), [&](const auto a, const auto b) { return size(a) < size(b); });
+    std::vector<size_type> batch_offsets(1, 0);
+    for (size_type i = 1; i < target_count; ++i) {
+        if ((size(order[i]) != size(order[i - 1])) or ((i - batch_offsets.back()) == width)) {
+            batch_offsets.push_back(i);
+        }
+    }
+    batch_offsets.push_back(target_count);
+    const size_type num_batches = batch_offsets.size() - 1;
+
+    // Solve each batch for the weights of its Targets
+    HOPI_PROFILE_SCOPE("rbf.solve");
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+    {
+        std::vector<double>     matrix;
+        std::array<bool, width> ok;
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic, 4)
+#endif
+        for (size_type batch = 0; batch < num_batches; ++batch) {
+            const auto batch_start  = profile::clock::now();
+            const auto first        = batch_offsets[batch];
+            const auto count        = batch_offsets[batch + 1] - first;
+            const auto stencil_size = size(order[first]);
+            const auto np           = this->stencil_polynomial(stencil_size);
+            const auto n            = stencil_size + np;
+
+            matrix.assign(width * (n * n + n), 0.0);
+            double* rhs = matrix.data() + width * n * n;
+            for (size_type lane = 0; lane < count; ++lane) {
+                const auto t = order[first + lane];
+                this->assemble_stencil(sources, targets[t], m_columns.data() + m_offsets[t], stencil_size, width, lane,
+                                       matrix.data(), rhs);
+            }
+            solver_type::solve(n, np, count, matrix.data(), rhs, ok.data());
+
+            // Share the batch equally between its lanes
+            const std::chrono::duration<double> batch_time = profile::clock::now() - batch_start;
+            for (size_type lane = 0; lane < count; ++lane) {
+                const auto t      = order[first + lane];
+                double*    weight = m_weights.data() + m_offsets[t];
+                m_costs[t] += batch_time.count() / double(count);
+                if (ok[lane]) {
+                    for (size_type j = 0; j < stencil_size; ++j) {
+                        weight[j] = rhs[j * width + lane];
+                    }
+                }
+                else {
+                    const auto          solve_start = profile::clock::now();
+                    std::vector<double> scratch;
+                    this->solve_stencil(sources, targets[t], m_columns.data() + m_offsets[t], stencil_size, scratch, weight);
+                    m_costs[t] += std::chrono::duration<double>(profile::clock::now() - solve_start).count();
+                }
+            }
+        }
+    }
+    HOPI_PROFILE_COUNT("rbf.target_cost", std::accumulate(m_costs.begin(), m_costs.end(), 0.0));
+    if (offload) {
+        m_device_weights = std::make_shared<const OffloadMatrix>(m_offsets, m_columns, m_weights, m_num_sources);
+    }
+}
+
+template<typename A>
+typename RBFInterpolator<A>::size_type
+RBFInterpolator<A>::stencil_polynomial(const size_type stencil_size) const noexcept
+{
+    // Fewer sources than polynomial terms cannot be solved so
+    // drop the polynomial until the system is square
+    int degree = m_options.degree;
+    while ((degree >= 0) and (stencil_size < num_polynomial(degree))) {
+        --degree;
+    }
+    return num_polynomial(degree);
+}
+
+template<typename A>
+void
+RBFInterpolator<A>::assemble_stencil(const std::vector<box_array>& sources,
+                                     const box_array&              target,
+                                     const size_type*              stencil,
+                                     const size_type               stencil_size,
+                                     const size_type               width,
+                                     const size_type               lane,
+                                     double*                       matrix,
+                                     double*                       rhs) const
+{
+    const size_type np = this->stencil_polynomial(stencil_size);
+    const size_type n  = stencil_size + np;
+
+    // Center and scale the polynomial terms for conditioning
+    // - Always in double so float coordinates only round once
+    std::array<double, NDim> shift{};
+    for (size_type j = 0; j < stencil_size; ++j) {
+        for (size_type d = 0; d < NDim; ++d) {
+            shift[d] += double(sources[stencil[j]][d]);
+        }
+    }
+    double scale = 0;
+    for (size_type d = 0; d < NDim; ++d) {
+        shift[d] /= double(stencil_size);
+    }
+    for (size_type j = 0; j < stencil_size; ++j) {
+        for (size_type d = 0; d < NDim; ++d) {
+            scale = std::max(scale, std::abs(double(sources[stencil[j]][d]) - shift[d]));
+        }
+    }
+    scale = (scale > 0) ? scale : 1.0;
+
+    auto distance = [](const box_array& a, const box_array& b) {
+        double sum = 0;
+        for (size_type d = 0; d < NDim; ++d) {
+            const double diff = double(a[d]) - double(b[d]);
+            sum += diff * diff;
+        }
+        return std::sqrt(sum);
+    };
+    auto polynomial = [&](const box_array& point, double* row, const size_type inc) {
+        if (np > 0) {
+            row[0] = 1;
+        }
+        if (np > 1) {
+            for (size_type d = 0; d < NDim; ++d) {
+                row[(d + 1) * inc] = (double(point[d]) - shift[d]) / scale;
+            }
+        }
+    };
+
+    // Assemble [K P; P^T 0] into the lane of a zeroed interleaved batch
+    double* M = matrix + lane;
+    for (size_type i = 0; i < stencil_size; ++i) {
+        const auto& si = sources[stencil[i]];
+        for (size_type j = i; j < stencil_size; ++j) {
+            const double value = detail::rbf_kernel(m_options.kernel, m_options.epsilon, distance(si, sources[stencil[j]]));
+            M[(i * n + j) * width] = value;
+            M[(j * n + i) * width] = value;
+        }
+        M[(i * n + i) * width] += m_options.smoothing;
+        polynomial(si, &M[(i * n + stencil_size) * width], width);
+        polynomial(si, &M[(stencil_size * n + i) * width], n * width);
+    }
+
+    // Right hand side is the kernel row of the target
+    double* b = rhs + lane;
+    for (size_type j = 0; j < stencil_size; ++j) {
+        b[j * width] = detail::rbf_kernel(m_options.kernel, m_options.epsilon, distance(target, sources[stencil[j]]));
+    }
+    polynomial(target, b + stencil_size * width, width);
+}
+
+template<typename A>
+void
+RBFInterpolator<A>::solve_stencil(const std::vector<box_array>& sources,
+                                  const box_array&              target,
+                                  const size_type*              stencil,
+                                  const size_type               stencil_size,
+                                  std::vector<double>&          matrix,
+                                  double*                       weight) const
+{
+    const size_type n = stencil_size + this->stencil_polynomial(stencil_size);
+    matrix.assign(n * n + n, 0.0);
+    double* rhs = matrix.data() + n * n;
+    this->assemble_stencil(sources, target, stencil, stencil_size, 1, 0, matrix.data(), rhs);
+
+    if (not detail::dense_solve(n, matrix.data(), rhs)) {
+        // Singular stencil (ie. duplicate sources) falls back to the nearest
+        std::fill_n(rhs, n, 0.0);
+        rhs[0] = 1;
+    }
+    std::copy_n(rhs, stencil_size, weight);
+}
+
+template<typename A>
+template<typename T>
+void
+RBFInterpolator<A>::apply(const T* source_values, const difference_type sinc, T* target_values, const difference_type tinc) const
+{
+    HOPI_PROFILE_SCOPE("rbf.apply");
+    if (m_device_weights) {
+        m_device_weights->apply(1, source_values, sinc, 0, target_values, tinc, 0);
+        return;
+    }
+    const size_type target_count = this->num_targets();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_type t = 0; t < target_count; ++t) {
+        T sum = 0;
+        for (size_type n = m_offsets[t]; n < m_offsets[t + 1]; ++n) {
+            sum += T(m_weights[n]) * source_values[m_columns[n] * sinc];
+        }
+        target_values[t * tinc] = sum;
+    }
+}
+
+template<typename A>
+template<typename T>
+void
+RBFInterpolator<A>::apply(const size_type       nvar,
+                          const T*              source_values,
+                          const difference_type sinc,
+                          const difference_type svar,
+                          T*                    target_values,
+                          const difference_type tinc,
+                          const difference_type tvar) const
+{
+    HOPI_PROFILE_SCOPE("rbf.apply");
+    if (m_device_weights) {
+        m_device_weights->apply(nvar, source_values, sinc, svar, target_values, tinc, tvar);
+        return;
+    }
+    constexpr size_type field_block  = 64;
+    const size_type     target_count = this->num_targets();
+
+    // Pack the fields of each source together unless they already are
+    std::vector<T>  packed;
+    const T*        source = source_values;
+    difference_type stride = sinc;
+    if ((svar != 1) and (nvar > 1)) {
+        packed.resize(m_num_sources * nvar);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+        for (size_type i = 0; i < m_num_sources; ++i) {
+            for (size_type v = 0; v < nvar; ++v) {
+                packed[i * nvar + v] = source_values[i * sinc + v * svar];
+            }
+        }
+        source = packed.data();
+        stride = difference_type(nvar);
+    }
+
+    // Blocks of fields are summed while the weights of the target are in cache
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_type t = 0; t < target_count; ++t) {
+        for (size_type first = 0; first < nvar; first += field_block) {
+            const size_type            count = std::min(field_block, nvar - first);
+            std::array<T, field_block> sum;
+            std::fill_n(sum.begin(), count, T(0));
+            for (size_type n = m_offsets[t]; n < m_offsets[t + 1]; ++n) {
+                const T  weight = T(m_weights[n]);
+                const T* value  = source + m_columns[n] * stride + first;
+                for (size_type v = 0; v < count; ++v) {
+                    sum[v] += weight * value[v];
+                }
+            }
+            for (size_type v = 0; v < count; ++v) {
+                target_values[t * tinc + (first + v) * tvar] = sum[v];
+            }
+        }
+    }
+}
+
+template<typename A>
+typename RBFInterpolator<A>::size_type
+RBFInterpolator<A>::num_sources() const noexcept
+{
+    return m_num_sources;
+}
+
+template<typename A>
+typename RBFInterpolator<A>::size_type
+RBFInterpolator<A>::num_targets() const noexcept
+{
+    return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+}
+
+template<typename A>
+const std::vector<typename RBFInterpolator<A>::size_type>&
+RBFInterpolator<A>::offsets() const noexcept
+{
+    return m_offsets;
+}
+
+template<typename A>
+const std::vector<typename RBFInterpolator<A>::size_type>&
+RBFInterpolator<A>::columns() const noexcept
+{
+    return m_columns;
+}
+
+template<typename A>
+const std::vector<double>&
+RBFInterpolator<A>::weights() const noexcept
+{
+    return m_weights;
+}
+
+template<typename A>
+const std::vector<double>&
+RBFInterpolator<A>::costs() const noexcept
+{
+    return m_costs;
+}
+
+} /* namespace hopi */
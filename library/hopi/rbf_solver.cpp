@@ -0,0 +1,71 @@
+/// @file rbf_solver.cpp
+/*
+ * Project:         HOPI
+ * File:            rbf_solver.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/rbf_solver.hpp"
+
+#include <utility>
+
+namespace hopi {
+namespace detail {
+
+bool
+dense_solve(const std::size_t n, double* A, double* b)
+{
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t pivot = k;
+        for (std::size_t i = k + 1; i < n; ++i) {
+            if (std::abs(A[i * n + k]) > std::abs(A[pivot * n + k])) {
+                pivot = i;
+            }
+        }
+        if (A[pivot * n + k] == 0) {
+            return false;
+        }
+        if (pivot != k) {
+            std::swap_ranges(A + k * n, A + (k + 1) * n, A + pivot * n);
+            std::swap(b[k], b[pivot]);
+        }
+        const double inv = 1.0 / A[k * n + k];
+        for (std::size_t i = k + 1; i < n; ++i) {
+            const double f = A[i * n + k] * inv;
+            if (f == 0) {
+                continue;
+            }
+            for (std::size_t j = k + 1; j < n; ++j) {
+                A[i * n + j] -= f * A[k * n + j];
+            }
+            b[i] -= f * b[k];
+        }
+    }
+    for (std::size_t k = n; k-- > 0;) {
+        double sum = b[k];
+        for (std::size_t j = k + 1; j < n; ++j) {
+            sum -= A[k * n + j] * b[j];
+        }
+        b[k] = sum / A[k * n + k];
+    }
+    return true;
+}
+
+} // namespace detail
+
+void
+DenseLUSolver::solve(const std::size_t n, const std::size_t np, const std::size_t count, double* A, double* b, bool* ok)
+{
+    assert(count == batch_size);
+    (void)np;
+    (void)count;
+    ok[0] = detail::dense_solve(n, A, b);
+}
+
+} /* namespace hopi */
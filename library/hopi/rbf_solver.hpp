@@ -0,0 +1,519 @@
+/// @file rbf_solver.hpp
+/*
+ * Project:         HOPI
+ * File:            rbf_solver.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace hopi {
+
+/**
+ * Backends solving the augmented stencil systems of RBFInterpolator
+ *
+ * Each backend solves up to batch_size systems of the same size n
+ *
+ *     [K P; P^T 0] [w; c] = [f; g]
+ *
+ * where the last np rows and columns are the polynomial terms. The
+ * systems are interleaved so element (i,j) of system l is found at
+ * A[(i * n + j) * batch_size + l] and entry i of its right hand side
+ * at b[i * batch_size + l]. On return the first n - np entries of b
+ * hold w while A and the remainder of b are unspecified. Any system
+ * which could not be solved has its ok flag set false.
+ *
+ * The backend used by RBFInterpolator is chosen at compile time by
+ * the optional rbf_solver_type of the InputAdaptor.
+ */
+
+namespace detail {
+
+/**
+ * Solve the dense n x n system A x = b in place
+ *
+ * Gaussian elimination with partial pivoting since the polynomial
+ * augmented systems are indefinite. A is row major and is
+ * overwritten, b is replaced by x. Returns false if singular.
+ */
+bool dense_solve(const std::size_t n, double* A, double* b);
+
+} // namespace detail
+
+/**
+ * Solve each system by itself with pivoted LU
+ *
+ * Works for every kernel and degree so it is also the fallback
+ * for systems a batched backend could not solve.
+ */
+struct DenseLUSolver {
+    static constexpr std::size_t batch_size = 1;
+
+    static void solve(const std::size_t n, const std::size_t np, const std::size_t count, double* A, double* b, bool* ok);
+};
+
+/**
+ * Solve Width systems together with Cholesky
+ *
+ * Every operation is a loop over the interleaved systems so the
+ * compiler vectorizes across systems instead of within one.
+ *
+ * The indefinite system is not factored directly. Householder
+ * reflectors Q^T P = [R; 0] first remove the polynomial constraints
+ * leaving the kernel projected onto the null space of P^T, which is
+ * positive definite for the conditionally positive definite kernels
+ * when the degree is at least the order of the kernel (always for the
+ * Gaussian). It is then factored by Cholesky without pivoting so every
+ * system follows the same path. Systems for which this does not hold
+ * (ie. Quintic or duplicate sources) are flagged to fall back.
+ */
+template<std::size_t Width = 8>
+struct BatchedCholeskySolver {
+    static_assert(Width > 0);
+
+    static constexpr std::size_t batch_size = Width;
+
+    static void solve(const std::size_t n, const std::size_t np, const std::size_t count, double* A, double* b, bool* ok);
+};
+
+template<std::size_t Width>
+void
+BatchedCholeskySolver<Width>::solve(const std::size_t n, const std::size_t np, const std::size_t count, double* A, double* b, bool* ok)
+{
+    constexpr std::size_t W = Width;
+    assert((count > 0) and (count <= W));
+    assert(np <= n - np);
+
+    const std::size_t m         = np;
+    const std::size_t s         = n - np;  // Rows of K
+    const double      tolerance = double(n) * std::numeric_limits<double>::epsilon();
+
+    // Interleaved element accessors of A, b and the reflector scratch
+    // - Scratch is kept per thread so repeated batches do not allocate
+    thread_local std::vector<double> scratch;
+    scratch.assign((3 * s * m + 3 * m * m) * W, 0.0);
+    auto a = [=](const std::size_t i, const std::size_t j) noexcept { return A + (i * n + j) * W; };
+    auto x = [=](const std::size_t i) noexcept { return b + i * W; };
+    auto V = [&, m](const std::size_t i, const std::size_t k) noexcept { return scratch.data() + (i * m + k) * W; };
+    auto Y = [&, m, s](const std::size_t i, const std::size_t k) noexcept { return scratch.data() + ((s + i) * m + k) * W; };
+    auto Z = [&, m, s](const std::size_t i, const std::size_t k) noexcept { return scratch.data() + ((2 * s + i) * m + k) * W; };
+    auto T = [&, m, s](const std::size_t i, const std::size_t k) noexcept { return scratch.data() + (3 * s * m + i * m + k) * W; };
+    auto G = [&, m, s](const std::size_t i, const std::size_t k) noexcept { return scratch.data() + (3 * s * m + (m + i) * m + k) * W; };
+    auto H = [&, m, s](const std::size_t i, const std::size_t k) noexcept { return scratch.data() + (3 * s * m + (2 * m + i) * m + k) * W; };
+
+    // Unused systems repeat the first
+    for (std::size_t i = 0; i < n * n; ++i) {
+        std::fill(A + i * W + count, A + (i + 1) * W, A[i * W]);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        std::fill(b + i * W + count, b + (i + 1) * W, b[i * W]);
+    }
+
+    std::array<bool, W>   good;
+    std::array<double, W> sum;
+    std::array<double, W> tmp;
+    good.fill(true);
+
+    // Householder QR of P = Q [R; 0] with Q = I - V T V^T
+    // - R replaces the upper triangle of P
+    for (std::size_t k = 0; k < m; ++k) {
+        const std::size_t pk = s + k;
+
+        sum.fill(0);
+        for (std::size_t i = k; i < s; ++i) {
+            const double* p = a(i, pk);
+            for (std::size_t l = 0; l < W; ++l) {
+                sum[l] += p[l] * p[l];
+            }
+        }
+        double* tau = T(k, k);
+        double* pkk = a(k, pk);
+        for (std::size_t l = 0; l < W; ++l) {
+            const double norm  = std::sqrt(sum[l]);
+            const double alpha = -std::copysign(norm, pkk[l]);
+            good[l]            = good[l] and (norm > tolerance);
+            tau[l]             = (alpha - pkk[l]) / alpha;
+            tmp[l]             = 1.0 / (pkk[l] - alpha);
+            pkk[l]             = alpha;
+            V(k, k)[l]         = 1;
+        }
+        for (std::size_t i = k + 1; i < s; ++i) {
+            const double* p = a(i, pk);
+            double*       v = V(i, k);
+            for (std::size_t l = 0; l < W; ++l) {
+                v[l] = p[l] * tmp[l];
+            }
+        }
+
+        // Apply (I - tau v v^T) to the remaining columns of P
+        for (std::size_t j = k + 1; j < m; ++j) {
+            const std::size_t pj = s + j;
+            sum.fill(0);
+            for (std::size_t i = k; i < s; ++i) {
+                const double* v = V(i, k);
+                const double* p = a(i, pj);
+                for (std::size_t l = 0; l < W; ++l) {
+                    sum[l] += v[l] * p[l];
+                }
+            }
+            for (std::size_t l = 0; l < W; ++l) {
+                sum[l] *= tau[l];
+            }
+            for (std::size_t i = k; i < s; ++i) {
+                const double* v = V(i, k);
+                double*       p = a(i, pj);
+                for (std::size_t l = 0; l < W; ++l) {
+                    p[l] -= sum[l] * v[l];
+                }
+            }
+        }
+
+        // Column k of T is -tau T V^T v
+        for (std::size_t j = 0; j < k; ++j) {
+            double* g = G(j, 0);
+            std::fill_n(g, W, 0.0);
+            for (std::size_t i = k; i < s; ++i) {
+                const double* vj = V(i, j);
+                const double* vk = V(i, k);
+                for (std::size_t l = 0; l < W; ++l) {
+                    g[l] += vj[l] * vk[l];
+                }
+            }
+        }
+        for (std::size_t j = 0; j < k; ++j) {
+            double* tjk = T(j, k);
+            for (std::size_t c = j; c < k; ++c) {
+                const double* tjc = T(j, c);
+                const double* g   = G(c, 0);
+                for (std::size_t l = 0; l < W; ++l) {
+                    tjk[l] -= tau[l] * tjc[l] * g[l];
+                }
+            }
+        }
+    }
+
+    // Apply Q^T K Q = K - V Z^T - Z V^T
+    // - Y = K V T
+    // - Z = Y - (1/2) V T^T V^T Y
+    if (m > 0) {
+        for (std::size_t i = 0; i < s; ++i) {
+            for (std::size_t k = 0; k < m; ++k) {
+                sum.fill(0);
+                for (std::size_t j = k; j < s; ++j) {
+                    const double* kij = a(i, j);
+                    const double* v   = V(j, k);
+                    for (std::size_t l = 0; l < W; ++l) {
+                        sum[l] += kij[l] * v[l];
+                    }
+                }
+                std::copy_n(sum.begin(), W, Z(i, k));
+            }
+            for (std::size_t k = 0; k < m; ++k) {
+                double* y = Y(i, k);
+                std::fill_n(y, W, 0.0);
+                for (std::size_t c = 0; c <= k; ++c) {
+                    const double* kv = Z(i, c);
+                    const double* t  = T(c, k);
+                    for (std::size_t l = 0; l < W; ++l) {
+                        y[l] += kv[l] * t[l];
+                    }
+                }
+            }
+        }
+        for (std::size_t c = 0; c < m; ++c) {
+            for (std::size_t k = 0; k < m; ++k) {
+                double* g = G(c, k);
+                std::fill_n(g, W, 0.0);
+                for (std::size_t i = c; i < s; ++i) {
+                    const double* v = V(i, c);
+                    const double* y = Y(i, k);
+                    for (std::size_t l = 0; l < W; ++l) {
+                        g[l] += v[l] * y[l];
+                    }
+                }
+            }
+        }
+        for (std::size_t c = 0; c < m; ++c) {
+            for (std::size_t k = 0; k < m; ++k) {
+                double* h = H(c, k);
+                std::fill_n(h, W, 0.0);
+                for (std::size_t j = 0; j <= c; ++j) {
+                    const double* t = T(j, c);
+                    const double* g = G(j, k);
+                    for (std::size_t l = 0; l < W; ++l) {
+                        h[l] += 0.5 * t[l] * g[l];
+                    }
+                }
+            }
+        }
+        for (std::size_t i = 0; i < s; ++i) {
+            for (std::size_t k = 0; k < m; ++k) {
+                double* z = Z(i, k);
+                std::copy_n(Y(i, k), W, z);
+                for (std::size_t c = 0; c < m; ++c) {
+                    const double* v = V(i, c);
+                    const double* h = H(c, k);
+                    for (std::size_t l = 0; l < W; ++l) {
+                        z[l] -= v[l] * h[l];
+                    }
+                }
+            }
+        }
+
+        // Only the rows of the null space are needed, K_21 and the upper triangle of K_22
+        for (std::size_t i = m; i < s; ++i) {
+            auto update = [&](const std::size_t j) {
+                double* kij = a(i, j);
+                std::copy_n(kij, W, sum.begin());
+                for (std::size_t k = 0; k < m; ++k) {
+                    const double* vi = V(i, k);
+                    const double* zi = Z(i, k);
+                    const double* vj = V(j, k);
+                    const double* zj = Z(j, k);
+                    for (std::size_t l = 0; l < W; ++l) {
+                        sum[l] -= vi[l] * zj[l] + zi[l] * vj[l];
+                    }
+                }
+                std::copy_n(sum.begin(), W, kij);
+            };
+            for (std::size_t j = 0; j < m; ++j) {
+                update(j);
+            }
+            for (std::size_t j = i; j < s; ++j) {
+                update(j);
+            }
+        }
+
+        // Apply Q^T = I - V T^T V^T to f
+        for (std::size_t c = 0; c < m; ++c) {
+            double* g = G(c, 0);
+            std::fill_n(g, W, 0.0);
+            for (std::size_t i = c; i < s; ++i) {
+                const double* v = V(i, c);
+                for (std::size_t l = 0; l < W; ++l) {
+                    g[l] += v[l] * x(i)[l];
+                }
+            }
+        }
+        for (std::size_t c = 0; c < m; ++c) {
+            double* h = H(c, 0);
+            std::fill_n(h, W, 0.0);
+            for (std::size_t j = 0; j <= c; ++j) {
+                const double* t = T(j, c);
+                const double* g = G(j, 0);
+                for (std::size_t l = 0; l < W; ++l) {
+                    h[l] += t[l] * g[l];
+                }
+            }
+        }
+        for (std::size_t i = 0; i < s; ++i) {
+            double* f = x(i);
+            for (std::size_t c = 0; c < m; ++c) {
+                const double* v = V(i, c);
+                const double* h = H(c, 0);
+                for (std::size_t l = 0; l < W; ++l) {
+                    f[l] -= v[l] * h[l];
+                }
+            }
+        }
+    }
+
+    // Solve R^T u = g in place
+    for (std::size_t k = 0; k < m; ++k) {
+        double* u = x(s + k);
+        for (std::size_t j = 0; j < k; ++j) {
+            const double* r  = a(j, s + k);
+            const double* uj = x(s + j);
+            for (std::size_t l = 0; l < W; ++l) {
+                u[l] -= r[l] * uj[l];
+            }
+        }
+        const double* rkk = a(k, s + k);
+        for (std::size_t l = 0; l < W; ++l) {
+            u[l] /= rkk[l];
+        }
+    }
+
+    // Right hand side of the null space rows (Q^T f)_2 - K_21 u
+    for (std::size_t i = m; i < s; ++i) {
+        double* fi = x(i);
+        for (std::size_t j = 0; j < m; ++j) {
+            const double* kij = a(i, j);
+            const double* uj  = x(s + j);
+            for (std::size_t l = 0; l < W; ++l) {
+                fi[l] -= kij[l] * uj[l];
+            }
+        }
+    }
+
+    // Cholesky U^T U of K_22 one row at a time from the rows above
+    std::array<double, W> diag;
+    diag.fill(0);
+    for (std::size_t k = m; k < s; ++k) {
+        const double* kkk = a(k, k);
+        for (std::size_t l = 0; l < W; ++l) {
+            diag[l] = std::max(diag[l], std::abs(kkk[l]));
+        }
+    }
+    for (std::size_t i = m; i < s; ++i) {
+        double* uii = a(i, i);
+        std::copy_n(uii, W, tmp.begin());
+        for (std::size_t k = m; k < i; ++k) {
+            const double* uki = a(k, i);
+            for (std::size_t l = 0; l < W; ++l) {
+                tmp[l] -= uki[l] * uki[l];
+            }
+        }
+        for (std::size_t l = 0; l < W; ++l) {
+            good[l] = good[l] and (tmp[l] > tolerance * diag[l]);
+            uii[l]  = std::sqrt(std::abs(tmp[l]));
+            tmp[l]  = 1.0 / uii[l];
+        }
+
+        // Four columns at a time so each row above is loaded once
+        std::size_t j = i + 1;
+        for (; j + 4 <= s; j += 4) {
+            std::array<double, 4 * W> acc;
+            std::copy_n(a(i, j), 4 * W, acc.begin());
+            for (std::size_t k = m; k < i; ++k) {
+                const double* uki = a(k, i);
+                const double* ukj = a(k, j);
+                for (std::size_t c = 0; c < 4; ++c) {
+                    for (std::size_t l = 0; l < W; ++l) {
+                        acc[c * W + l] -= uki[l] * ukj[c * W + l];
+                    }
+                }
+            }
+            double* uij = a(i, j);
+            for (std::size_t c = 0; c < 4; ++c) {
+                for (std::size_t l = 0; l < W; ++l) {
+                    uij[c * W + l] = acc[c * W + l] * tmp[l];
+                }
+            }
+        }
+        for (; j < s; ++j) {
+            std::copy_n(a(i, j), W, sum.begin());
+            for (std::size_t k = m; k < i; ++k) {
+                const double* uki = a(k, i);
+                const double* ukj = a(k, j);
+                for (std::size_t l = 0; l < W; ++l) {
+                    sum[l] -= uki[l] * ukj[l];
+                }
+            }
+            double* uij = a(i, j);
+            for (std::size_t l = 0; l < W; ++l) {
+                uij[l] = sum[l] * tmp[l];
+            }
+        }
+    }
+
+    // Solve U^T z = r then U v = z in place
+    for (std::size_t i = m; i < s; ++i) {
+        std::copy_n(x(i), W, sum.begin());
+        for (std::size_t k = m; k < i; ++k) {
+            const double* uki = a(k, i);
+            const double* zk  = x(k);
+            for (std::size_t l = 0; l < W; ++l) {
+                sum[l] -= uki[l] * zk[l];
+            }
+        }
+        const double* uii = a(i, i);
+        for (std::size_t l = 0; l < W; ++l) {
+            x(i)[l] = sum[l] / uii[l];
+        }
+    }
+    for (std::size_t i = s; i-- > m;) {
+        std::copy_n(x(i), W, sum.begin());
+        for (std::size_t j = i + 1; j < s; ++j) {
+            const double* uij = a(i, j);
+            const double* vj  = x(j);
+            for (std::size_t l = 0; l < W; ++l) {
+                sum[l] -= uij[l] * vj[l];
+            }
+        }
+        const double* uii = a(i, i);
+        for (std::size_t l = 0; l < W; ++l) {
+            x(i)[l] = sum[l] / uii[l];
+        }
+    }
+
+    // Form w = Q [u; v] = (I - V T V^T) [u; v]
+    for (std::size_t k = 0; k < m; ++k) {
+        std::copy_n(x(s + k), W, x(k));
+    }
+    for (std::size_t c = 0; c < m; ++c) {
+        double* g = G(c, 0);
+        std::fill_n(g, W, 0.0);
+        for (std::size_t i = c; i < s; ++i) {
+            const double* v = V(i, c);
+            for (std::size_t l = 0; l < W; ++l) {
+                g[l] += v[l] * x(i)[l];
+            }
+        }
+    }
+    for (std::size_t c = 0; c < m; ++c) {
+        double* h = H(c, 0);
+        std::fill_n(h, W, 0.0);
+        for (std::size_t j = c; j < m; ++j) {
+            const double* t = T(c, j);
+            const double* g = G(j, 0);
+            for (std::size_t l = 0; l < W; ++l) {
+                h[l] += t[l] * g[l];
+            }
+        }
+    }
+    for (std::size_t i = 0; i < s; ++i) {
+        double* w = x(i);
+        for (std::size_t c = 0; c < m; ++c) {
+            const double* v = V(i, c);
+            const double* h = H(c, 0);
+            for (std::size_t l = 0; l < W; ++l) {
+                w[l] -= v[l] * h[l];
+            }
+        }
+    }
+
+    // Every weight must be finite
+    for (std::size_t i = 0; i < s; ++i) {
+        const double* w = x(i);
+        for (std::size_t l = 0; l < W; ++l) {
+            good[l] = good[l] and std::isfinite(w[l]);
+        }
+    }
+    std::copy_n(good.begin(), count, ok);
+}
+
+namespace detail {
+
+/**
+ * Backend selected by the InputAdaptor
+ *
+ * Defaults to BatchedCholeskySolver<> unless the InputAdaptor
+ * provides its own rbf_solver_type.
+ */
+template<typename InputAdaptor>
+struct rbf_solver {
+    using type = BatchedCholeskySolver<>;
+};
+
+template<typename InputAdaptor>
+    requires requires { typename InputAdaptor::rbf_solver_type; }
+struct rbf_solver<InputAdaptor> {
+    using type = typename InputAdaptor::rbf_solver_type;
+};
+
+} // namespace detail
+} /* namespace hopi */
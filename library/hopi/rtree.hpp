@@ -12,9 +12,14 @@
  */
 #pragma once
 
+#include "hopi/profile.hpp"
+#include "hopi/snapshot.hpp"
 #include "hopi/spatial/all.hpp"
 
-#include <utility> // std::pair
+#include <functional> // std::equal_to
+#include <memory>     // std::allocator, std::shared_ptr
+#include <string>     // std::string
+#include <utility>    // std::pair
 
 namespace hopi {
 namespace spatial {
@@ -28,6 +33,10 @@ struct pair_extractor {
 	const bound_type& operator()(PairType const& pair) const {
 		return pair.first;
 	}
+
+	const key_type& key(PairType const& pair) const {
+		return pair.second;
+	}
 };
 template<typename TupleType>
 struct tuple_extractor {
@@ -63,10 +72,117 @@ template<typename IndexType>
 using IndexExtractor = detail_extractor::pair_extractor<IndexType>;
 
 //
-// R-Tree Type
+// Bulk Loading Policies
+//
+using STRPacking     = shared::index::rtree::STRPacking;
+using HilbertPacking = shared::index::rtree::HilbertPacking;
+
+//
+// Node Storage Policies
+// - std::allocator stores each Node within a std::shared_ptr
+// - ArenaAllocator stores all Nodes within a pointer free Arena
 //
 template<typename IndexType>
-using RTree = shared::index::RTree<IndexType, IndexExtractor<IndexType>, shared::index::rtree::Quadratic<10,4>>;
+using ArenaAllocator = shared::index::rtree::ArenaAllocator<IndexType>;
+
+//
+// Node Splitting Policies
+// - Quadratic and Linear split by the least area (Guttman)
+// - RStar splits by margin and overlap with forced reinsertion
+//
+template<std::size_t MaxChildren, std::size_t MinChildren = MaxChildren/2>
+using Quadratic = shared::index::rtree::Quadratic<MaxChildren,MinChildren>;
+
+template<std::size_t MaxChildren, std::size_t MinChildren = MaxChildren/2>
+using Linear = shared::index::rtree::Linear<MaxChildren,MinChildren>;
+
+template<std::size_t MaxChildren, std::size_t MinChildren = (2*MaxChildren)/5>
+using RStar = shared::index::rtree::RStar<MaxChildren,MinChildren>;
+
+using DefaultSplitting = Quadratic<10,4>;
+
+//
+// Splitting Policy selected by an InputAdaptor
+// - InputAdaptor::rtree_splitting_type if provided
+// - DefaultSplitting otherwise
+//
+template<typename InputAdaptor>
+struct splitting_of {
+	using type = DefaultSplitting;
+};
+
+template<typename InputAdaptor>
+	requires requires { typename InputAdaptor::rtree_splitting_type; }
+struct splitting_of<InputAdaptor> {
+	using type = typename InputAdaptor::rtree_splitting_type;
+};
+
+//
+// R-Tree Type
+//
+template<typename IndexType, typename Allocator = std::allocator<IndexType>, typename Splitting = DefaultSplitting>
+using RTree = shared::index::RTree<IndexType,
+                                   IndexExtractor<IndexType>,
+                                   Splitting,
+                                   std::equal_to<IndexType>,
+                                   Allocator>;
+
+//
+// Read Only R-Tree Type which can be Queried by many Threads
+//
+template<typename IndexType, typename Allocator = std::allocator<IndexType>, typename Splitting = DefaultSplitting>
+using FrozenRTree = shared::index::Frozen<RTree<IndexType,Allocator,Splitting>>;
+
+//
+// Snapshots of R-Trees with ArenaAllocator storage
+// - The Pages and Leafs are written as is and queried in place
+//   within the mapped file when loaded
+//
+namespace detail_snapshot {
+template<typename Tree>
+constexpr std::uint64_t signature() noexcept {
+	const auto layout = Tree::snapshot_layout();
+	return ::hopi::snapshot_signature({layout[0], layout[1], layout[2], layout[3], layout[4], layout[5], layout[6]});
+}
+}
+
+/**
+ * Write the tree to a snapshot file
+ */
+template<typename Tree>
+void save_snapshot(const Tree& tree, const std::string& file_name) {
+	HOPI_PROFILE_SCOPE("rtree.save");
+	::hopi::SnapshotWriter writer(file_name, detail_snapshot::signature<Tree>());
+	tree.save(writer);
+	writer.close();
+}
+
+template<typename Tree>
+void save_snapshot(const shared::index::Frozen<Tree>& tree, const std::string& file_name) {
+	save_snapshot(tree.index(), file_name);
+}
+
+/**
+ * Replace the tree by the one within a snapshot file
+ *
+ * Exits with the file name if it was not saved from the same type.
+ */
+template<typename Tree>
+void load_snapshot(Tree& tree, const std::string& file_name) {
+	HOPI_PROFILE_SCOPE("rtree.load");
+	tree.view(std::make_shared<const ::hopi::MappedSnapshot>(file_name, detail_snapshot::signature<Tree>(), Tree::snapshot_sections));
+}
+
+/**
+ * Read only tree queried in place from a snapshot file
+ */
+template<typename FrozenTree>
+FrozenTree load_frozen_snapshot(const std::string& file_name) {
+	using index_type = typename FrozenTree::index_type;
+	auto index = std::make_shared<index_type>();
+	load_snapshot(*index, file_name);
+	return FrozenTree(std::shared_ptr<const index_type>(std::move(index)));
+}
 
 
 } // namespace spatial
@@ -0,0 +1,19 @@
+/// @file sfc_partition.cpp
+/*
+ * Project:         HOPI
+ * File:            sfc_partition.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/sfc_partition.hpp"
+
+namespace hopi {
+
+
+} /* namespace hopi */
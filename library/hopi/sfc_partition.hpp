@@ -0,0 +1,484 @@
+/// @file sfc_partition.hpp
+/*
+ * Project:         HOPI
+ * File:            sfc_partition.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/mpixx.hpp"
+#include "hopi/profile.hpp"
+#include "hopi/rtree.hpp"
+#include "hopi/spatial/common/space_filling_curve.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace hopi {
+
+/**
+ * Space filling curve used to order the points
+ */
+enum class SFCCurve { Morton, Hilbert };
+
+/**
+ * Options controlling how SFCPartition splits the curve
+ */
+struct SFCPartitionOptions {
+    SFCCurve    curve      = SFCCurve::Hilbert;
+    std::size_t num_bins   = 256;   ///< Histogram bins per window in each round (rounded up to a power of 2)
+    std::size_t max_rounds = 4;     ///< Maximum histogram rounds (ie. Allreduce calls)
+    double      tolerance  = 1e-3;  ///< Allowed weight error of a split as a fraction of the rank weight
+};
+
+/**
+ * Partition along a space filling curve
+ *
+ * Every point is given a 64 bit key along the curve through the
+ * global Box and each rank owns a contiguous range of keys holding
+ * an equal share of the weight. All splitters are found together
+ * from histograms of the keys so init uses a fixed number of
+ * collectives independent of the number of ranks instead of the
+ * log2(P) levels of Partition. The ranges are not Boxes so the
+ * bounds() of each rank may overlap.
+ *
+ * The keys of the points given to init are kept for reordering the
+ * local points (see keys() and order()).
+ */
+template<typename InputAdaptor>
+class SFCPartition final {
+    // ----------------------------------------------------------
+    // Types
+    // ----------------------------------------------------------
+    static constexpr auto NDim = InputAdaptor::NDim;
+    static_assert(NDim == 3, "SFCPartition takes the x, y and z coordinates of points");
+
+   public:
+    using size_type       = typename InputAdaptor::size_type;
+    using difference_type = typename InputAdaptor::difference_type;
+    using coordinate_type = typename InputAdaptor::coordinate_type;
+    using rank_type       = typename InputAdaptor::rank_type;
+    using weight_type     = typename InputAdaptor::weight_type;
+    using box_type        = hopi::spatial::BoundBox<coordinate_type, NDim>;
+    using box_array       = typename box_type::array_type;
+    using key_type        = hopi::spatial::sfc::key_type;
+
+    // ----------------------------------------------------------
+    // Constructors and Operators
+    // ----------------------------------------------------------
+   public:
+    SFCPartition()                          = delete;
+    SFCPartition(const SFCPartition& other) = default;
+    SFCPartition(SFCPartition&& other)      = default;
+    ~SFCPartition()                         = default;
+    SFCPartition& operator=(const SFCPartition& other) = default;
+    SFCPartition& operator=(SFCPartition&& other)      = default;
+
+    SFCPartition(const mpixx::communicator& comm, const SFCPartitionOptions& options = SFCPartitionOptions());
+
+    // ----------------------------------------------------------
+    // Methods
+    // ----------------------------------------------------------
+   public:
+    void init(const size_type        local_count,
+              const coordinate_type* x,
+              const difference_type  xinc,
+              const coordinate_type* y,
+              const difference_type  yinc,
+              const coordinate_type* z,
+              const difference_type  zinc,
+              const weight_type*     w,
+              const difference_type  winc);
+
+    void report(const size_type        local_count,
+                const coordinate_type* x,
+                const difference_type  xinc,
+                const coordinate_type* y,
+                const difference_type  yinc,
+                const coordinate_type* z,
+                const difference_type  zinc,
+                const weight_type*     w,
+                const difference_type  winc) const;
+
+    /**
+     * Communicator of all ranks within the Partition
+     */
+    const mpixx::communicator& comm() const noexcept { return m_comm; }
+
+    /**
+     * Bound of the points owned by each rank (valid after init)
+     *
+     * Ranks owning no points have a reset Box.
+     */
+    const std::vector<box_type>& bounds() const noexcept { return m_bounds; }
+
+    /**
+     * First key owned by each rank above rank 0 (valid after init)
+     *
+     * Rank r owns the keys within [splitters[r-1], splitters[r]).
+     */
+    const std::vector<key_type>& splitters() const noexcept { return m_splitters; }
+
+    /**
+     * Key of a location along the curve through the global Box
+     */
+    key_type key(const box_array& point) const noexcept;
+
+    /**
+     * Rank owning a location
+     *
+     * Binary search of the splitters in O(log P).
+     */
+    rank_type owner(const box_array& point) const noexcept;
+
+    /**
+     * Keys of the points given to init in input order
+     */
+    const std::vector<key_type>& keys() const noexcept { return m_keys; }
+
+    /**
+     * Indices of the points given to init in curve order
+     *
+     * Points taken in this order are compact in space which suits
+     * both bulk loading a tree and batches of queries. Sorted from
+     * keys() on each call since init does not need the order.
+     */
+    std::vector<size_type> order() const;
+
+    // ----------------------------------------------------------
+    // [PRIVATE]
+    // ----------------------------------------------------------
+   private:
+    std::vector<key_type> find_splitters(const std::vector<weight_type>& weight) const;
+
+    mpixx::communicator    m_comm;        ///< Communicator for everyone participating
+    SFCPartitionOptions    m_options;     ///< Options controlling the splits
+    box_type               m_domain;      ///< Global Box the keys are calculated within
+    std::vector<key_type>  m_splitters;   ///< First key of ranks [1,P)
+    std::vector<box_type>  m_bounds;      ///< Bound of the points owned by each rank
+    std::vector<key_type>  m_keys;        ///< Key of each point given to init
+};
+
+template<typename A>
+SFCPartition<A>::SFCPartition(const mpixx::communicator& comm, const SFCPartitionOptions& options) : m_comm(comm), m_options(options)
+{
+    m_domain.reset();
+}
+
+template<typename A>
+typename SFCPartition<A>::key_type
+SFCPartition<A>::key(const box_array& point) const noexcept
+{
+    namespace sfc = hopi::spatial::sfc;
+    if (m_options.curve == SFCCurve::Morton) {
+        return sfc::key(point, m_domain.min_corner(), m_domain.max_corner(), sfc::morton_tag());
+    }
+    return sfc::key(point, m_domain.min_corner(), m_domain.max_corner(), sfc::hilbert_tag());
+}
+
+template<typename A>
+typename SFCPartition<A>::rank_type
+SFCPartition<A>::owner(const box_array& point) const noexcept
+{
+    const auto it = std::upper_bound(m_splitters.begin(), m_splitters.end(), this->key(point));
+    return rank_type(std::distance(m_splitters.begin(), it));
+}
+
+template<typename A>
+std::vector<typename SFCPartition<A>::size_type>
+SFCPartition<A>::order() const
+{
+    std::vector<std::pair<key_type, size_type>> sorted(m_keys.size());
+    for (size_type i = 0; i < m_keys.size(); ++i) {
+        sorted[i] = { m_keys[i], i };
+    }
+    hopi::spatial::sfc::sort_keys(sorted);
+
+    std::vector<size_type> ans(sorted.size());
+    for (size_type n = 0; n < sorted.size(); ++n) {
+        ans[n] = sorted[n].second;
+    }
+    return ans;
+}
+
+template<typename A>
+void
+SFCPartition<A>::init(const size_type        local_count,
+                      const coordinate_type* x,
+                      const difference_type  xinc,
+                      const coordinate_type* y,
+                      const difference_type  yinc,
+                      const coordinate_type* z,
+                      const difference_type  zinc,
+                      const weight_type*     w,
+                      const difference_type  winc)
+{
+    HOPI_PROFILE_SCOPE("sfc_partition.init");
+
+    // Copy the Points and get their Bounding Box
+    std::vector<box_array> points(local_count);
+    box_type               my_bound;
+    my_bound.reset();
+    for (size_type i = 0; i < local_count; ++i) {
+        points[i] = { x[i * xinc], y[i * yinc], z[i * zinc] };
+        my_bound.stretch(box_type(points[i], points[i]));
+    }
+
+    // Start gathering the Bounding Box of all Ranks
+    std::vector<box_type> bounds_by_rank;
+    auto                  bounds_request = mpixx::iall_gather(m_comm, my_bound, bounds_by_rank);
+
+    // Copy the Weights or assign 1
+    std::vector<weight_type> weight(local_count, 1);
+    if (nullptr != w) {
+        for (size_type i = 0; i < local_count; ++i) {
+            weight[i] = w[i * winc];
+        }
+    }
+    m_keys.resize(local_count);
+
+    // Global Bounding Box for all Ranks
+    bounds_request.wait();
+    m_domain = bounds_by_rank[0];
+    for (size_type i = 1; i < bounds_by_rank.size(); ++i) {
+        m_domain.stretch(bounds_by_rank[i]);
+    }
+
+    // Key of each Point
+    if (m_options.curve == SFCCurve::Morton) {
+        hopi::spatial::sfc::keys(std::span<const box_array>(points), m_domain.min_corner(), m_domain.max_corner(), std::span<key_type>(m_keys),
+                                 hopi::spatial::sfc::morton_tag());
+    }
+    else {
+        hopi::spatial::sfc::keys(std::span<const box_array>(points), m_domain.min_corner(), m_domain.max_corner(), std::span<key_type>(m_keys),
+                                 hopi::spatial::sfc::hilbert_tag());
+    }
+
+    m_splitters = this->find_splitters(weight);
+
+    // Bound the Points owned by each Rank
+    // - Max is negated so both corners reduce with one MPI_MIN
+    const size_type              num_ranks = m_comm.size();
+    std::vector<coordinate_type> local_corners(2 * num_ranks * NDim, std::numeric_limits<coordinate_type>::max());
+    for (size_type i = 0; i < local_count; ++i) {
+        const auto rank  = size_type(std::distance(m_splitters.begin(), std::upper_bound(m_splitters.begin(), m_splitters.end(), m_keys[i])));
+        auto*      lower = local_corners.data() + 2 * rank * NDim;
+        auto*      upper = lower + NDim;
+        for (size_type d = 0; d < NDim; ++d) {
+            lower[d] = std::min(lower[d], points[i][d]);
+            upper[d] = std::min(upper[d], -points[i][d]);
+        }
+    }
+    std::vector<coordinate_type> global_corners(local_corners.size());
+    mpixx::all_reduce(m_comm, local_corners.data(), int(local_corners.size()), global_corners.data(), MPI_MIN);
+
+    m_bounds.resize(num_ranks);
+    for (size_type rank = 0; rank < num_ranks; ++rank) {
+        box_array min_corner;
+        box_array max_corner;
+        for (size_type d = 0; d < NDim; ++d) {
+            min_corner[d] = global_corners[2 * rank * NDim + d];
+            max_corner[d] = -global_corners[2 * rank * NDim + NDim + d];
+        }
+        m_bounds[rank].reset();
+        if (min_corner[0] <= max_corner[0]) {
+            m_bounds[rank].set(min_corner, max_corner);
+        }
+    }
+}
+
+/**
+ * Find the first key of each rank from histograms
+ *
+ * Every round bins the weight of my keys within the search window of
+ * each unresolved splitter and sums all histograms with one Allreduce.
+ * The windows are disjoint so each key is placed by one binary search
+ * and the keys are never sorted. The first round has a single window
+ * over every key so also gives the total weight. Splitters falling
+ * within the same bin share the window of the next round. A splitter
+ * is resolved once its bin holds less than the tolerance, is a single
+ * key or the maximum rounds are used, and is then interpolated within
+ * the bin.
+ */
+template<typename A>
+std::vector<typename SFCPartition<A>::key_type>
+SFCPartition<A>::find_splitters(const std::vector<weight_type>& weight) const
+{
+    HOPI_PROFILE_SCOPE("sfc_partition.find_splitters");
+    constexpr unsigned key_bits   = hopi::spatial::sfc::bits_per_dimension<NDim> * NDim;
+    const unsigned     bin_bits   = unsigned(std::bit_width(std::max<size_type>(m_options.num_bins, 2) - 1));
+    const size_type    num_bins   = size_type(1) << bin_bits;
+    const size_type    num_split  = m_comm.size() - 1;
+    const size_type    max_rounds = std::max<size_type>(m_options.max_rounds, 1);
+
+    // Last key of a window of 2^bits keys starting at lo
+    auto window_last = [](const key_type lo, const unsigned bits) {
+        return (bits >= 64) ? ~key_type(0) : lo + ((key_type(1) << bits) - 1);
+    };
+
+    // Search window & state of each splitter
+    // - window_min/bits = Histogram spans the 2^bits keys from window_min
+    // - weight_below    = Global weight below the window
+    // - weight_target   = Global weight which should be below the splitter
+    std::vector<key_type> splitter(num_split, 0);
+    std::vector<key_type> window_min(num_split, 0);
+    std::vector<unsigned> window_bits(num_split, key_bits);
+    std::vector<double>   weight_below(num_split, 0);
+    std::vector<double>   weight_target(num_split, 0);
+    double                weight_allowed = 0;
+
+    // Splitters which have not been found in increasing order
+    std::vector<size_type> active(num_split);
+    std::iota(std::begin(active), std::end(active), size_type(0));
+
+    for (size_type round = 0; active.size() > 0; ++round) {
+
+        // Unique windows of the active splitters
+        // - Windows of increasing splitters never decrease so equal windows are adjacent
+        std::vector<key_type>  window_lo;
+        std::vector<key_type>  window_hi;
+        std::vector<unsigned>  bin_shift;
+        std::vector<size_type> window_of(active.size());
+        for (size_type a = 0; a < active.size(); ++a) {
+            const auto s = active[a];
+            if (window_lo.empty() or (window_lo.back() != window_min[s])) {
+                window_lo.push_back(window_min[s]);
+                window_hi.push_back(window_last(window_min[s], window_bits[s]));
+                bin_shift.push_back((window_bits[s] > bin_bits) ? window_bits[s] - bin_bits : 0);
+            }
+            window_of[a] = window_lo.size() - 1;
+        }
+
+        // Bin the weight of my keys within each window
+        // - Windows are disjoint bins of the last round so a key is in at most one
+        // - Windows and bins are powers of 2 keys wide so a bin is a shift
+        std::vector<double> local_histogram(window_lo.size() * num_bins, 0);
+        for (size_type i = 0; i < m_keys.size(); ++i) {
+            const auto key = m_keys[i];
+            const auto n   = size_type(std::distance(window_lo.begin(), std::upper_bound(window_lo.begin(), window_lo.end(), key)));
+            if ((n == 0) or (key > window_hi[n - 1])) {
+                continue;
+            }
+            local_histogram[(n - 1) * num_bins + ((key - window_lo[n - 1]) >> bin_shift[n - 1])] += double(weight[i]);
+        }
+
+        // Sum Across All Processors
+        std::vector<double> global_histogram(local_histogram.size());
+        mpixx::all_reduce(m_comm, local_histogram.data(), int(local_histogram.size()), global_histogram.data(), std::plus<double>());
+
+        // First round covers every key so sets the targets
+        if (round == 0) {
+            const auto total_weight = std::accumulate(global_histogram.begin(), global_histogram.end(), double(0));
+            if (total_weight <= 0) {
+                for (size_type s = 0; s < num_split; ++s) {
+                    splitter[s] = key_type(double(window_last(0, key_bits)) * double(s + 1) / double(num_split + 1));
+                }
+                break;
+            }
+            for (size_type s = 0; s < num_split; ++s) {
+                weight_target[s] = total_weight * double(s + 1) / double(num_split + 1);
+            }
+            weight_allowed = m_options.tolerance * total_weight / double(num_split + 1);
+        }
+
+        // Find the bin holding the target of each splitter
+        std::vector<size_type> still_active;
+        for (size_type a = 0; a < active.size(); ++a) {
+            const auto    s         = active[a];
+            const auto    shift     = bin_shift[window_of[a]];
+            const auto    used_bins = size_type(1) << (window_bits[s] - shift);
+            const double* histogram = global_histogram.data() + window_of[a] * num_bins;
+
+            size_type bin         = 0;
+            double    running_sum = weight_below[s];
+            while ((bin < used_bins - 1) and (running_sum + histogram[bin] <= weight_target[s])) {
+                running_sum += histogram[bin];
+                ++bin;
+            }
+            const auto bin_min = window_min[s] + (key_type(bin) << shift);
+            const auto bin_max = window_last(bin_min, shift);
+
+            if ((histogram[bin] <= weight_allowed) or (shift == 0) or (round + 1 >= max_rounds)) {
+                auto fraction = 0.5;
+                if (histogram[bin] > 0) {
+                    fraction = std::clamp((weight_target[s] - running_sum) / histogram[bin], 0.0, 1.0);
+                }
+                splitter[s] = bin_min + key_type(fraction * double(bin_max - bin_min));
+            }
+            else {
+                window_min[s]   = bin_min;
+                window_bits[s]  = shift;
+                weight_below[s] = running_sum;
+                still_active.push_back(s);
+            }
+        }
+        active = std::move(still_active);
+    }
+
+    // Interpolation within a shared bin could cross
+    for (size_type s = 1; s < num_split; ++s) {
+        splitter[s] = std::max(splitter[s], splitter[s - 1]);
+    }
+    return splitter;
+}
+
+template<typename A>
+void
+SFCPartition<A>::report(const size_type        local_count,
+                        const coordinate_type* x,
+                        const difference_type  xinc,
+                        const coordinate_type* y,
+                        const difference_type  yinc,
+                        const coordinate_type* z,
+                        const difference_type  zinc,
+                        const weight_type*     w,
+                        const difference_type  winc) const
+{
+    HOPI_PROFILE_SCOPE("sfc_partition.report");
+
+    // Sum my weight owned by each rank
+    std::vector<weight_type> local_weight_total(m_comm.size(), 0);
+    for (size_type i = 0; i < local_count; ++i) {
+        const box_array point = { x[i * xinc], y[i * yinc], z[i * zinc] };
+        local_weight_total[this->owner(point)] += (nullptr == w) ? weight_type(1) : w[i * winc];
+    }
+
+    // Reduce (ie. sum) the weights across all Ranks
+    std::vector<weight_type> global_weight_total(local_weight_total.size());
+    mpixx::all_reduce(m_comm, local_weight_total.data(), int(local_weight_total.size()), global_weight_total.data(), MPI_SUM);
+
+    const auto minmax_weight = std::minmax_element(global_weight_total.begin(), global_weight_total.end());
+    const auto sum_weight    = std::accumulate(global_weight_total.begin(), global_weight_total.end(), weight_type(0));
+    const auto weight_ratio  = (*minmax_weight.second - *minmax_weight.first) / sum_weight;
+    const auto weight_imbal  = *minmax_weight.second / *minmax_weight.first;
+
+    if (m_comm.rank() == 0) {
+        std::cout << "P:" << m_comm.rank() << "\n";
+        std::cout << "    Total Ranges     = " << m_comm.size() << "\n";
+        std::cout << "    Minimum Weight   = " << *minmax_weight.first << "\n";
+        std::cout << "    Maximum Weight   = " << *minmax_weight.second << "\n";
+        std::cout << "    Weight Ratio     = " << weight_ratio << "\n";
+        std::cout << "    Weight Imbalance = " << weight_imbal << "\n";
+        std::cout << std::flush;
+    }
+    m_comm.barrier();
+}
+
+} /* namespace hopi */
@@ -0,0 +1,218 @@
+/// @file snapshot.cpp
+/*
+ * Project:         HOPI
+ * File:            snapshot.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/snapshot.hpp"
+#include "hopi/profile.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hopi {
+
+namespace {
+
+[[noreturn]] void
+snapshot_file_error(const std::string& message, const std::string& file_name)
+{
+    std::cerr << "ERROR: " << message << std::endl;
+    std::cerr << "Filename: " << file_name << std::endl;
+    std::exit(EXIT_FAILURE);
+}
+
+std::uint64_t
+round_up(const std::uint64_t bytes, const std::uint64_t alignment)
+{
+    return ((bytes + alignment - 1) / alignment) * alignment;
+}
+
+}  // namespace
+
+SnapshotWriter::SnapshotWriter(const std::string& file_name, const std::uint64_t signature)
+    : m_file_name(file_name), m_file(file_name, std::ios::binary | std::ios::trunc)
+{
+    if (not m_file) {
+        snapshot_file_error("File Did Not Open", m_file_name);
+    }
+    std::memcpy(m_header.magic, SnapshotHeader::magic_value, sizeof(m_header.magic));
+    m_header.version      = SnapshotHeader::version_value;
+    m_header.header_bytes = sizeof(SnapshotHeader);
+    m_header.byte_order   = SnapshotHeader::byte_order_value;
+    m_header.signature    = signature;
+
+    // Room for the header which is written by close
+    const std::vector<char> padding(sizeof(SnapshotHeader), 0);
+    m_file.write(padding.data(), std::streamsize(padding.size()));
+    m_position = sizeof(SnapshotHeader);
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    if (m_file.is_open()) {
+        this->close();
+    }
+}
+
+void
+SnapshotWriter::begin_section()
+{
+    assert(not m_in_section);
+    if (m_header.num_sections == SnapshotHeader::max_sections) {
+        snapshot_file_error("Too Many Snapshot Sections", m_file_name);
+    }
+    const auto              offset = round_up(m_position, SnapshotHeader::alignment_value);
+    const std::vector<char> padding(offset - m_position, 0);
+    m_file.write(padding.data(), std::streamsize(padding.size()));
+    m_position = offset;
+
+    m_header.section_offset[m_header.num_sections] = offset;
+    m_header.section_bytes[m_header.num_sections]  = 0;
+    m_in_section                                   = true;
+}
+
+void
+SnapshotWriter::write(const void* data, const std::size_t bytes)
+{
+    assert(m_in_section);
+    m_file.write(static_cast<const char*>(data), std::streamsize(bytes));
+    m_header.section_bytes[m_header.num_sections] += bytes;
+    m_position += bytes;
+}
+
+void
+SnapshotWriter::end_section()
+{
+    assert(m_in_section);
+    ++m_header.num_sections;
+    m_in_section = false;
+}
+
+void
+SnapshotWriter::close()
+{
+    HOPI_PROFILE_SCOPE("io.write_snapshot");
+    assert(not m_in_section);
+    m_header.file_bytes = m_position;
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    if (not m_file) {
+        snapshot_file_error("File Write Failed", m_file_name);
+    }
+    m_file.close();
+}
+
+MappedSnapshot::MappedSnapshot(const std::string& file_name, const std::uint64_t signature)
+{
+    HOPI_PROFILE_SCOPE("io.map_snapshot");
+    const int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        snapshot_file_error("File Did Not Open", file_name);
+    }
+
+    struct stat file_stat;
+    if ((::fstat(fd, &file_stat) != 0) or (std::size_t(file_stat.st_size) < sizeof(SnapshotHeader))) {
+        ::close(fd);
+        snapshot_file_error("File Too Small For Header", file_name);
+    }
+    m_bytes = std::size_t(file_stat.st_size);
+
+    void* map = ::mmap(nullptr, m_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        m_bytes = 0;
+        snapshot_file_error("File Did Not Map", file_name);
+    }
+    m_data = static_cast<std::byte*>(map);
+
+    // Check the Header
+    const auto& head = this->header();
+    if (std::memcmp(head.magic, SnapshotHeader::magic_value, sizeof(head.magic)) != 0) {
+        snapshot_file_error("Not A HOPI Snapshot File", file_name);
+    }
+    if (head.version > SnapshotHeader::version_value) {
+        snapshot_file_error("Unsupported HOPI Snapshot Version", file_name);
+    }
+    if (head.byte_order != SnapshotHeader::byte_order_value) {
+        snapshot_file_error("Wrong Byte Order In File", file_name);
+    }
+    if (head.signature != signature) {
+        snapshot_file_error("Snapshot Was Saved From A Different Type", file_name);
+    }
+    if ((head.num_sections > SnapshotHeader::max_sections) or (head.file_bytes > m_bytes)) {
+        snapshot_file_error("File Is Truncated", file_name);
+    }
+    for (std::size_t i = 0; i < head.num_sections; ++i) {
+        if (head.section_offset[i] + head.section_bytes[i] > head.file_bytes) {
+            snapshot_file_error("File Is Truncated", file_name);
+        }
+    }
+}
+
+MappedSnapshot::MappedSnapshot(const std::string& file_name, const std::uint64_t signature, const std::size_t num_sections)
+    : MappedSnapshot(file_name, signature)
+{
+    if (this->size() != num_sections) {
+        snapshot_file_error("Snapshot Has Wrong Number Of Sections", file_name);
+    }
+}
+
+MappedSnapshot::MappedSnapshot(MappedSnapshot&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_bytes(std::exchange(other.m_bytes, 0))
+{
+}
+
+MappedSnapshot&
+MappedSnapshot::operator=(MappedSnapshot&& other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_bytes, other.m_bytes);
+    return *this;
+}
+
+MappedSnapshot::~MappedSnapshot()
+{
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_bytes);
+    }
+}
+
+const SnapshotHeader&
+MappedSnapshot::header() const noexcept
+{
+    return *reinterpret_cast<const SnapshotHeader*>(m_data);
+}
+
+std::size_t
+MappedSnapshot::size() const noexcept
+{
+    return this->header().num_sections;
+}
+
+std::span<std::byte>
+MappedSnapshot::section(const std::size_t index) const noexcept
+{
+    const auto& head = this->header();
+    if (index >= head.num_sections) {
+        return std::span<std::byte>();
+    }
+    return std::span<std::byte>(m_data + head.section_offset[index], head.section_bytes[index]);
+}
+
+} /* namespace hopi */
@@ -0,0 +1,153 @@
+/// @file snapshot.hpp
+/*
+ * Project:         HOPI
+ * File:            snapshot.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <span>
+#include <string>
+
+namespace hopi {
+
+/// Header of a HOPI Snapshot File
+/**
+ * The header is followed by num_sections blocks of raw bytes,
+ * each starting on a multiple of alignment so a mapped section
+ * can be used in place as an array of the saved records.
+ *
+ * The signature records the layout of the saved type so a
+ * snapshot is only ever mapped by the type which wrote it.
+ * Values are in native byte order which is recorded in byte_order.
+ */
+struct SnapshotHeader {
+    static constexpr char          magic_value[8]   = { 'H', 'O', 'P', 'I', 'S', 'N', 'A', 'P' };
+    static constexpr std::uint32_t version_value    = 1;
+    static constexpr std::uint32_t byte_order_value = 0x01020304;
+    static constexpr std::uint64_t alignment_value  = 64;
+    static constexpr std::size_t   max_sections     = 12;
+
+    char          magic[8];                       ///< Always magic_value
+    std::uint32_t version;                        ///< Format version
+    std::uint32_t header_bytes;                   ///< Size of this header in bytes
+    std::uint32_t byte_order;                     ///< Reads as byte_order_value on a matching machine
+    std::uint32_t num_sections;                   ///< Number of sections written
+    std::uint64_t signature;                      ///< Layout of the saved type
+    std::uint64_t file_bytes;                     ///< Size of the whole file
+    std::uint64_t section_offset[max_sections];   ///< Byte offset of each section
+    std::uint64_t section_bytes[max_sections];    ///< Bytes within each section
+    std::uint64_t reserved[3];                    ///< Zero, room for later fields
+};
+static_assert(sizeof(SnapshotHeader) == 256, "Snapshot header must stay 256 bytes");
+
+/// Signature of a saved type from the numbers describing its layout
+/**
+ * FNV-1a hash of the numbers (ie. record sizes and capacities)
+ */
+constexpr std::uint64_t
+snapshot_signature(std::initializer_list<std::uint64_t> layout) noexcept
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (auto number : layout) {
+        for (int byte = 0; byte < 8; ++byte) {
+            hash ^= (number >> (8 * byte)) & 0xFF;
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash;
+}
+
+/// Sequential writer of a HOPI Snapshot File
+/**
+ * Sections are written in order between begin_section and
+ * end_section. The header is written last by close.
+ */
+class SnapshotWriter final {
+   public:
+    SnapshotWriter()                            = delete;
+    SnapshotWriter(const SnapshotWriter& other) = delete;
+    SnapshotWriter(const std::string& file_name, const std::uint64_t signature);
+    ~SnapshotWriter();
+
+    SnapshotWriter& operator=(const SnapshotWriter& other) = delete;
+
+    void begin_section();
+    void write(const void* data, const std::size_t bytes);
+    void end_section();
+
+    /// Write a whole section of trivially copyable values
+    template<typename T>
+    void
+    write_section(std::span<const T> values)
+    {
+        this->begin_section();
+        this->write(values.data(), values.size_bytes());
+        this->end_section();
+    }
+
+    /// Write the header and close the file
+    void close();
+
+   private:
+    std::string    m_file_name;
+    std::ofstream  m_file;
+    SnapshotHeader m_header{};
+    std::uint64_t  m_position   = 0;      ///< Bytes written so far
+    bool           m_in_section = false;  ///< Between begin_section and end_section
+};
+
+/// Memory Map of a HOPI Snapshot File
+/**
+ * The file is mapped copy on write so sections can be used in
+ * place as mutable arrays without ever changing the file. Pages
+ * are only read from disk when first touched so opening costs
+ * the same regardless of the size of the file.
+ */
+class MappedSnapshot final {
+   public:
+    MappedSnapshot()                            = delete;
+    MappedSnapshot(const MappedSnapshot& other) = delete;
+    MappedSnapshot(MappedSnapshot&& other) noexcept;
+    MappedSnapshot(const std::string& file_name, const std::uint64_t signature);
+
+    /// Map a snapshot which must hold exactly num_sections sections
+    MappedSnapshot(const std::string& file_name, const std::uint64_t signature, const std::size_t num_sections);
+    ~MappedSnapshot();
+
+    MappedSnapshot& operator=(const MappedSnapshot& other) = delete;
+    MappedSnapshot& operator=(MappedSnapshot&& other) noexcept;
+
+    const SnapshotHeader& header() const noexcept;
+
+    /// Number of sections within the file
+    std::size_t size() const noexcept;
+
+    /// Bytes of section index or an empty span if index >= size()
+    std::span<std::byte> section(const std::size_t index) const noexcept;
+
+    /// Section index viewed as an array of T
+    template<typename T>
+    std::span<T>
+    section_as(const std::size_t index) const noexcept
+    {
+        const auto bytes = this->section(index);
+        return std::span<T>(reinterpret_cast<T*>(bytes.data()), bytes.size() / sizeof(T));
+    }
+
+   private:
+    std::byte*  m_data  = nullptr;  ///< Start of the mapping
+    std::size_t m_bytes = 0;        ///< Length of the mapping
+};
+
+} /* namespace hopi */
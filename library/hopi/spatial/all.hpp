@@ -14,14 +14,24 @@
 
 
 #include "hopi/spatial/bound/box.hpp"
-#include "hopi/spatial/common/truncated_multiset.hpp"
+#include "hopi/spatial/bound/box_array.hpp"
+#include "hopi/spatial/bound/point.hpp"
+#include "hopi/spatial/common/bounded_heap.hpp"
+#include "hopi/spatial/common/simd.hpp"
+#include "hopi/spatial/common/space_filling_curve.hpp"
 #include "hopi/spatial/shared/index/rtree/algorithm.hpp"
+#include "hopi/spatial/shared/index/rtree/arena.hpp"
+#include "hopi/spatial/shared/index/rtree/bulk_load.hpp"
 #include "hopi/spatial/shared/index/rtree/leaf.hpp"
 #include "hopi/spatial/shared/index/rtree/linear.hpp"
 #include "hopi/spatial/shared/index/rtree/node.hpp"
 #include "hopi/spatial/shared/index/rtree/page.hpp"
 #include "hopi/spatial/shared/index/rtree/quadratic.hpp"
+#include "hopi/spatial/shared/index/rtree/query_context.hpp"
+#include "hopi/spatial/shared/index/rtree/rstar.hpp"
+#include "hopi/spatial/shared/index/rtree/storage.hpp"
 #include "hopi/spatial/shared/index/exhaustive.hpp"
+#include "hopi/spatial/shared/index/frozen.hpp"
 #include "hopi/spatial/shared/index/rtree.hpp"
 #include "hopi/spatial/shared/predicate/dispatch.hpp"
 #include "hopi/spatial/shared/predicate/distance.hpp"
@@ -20,6 +20,13 @@
 #include <limits>
 #include <ostream>
 
+// Allow Boost.Serialization without depending on it
+namespace boost {
+namespace serialization {
+class access;
+} // namespace serialization
+} // namespace boost
+
 namespace hopi {
 namespace spatial {
 namespace bound {
@@ -76,6 +83,14 @@ Box<T, N> Union(Box<T, N> const& a, Box<T, N> const& b);
 template<typename T, std::size_t N>
 typename Box<T, N>::value_type IncreaseToHold(Box<T, N> const& a, Box<T, N> const& b);
 
+/**
+ * Get area of the region shared by Box A and Box B
+ *
+ * Returns zero if the boxes do not intersect.
+ */
+template<typename T, std::size_t N>
+typename Box<T, N>::value_type OverlapArea(Box<T, N> const& a, Box<T, N> const& b);
+
 /** Bounding Box of Fixed Dimension
  *
  *
@@ -168,6 +183,16 @@ class Box final {
         return s;
     }
 
+    value_type
+    margin() const noexcept
+    {
+        value_type s = max_[0] - min_[0];
+        for (size_type i = 1; i < ndim; ++i) {
+            s += max_[i] - min_[i];
+        }
+        return s;
+    }
+
     size_type
     longest_dimension() const noexcept
     {
@@ -239,10 +264,10 @@ class Box final {
     void
     next_larger() noexcept
     {
-        using std::nexttoward;
+        using std::nextafter;
         for (size_type i = 0; i < min_.size(); ++i) {
-            min_[i] = nexttoward(min_[i], std::numeric_limits<value_type>::lowest());
-            max_[i] = nexttoward(max_[i], std::numeric_limits<value_type>::max());
+            min_[i] = nextafter(min_[i], std::numeric_limits<value_type>::lowest());
+            max_[i] = nextafter(max_[i], std::numeric_limits<value_type>::max());
         }
     }
 
@@ -255,10 +280,10 @@ class Box final {
     void
     next_smaller() noexcept
     {
-        using std::nexttoward;
+        using std::nextafter;
         for (size_type i = 0; i < min_.size(); ++i) {
-            min_[i] = nexttoward(min_[i], std::numeric_limits<value_type>::max());
-            max_[i] = nexttoward(max_[i], std::numeric_limits<value_type>::lowest());
+            min_[i] = nextafter(min_[i], std::numeric_limits<value_type>::max());
+            max_[i] = nextafter(max_[i], std::numeric_limits<value_type>::lowest());
         }
     }
 
@@ -303,16 +328,19 @@ class Box final {
     friend value_type Centroid<RANGE_TYPE, NDIM>(self_type const& a, self_type const& b);
     friend value_type Furthest<RANGE_TYPE, NDIM>(self_type const& a, self_type const& b);
 
+    /**
+     * Strict weak ordering of Boxes
+     *
+     * Orders lexicographically by the minimum then maximum corner
+     */
     struct less {
         bool
         operator()(self_type const& a, self_type const& b) const noexcept
         {
-            for (auto i = 0; i < a.ndim; ++i) {
-                if (a.min(i) < b.min(i)) {
-                    return true;
-                }
+            if (a.min_ != b.min_) {
+                return a.min_ < b.min_;
             }
-            return false;
+            return a.max_ < b.max_;
         }
     };
 
@@ -563,6 +591,28 @@ IncreaseToHold(Box<T, N> const& a, Box<T, N> const& b)
     return (Union(a, b).area() - a.area());
 }
 
+/**
+ * Get area of the region shared by Box A and Box B
+ *
+ * Returns zero if the boxes do not intersect.
+ */
+template<typename T, std::size_t N>
+typename Box<T, N>::value_type
+OverlapArea(Box<T, N> const& a, Box<T, N> const& b)
+{
+    using std::max;
+    using std::min;
+    typename Box<T, N>::value_type ans = 1;
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto length = min(a.max(i), b.max(i)) - max(a.min(i), b.min(i));
+        if (not(length > 0)) {
+            return 0;
+        }
+        ans *= length;
+    }
+    return ans;
+}
+
 } /* namespace bound */
 } /* namespace spatial */
 } /* namespace hopi */
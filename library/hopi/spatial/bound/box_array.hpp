@@ -0,0 +1,389 @@
+/// @file box_array.cpp
+/*
+ * Project:         HOPI
+ * File:            box_array.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/spatial/bound/box.hpp"
+#include "hopi/spatial/common/simd.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace hopi {
+namespace spatial {
+namespace bound {
+
+/**
+ * Fixed capacity array of Boxes stored as Structure of Arrays
+ *
+ * The minimum and maximum corners of every Box are stored
+ * within contiguous arrays for each dimension so the tests
+ * of box.hpp can be evaluated against all Boxes at once
+ * using the SIMD pack of the value type.  The arrays are
+ * padded to a multiple of the vector width so the tail
+ * never needs a partial load.
+ */
+template<typename T, std::size_t N, std::size_t Capacity>
+class BoxArray final {
+    //-------------------------------------------------------------------------
+    // Types & Constants
+    //-------------------------------------------------------------------------
+   public:
+    using self_type  = BoxArray<T, N, Capacity>;
+    using box_type   = Box<T, N>;
+    using pack_type  = simd::pack<T>;
+    using value_type = T;
+    using size_type  = std::size_t;
+    using mask_type  = std::uint64_t;
+
+    static constexpr size_type ndim     = N;
+    static constexpr size_type capacity = Capacity;
+    static constexpr size_type width    = pack_type::width;
+    static constexpr size_type padded   = ((Capacity + width - 1) / width) * width;
+
+    static_assert(Capacity <= 8 * sizeof(mask_type), "BoxArray Capacity must fit within the mask");
+
+    using value_array = std::array<T, padded>;
+
+    //-------------------------------------------------------------------------
+    // Access Operators
+    //-------------------------------------------------------------------------
+
+    /**
+     * Set the Box at location i
+     */
+    void
+    set(const size_type i, box_type const& box) noexcept
+    {
+        assert(i < Capacity);
+        for (size_type d = 0; d < N; ++d) {
+            min_[d][i] = box.min(d);
+            max_[d][i] = box.max(d);
+        }
+    }
+
+    /**
+     * Copy the Box at location "from" into location "to"
+     */
+    void
+    copy(const size_type to, const size_type from) noexcept
+    {
+        assert(to < Capacity);
+        assert(from < Capacity);
+        for (size_type d = 0; d < N; ++d) {
+            min_[d][to] = min_[d][from];
+            max_[d][to] = max_[d][from];
+        }
+    }
+
+    /**
+     * Get the Box at location i
+     */
+    box_type
+    get(const size_type i) const noexcept
+    {
+        assert(i < Capacity);
+        typename box_type::array_type min_corner;
+        typename box_type::array_type max_corner;
+        for (size_type d = 0; d < N; ++d) {
+            min_corner[d] = min_[d][i];
+            max_corner[d] = max_[d][i];
+        }
+        return box_type(min_corner, max_corner);
+    }
+
+    value_type const*
+    min_data(const size_type dim) const noexcept
+    {
+        return min_[dim].data();
+    }
+
+    value_type const*
+    max_data(const size_type dim) const noexcept
+    {
+        return max_[dim].data();
+    }
+
+    //-------------------------------------------------------------------------
+    // Data [Private]
+    //-------------------------------------------------------------------------
+   private:
+    alignas(64) std::array<std::array<T, padded>, N> min_{};
+    alignas(64) std::array<std::array<T, padded>, N> max_{};
+};
+
+namespace detail {
+
+/**
+ * Mask with the first count bits set
+ */
+inline std::uint64_t
+first_lanes(const std::size_t count) noexcept
+{
+    return (count >= 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << count) - 1);
+}
+
+/**
+ * Compare the corners of every Box against a pair of corners
+ *
+ * Bit i of the result is set if for every dimension
+ * (min_i MinOp min_against) and (max_i MaxOp max_against)
+ */
+template<simd::cmp MinOp, simd::cmp MaxOp, typename T, std::size_t N, std::size_t C>
+std::uint64_t
+compare_corners(BoxArray<T, N, C> const&   a,
+                std::array<T, N> const&    min_against,
+                std::array<T, N> const&    max_against,
+                const std::size_t          count) noexcept
+{
+    using pack = simd::pack<T>;
+    assert(count <= C);
+
+    std::uint64_t ans = 0;
+    for (std::size_t j = 0; j < count; j += pack::width) {
+        auto m = pack::mask_and(pack::template compare<MinOp>(pack::load(a.min_data(0) + j), pack::broadcast(min_against[0])),
+                                pack::template compare<MaxOp>(pack::load(a.max_data(0) + j), pack::broadcast(max_against[0])));
+        for (std::size_t d = 1; d < N; ++d) {
+            m = pack::mask_and(m, pack::template compare<MinOp>(pack::load(a.min_data(d) + j), pack::broadcast(min_against[d])));
+            m = pack::mask_and(m, pack::template compare<MaxOp>(pack::load(a.max_data(d) + j), pack::broadcast(max_against[d])));
+        }
+        ans |= pack::bits(m) << j;
+    }
+    return ans & first_lanes(count);
+}
+
+} /* namespace detail */
+
+//-------------------------------------------------------------------------
+// Tests of Every Box
+//
+// Bit i of the returned mask holds the result of the
+// matching box.hpp test for Box i of the array.  Only
+// the first count Boxes are tested.
+//-------------------------------------------------------------------------
+
+/**
+ * Test if each Box A[i] and Box B are disjoint
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Disjoint(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return (~detail::compare_corners<cmp::le, cmp::ge>(a, b.max_corner(), b.min_corner(), count)) & detail::first_lanes(count);
+}
+
+/**
+ * Test if each Box A[i] intersects Box B
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Intersects(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_corners<cmp::le, cmp::ge>(a, b.max_corner(), b.min_corner(), count);
+}
+
+/**
+ * Test if each Box A[i] overlaps Box B
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Overlaps(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_corners<cmp::lt, cmp::gt>(a, b.max_corner(), b.min_corner(), count);
+}
+
+/**
+ * Test if each Box A[i] fully Contains Box B
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Contains(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_corners<cmp::le, cmp::ge>(a, b.min_corner(), b.max_corner(), count);
+}
+
+/**
+ * Test if Box A fully Contains each Box B[i]
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Contains(Box<T, N> const& a, BoxArray<T, N, C> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_corners<cmp::ge, cmp::le>(b, a.min_corner(), a.max_corner(), count);
+}
+
+/**
+ * Test if each Box A[i] fully Contains Box B (without touching Max)
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+ContainsNonInclusive(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_corners<cmp::le, cmp::gt>(a, b.min_corner(), b.max_corner(), count);
+}
+
+/**
+ * Test if Box A fully Contains each Box B[i] (without touching Max)
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+ContainsNonInclusive(Box<T, N> const& a, BoxArray<T, N, C> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_corners<cmp::ge, cmp::lt>(b, a.min_corner(), a.max_corner(), count);
+}
+
+/**
+ * Test if each Box A[i] fully Covers Box B
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Covers(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_corners<cmp::lt, cmp::gt>(a, b.min_corner(), b.max_corner(), count);
+}
+
+/**
+ * Test if Box A fully Covers each Box B[i]
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Covers(Box<T, N> const& a, BoxArray<T, N, C> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_corners<cmp::gt, cmp::lt>(b, a.min_corner(), a.max_corner(), count);
+}
+
+/**
+ * Test if each Box A[i] and Box B are equal
+ */
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Equals(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_corners<cmp::eq, cmp::eq>(a, b.min_corner(), b.max_corner(), count);
+}
+
+//-------------------------------------------------------------------------
+// Measures of Every Box
+//
+// Entry i of the output holds the result of the matching
+// box.hpp measure for Box i of the array.  Only the first
+// count entries are valid.
+//-------------------------------------------------------------------------
+
+/**
+ * Nearest distance metric between each Box A[i] and Box B
+ */
+template<typename T, std::size_t N, std::size_t C>
+void
+Nearest(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count, typename BoxArray<T, N, C>::value_array& out) noexcept
+{
+    using pack      = simd::pack<T>;
+    const auto zero = pack::broadcast(0);
+    for (std::size_t j = 0; j < count; j += pack::width) {
+        auto dist_sq = zero;
+        for (std::size_t d = 0; d < N; ++d) {
+            auto b_bigger  = pack::max(zero, pack::sub(pack::broadcast(b.min(d)), pack::load(a.max_data(d) + j)));
+            auto b_smaller = pack::max(zero, pack::sub(pack::load(a.min_data(d) + j), pack::broadcast(b.max(d))));
+            auto b_dist    = pack::max(b_bigger, b_smaller);
+            dist_sq        = pack::add(dist_sq, pack::mul(b_dist, b_dist));
+        }
+        pack::store(out.data() + j, dist_sq);
+    }
+}
+
+/**
+ * Center distance metric between each Box A[i] and Box B
+ */
+template<typename T, std::size_t N, std::size_t C>
+void
+Centroid(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count, typename BoxArray<T, N, C>::value_array& out) noexcept
+{
+    using pack      = simd::pack<T>;
+    const auto half = pack::broadcast(0.5);
+    for (std::size_t j = 0; j < count; j += pack::width) {
+        auto dist_sq = pack::broadcast(0);
+        for (std::size_t d = 0; d < N; ++d) {
+            auto sum = pack::add(pack::load(a.max_data(d) + j), pack::load(a.min_data(d) + j));
+            sum      = pack::sub(pack::sub(sum, pack::broadcast(b.max(d))), pack::broadcast(b.min(d)));
+            sum      = pack::mul(half, sum);
+            dist_sq  = pack::add(dist_sq, pack::mul(sum, sum));
+        }
+        pack::store(out.data() + j, dist_sq);
+    }
+}
+
+/**
+ * Furthest distance metric between each Box A[i] and Box B
+ */
+template<typename T, std::size_t N, std::size_t C>
+void
+Furthest(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count, typename BoxArray<T, N, C>::value_array& out) noexcept
+{
+    using simd::cmp;
+    using pack      = simd::pack<T>;
+    const auto zero = pack::broadcast(0);
+    for (std::size_t j = 0; j < count; j += pack::width) {
+        auto dist_sq = zero;
+        for (std::size_t d = 0; d < N; ++d) {
+            const auto a_min = pack::load(a.min_data(d) + j);
+            const auto a_max = pack::load(a.max_data(d) + j);
+            const auto b_min = pack::broadcast(b.min(d));
+            const auto b_max = pack::broadcast(b.max(d));
+            const auto use   = pack::mask_xor(pack::template compare<cmp::lt>(a_max, b_max), pack::template compare<cmp::lt>(b_min, a_min));
+            auto b_bigger    = pack::sub(b_max, a_min);
+            auto b_smaller   = pack::sub(b_min, a_max);
+            b_bigger         = pack::mul(b_bigger, b_bigger);
+            b_smaller        = pack::mul(b_smaller, b_smaller);
+            dist_sq          = pack::add(dist_sq, pack::select(use, pack::max(b_bigger, b_smaller), zero));
+        }
+        pack::store(out.data() + j, dist_sq);
+    }
+}
+
+/**
+ * Get increased area of each Box A[i] needed to contain Box B
+ */
+template<typename T, std::size_t N, std::size_t C>
+void
+IncreaseToHold(BoxArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count, typename BoxArray<T, N, C>::value_array& out) noexcept
+{
+    using pack = simd::pack<T>;
+    for (std::size_t j = 0; j < count; j += pack::width) {
+        auto a_min      = pack::load(a.min_data(0) + j);
+        auto a_max      = pack::load(a.max_data(0) + j);
+        auto a_area     = pack::sub(a_max, a_min);
+        auto union_area = pack::sub(pack::max(a_max, pack::broadcast(b.max(0))), pack::min(a_min, pack::broadcast(b.min(0))));
+        for (std::size_t d = 1; d < N; ++d) {
+            a_min      = pack::load(a.min_data(d) + j);
+            a_max      = pack::load(a.max_data(d) + j);
+            a_area     = pack::mul(a_area, pack::sub(a_max, a_min));
+            union_area = pack::mul(union_area, pack::sub(pack::max(a_max, pack::broadcast(b.max(d))), pack::min(a_min, pack::broadcast(b.min(d)))));
+        }
+        pack::store(out.data() + j, pack::sub(union_area, a_area));
+    }
+}
+
+} /* namespace bound */
+} /* namespace spatial */
+} /* namespace hopi */
@@ -0,0 +1,446 @@
+/// @file point.cpp
+/*
+ * Project:         HOPI
+ * File:            point.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/spatial/bound/box.hpp"
+#include "hopi/spatial/bound/box_array.hpp"
+#include "hopi/spatial/common/simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace hopi {
+namespace spatial {
+namespace bound {
+
+//-------------------------------------------------------------------------
+// Tests of a Point
+//
+// Each returns the same result as the matching box.hpp test
+// of the degenerate Box(a,a) while reading a single corner.
+//-------------------------------------------------------------------------
+
+/**
+ * Test if Point A and Box B are disjoint
+ */
+template<typename T, std::size_t N>
+bool
+Disjoint(std::array<T, N> const& a, Box<T, N> const& b)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        if ((a[i] < b.min(i)) or (b.max(i) < a[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Test if Point A is within or on Box B
+ */
+template<typename T, std::size_t N>
+bool
+Intersects(std::array<T, N> const& a, Box<T, N> const& b)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        if (not((a[i] <= b.max(i)) and (a[i] >= b.min(i)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Test if Point A is strictly within Box B
+ */
+template<typename T, std::size_t N>
+bool
+Overlaps(std::array<T, N> const& a, Box<T, N> const& b)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        if (not((a[i] < b.max(i)) and (a[i] > b.min(i)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Test if Point A Contains Box B (ie. B is the same Point)
+ */
+template<typename T, std::size_t N>
+bool
+Contains(std::array<T, N> const& a, Box<T, N> const& b)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        if (not((a[i] <= b.min(i)) and (a[i] >= b.max(i)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Test if Box A Contains Point B
+ */
+template<typename T, std::size_t N>
+bool
+Contains(Box<T, N> const& a, std::array<T, N> const& b)
+{
+    return Intersects(b, a);
+}
+
+/**
+ * Test if Box A Contains Point B (without touching Max)
+ */
+template<typename T, std::size_t N>
+bool
+ContainsNonInclusive(Box<T, N> const& a, std::array<T, N> const& b)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        if (not((a.min(i) <= b[i]) and (a.max(i) > b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Test if Point A Covers Box B (never true)
+ */
+template<typename T, std::size_t N>
+bool
+Covers(std::array<T, N> const& a, Box<T, N> const& b)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        if (not((a[i] < b.min(i)) and (a[i] > b.max(i)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Test if Box A Covers Point B
+ */
+template<typename T, std::size_t N>
+bool
+Covers(Box<T, N> const& a, std::array<T, N> const& b)
+{
+    return Overlaps(b, a);
+}
+
+/**
+ * Test if Box B is the Point A
+ */
+template<typename T, std::size_t N>
+bool
+Equals(std::array<T, N> const& a, Box<T, N> const& b)
+{
+    return std::equal(a.cbegin(), a.cend(), b.min_corner().cbegin()) and std::equal(a.cbegin(), a.cend(), b.max_corner().cbegin());
+}
+
+/**
+ * Nearest distance metric between Point A and Box B
+ */
+template<typename T, std::size_t N>
+typename Box<T, N>::value_type
+Nearest(std::array<T, N> const& a, Box<T, N> const& b)
+{
+    using std::max;
+    using std::pow;
+    using value_type             = typename Box<T, N>::value_type;
+    constexpr value_type zero    = 0;
+    value_type           dist_sq = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        auto b_bigger  = max(zero, b.min(i) - a[i]);
+        auto b_smaller = max(zero, a[i] - b.max(i));
+        auto b_dist    = max(b_bigger, b_smaller);
+        dist_sq += pow(b_dist, 2);
+    }
+    return dist_sq;
+}
+
+/**
+ * Center distance metric between Point A and Box B
+ */
+template<typename T, std::size_t N>
+typename Box<T, N>::value_type
+Centroid(std::array<T, N> const& a, Box<T, N> const& b)
+{
+    using std::pow;
+    using value_type   = typename Box<T, N>::value_type;
+    value_type dist_sq = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        dist_sq += pow(0.5 * (a[i] + a[i] - b.max(i) - b.min(i)), 2);
+    }
+    return dist_sq;
+}
+
+/**
+ * Furthest distance metric between Point A and Box B
+ */
+template<typename T, std::size_t N>
+typename Box<T, N>::value_type
+Furthest(std::array<T, N> const& a, Box<T, N> const& b)
+{
+    using std::max;
+    using std::pow;
+    using value_type   = typename Box<T, N>::value_type;
+    value_type dist_sq = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        if ((a[i] < b.max(i)) xor (b.min(i) < a[i])) {
+            auto b_bigger  = pow(b.max(i) - a[i], 2);
+            auto b_smaller = pow(b.min(i) - a[i], 2);
+            dist_sq += max(b_bigger, b_smaller);
+        }
+    }
+    return dist_sq;
+}
+
+/**
+ * Relative error bound of a distance metric computed in T
+ *
+ * Each of the N differences, squares and sums rounds at most
+ * once, doubled to also cover the bounds compared while pruning.
+ * A metric m computed in T lies within m * (1 +/- bound) of the
+ * exact value.
+ */
+template<typename T, std::size_t N>
+constexpr double
+distance_error_bound() noexcept
+{
+    return 2 * double(N + 2) * double(std::numeric_limits<T>::epsilon());
+}
+
+/**
+ * Boxes of a BoxArray which are all Points
+ *
+ * The tests below only load the minimum corners so they
+ * read half the memory of the matching BoxArray tests.
+ */
+template<typename T, std::size_t N, std::size_t Capacity>
+struct PointArray final {
+    using box_array_type = BoxArray<T, N, Capacity>;
+    using value_type     = T;
+    using value_array    = typename box_array_type::value_array;
+
+    static constexpr std::size_t ndim     = N;
+    static constexpr std::size_t capacity = Capacity;
+
+    value_type const*
+    data(const std::size_t dim) const noexcept
+    {
+        return boxes.min_data(dim);
+    }
+
+    box_array_type const& boxes;
+};
+
+/**
+ * View the Boxes of a BoxArray as Points
+ */
+template<typename T, std::size_t N, std::size_t C>
+PointArray<T, N, C>
+as_points(BoxArray<T, N, C> const& boxes) noexcept
+{
+    return PointArray<T, N, C>{ boxes };
+}
+
+namespace detail {
+
+/**
+ * Compare every Point against a pair of corners
+ *
+ * Bit i of the result is set if for every dimension
+ * (point_i LowOp low) and (point_i HighOp high)
+ */
+template<simd::cmp LowOp, simd::cmp HighOp, typename T, std::size_t N, std::size_t C>
+std::uint64_t
+compare_points(PointArray<T, N, C> const& a, std::array<T, N> const& low, std::array<T, N> const& high, const std::size_t count) noexcept
+{
+    using pack = simd::pack<T>;
+    assert(count <= C);
+
+    std::uint64_t ans = 0;
+    for (std::size_t j = 0; j < count; j += pack::width) {
+        auto p = pack::load(a.data(0) + j);
+        auto m = pack::mask_and(pack::template compare<LowOp>(p, pack::broadcast(low[0])),
+                                pack::template compare<HighOp>(p, pack::broadcast(high[0])));
+        for (std::size_t d = 1; d < N; ++d) {
+            p = pack::load(a.data(d) + j);
+            m = pack::mask_and(m, pack::template compare<LowOp>(p, pack::broadcast(low[d])));
+            m = pack::mask_and(m, pack::template compare<HighOp>(p, pack::broadcast(high[d])));
+        }
+        ans |= pack::bits(m) << j;
+    }
+    return ans & first_lanes(count);
+}
+
+} /* namespace detail */
+
+//-------------------------------------------------------------------------
+// Tests of Every Point
+//
+// Bit i of the returned mask holds the result of the
+// matching Point test for Point i of the array.  Only
+// the first count Points are tested.
+//-------------------------------------------------------------------------
+
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Disjoint(PointArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return (~detail::compare_points<cmp::ge, cmp::le>(a, b.min_corner(), b.max_corner(), count)) & detail::first_lanes(count);
+}
+
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Intersects(PointArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_points<cmp::ge, cmp::le>(a, b.min_corner(), b.max_corner(), count);
+}
+
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Overlaps(PointArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_points<cmp::gt, cmp::lt>(a, b.min_corner(), b.max_corner(), count);
+}
+
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Contains(PointArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_points<cmp::le, cmp::ge>(a, b.min_corner(), b.max_corner(), count);
+}
+
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Contains(Box<T, N> const& a, PointArray<T, N, C> const& b, const std::size_t count) noexcept
+{
+    return Intersects(b, a, count);
+}
+
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+ContainsNonInclusive(Box<T, N> const& a, PointArray<T, N, C> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_points<cmp::ge, cmp::lt>(b, a.min_corner(), a.max_corner(), count);
+}
+
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Covers(PointArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_points<cmp::lt, cmp::gt>(a, b.min_corner(), b.max_corner(), count);
+}
+
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Covers(Box<T, N> const& a, PointArray<T, N, C> const& b, const std::size_t count) noexcept
+{
+    return Overlaps(b, a, count);
+}
+
+template<typename T, std::size_t N, std::size_t C>
+std::uint64_t
+Equals(PointArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count) noexcept
+{
+    using simd::cmp;
+    return detail::compare_points<cmp::eq, cmp::eq>(a, b.min_corner(), b.max_corner(), count);
+}
+
+//-------------------------------------------------------------------------
+// Measures of Every Point
+//
+// Entry i of the output holds the result of the matching
+// Point measure for Point i of the array.  Only the first
+// count entries are valid.
+//-------------------------------------------------------------------------
+
+template<typename T, std::size_t N, std::size_t C>
+void
+Nearest(PointArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count, typename PointArray<T, N, C>::value_array& out) noexcept
+{
+    using pack      = simd::pack<T>;
+    const auto zero = pack::broadcast(0);
+    for (std::size_t j = 0; j < count; j += pack::width) {
+        auto dist_sq = zero;
+        for (std::size_t d = 0; d < N; ++d) {
+            const auto p   = pack::load(a.data(d) + j);
+            auto b_bigger  = pack::max(zero, pack::sub(pack::broadcast(b.min(d)), p));
+            auto b_smaller = pack::max(zero, pack::sub(p, pack::broadcast(b.max(d))));
+            auto b_dist    = pack::max(b_bigger, b_smaller);
+            dist_sq        = pack::add(dist_sq, pack::mul(b_dist, b_dist));
+        }
+        pack::store(out.data() + j, dist_sq);
+    }
+}
+
+template<typename T, std::size_t N, std::size_t C>
+void
+Centroid(PointArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count, typename PointArray<T, N, C>::value_array& out) noexcept
+{
+    using pack      = simd::pack<T>;
+    const auto half = pack::broadcast(0.5);
+    for (std::size_t j = 0; j < count; j += pack::width) {
+        auto dist_sq = pack::broadcast(0);
+        for (std::size_t d = 0; d < N; ++d) {
+            const auto p = pack::load(a.data(d) + j);
+            auto sum     = pack::sub(pack::sub(pack::add(p, p), pack::broadcast(b.max(d))), pack::broadcast(b.min(d)));
+            sum          = pack::mul(half, sum);
+            dist_sq      = pack::add(dist_sq, pack::mul(sum, sum));
+        }
+        pack::store(out.data() + j, dist_sq);
+    }
+}
+
+template<typename T, std::size_t N, std::size_t C>
+void
+Furthest(PointArray<T, N, C> const& a, Box<T, N> const& b, const std::size_t count, typename PointArray<T, N, C>::value_array& out) noexcept
+{
+    using simd::cmp;
+    using pack      = simd::pack<T>;
+    const auto zero = pack::broadcast(0);
+    for (std::size_t j = 0; j < count; j += pack::width) {
+        auto dist_sq = zero;
+        for (std::size_t d = 0; d < N; ++d) {
+            const auto p     = pack::load(a.data(d) + j);
+            const auto b_min = pack::broadcast(b.min(d));
+            const auto b_max = pack::broadcast(b.max(d));
+            const auto use   = pack::mask_xor(pack::template compare<cmp::lt>(p, b_max), pack::template compare<cmp::lt>(b_min, p));
+            auto b_bigger    = pack::sub(b_max, p);
+            auto b_smaller   = pack::sub(b_min, p);
+            b_bigger         = pack::mul(b_bigger, b_bigger);
+            b_smaller        = pack::mul(b_smaller, b_smaller);
+            dist_sq          = pack::add(dist_sq, pack::select(use, pack::max(b_bigger, b_smaller), zero));
+        }
+        pack::store(out.data() + j, dist_sq);
+    }
+}
+
+} /* namespace bound */
+} /* namespace spatial */
+} /* namespace hopi */
@@ -0,0 +1,254 @@
+/// @file bounded_heap.cpp
+/*
+ * Project:         HOPI
+ * File:            bounded_heap.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hopi {
+namespace spatial {
+
+/**
+ * Compare pairs using only the N'th member
+ */
+template<std::size_t N>
+struct LessPair {
+	template<typename T1, typename T2>
+	bool operator()(const std::pair<T1,T2>& p1, const std::pair<T1,T2>& p2) const {
+		return std::get<N>(p1) < std::get<N>(p2);
+	}
+};
+
+/**
+ * Count used to select a BoundedHeap sized at runtime
+ */
+inline constexpr std::size_t dynamic_count = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Heap holding only the best Count values pushed into it
+ *
+ * The worst value kept (largest by Compare) is always at the
+ * front so testing a candidate against it is O(1) and replacing
+ * it is O(log Count). The storage is a std::array when Count is
+ * known at compile time and a std::vector otherwise, which only
+ * grows so a reused heap stops allocating.
+ *
+ * Iteration is in heap order until sort() is called.
+ */
+template<typename Key,
+		 std::size_t Count = dynamic_count,
+		 typename Compare  = std::less<Key>>
+class BoundedHeap {
+
+	//-------------------------------------------------------------------------
+	// Types & Constants
+	//-------------------------------------------------------------------------
+public:
+	static constexpr bool is_dynamic = (Count == dynamic_count);
+
+private:
+	using storage_type = std::conditional_t<is_dynamic, std::vector<Key>, std::array<Key,is_dynamic ? 1 : Count>>;
+
+public:
+	using value_type      = Key;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference       = value_type&;
+	using const_reference = value_type const&;
+	using iterator        = typename storage_type::iterator;
+	using const_iterator  = typename storage_type::const_iterator;
+	using value_compare   = Compare;
+
+	//-------------------------------------------------------------------------
+	// Constructors
+	//-------------------------------------------------------------------------
+
+	BoundedHeap() = default;
+
+	BoundedHeap(BoundedHeap const& other) = default;
+	BoundedHeap(BoundedHeap&& other)      = default;
+
+	explicit BoundedHeap(const size_type count) {
+		this->reset(count);
+	}
+
+	~BoundedHeap() = default;
+
+	//-------------------------------------------------------------------------
+	// Assignment Operators
+	//-------------------------------------------------------------------------
+
+	BoundedHeap& operator=(const BoundedHeap& other) = default;
+
+	BoundedHeap& operator=(BoundedHeap&& other) = default;
+
+	//-------------------------------------------------------------------------
+	// Iterators
+	//-------------------------------------------------------------------------
+
+	iterator begin() noexcept {
+		return data_.begin();
+	}
+
+	const_iterator begin() const noexcept {
+		return data_.begin();
+	}
+
+	const_iterator cbegin() const noexcept {
+		return data_.cbegin();
+	}
+
+	iterator end() noexcept {
+		return std::next(data_.begin(), size_);
+	}
+
+	const_iterator end() const noexcept {
+		return std::next(data_.cbegin(), size_);
+	}
+
+	const_iterator cend() const noexcept {
+		return std::next(data_.cbegin(), size_);
+	}
+
+	//-------------------------------------------------------------------------
+	// Capacity
+	//-------------------------------------------------------------------------
+
+	bool empty() const noexcept {
+		return size_ == 0;
+	}
+
+	bool full() const noexcept {
+		return size_ == count_;
+	}
+
+	size_type size() const noexcept {
+		return size_;
+	}
+
+	/**
+	 * Maximum number of values kept
+	 */
+	size_type count() const noexcept {
+		return count_;
+	}
+
+	//-------------------------------------------------------------------------
+	// Element Access
+	//-------------------------------------------------------------------------
+
+	/**
+	 * Worst value currently kept
+	 *
+	 * Only valid when not empty and before sort()
+	 */
+	const_reference worst() const noexcept {
+		assert(size_ > 0);
+		return data_[0];
+	}
+
+	//-------------------------------------------------------------------------
+	// Modifiers
+	//-------------------------------------------------------------------------
+
+	void clear() noexcept {
+		size_ = 0;
+	}
+
+	/**
+	 * Clear and change the number of values kept
+	 *
+	 * A compile time Count may only be lowered.
+	 */
+	void reset(const size_type count) {
+		if constexpr ( is_dynamic ) {
+			if( data_.size() < count ) {
+				data_.resize(count);
+			}
+		}
+		assert(count <= data_.size());
+		count_ = count;
+		size_  = 0;
+	}
+
+	/**
+	 * Push value if it is better than the worst kept
+	 *
+	 * Returns true if the value was kept.
+	 */
+	bool push(value_type const& value) {
+		if( size_ < count_ ) {
+			data_[size_] = value;
+			++size_;
+			std::push_heap(this->begin(), this->end(), comp_);
+			return true;
+		}
+		if( (count_ > 0) and comp_(value, data_[0]) ) {
+			this->replace_top_(value);
+			return true;
+		}
+		return false;
+	}
+
+	template< class... Args >
+	bool emplace(Args&&... args) {
+		return this->push(value_type(std::forward<Args>(args)...));
+	}
+
+	/**
+	 * Sort kept values from best to worst
+	 *
+	 * The heap order is lost so the heap must be cleared
+	 * or reset before pushing again.
+	 */
+	void sort() {
+		std::sort_heap(this->begin(), this->end(), comp_);
+	}
+
+private:
+	storage_type  data_{};
+	size_type     count_ = is_dynamic ? 0 : Count;
+	size_type     size_  = 0;
+	value_compare comp_{};
+
+	/**
+	 * Replace the front of the heap and sift it down
+	 */
+	void replace_top_(value_type const& value) {
+		size_type hole  = 0;
+		size_type child = 1;
+		while( child < size_ ) {
+			if( (child + 1 < size_) and comp_(data_[child], data_[child+1]) ) {
+				++child;
+			}
+			if( not comp_(value, data_[child]) ) {
+				break;
+			}
+			data_[hole] = std::move(data_[child]);
+			hole  = child;
+			child = 2 * hole + 1;
+		}
+		data_[hole] = value;
+	}
+};
+
+
+} /* namespace spatial */
+} /* namespace hopi */
@@ -0,0 +1,85 @@
+/// @file profile.hpp
+/*
+ * Project:         HOPI
+ * File:            profile.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace hopi {
+namespace spatial {
+namespace profile {
+
+/**
+ * Totals of a named spatial query
+ */
+struct QueryStat {
+	std::uint64_t queries       = 0;  ///< Number of queries
+	std::uint64_t nodes_visited = 0;  ///< Pages whose children were tested
+	std::uint64_t leaves_tested = 0;  ///< Leafs tested against the predicate
+	std::uint64_t found         = 0;  ///< Values returned
+	double        pruned        = 0;  ///< Sum over queries of the fraction of Leafs never tested
+};
+
+/**
+ * Record a completed spatial query on this thread
+ *
+ * Only declared here so the indexes do not depend on a profiler.
+ * Defined by hopi::profile which adds it to its query tables.
+ */
+void record_query(std::string_view name, const QueryStat& query);
+
+/**
+ * Counts the work of a single spatial query
+ *
+ * Compiles to nothing unless HOPI_USE_PROFILE is defined.
+ */
+#if defined(HOPI_USE_PROFILE)
+class QueryCounter final {
+public:
+	QueryCounter(std::string_view name, std::size_t num_values, std::size_t num_queries = 1) noexcept
+		: m_name(name), m_num_leaves(num_values * num_queries) {
+		m_stat.queries = num_queries;
+	}
+	QueryCounter(const QueryCounter& other)            = delete;
+	QueryCounter& operator=(const QueryCounter& other) = delete;
+	~QueryCounter() {
+		if (m_num_leaves > 0) {
+			m_stat.pruned = double(m_stat.queries) * (1.0 - double(m_stat.leaves_tested) / double(m_num_leaves));
+		}
+		record_query(m_name, m_stat);
+	}
+
+	void visit(const std::size_t n = 1) noexcept { m_stat.nodes_visited += n; }
+	void test(const std::size_t n = 1) noexcept { m_stat.leaves_tested += n; }
+	void found(const std::size_t n) noexcept { m_stat.found += n; }
+
+private:
+	std::string_view m_name;
+	std::size_t      m_num_leaves;
+	QueryStat        m_stat;
+};
+#else
+class QueryCounter final {
+public:
+	QueryCounter(std::string_view /* name */, std::size_t /* num_values */, std::size_t /* num_queries */ = 1) noexcept {}
+
+	void visit(const std::size_t /* n */ = 1) noexcept {}
+	void test(const std::size_t /* n */ = 1) noexcept {}
+	void found(const std::size_t /* n */) noexcept {}
+};
+#endif
+
+} // namespace profile
+} // namespace spatial
+} // namespace hopi
@@ -0,0 +1,331 @@
+/// @file simd.cpp
+/*
+ * Project:         HOPI
+ * File:            simd.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace hopi {
+namespace spatial {
+namespace simd {
+
+/**
+ * Comparison performed lane by lane
+ *
+ * All comparisons are ordered so any NaN compares
+ * false the same as the scalar operators.
+ */
+enum class cmp {
+	lt,
+	le,
+	gt,
+	ge,
+	eq
+};
+
+/**
+ * Thin wrapper over the widest native vector of T
+ *
+ * The primary template is the scalar fallback (width of 1)
+ * which is used for any value type without a vector path.
+ * The min/max operations match std::min/std::max so the
+ * vector and scalar results are identical.
+ */
+template<typename T>
+struct pack {
+	using value_type    = T;
+	using register_type = T;
+	using mask_type     = bool;
+
+	static constexpr std::size_t width = 1;
+
+	static register_type load(T const* ptr) noexcept {
+		return *ptr;
+	}
+
+	static register_type broadcast(T const value) noexcept {
+		return value;
+	}
+
+	static void store(T* ptr, register_type const a) noexcept {
+		*ptr = a;
+	}
+
+	template<cmp Op>
+	static mask_type compare(register_type const a, register_type const b) noexcept {
+		if constexpr (Op == cmp::lt) { return a <  b; }
+		else if constexpr (Op == cmp::le) { return a <= b; }
+		else if constexpr (Op == cmp::gt) { return a >  b; }
+		else if constexpr (Op == cmp::ge) { return a >= b; }
+		else { return a == b; }
+	}
+
+	static mask_type mask_and(mask_type const a, mask_type const b) noexcept {
+		return a and b;
+	}
+
+	static mask_type mask_xor(mask_type const a, mask_type const b) noexcept {
+		return a != b;
+	}
+
+	static std::uint64_t bits(mask_type const m) noexcept {
+		return m ? 1 : 0;
+	}
+
+	static register_type select(mask_type const m, register_type const a, register_type const b) noexcept {
+		return m ? a : b;
+	}
+
+	static register_type add(register_type const a, register_type const b) noexcept { return a + b; }
+	static register_type sub(register_type const a, register_type const b) noexcept { return a - b; }
+	static register_type mul(register_type const a, register_type const b) noexcept { return a * b; }
+	static register_type min(register_type const a, register_type const b) noexcept { return std::min(a, b); }
+	static register_type max(register_type const a, register_type const b) noexcept { return std::max(a, b); }
+};
+
+
+#if defined(__AVX512F__)
+
+namespace detail {
+template<cmp Op>
+inline constexpr int x86_predicate = (Op == cmp::lt) ? _CMP_LT_OQ :
+                                     (Op == cmp::le) ? _CMP_LE_OQ :
+                                     (Op == cmp::gt) ? _CMP_GT_OQ :
+                                     (Op == cmp::ge) ? _CMP_GE_OQ : _CMP_EQ_OQ;
+} /* namespace detail */
+
+template<>
+struct pack<double> {
+	using value_type    = double;
+	using register_type = __m512d;
+	using mask_type     = __mmask8;
+
+	static constexpr std::size_t width = 8;
+
+	static register_type load(double const* ptr) noexcept { return _mm512_loadu_pd(ptr); }
+	static register_type broadcast(double const value) noexcept { return _mm512_set1_pd(value); }
+	static void store(double* ptr, register_type const a) noexcept { _mm512_storeu_pd(ptr, a); }
+
+	template<cmp Op>
+	static mask_type compare(register_type const a, register_type const b) noexcept {
+		return _mm512_cmp_pd_mask(a, b, detail::x86_predicate<Op>);
+	}
+
+	static mask_type mask_and(mask_type const a, mask_type const b) noexcept { return a & b; }
+	static mask_type mask_xor(mask_type const a, mask_type const b) noexcept { return a ^ b; }
+	static std::uint64_t bits(mask_type const m) noexcept { return m; }
+	static register_type select(mask_type const m, register_type const a, register_type const b) noexcept {
+		return _mm512_mask_blend_pd(m, b, a);
+	}
+
+	static register_type add(register_type const a, register_type const b) noexcept { return _mm512_add_pd(a, b); }
+	static register_type sub(register_type const a, register_type const b) noexcept { return _mm512_sub_pd(a, b); }
+	static register_type mul(register_type const a, register_type const b) noexcept { return _mm512_mul_pd(a, b); }
+	static register_type min(register_type const a, register_type const b) noexcept { return select(compare<cmp::lt>(b, a), b, a); }
+	static register_type max(register_type const a, register_type const b) noexcept { return select(compare<cmp::lt>(a, b), b, a); }
+};
+
+template<>
+struct pack<float> {
+	using value_type    = float;
+	using register_type = __m512;
+	using mask_type     = __mmask16;
+
+	static constexpr std::size_t width = 16;
+
+	static register_type load(float const* ptr) noexcept { return _mm512_loadu_ps(ptr); }
+	static register_type broadcast(float const value) noexcept { return _mm512_set1_ps(value); }
+	static void store(float* ptr, register_type const a) noexcept { _mm512_storeu_ps(ptr, a); }
+
+	template<cmp Op>
+	static mask_type compare(register_type const a, register_type const b) noexcept {
+		return _mm512_cmp_ps_mask(a, b, detail::x86_predicate<Op>);
+	}
+
+	static mask_type mask_and(mask_type const a, mask_type const b) noexcept { return a & b; }
+	static mask_type mask_xor(mask_type const a, mask_type const b) noexcept { return a ^ b; }
+	static std::uint64_t bits(mask_type const m) noexcept { return m; }
+	static register_type select(mask_type const m, register_type const a, register_type const b) noexcept {
+		return _mm512_mask_blend_ps(m, b, a);
+	}
+
+	static register_type add(register_type const a, register_type const b) noexcept { return _mm512_add_ps(a, b); }
+	static register_type sub(register_type const a, register_type const b) noexcept { return _mm512_sub_ps(a, b); }
+	static register_type mul(register_type const a, register_type const b) noexcept { return _mm512_mul_ps(a, b); }
+	static register_type min(register_type const a, register_type const b) noexcept { return select(compare<cmp::lt>(b, a), b, a); }
+	static register_type max(register_type const a, register_type const b) noexcept { return select(compare<cmp::lt>(a, b), b, a); }
+};
+
+#elif defined(__AVX2__)
+
+namespace detail {
+template<cmp Op>
+inline constexpr int x86_predicate = (Op == cmp::lt) ? _CMP_LT_OQ :
+                                     (Op == cmp::le) ? _CMP_LE_OQ :
+                                     (Op == cmp::gt) ? _CMP_GT_OQ :
+                                     (Op == cmp::ge) ? _CMP_GE_OQ : _CMP_EQ_OQ;
+} /* namespace detail */
+
+template<>
+struct pack<double> {
+	using value_type    = double;
+	using register_type = __m256d;
+	using mask_type     = __m256d;
+
+	static constexpr std::size_t width = 4;
+
+	static register_type load(double const* ptr) noexcept { return _mm256_loadu_pd(ptr); }
+	static register_type broadcast(double const value) noexcept { return _mm256_set1_pd(value); }
+	static void store(double* ptr, register_type const a) noexcept { _mm256_storeu_pd(ptr, a); }
+
+	template<cmp Op>
+	static mask_type compare(register_type const a, register_type const b) noexcept {
+		return _mm256_cmp_pd(a, b, detail::x86_predicate<Op>);
+	}
+
+	static mask_type mask_and(mask_type const a, mask_type const b) noexcept { return _mm256_and_pd(a, b); }
+	static mask_type mask_xor(mask_type const a, mask_type const b) noexcept { return _mm256_xor_pd(a, b); }
+	static std::uint64_t bits(mask_type const m) noexcept { return static_cast<std::uint64_t>(_mm256_movemask_pd(m)); }
+	static register_type select(mask_type const m, register_type const a, register_type const b) noexcept {
+		return _mm256_blendv_pd(b, a, m);
+	}
+
+	static register_type add(register_type const a, register_type const b) noexcept { return _mm256_add_pd(a, b); }
+	static register_type sub(register_type const a, register_type const b) noexcept { return _mm256_sub_pd(a, b); }
+	static register_type mul(register_type const a, register_type const b) noexcept { return _mm256_mul_pd(a, b); }
+	static register_type min(register_type const a, register_type const b) noexcept { return _mm256_min_pd(b, a); }
+	static register_type max(register_type const a, register_type const b) noexcept { return _mm256_max_pd(b, a); }
+};
+
+template<>
+struct pack<float> {
+	using value_type    = float;
+	using register_type = __m256;
+	using mask_type     = __m256;
+
+	static constexpr std::size_t width = 8;
+
+	static register_type load(float const* ptr) noexcept { return _mm256_loadu_ps(ptr); }
+	static register_type broadcast(float const value) noexcept { return _mm256_set1_ps(value); }
+	static void store(float* ptr, register_type const a) noexcept { _mm256_storeu_ps(ptr, a); }
+
+	template<cmp Op>
+	static mask_type compare(register_type const a, register_type const b) noexcept {
+		return _mm256_cmp_ps(a, b, detail::x86_predicate<Op>);
+	}
+
+	static mask_type mask_and(mask_type const a, mask_type const b) noexcept { return _mm256_and_ps(a, b); }
+	static mask_type mask_xor(mask_type const a, mask_type const b) noexcept { return _mm256_xor_ps(a, b); }
+	static std::uint64_t bits(mask_type const m) noexcept { return static_cast<std::uint64_t>(_mm256_movemask_ps(m)); }
+	static register_type select(mask_type const m, register_type const a, register_type const b) noexcept {
+		return _mm256_blendv_ps(b, a, m);
+	}
+
+	static register_type add(register_type const a, register_type const b) noexcept { return _mm256_add_ps(a, b); }
+	static register_type sub(register_type const a, register_type const b) noexcept { return _mm256_sub_ps(a, b); }
+	static register_type mul(register_type const a, register_type const b) noexcept { return _mm256_mul_ps(a, b); }
+	static register_type min(register_type const a, register_type const b) noexcept { return _mm256_min_ps(b, a); }
+	static register_type max(register_type const a, register_type const b) noexcept { return _mm256_max_ps(b, a); }
+};
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+template<>
+struct pack<double> {
+	using value_type    = double;
+	using register_type = float64x2_t;
+	using mask_type     = uint64x2_t;
+
+	static constexpr std::size_t width = 2;
+
+	static register_type load(double const* ptr) noexcept { return vld1q_f64(ptr); }
+	static register_type broadcast(double const value) noexcept { return vdupq_n_f64(value); }
+	static void store(double* ptr, register_type const a) noexcept { vst1q_f64(ptr, a); }
+
+	template<cmp Op>
+	static mask_type compare(register_type const a, register_type const b) noexcept {
+		if constexpr (Op == cmp::lt) { return vcltq_f64(a, b); }
+		else if constexpr (Op == cmp::le) { return vcleq_f64(a, b); }
+		else if constexpr (Op == cmp::gt) { return vcgtq_f64(a, b); }
+		else if constexpr (Op == cmp::ge) { return vcgeq_f64(a, b); }
+		else { return vceqq_f64(a, b); }
+	}
+
+	static mask_type mask_and(mask_type const a, mask_type const b) noexcept { return vandq_u64(a, b); }
+	static mask_type mask_xor(mask_type const a, mask_type const b) noexcept { return veorq_u64(a, b); }
+	static std::uint64_t bits(mask_type const m) noexcept {
+		return (vgetq_lane_u64(m, 0) & 1) | ((vgetq_lane_u64(m, 1) & 1) << 1);
+	}
+	static register_type select(mask_type const m, register_type const a, register_type const b) noexcept {
+		return vbslq_f64(m, a, b);
+	}
+
+	static register_type add(register_type const a, register_type const b) noexcept { return vaddq_f64(a, b); }
+	static register_type sub(register_type const a, register_type const b) noexcept { return vsubq_f64(a, b); }
+	static register_type mul(register_type const a, register_type const b) noexcept { return vmulq_f64(a, b); }
+	static register_type min(register_type const a, register_type const b) noexcept { return vbslq_f64(vcltq_f64(b, a), b, a); }
+	static register_type max(register_type const a, register_type const b) noexcept { return vbslq_f64(vcltq_f64(a, b), b, a); }
+};
+
+template<>
+struct pack<float> {
+	using value_type    = float;
+	using register_type = float32x4_t;
+	using mask_type     = uint32x4_t;
+
+	static constexpr std::size_t width = 4;
+
+	static register_type load(float const* ptr) noexcept { return vld1q_f32(ptr); }
+	static register_type broadcast(float const value) noexcept { return vdupq_n_f32(value); }
+	static void store(float* ptr, register_type const a) noexcept { vst1q_f32(ptr, a); }
+
+	template<cmp Op>
+	static mask_type compare(register_type const a, register_type const b) noexcept {
+		if constexpr (Op == cmp::lt) { return vcltq_f32(a, b); }
+		else if constexpr (Op == cmp::le) { return vcleq_f32(a, b); }
+		else if constexpr (Op == cmp::gt) { return vcgtq_f32(a, b); }
+		else if constexpr (Op == cmp::ge) { return vcgeq_f32(a, b); }
+		else { return vceqq_f32(a, b); }
+	}
+
+	static mask_type mask_and(mask_type const a, mask_type const b) noexcept { return vandq_u32(a, b); }
+	static mask_type mask_xor(mask_type const a, mask_type const b) noexcept { return veorq_u32(a, b); }
+	static std::uint64_t bits(mask_type const m) noexcept {
+		return  (std::uint64_t(vgetq_lane_u32(m, 0)) & 1)       |
+		       ((std::uint64_t(vgetq_lane_u32(m, 1)) & 1) << 1) |
+		       ((std::uint64_t(vgetq_lane_u32(m, 2)) & 1) << 2) |
+		       ((std::uint64_t(vgetq_lane_u32(m, 3)) & 1) << 3);
+	}
+	static register_type select(mask_type const m, register_type const a, register_type const b) noexcept {
+		return vbslq_f32(m, a, b);
+	}
+
+	static register_type add(register_type const a, register_type const b) noexcept { return vaddq_f32(a, b); }
+	static register_type sub(register_type const a, register_type const b) noexcept { return vsubq_f32(a, b); }
+	static register_type mul(register_type const a, register_type const b) noexcept { return vmulq_f32(a, b); }
+	static register_type min(register_type const a, register_type const b) noexcept { return vbslq_f32(vcltq_f32(b, a), b, a); }
+	static register_type max(register_type const a, register_type const b) noexcept { return vbslq_f32(vcltq_f32(a, b), b, a); }
+};
+
+#endif
+
+} /* namespace simd */
+} /* namespace spatial */
+} /* namespace hopi */
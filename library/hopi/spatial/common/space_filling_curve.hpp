@@ -0,0 +1,377 @@
+/// @file space_filling_curve.cpp
+/*
+ * Project:         HOPI
+ * File:            space_filling_curve.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace hopi {
+namespace spatial {
+namespace sfc {
+
+/**
+ * Key type produced by all space filling curves
+ */
+using key_type = std::uint64_t;
+
+/**
+ * Number of bits used for each dimension within a key
+ */
+template<std::size_t N>
+inline constexpr unsigned bits_per_dimension = ((8 * sizeof(key_type)) / N < 32) ? (8 * sizeof(key_type)) / N : 32;
+
+/**
+ * Quantize a location into integer grid coordinates
+ *
+ * Maps each coordinate of the point onto the integer grid
+ * [0, 2^bits) spanning the provided bounding corners.
+ * Locations outside the bounds are clamped to the edge.
+ *
+ * @param[in] point      Location to quantize
+ * @param[in] min_corner Minimum corner of the domain
+ * @param[in] max_corner Maximum corner of the domain
+ *
+ * @returns Integer grid coordinates of the point
+ */
+template<typename T, std::size_t N>
+std::array<std::uint32_t, N>
+quantize(std::array<T, N> const& point, std::array<T, N> const& min_corner, std::array<T, N> const& max_corner) noexcept {
+	constexpr auto bits      = bits_per_dimension<N>;
+	constexpr auto max_cells = static_cast<double>((std::uint64_t(1) << bits) - 1);
+
+	std::array<std::uint32_t, N> ans;
+	for(std::size_t i = 0; i < N; ++i) {
+		const double length = static_cast<double>(max_corner[i]) - static_cast<double>(min_corner[i]);
+		double scaled = 0;
+		if( length > 0 ) {
+			scaled = (static_cast<double>(point[i]) - static_cast<double>(min_corner[i])) / length;
+		}
+		scaled = std::clamp(scaled, 0.0, 1.0);
+		ans[i] = static_cast<std::uint32_t>(scaled * max_cells);
+	}
+	return ans;
+}
+
+namespace detail {
+
+/**
+ * Spread the low bits of a coordinate N-1 zeros apart
+ *
+ * Uses the shift and mask sequences for 2 and 3 dimensions
+ * and a loop over the bits otherwise.
+ */
+template<std::size_t N>
+key_type
+spread_bits(std::uint32_t value) noexcept {
+	key_type x = value;
+	if constexpr (N == 1) {
+		return x;
+	}
+	else if constexpr (N == 2) {
+		x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+		x = (x | (x <<  8)) & 0x00FF00FF00FF00FFull;
+		x = (x | (x <<  4)) & 0x0F0F0F0F0F0F0F0Full;
+		x = (x | (x <<  2)) & 0x3333333333333333ull;
+		x = (x | (x <<  1)) & 0x5555555555555555ull;
+		return x;
+	}
+	else if constexpr (N == 3) {
+		x &= 0x1FFFFFull;
+		x = (x | (x << 32)) & 0x001F00000000FFFFull;
+		x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+		x = (x | (x <<  8)) & 0x100F00F00F00F00Full;
+		x = (x | (x <<  4)) & 0x10C30C30C30C30C3ull;
+		x = (x | (x <<  2)) & 0x1249249249249249ull;
+		return x;
+	}
+	else {
+		key_type ans = 0;
+		for(unsigned b = 0; b < bits_per_dimension<N>; ++b) {
+			ans |= ((x >> b) & 1u) << (b * N);
+		}
+		return ans;
+	}
+}
+
+} /* namespace detail */
+
+/**
+ * Morton (Z-Order) key of integer grid coordinates
+ *
+ * Interleaves the bits of each coordinate with the
+ * most significant bit of the first dimension becoming
+ * the most significant bit of the key.
+ */
+template<std::size_t N>
+key_type
+morton(std::array<std::uint32_t, N> const& coord) noexcept {
+	key_type key = 0;
+	for(std::size_t i = 0; i < N; ++i) {
+		key |= detail::spread_bits<N>(coord[i]) << (N - 1 - i);
+	}
+	return key;
+}
+
+namespace detail {
+
+/**
+ * Hilbert keys of L integer grid coordinates at once
+ *
+ * Each lane runs the same branch free steps so the
+ * independent lanes overlap (or vectorize) in place of
+ * the long chain of dependent steps of a single key.
+ */
+template<std::size_t N, std::size_t L>
+void
+hilbert_lanes(std::array<std::uint32_t, N> const* coord, key_type* keys) noexcept {
+	constexpr auto bits = bits_per_dimension<N>;
+	const std::uint32_t M = std::uint32_t(1) << (bits - 1);
+
+	// First axis is held apart so the compiler sees it never aliases the others
+	std::uint32_t x0[L];
+	std::uint32_t x[N][L];
+	for(std::size_t l = 0; l < L; ++l) {
+		x0[l] = coord[l][0];
+		for(std::size_t i = 1; i < N; ++i) {
+			x[i][l] = coord[l][i];
+		}
+	}
+
+	// Inverse undo excess work
+	for(std::uint32_t Q = M; Q > 1; Q >>= 1) {
+		const std::uint32_t P = Q - 1;
+		for(std::size_t l = 0; l < L; ++l) {
+			x0[l] ^= P & (std::uint32_t(0) - ((x0[l] & Q) ? 1u : 0u));
+		}
+		for(std::size_t i = 1; i < N; ++i) {
+			for(std::size_t l = 0; l < L; ++l) {
+				const std::uint32_t set = std::uint32_t(0) - ((x[i][l] & Q) ? 1u : 0u);
+				x0[l] ^= P & set;
+				const std::uint32_t t = (x0[l] ^ x[i][l]) & P & ~set;
+				x0[l]   ^= t;
+				x[i][l] ^= t;
+			}
+		}
+	}
+
+	// Gray encode
+	for(std::size_t l = 0; l < L; ++l) {
+		std::uint32_t prev = x0[l];
+		for(std::size_t i = 1; i < N; ++i) {
+			x[i][l] ^= prev;
+			prev = x[i][l];
+		}
+	}
+	std::uint32_t t[L] = {};
+	for(std::uint32_t Q = M; Q > 1; Q >>= 1) {
+		for(std::size_t l = 0; l < L; ++l) {
+			const std::uint32_t last = (N > 1) ? x[N-1][l] : x0[l];
+			t[l] ^= (Q - 1) & (std::uint32_t(0) - ((last & Q) ? 1u : 0u));
+		}
+	}
+
+	// Transposed index is now the interleaved bits
+	for(std::size_t l = 0; l < L; ++l) {
+		std::array<std::uint32_t, N> transposed;
+		transposed[0] = x0[l] ^ t[l];
+		for(std::size_t i = 1; i < N; ++i) {
+			transposed[i] = x[i][l] ^ t[l];
+		}
+		keys[l] = morton(transposed);
+	}
+}
+
+} /* namespace detail */
+
+/**
+ * Hilbert key of integer grid coordinates
+ *
+ * Uses the transpose algorithm of Skilling (2004) "Programming
+ * the Hilbert curve" to convert the coordinates into the
+ * transposed Hilbert index which is then interleaved into a
+ * single key.
+ */
+template<std::size_t N>
+key_type
+hilbert(std::array<std::uint32_t, N> const& coord) noexcept {
+	key_type ans;
+	detail::hilbert_lanes<N, 1>(&coord, &ans);
+	return ans;
+}
+
+/**
+ * Tag to select a Morton (Z-Order) curve
+ */
+struct morton_tag final {};
+
+/**
+ * Tag to select a Hilbert curve
+ */
+struct hilbert_tag final {};
+
+/**
+ * Key of a location within a bounded domain
+ *
+ * @param[in] point      Location to calculate key for
+ * @param[in] min_corner Minimum corner of the domain
+ * @param[in] max_corner Maximum corner of the domain
+ */
+template<typename T, std::size_t N>
+key_type
+key(std::array<T, N> const& point, std::array<T, N> const& min_corner, std::array<T, N> const& max_corner, morton_tag) noexcept {
+	return morton(quantize(point, min_corner, max_corner));
+}
+
+template<typename T, std::size_t N>
+key_type
+key(std::array<T, N> const& point, std::array<T, N> const& min_corner, std::array<T, N> const& max_corner, hilbert_tag) noexcept {
+	return hilbert(quantize(point, min_corner, max_corner));
+}
+
+/**
+ * Keys of many locations within a bounded domain
+ *
+ * Same keys as key() of each point but Hilbert keys are
+ * calculated in blocks of lanes.
+ *
+ * @param[in]  points     Locations to calculate keys for
+ * @param[in]  min_corner Minimum corner of the domain
+ * @param[in]  max_corner Maximum corner of the domain
+ * @param[out] keys       Key of each point (same size as points)
+ */
+template<typename T, std::size_t N>
+void
+keys(std::span<const std::array<T, N>> points, std::array<T, N> const& min_corner, std::array<T, N> const& max_corner, std::span<key_type> keys, morton_tag tag) noexcept {
+	for(std::size_t i = 0; i < points.size(); ++i) {
+		keys[i] = key(points[i], min_corner, max_corner, tag);
+	}
+}
+
+template<typename T, std::size_t N>
+void
+keys(std::span<const std::array<T, N>> points, std::array<T, N> const& min_corner, std::array<T, N> const& max_corner, std::span<key_type> keys, hilbert_tag tag) noexcept {
+	constexpr std::size_t lanes = 32;  // Enough that the lane loops vectorize instead of unroll
+	std::array<std::array<std::uint32_t, N>, lanes> coord;
+
+	const std::size_t num_blocked = points.size() - (points.size() % lanes);
+	for(std::size_t i = 0; i < num_blocked; i += lanes) {
+		for(std::size_t l = 0; l < lanes; ++l) {
+			coord[l] = quantize(points[i + l], min_corner, max_corner);
+		}
+		detail::hilbert_lanes<N, lanes>(coord.data(), keys.data() + i);
+	}
+	for(std::size_t i = num_blocked; i < points.size(); ++i) {
+		keys[i] = key(points[i], min_corner, max_corner, tag);
+	}
+}
+
+/**
+ * Sort keys paired with a value by key
+ *
+ * Least significant digit radix sort which keeps the input order
+ * of equal keys. Passes where every key holds the same digit are
+ * skipped and short ranges use std::stable_sort.
+ *
+ * @param[in,out] keys Pairs of key and value to sort
+ */
+template<typename Value>
+void
+sort_keys(std::vector<std::pair<key_type, Value>>& keys) {
+	constexpr unsigned    digit_bits = 11;
+	constexpr std::size_t num_digits = std::size_t(1) << digit_bits;
+	constexpr key_type    digit_mask = num_digits - 1;
+
+	if( keys.size() < 256 ) {
+		std::stable_sort(keys.begin(), keys.end(), [](auto const& a, auto const& b){ return a.first < b.first; });
+		return;
+	}
+
+	// Count every digit of every pass at once
+	constexpr unsigned num_passes = (8 * sizeof(key_type) + digit_bits - 1) / digit_bits;
+	std::vector<std::size_t> counts(num_passes * num_digits, 0);
+	for(auto const& item : keys) {
+		for(unsigned p = 0; p < num_passes; ++p) {
+			++counts[p * num_digits + ((item.first >> (p * digit_bits)) & digit_mask)];
+		}
+	}
+
+	std::vector<std::pair<key_type, Value>> buffer(keys.size());
+	for(unsigned p = 0; p < num_passes; ++p) {
+		std::size_t* count = counts.data() + p * num_digits;
+		const auto shift = p * digit_bits;
+		if( count[(keys.front().first >> shift) & digit_mask] == keys.size() ) {
+			continue;
+		}
+		std::size_t offset = 0;
+		for(std::size_t d = 0; d < num_digits; ++d) {
+			offset += std::exchange(count[d], offset);
+		}
+		for(auto const& item : keys) {
+			buffer[count[(item.first >> shift) & digit_mask]++] = item;
+		}
+		keys.swap(buffer);
+	}
+}
+
+/**
+ * Order bounds along a space filling curve
+ *
+ * Fills order with the key and index of each bound center
+ * sorted along the curve through the domain of all centers.
+ *
+ * @param[in]  bounds Bounds to order
+ * @param[out] order  Key and index of each bound in curve order
+ */
+template<typename BoundType, typename CurveTag>
+void
+sort_centers(std::span<const BoundType> bounds, std::vector<std::pair<key_type, std::size_t>>& order, CurveTag tag) {
+	using point_type = typename BoundType::array_type;
+
+	order.clear();
+	if( bounds.empty() ) {
+		return;
+	}
+
+	// Domain of all centers to calculate keys within
+	point_type min_corner;
+	point_type max_corner;
+	for(std::size_t d = 0; d < BoundType::ndim; ++d) {
+		min_corner[d] = bounds[0].center(d);
+		max_corner[d] = bounds[0].center(d);
+	}
+	for(auto const& bound : bounds) {
+		for(std::size_t d = 0; d < BoundType::ndim; ++d) {
+			min_corner[d] = std::min(min_corner[d], bound.center(d));
+			max_corner[d] = std::max(max_corner[d], bound.center(d));
+		}
+	}
+
+	order.reserve(bounds.size());
+	for(std::size_t i = 0; i < bounds.size(); ++i) {
+		point_type center;
+		for(std::size_t d = 0; d < BoundType::ndim; ++d) {
+			center[d] = bounds[i].center(d);
+		}
+		order.emplace_back(key(center, min_corner, max_corner, tag), i);
+	}
+	sort_keys(order);
+}
+
+} /* namespace sfc */
+} /* namespace spatial */
+} /* namespace hopi */
@@ -13,7 +13,7 @@
 #pragma once
 
 
-#include "hopi/spatial/common/truncated_multiset.hpp"
+#include "hopi/spatial/common/bounded_heap.hpp"
 // #include "hopi/spatial/shared/predicate/dispatch.hpp"
 #include "hopi/spatial/shared/predicate/distance.hpp"
 // #include "hopi/spatial/shared/predicate/factories.hpp"
@@ -180,8 +180,7 @@ private:
 private:
 
 	bound_type const& _extract_bound(value_type const& value) const noexcept {
-		static const bound_extractor extract;
-		return extract(value);
+		return bound_extractor()(value);
 	}
 
 	template<typename Iterator>
@@ -230,22 +229,31 @@ private:
 	size_type _query_dispatch(Predicates const& pred, OutIter out_it, const std::true_type& /* is_distance_pred */) const noexcept {
 		constexpr auto bound_from_leaf = std::true_type();
 
-		// Get a multiset which ranks and automatically trims excess
+		// Quick return if nothing to be done
+		// - A heap keeping no values is always full with no worst()
+		if(pred.count() == 0) return 0;
+
+		// Get a heap which ranks and keeps only the nearest
 		using dist_value_pair = std::pair<bound_value_type, value_type>;
 		using pair_less_op    = LessPair<0>;
-		TruncatedMultiSet<dist_value_pair,pair_less_op> min_set(pred.count());
+		thread_local BoundedHeap<dist_value_pair,dynamic_count,pair_less_op> min_heap;
+		min_heap.reset(pred.count());
 
-		// Place all evaluated predicates into MultSet which ranks and limits size
+		// Place all evaluated predicates into heap which ranks and limits size
 		for(auto& value : this->_values){
-			min_set.emplace(pred(_extract_bound(value),bound_from_leaf),value);
+			const auto dist = pred(_extract_bound(value),bound_from_leaf);
+			if( not min_heap.full() or (dist < min_heap.worst().first) ) {
+				min_heap.emplace(dist,value);
+			}
 		}
 
-		// Copy results into provided output iterator
-		std::transform(std::cbegin(min_set), std::cend(min_set), out_it, [](auto& value_pair){
+		// Copy results nearest first into provided output iterator
+		min_heap.sort();
+		std::transform(std::cbegin(min_heap), std::cend(min_heap), out_it, [](auto& value_pair){
 			return value_pair.second;
 		});
 
-		return pred.count(); //min_set.size();
+		return min_heap.size();
 	}
 
 
@@ -0,0 +1,298 @@
+/// @file frozen.cpp
+/*
+ * Project:         HOPI
+ * File:            frozen.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/spatial/bound/point.hpp"
+#include "hopi/spatial/common/space_filling_curve.hpp"
+#include "hopi/spatial/shared/predicate/factories.hpp"
+
+#include <algorithm>  // std::copy_n
+#include <cmath>      // std::sqrt
+#include <cstddef>    // std::size_t
+#include <iterator>   // std::back_inserter
+#include <memory>     // std::shared_ptr
+#include <span>       // std::span
+#include <utility>    // std::move
+#include <vector>     // std::vector
+
+namespace hopi {
+namespace spatial {
+namespace shared {
+namespace index {
+
+/**
+ * Read only index which may be queried by many threads at once
+ *
+ * Takes ownership of a finished index and only exposes the
+ * const query interface. Copies share the same index making
+ * them cheap to hand to each thread.
+ *
+ * The index is moved in so no other handle can modify the
+ * Nodes while queries are running.
+ */
+template<typename Index>
+class Frozen final {
+
+	//-------------------------------------------------------------------------
+	// Types & Constants
+	//-------------------------------------------------------------------------
+public:
+	using index_type       = Index;
+	using value_type       = typename index_type::value_type;
+	using size_type        = typename index_type::size_type;
+	using bound_type       = typename index_type::bound_type;
+	using bound_reference  = typename index_type::bound_reference;
+	using bound_value_type = typename index_type::bound_value_type;
+
+	//-------------------------------------------------------------------------
+	// Constructors
+	//-------------------------------------------------------------------------
+
+	Frozen() = delete;
+
+	Frozen(const Frozen& other) = default;
+
+	Frozen(Frozen&& other) = default;
+
+	explicit Frozen(index_type&& index) :
+		index_(std::make_shared<const index_type>(std::move(index))) {
+	}
+
+	/**
+	 * Share an index which nothing else may modify
+	 *
+	 * (ie. one viewing a mapped snapshot)
+	 */
+	explicit Frozen(std::shared_ptr<const index_type> index) :
+		index_(std::move(index)) {
+	}
+
+	~Frozen() = default;
+
+	//-------------------------------------------------------------------------
+	// Assignment Operators
+	//-------------------------------------------------------------------------
+
+	Frozen& operator=(const Frozen& other) = default;
+
+	Frozen& operator=(Frozen&& other) = default;
+
+	//-------------------------------------------------------------------------
+	// Capacity
+	//-------------------------------------------------------------------------
+
+	bool empty() const noexcept {
+		return index_->empty();
+	}
+
+	//-------------------------------------------------------------------------
+	// Indexing
+	//-------------------------------------------------------------------------
+
+	index_type const& index() const noexcept {
+		return *index_;
+	}
+
+	bound_reference bounds() const noexcept {
+		return index_->bounds();
+	}
+
+	template<typename Predicates, typename OutIter>
+	size_type query(Predicates const& pred, OutIter out_it) const {
+		return index_->query(pred, out_it);
+	}
+
+	void query_batch(std::span<const bound_type> queries,
+	                 const size_type k,
+	                 std::vector<size_type>& offsets,
+	                 std::vector<value_type>& neighbors,
+	                 const size_type group_size = 8) const {
+		index_->query_batch(queries, k, offsets, neighbors, group_size);
+	}
+
+	/**
+	 * Find the K nearest values to each query using all threads
+	 *
+	 * Produces the same CSR results as query_batch. The queries
+	 * are Morton sorted and cut into chunks of chunk_size which
+	 * are handed out to the OpenMP threads as they become free.
+	 * Without OpenMP the chunks are searched in order.
+	 */
+	void parallel_query_batch(std::span<const bound_type> queries,
+	                          const size_type k,
+	                          std::vector<size_type>& offsets,
+	                          std::vector<value_type>& neighbors,
+	                          const size_type group_size = 8,
+	                          const size_type chunk_size = 1024) const {
+		using key_index_pair = std::pair<spatial::sfc::key_type, std::size_t>;
+
+		const auto num_queries = queries.size();
+		offsets.assign(num_queries + 1, 0);
+		neighbors.clear();
+		if( num_queries == 0 ) {
+			return;
+		}
+
+		// Sort queries along the Morton curve so each chunk is compact
+		std::vector<key_index_pair> order;
+		spatial::sfc::sort_centers(queries, order, spatial::sfc::morton_tag());
+		std::vector<bound_type> sorted_queries;
+		sorted_queries.reserve(num_queries);
+		for(auto const& key_index : order) {
+			sorted_queries.push_back(queries[key_index.second]);
+		}
+
+		const auto num_per_chunk = std::max<size_type>(chunk_size, 1);
+		const auto num_chunks    = (num_queries + num_per_chunk - 1) / num_per_chunk;
+		size_type  num_found     = 0;
+
+		// Search one chunk and place results at the original query locations
+		auto search_chunk = [&](const std::size_t chunk, std::vector<size_type>& chunk_offsets, std::vector<value_type>& chunk_neighbors) {
+			const auto first = chunk * num_per_chunk;
+			const auto count = std::min(num_per_chunk, num_queries - first);
+			index_->query_batch(std::span<const bound_type>(sorted_queries).subspan(first, count), k, chunk_offsets, chunk_neighbors, group_size);
+			for(std::size_t i = 0; i < count; ++i) {
+				std::copy_n(std::next(chunk_neighbors.cbegin(), chunk_offsets[i]),
+				            num_found,
+				            std::next(neighbors.begin(), order[first + i].second * num_found));
+			}
+		};
+
+		// First chunk finds how many values every query will have
+		// - Every query finds min(k, # of values)
+		std::vector<size_type>  chunk_offsets;
+		std::vector<value_type> chunk_neighbors;
+		index_->query_batch(std::span<const bound_type>(sorted_queries).subspan(0, 1), k, chunk_offsets, chunk_neighbors, group_size);
+		num_found = chunk_offsets[1];
+		neighbors.resize(num_queries * num_found);
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) firstprivate(chunk_offsets, chunk_neighbors)
+#endif
+		for(std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+			search_chunk(chunk, chunk_offsets, chunk_neighbors);
+		}
+
+		for(std::size_t i = 0; i <= num_queries; ++i) {
+			offsets[i] = i * num_found;
+		}
+	}
+
+	/**
+	 * Find the K nearest values to each query ranked in double
+	 *
+	 * Searches in the precision of the bounds for k + extra
+	 * candidates which are then ranked by their distance in
+	 * double. When the candidates do not reach past the rounding
+	 * error of the K'th (ie. many near ties) the query is instead
+	 * searched with a Box holding every value which could be among
+	 * the K nearest. The result matches a search done in double.
+	 */
+	void parallel_query_batch_exact(std::span<const bound_type> queries,
+	                                const size_type k,
+	                                std::vector<size_type>& offsets,
+	                                std::vector<value_type>& neighbors,
+	                                const size_type extra = 8,
+	                                const size_type group_size = 8,
+	                                const size_type chunk_size = 1024) const {
+		using leaf_bound    = typename index_type::leaf_bound;
+		using array_type    = typename bound_type::array_type;
+		using distance_pair = std::pair<double, value_type>;
+		constexpr auto NDim  = bound_type::ndim;
+		constexpr auto error = spatial::bound::distance_error_bound<bound_value_type, NDim>();
+
+		std::vector<size_type>  candidate_offsets;
+		std::vector<value_type> candidates;
+		this->parallel_query_batch(queries, k + extra, candidate_offsets, candidates, group_size, chunk_size);
+
+		const auto num_queries    = queries.size();
+		const auto num_candidates = (num_queries > 0) ? candidate_offsets[1] : size_type(0);
+		const auto num_found      = std::min(k, num_candidates);
+		const bool has_all        = (num_candidates < k + extra);
+		offsets.assign(num_queries + 1, 0);
+		neighbors.resize(num_queries * num_found);
+		for(std::size_t i = 0; i <= num_queries; ++i) {
+			offsets[i] = i * num_found;
+		}
+		if( num_found == 0 ) {
+			return;
+		}
+
+		// Distance between the query and a value in double
+		auto distance = [](bound_type const& query, value_type const& value) {
+			const auto bound = leaf_bound::bound(value);
+			double dist_sq = 0;
+			for(std::size_t d = 0; d < NDim; ++d) {
+				const double gap = std::max({0.0,
+				                             double(bound.min(d)) - double(query.max(d)),
+				                             double(query.min(d)) - double(bound.max(d))});
+				dist_sq += gap * gap;
+			}
+			return dist_sq;
+		};
+		auto by_distance = [](auto const& a, auto const& b) { return a.first < b.first; };
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+		for(std::size_t i = 0; i < num_queries; ++i) {
+			std::vector<distance_pair> ranked;
+			ranked.reserve(num_candidates);
+			for(size_type n = candidate_offsets[i]; n < candidate_offsets[i + 1]; ++n) {
+				ranked.emplace_back(distance(queries[i], candidates[n]), candidates[n]);
+			}
+
+			// Values beyond the candidates are at least the furthest
+			// candidate less the rounding error of the search
+			double furthest = 0;
+			for(auto const& pair : ranked) {
+				furthest = std::max(furthest, pair.first);
+			}
+			std::stable_sort(ranked.begin(), ranked.end(), by_distance);
+			const double kth = ranked[num_found - 1].first;
+			if( (not has_all) and (furthest * (1 - error) <= kth * (1 + error)) ) {
+				const double radius = std::sqrt(kth) * (1 + error);
+				array_type lo, hi;
+				for(std::size_t d = 0; d < NDim; ++d) {
+					lo[d] = bound_value_type(double(queries[i].min(d)) - radius);
+					hi[d] = bound_value_type(double(queries[i].max(d)) + radius);
+				}
+				bound_type search(lo, hi);
+				search.next_larger();
+
+				std::vector<value_type> found;
+				index_->query(predicate::Intersects(search), std::back_inserter(found));
+				ranked.clear();
+				for(auto const& value : found) {
+					ranked.emplace_back(distance(queries[i], value), value);
+				}
+				std::stable_sort(ranked.begin(), ranked.end(), by_distance);
+			}
+			std::transform(ranked.cbegin(), std::next(ranked.cbegin(), num_found), std::next(neighbors.begin(), offsets[i]), [](auto const& pair){
+				return pair.second;
+			});
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	// Data [Private]
+	//-------------------------------------------------------------------------
+private:
+	std::shared_ptr<const index_type> index_;
+};
+
+
+} /* namespace index */
+} /* namespace shared */
+} /* namespace spatial */
+} /* namespace hopi */
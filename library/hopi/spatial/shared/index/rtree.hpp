@@ -12,19 +12,38 @@
  */
 #pragma once
 
+#include "hopi/spatial/common/space_filling_curve.hpp"
 #include "hopi/spatial/shared/index/rtree/algorithm.hpp"
+#include "hopi/spatial/shared/index/rtree/arena.hpp"
+#include "hopi/spatial/shared/index/rtree/bulk_load.hpp"
+#include "hopi/spatial/shared/index/rtree/key_index.hpp"
 #include "hopi/spatial/shared/index/rtree/leaf.hpp"
 #include "hopi/spatial/shared/index/rtree/linear.hpp"
 #include "hopi/spatial/shared/index/rtree/node.hpp"
 #include "hopi/spatial/shared/index/rtree/page.hpp"
 #include "hopi/spatial/shared/index/rtree/quadratic.hpp"
+#include "hopi/spatial/shared/index/rtree/query_context.hpp"
+#include "hopi/spatial/shared/index/rtree/rstar.hpp"
+#include "hopi/spatial/shared/index/rtree/storage.hpp"
 
-#include "hopi/spatial/common/truncated_multiset.hpp"
+#include "hopi/spatial/shared/predicate/distance.hpp"
+#include "hopi/spatial/shared/predicate/spatial.hpp"
+
+#include "hopi/spatial/common/profile.hpp"
 // #include "hopi/spatial/shared/predicate/all.hpp"
 
 #include <algorithm>  // std::remove_if
+#include <array>      // std::array
+#include <bit>        // std::countr_zero
+#include <cassert>    // assert
+#include <concepts>   // std::constructible_from
+#include <cstdint>    // std::uint64_t
 #include <functional> // std::equal_to
+#include <iterator>   // std::back_inserter
+#include <limits>     // std::numeric_limits
 #include <memory>     // std::allocator
+#include <span>       // std::span
+#include <vector>     // std::vector
 
 namespace hopi {
 namespace spatial {
@@ -32,7 +51,29 @@ namespace shared {
 namespace index {
 
 
-
+/**
+ * R-Tree spatial index
+ *
+ * Thread Safety:
+ * The const member functions (query, query_batch, bounds, etc.)
+ * only read the tree and use thread local or caller provided
+ * working memory, so any number of threads may query a tree at
+ * once provided no thread modifies it. Wrap a finished tree in
+ * a Frozen index to enforce this.
+ *
+ * Moving Values:
+ * When the BoundGetter can return the key of a value the tree
+ * keeps a back index from each key to its Leaf so values can be
+ * updated or erased without searching the tree. The quality of
+ * the tree is measured every so many updates and the tree is
+ * re-packed once it has degraded by more than the rebuild ratio.
+ *
+ * Point Values:
+ * When the BoundGetter returns a point (std::array) instead of a
+ * Box the Leafs only hold the point and its degenerate Box is built
+ * when needed. Predicates test Leafs with the point kernels which
+ * read a single corner.
+ */
 template<typename Value,
 		 typename BoundGetter,
          typename Parameters  = rtree::Quadratic<10,4>,
@@ -45,11 +86,13 @@ class RTree final {
 	// Types & Constants
 	//-------------------------------------------------------------------------
 private:
-	using node_type            = rtree::Node<Value,BoundGetter>;
+	using storage_type         = rtree::Storage<Value,BoundGetter,Parameters,Allocator>;
+	using node_type            = typename storage_type::node_type;
 	using node_reference       = node_type&;
 	using const_node_reference = node_type const&;
-	using node_pointer         = std::shared_ptr<node_type>;
+	using node_pointer         = typename storage_type::node_pointer;
 	using Algorithm            = Parameters;
+	using key_index_type       = rtree::KeyIndex<Value,BoundGetter,node_pointer>;
 
 public:
 
@@ -64,8 +107,17 @@ public:
 	using parameters       = Parameters;
 	using equal_operator   = EqualOp;
 	using bound_extractor  = BoundGetter;
-	using bound_type       = typename bound_extractor::bound_type;
+	using leaf_bound       = rtree::LeafBound<BoundGetter>;
+	using bound_type       = typename leaf_bound::bound_type;
+	using bound_reference  = typename leaf_bound::bound_reference;
 	using bound_value_type = typename bound_type::value_type;
+	using raw_node_pointer = decltype(rtree::raw(std::declval<node_pointer>()));
+	using query_context    = rtree::QueryContext<raw_node_pointer, bound_value_type>;
+
+	template<std::size_t LeafCount>
+	using fixed_query_context = rtree::QueryContext<raw_node_pointer, bound_value_type, LeafCount>;
+
+	using batch_query_context = rtree::BatchQueryContext<raw_node_pointer, bound_value_type>;
 
 
 
@@ -73,21 +125,71 @@ public:
 	// Constructors
 	//-------------------------------------------------------------------------
 
-	RTree() = default;
+	RTree() : storage_(), root_node_ptr_(storage_.null_node()) {
+	}
 
-	RTree(const RTree& other) = default;
+	RTree(const RTree& other) :
+		storage_(other.storage_),
+		root_node_ptr_(storage_.rebind(other.root_node_ptr_)),
+		size_(other.size_),
+		baseline_ratio_(other.baseline_ratio_),
+		rebuild_ratio_(other.rebuild_ratio_) {
+	}
 
-	RTree(RTree&& other) = default;
+	RTree(RTree&& other) :
+		storage_(std::move(other.storage_)),
+		root_node_ptr_(storage_.rebind(other.root_node_ptr_)),
+		size_(other.size_),
+		baseline_ratio_(other.baseline_ratio_),
+		rebuild_ratio_(other.rebuild_ratio_) {
+		other.root_node_ptr_ = other.storage_.null_node();
+		other.size_          = 0;
+		other.key_index_.invalidate();
+	}
 
 	~RTree() = default;
 
+	/**
+	 * Construct a packed tree from a range of values
+	 *
+	 * Builds the tree bottom up using the packing policy
+	 * selected by the tag (rtree::STRPacking or rtree::HilbertPacking).
+	 */
+	template<typename Iterator, typename PackingTag>
+	RTree(Iterator first, Iterator last, PackingTag tag) : RTree() {
+		this->insert(first, last, tag);
+	}
+
 	//-------------------------------------------------------------------------
 	// Assignment Operators
 	//-------------------------------------------------------------------------
 
-	RTree& operator=(const RTree& box) = default;
+	RTree& operator=(const RTree& other) {
+		if( this != &other ) {
+			storage_        = other.storage_;
+			root_node_ptr_  = storage_.rebind(other.root_node_ptr_);
+			size_           = other.size_;
+			baseline_ratio_ = other.baseline_ratio_;
+			rebuild_ratio_  = other.rebuild_ratio_;
+			key_index_.invalidate();
+		}
+		return *this;
+	}
 
-	RTree& operator=(RTree&& box) = default;
+	RTree& operator=(RTree&& other) {
+		if( this != &other ) {
+			storage_             = std::move(other.storage_);
+			root_node_ptr_       = storage_.rebind(other.root_node_ptr_);
+			size_                = other.size_;
+			baseline_ratio_      = other.baseline_ratio_;
+			rebuild_ratio_       = other.rebuild_ratio_;
+			other.root_node_ptr_ = other.storage_.null_node();
+			other.size_          = 0;
+			key_index_.invalidate();
+			other.key_index_.invalidate();
+		}
+		return *this;
+	}
 
 
 	//-------------------------------------------------------------------------
@@ -95,8 +197,16 @@ public:
 	//-------------------------------------------------------------------------
 
 	void insert(value_type const& value) {
-		auto new_leaf = std::make_shared<node_type>(value);
-		root_node_ptr_ = Algorithm::insert(root_node_ptr_,new_leaf);
+		this->grow_root_();
+		auto new_leaf = rtree::make_leaf(root_node_ptr_, value);
+		if constexpr ( Algorithm::reinsert_count > 0 ) {
+			root_node_ptr_ = Algorithm::reinsert(root_node_ptr_,new_leaf,Algorithm::reinsert_count);
+		}
+		else {
+			root_node_ptr_ = Algorithm::insert(root_node_ptr_,new_leaf);
+		}
+		key_index_.insert(new_leaf);
+		++size_;
 	}
 
 	template<typename Iterator>
@@ -107,21 +217,243 @@ public:
 		};
 	}
 
-	void remove(value_type const& value) {
-		auto del_leaf = std::make_shared<node_type>(value);
-		root_node_ptr_ = Algorithm::remove(root_node_ptr_,del_leaf);
+	/**
+	 * Bulk load a range of values
+	 *
+	 * Rebuilds the tree bottom up using the packing policy
+	 * selected by the tag (rtree::STRPacking or rtree::HilbertPacking).
+	 * Any values already within the tree are packed along with
+	 * the new values.
+	 */
+	template<typename Iterator, typename PackingTag>
+	void insert(Iterator first, Iterator last, PackingTag tag) {
+		if( root_node_ptr_ ) {
+			auto values = this->values_();
+			values.insert(values.end(), first, last);
+			this->pack_(values.begin(), values.end(), tag);
+		}
+		else {
+			this->pack_(first, last, tag);
+		}
+	}
+
+	/**
+	 * Remove every value equal to the one provided
+	 *
+	 * With a back index only the Leaf holding the key is tested.
+	 *
+	 * @returns Number of values removed
+	 */
+	size_type remove(value_type const& value) {
+		const auto is_equal = [&](const node_pointer& leaf){
+			return equal_operator()(leaf->getValue(), value);
+		};
+
+		if constexpr ( key_index_type::enabled ) {
+			auto leaf = this->find_leaf_(bound_extractor().key(value));
+			if( leaf and is_equal(leaf) ) {
+				this->erase_leaf_(leaf);
+				return 1;
+			}
+			return 0;
+		}
+		else {
+			size_type count = 0;
+			while( root_node_ptr_ ) {
+				auto leaf = root_node_ptr_->isLeaf() ? root_node_ptr_ : Algorithm::find_leaf(root_node_ptr_, leaf_bound::bound(value), is_equal);
+				if( not (leaf and is_equal(leaf)) ) {
+					break;
+				}
+				this->erase_leaf_(leaf);
+				++count;
+			}
+			return count;
+		}
 	}
 
 	template<typename Iterator>
-	void remove(Iterator first, Iterator last) {
+	size_type remove(Iterator first, Iterator last) {
+		size_type count = 0;
+		while(first != last) {
+			count += this->remove(*first);
+			++first;
+		};
+		return count;
+	}
+
+	/**
+	 * Remove the value with the key
+	 *
+	 * Requires a BoundGetter which returns the key of a value.
+	 *
+	 * @returns True if a value was removed
+	 */
+	template<typename Key>
+	requires key_index_type::enabled
+	bool erase(Key const& key) {
+		auto leaf = this->find_leaf_(key);
+		if( not leaf ) {
+			return false;
+		}
+		this->erase_leaf_(leaf);
+		return true;
+	}
+
+	/**
+	 * Replace the value with the same key
+	 *
+	 * Values which remain near their Page are changed in place.
+	 * Otherwise the Leaf is detached and placed again using R* style
+	 * forced reinsertion which keeps the tree from degrading as the
+	 * values move. Requires a BoundGetter which returns the key of a value.
+	 *
+	 * @returns True if a value with the key was found
+	 */
+	bool update(value_type const& value) {
+		static_assert(key_index_type::enabled, "RTree::update requires a BoundGetter with a key(value) function");
+		auto leaf = this->find_leaf_(bound_extractor().key(value));
+		if( not leaf ) {
+			return false;
+		}
+		this->move_leaf_(leaf, value);
+		this->check_quality_();
+		return true;
+	}
+
+	/**
+	 * Replace the bound of the value with the key
+	 */
+	template<typename Key>
+	requires key_index_type::enabled and std::constructible_from<value_type, bound_type const&, Key const&>
+	bool update(Key const& key, bound_type const& bound) {
+		return this->update(value_type(bound, key));
+	}
+
+	/**
+	 * Replace a range of values
+	 *
+	 * Re-packing is cheaper than moving Leafs one at a time when a
+	 * large share of the tree changes so such ranges are written
+	 * into their Leafs in place followed by a rebuild.
+	 *
+	 * @returns Number of values found and updated
+	 */
+	template<typename Iterator>
+	size_type update(Iterator first, Iterator last) {
+		size_type count = 0;
+		if constexpr ( std::forward_iterator<Iterator> ) {
+			if( (size_ > 0) and (size_type(4 * std::distance(first, last)) >= size_) ) {
+				for(; first != last; ++first) {
+					auto leaf = this->find_leaf_(bound_extractor().key(*first));
+					if( leaf ) {
+						leaf->setValue(*first);
+						++count;
+					}
+				}
+				this->rebuild();
+				return count;
+			}
+		}
 		while(first != last) {
-			this->remove(*first);
+			count += this->update(*first);
 			++first;
 		};
+		return count;
+	}
+
+	/**
+	 * Re-pack all values within the tree
+	 */
+	template<typename PackingTag = rtree::STRPacking>
+	void rebuild(PackingTag tag = PackingTag()) {
+		if( root_node_ptr_ ) {
+			auto values = this->values_();
+			this->pack_(values.begin(), values.end(), tag);
+		}
+	}
+
+	/**
+	 * Set the degradation which triggers a rebuild
+	 *
+	 * The tree is re-packed once leaf_margin_ratio grows by more
+	 * than ratio times its value after the last bulk load. A ratio
+	 * of zero never triggers a rebuild.
+	 */
+	void set_rebuild_ratio(const double ratio) noexcept {
+		rebuild_ratio_ = ratio;
+	}
+
+	/**
+	 * Remove all values from the tree
+	 *
+	 * Arena storage keeps the memory for re-use making
+	 * clear O(1) for trivially destructible values.
+	 */
+	void clear() noexcept {
+		storage_.clear();
+		root_node_ptr_ = storage_.null_node();
+		size_          = 0;
+		num_updates_   = 0;
+		key_index_.invalidate();
+	}
+
+	//-------------------------------------------------------------------------
+	// Snapshots
+	//-------------------------------------------------------------------------
+
+	/**
+	 * Number of sections written by save
+	 */
+	static constexpr std::size_t snapshot_sections = 5;
+
+	/**
+	 * Numbers describing the layout a snapshot must have been saved from
+	 */
+	static constexpr std::array<std::uint64_t, 7> snapshot_layout() noexcept {
+		using arena_type = typename storage_type::arena_type;
+		return {sizeof(typename arena_type::PageRecord),
+		        sizeof(typename arena_type::LeafRecord),
+		        arena_type::capacity,
+		        sizeof(value_type),
+		        sizeof(bound_value_type),
+		        bound_type::ndim,
+		        leaf_bound::is_point};
+	}
+
+	/**
+	 * Write the tree as snapshot_sections sections
+	 *
+	 * Requires ArenaAllocator storage whose Pages and Leafs
+	 * are pointer free and written as is.
+	 */
+	template<typename Writer>
+	void save(Writer& writer) const {
+		static_assert(rtree::is_arena_storage<storage_type>::value, "Snapshots require ArenaAllocator storage");
+		const snapshot_record record{root_node_ptr_.index(), size_, num_updates_, baseline_ratio_, rebuild_ratio_};
+		writer.write_section(std::span<const snapshot_record>(&record, 1));
+		storage_.arena.save(writer);
 	}
 
-	void clear() const noexcept {
-		root_node_ptr_.reset();
+	/**
+	 * Replace the tree by a view of the sections written by save
+	 *
+	 * The Pages and Leafs are queried in place within the mapping
+	 * so viewing costs the same whatever the size of the tree.
+	 * They are copied out of the mapping (copy on write) only
+	 * once the tree is modified.
+	 */
+	template<typename Mapping>
+	void view(std::shared_ptr<const Mapping> const& mapping) {
+		static_assert(rtree::is_arena_storage<storage_type>::value, "Snapshots require ArenaAllocator storage");
+		assert(mapping->size() == snapshot_sections);
+		const auto record = mapping->template section_as<const snapshot_record>(0).front();
+		this->clear();
+		storage_.arena.view(mapping, 1);
+		root_node_ptr_  = node_pointer(&storage_.arena, record.root);
+		size_           = record.size;
+		num_updates_    = record.num_updates;
+		baseline_ratio_ = record.baseline_ratio;
+		rebuild_ratio_  = record.rebuild_ratio;
 	}
 
 	//-------------------------------------------------------------------------
@@ -134,11 +466,11 @@ public:
 	//-------------------------------------------------------------------------
 
 	size_type size() const noexcept {
-		return 0;
+		return size_;
 	}
 
 	bool empty() const noexcept {
-		return (root_node_ptr_);
+		return not root_node_ptr_;
 	}
 
 	constexpr size_type max_size() const noexcept {
@@ -149,26 +481,187 @@ public:
 	// Indexing
 	//-------------------------------------------------------------------------
 
-	bound_type const& bounds() const noexcept {
+	bound_reference bounds() const noexcept {
 		return root_node_ptr_->getBound();
 	}
 
+	/**
+	 * Quality of the tree
+	 *
+	 * Mean margin (sum of edge lengths) of the Pages holding Leafs
+	 * relative to the margin of the whole tree. Smaller is better
+	 * and the ratio does not change when all values are scaled.
+	 */
+	double leaf_margin_ratio() const {
+		if( (not root_node_ptr_) or root_node_ptr_->isLeaf() ) {
+			return 0;
+		}
+		const auto margin = [](bound_type const& bound){
+			double sum = 0;
+			for(std::size_t d = 0; d < bound.ndim; ++d){
+				sum += bound.length(d);
+			}
+			return sum;
+		};
+
+		double    sum_margin = 0;
+		size_type num_pages  = 0;
+		std::vector<node_pointer> candidate_nodes;
+		candidate_nodes.push_back(root_node_ptr_);
+		while(candidate_nodes.size() > 0){
+			node_pointer current_node = candidate_nodes.back();
+			candidate_nodes.pop_back();
+			if( (current_node->size() == 0) or current_node->front()->isLeaf() ) {
+				sum_margin += margin(current_node->getBound());
+				++num_pages;
+			}
+			else {
+				std::copy(current_node->begin(), current_node->end(), std::back_inserter(candidate_nodes));
+			}
+		}
+		const auto root_margin = margin(root_node_ptr_->getBound());
+		return (root_margin > 0) ? sum_margin / (num_pages * root_margin) : 0;
+	}
+
+	/**
+	 * Query the tree for all values matching the predicate
+	 *
+	 * Uses a thread local query_context so no memory is allocated
+	 * once the context has grown to the size needed. The output
+	 * iterator must not query another tree of this type.
+	 */
 	template<typename Predicates, typename OutIter>
-	size_type query(Predicates const& pred, OutIter out_it) const noexcept {
-		return query_dispatch(pred,out_it, predicate::is_distance_predicate<Predicates>());
+	size_type query(Predicates const& pred, OutIter out_it) const {
+		thread_local query_context context;
+		return this->query(pred, out_it, context);
+	}
+
+	/**
+	 * Query the tree using a caller provided context
+	 *
+	 * A fixed_query_context must hold at least as many Leafs
+	 * as requested by a distance predicate.
+	 */
+	template<typename Predicates, typename OutIter, std::size_t LeafCount>
+	size_type query(Predicates const& pred, OutIter out_it, rtree::QueryContext<raw_node_pointer, bound_value_type, LeafCount>& context) const {
+		context.clear();
+		return query_dispatch(pred,out_it, context, predicate::is_distance_predicate<Predicates>());
 	}
 
+	/**
+	 * Find the K nearest values to each of a batch of queries
+	 *
+	 * Results are written CSR style where the values nearest to
+	 * queries[i] are neighbors[offsets[i]] to neighbors[offsets[i+1]-1]
+	 * ordered nearest first. The queries are Morton sorted and
+	 * searched in groups of group_size so the upper levels of the
+	 * tree are visited once per group instead of once per query.
+	 *
+	 * Uses a thread local batch_query_context.
+	 */
+	void query_batch(std::span<const bound_type> queries,
+	                 const size_type k,
+	                 std::vector<size_type>& offsets,
+	                 std::vector<value_type>& neighbors,
+	                 const size_type group_size = 8) const {
+		thread_local batch_query_context context;
+		this->query_batch(queries, k, offsets, neighbors, context, group_size);
+	}
+
+	/**
+	 * Find the K nearest values to each of a batch of queries
+	 * using a caller provided context
+	 */
+	void query_batch(std::span<const bound_type> queries,
+	                 const size_type k,
+	                 std::vector<size_type>& offsets,
+	                 std::vector<value_type>& neighbors,
+	                 batch_query_context& context,
+	                 const size_type group_size = 8) const {
+		const auto num_queries = queries.size();
+		offsets.assign(num_queries + 1, 0);
+		neighbors.clear();
+		if( (num_queries == 0) or (k == 0) or (not root_node_ptr_) ) {
+			return;
+		}
+		context.clear();
+
+		// Sort queries along the Morton curve
+		auto& order = context.order;
+		spatial::sfc::sort_centers(queries, order, spatial::sfc::morton_tag());
+
+		// Search each group of queries
+		// - Every query finds min(k, # of values) so the count is known after the first group
+		const auto num_in_group = std::max<size_type>(group_size, 1);
+		if( context.leaf_heaps.size() < num_in_group ) {
+			context.leaf_heaps.resize(num_in_group);
+		}
+		size_type num_found = 0;
+		for(std::size_t first = 0; first < num_queries; first += num_in_group) {
+			const auto last = std::min(first + num_in_group, num_queries);
+			this->query_group(queries, k, first, last, context);
+
+			if( first == 0 ) {
+				num_found = context.leaf_heaps[0].size();
+				neighbors.resize(num_queries * num_found);
+			}
+			for(std::size_t j = first; j < last; ++j) {
+				auto& heap = context.leaf_heaps[j - first];
+				assert(heap.size() == num_found);
+				heap.sort();
+				auto out_it = std::next(neighbors.begin(), order[j].second * num_found);
+				std::transform(heap.cbegin(), heap.cend(), out_it, [](auto& value_pair){
+					return value_pair.second->getValue();
+				});
+			}
+		}
+		for(std::size_t i = 0; i <= num_queries; ++i) {
+			offsets[i] = i * num_found;
+		}
+	}
 
 	void display() const {
 		Algorithm::Diagnostics(root_node_ptr_);
 	}
 
+	/**
+	 * Depth first visit of every Page and Leaf
+	 *
+	 * Calls enter(bound) before and leave() after the children of
+	 * each Page and leaf(value) for each Leaf, so a pointer-free
+	 * copy of the tree can be laid out in depth first order.
+	 */
+	template<typename Enter, typename Leave, typename Visit>
+	void walk(Enter&& enter, Leave&& leave, Visit&& leaf) const {
+		if( root_node_ptr_ ) {
+			walk_(root_node_ptr_, enter, leave, leaf);
+		}
+	}
+
 
 	//-------------------------------------------------------------------------
 	// Data [Private]
 	//-------------------------------------------------------------------------
 private:
-	node_pointer root_node_ptr_;
+
+	/**
+	 * Scalars of the tree written as the first snapshot section
+	 */
+	struct snapshot_record {
+		std::uint64_t root;
+		std::uint64_t size;
+		std::uint64_t num_updates;
+		double        baseline_ratio;
+		double        rebuild_ratio;
+	};
+
+	storage_type   storage_;
+	node_pointer   root_node_ptr_;
+	size_type      size_ = 0;
+	key_index_type key_index_;
+	size_type      num_updates_    = 0;   // Updates since the quality was measured
+	double         baseline_ratio_ = 0;   // leaf_margin_ratio after the last bulk load
+	double         rebuild_ratio_  = 1.5;
 
 
 	//-------------------------------------------------------------------------
@@ -176,99 +669,508 @@ private:
 	//-------------------------------------------------------------------------
 private:
 
-	template<typename Predicates, typename OutIter>
-	size_type query_dispatch(Predicates const& pred, OutIter out_it, const std::false_type& /* is_distance_pred */) const noexcept {
+	/**
+	 * Replace the tree with a packed tree of the values
+	 */
+	template<typename Iterator, typename PackingTag>
+	void pack_(Iterator first, Iterator last, PackingTag tag) {
+		using rtree_bulk_load = rtree::BulkLoad<Parameters>;
+		this->clear();
+		size_           = std::distance(first, last);
+		root_node_ptr_  = rtree_bulk_load::build(root_node_ptr_, first, last, tag);
+		baseline_ratio_ = this->leaf_margin_ratio();
+	}
+
+	/**
+	 * Copy of every value within the tree
+	 *
+	 * Visits the Leafs without testing bounds so it
+	 * remains correct while Page bounds are out of date.
+	 */
+	std::vector<value_type> values_() const {
+		std::vector<value_type> values;
+		values.reserve(size_);
+		if( not root_node_ptr_ ) {
+			return values;
+		}
+		std::vector<node_pointer> candidate_nodes;
+		candidate_nodes.push_back(root_node_ptr_);
+		while(candidate_nodes.size() > 0){
+			node_pointer current_node = candidate_nodes.back();
+			candidate_nodes.pop_back();
+			if( current_node->isLeaf() ) {
+				values.push_back(current_node->getValue());
+			}
+			else {
+				std::copy(current_node->begin(), current_node->end(), std::back_inserter(candidate_nodes));
+			}
+		}
+		return values;
+	}
+
+	/**
+	 * Visit the subtree below node for walk
+	 */
+	template<typename Node, typename Enter, typename Leave, typename Visit>
+	static void walk_(Node const& node, Enter& enter, Leave& leave, Visit& leaf) {
+		if( node->isLeaf() ) {
+			leaf(node->getValue());
+			return;
+		}
+		enter(node->getBound());
+		for(auto const& child : *node){
+			walk_(child, enter, leave, leaf);
+		}
+		leave();
+	}
+
+	/**
+	 * Place a root Leaf within a Page so values can be inserted
+	 */
+	void grow_root_() {
+		if( root_node_ptr_ and root_node_ptr_->isLeaf() ) {
+			auto page_ptr = rtree::make_page(root_node_ptr_);
+			page_ptr->insert(root_node_ptr_);
+			root_node_ptr_ = page_ptr;
+		}
+	}
+
+	/**
+	 * Leaf holding the key (building the back index if needed)
+	 */
+	template<typename Key>
+	node_pointer find_leaf_(Key const& key) {
+		if( not key_index_.valid() ) {
+			key_index_.build(root_node_ptr_);
+		}
+		return key_index_.find(key);
+	}
+
+	/**
+	 * Remove a Leaf from the tree and release it
+	 */
+	void erase_leaf_(node_pointer leaf) {
+		key_index_.erase(leaf);
+		if( --size_ == 0 ) {
+			this->clear();
+			return;
+		}
+		if( leaf->hasParent() ) {
+			root_node_ptr_ = Algorithm::detach(leaf);
+		}
+		rtree::release(leaf);
+	}
+
+	/**
+	 * Replace the value within a Leaf and re-position it
+	 *
+	 * A Leaf which remains within its parent or grandparent Page
+	 * stays where it is and only the Pages whose bounds changed are
+	 * re-stretched. Otherwise it is detached and placed again.
+	 */
+	void move_leaf_(node_pointer leaf, value_type const& value) {
+		using spatial::bound::Contains;
+		if( not leaf->hasParent() ) {
+			leaf->setValue(value);
+			return;
+		}
+
+		node_pointer current_node(leaf->getParent());
+		const auto& new_bound = leaf_bound::bound(value);
+		const bool stays = Contains(current_node->getBound(), new_bound) or
+		                   (current_node->hasParent() and Contains(current_node->getParent()->getBound(), new_bound));
+		if( stays ) {
+			leaf->setValue(value);
+			while( true ) {
+				const auto old_bound = current_node->getBound();
+				current_node->restretch();
+				if( (current_node->getBound() == old_bound) or (not current_node->hasParent()) ) {
+					break;
+				}
+				current_node = current_node->getParent();
+			}
+			return;
+		}
+
+		root_node_ptr_ = Algorithm::detach(leaf);
+		leaf->setValue(value);
+		if( root_node_ptr_->size() == 0 ) {
+			root_node_ptr_->insert(leaf);
+		}
+		else {
+			constexpr auto num_reinsert = std::max<size_type>(1, (3 * Algorithm::max_children) / 10);
+			root_node_ptr_ = Algorithm::reinsert(root_node_ptr_, leaf, num_reinsert);
+		}
+	}
+
+	/**
+	 * Bounds of the Leafs of a Page as tested by predicates
+	 *
+	 * Only the minimum corners are read for point values.
+	 */
+	template<typename PagePtr>
+	static decltype(auto) leaf_bounds_(PagePtr const& page) noexcept {
+		if constexpr ( leaf_bound::is_point ) {
+			return spatial::bound::as_points(page->child_bounds());
+		}
+		else {
+			return page->child_bounds();
+		}
+	}
+
+	/**
+	 * Measure the tree every so many updates and rebuild if degraded
+	 */
+	void check_quality_() {
+		if( ++num_updates_ < std::max<size_type>(size_ / 16, 64) ) {
+			return;
+		}
+		num_updates_ = 0;
+		const auto ratio = this->leaf_margin_ratio();
+		if( baseline_ratio_ <= 0 ) {
+			baseline_ratio_ = ratio;
+		}
+		else if( (rebuild_ratio_ > 0) and (ratio > rebuild_ratio_ * baseline_ratio_) ) {
+			this->rebuild();
+		}
+	}
+
+	template<typename Predicates, typename OutIter, typename Context>
+	size_type query_dispatch(Predicates const& pred, OutIter out_it, Context& context, const std::false_type& /* is_distance_pred */) const {
 
 		// Quick return if nothing to be done
 		if(!root_node_ptr_) return 0;
 
+		// Test all children of a Page at once if bounds are in a BoxArray
+		if constexpr ( rtree::has_child_bounds<node_pointer>::value ) {
+			return query_child_bounds(pred, out_it, context);
+		}
+
 		// Get stack for searching
-		std::list<node_pointer> candidate_nodes;
+		auto& candidate_nodes = context.node_stack;
+		spatial::profile::QueryCounter counter("rtree.spatial", size_);
 
 		// Iterate over stack till all pages are processed
 		size_type count = 0;
-		candidate_nodes.push_back(root_node_ptr_);
+		candidate_nodes.push_back(rtree::raw(root_node_ptr_));
 		while(candidate_nodes.size() > 0){
 
-			auto const& current_candidate = candidate_nodes.front();
+			const auto current_candidate = candidate_nodes.back();
+			candidate_nodes.pop_back();
 			auto candidate_is_leaf = current_candidate->isLeaf();
+			if( candidate_is_leaf ) {
+				counter.test();
+			}
 
-			if( pred(current_candidate->getBound(), candidate_is_leaf) ) {
+			if( candidate_is_leaf ? pred(current_candidate->getLeafBound(), std::true_type()) :
+			                        pred(current_candidate->getBound(), std::false_type()) ) {
 				if( candidate_is_leaf ){
 					*out_it = current_candidate->getValue();
 					++out_it;
 					++count;
 				}
 				else {
-					for(auto& child : *current_candidate){
-						candidate_nodes.push_back(child);
+					counter.visit();
+					for(auto const& child : *current_candidate){
+						candidate_nodes.push_back(rtree::raw(child));
 					}
 				}
 			}
-			candidate_nodes.pop_front();
 		}
+		counter.found(count);
 		return count;
 	}
 
+	/**
+	 * Spatial query testing all children of a Page at once
+	 *
+	 * Only Pages which passed the predicate are placed on
+	 * the stack so each bound is tested exactly once.
+	 */
+	template<typename Predicates, typename OutIter, typename Context>
+	size_type query_child_bounds(Predicates const& pred, OutIter out_it, Context& context) const {
+		spatial::profile::QueryCounter counter("rtree.spatial", size_);
 
-	template<typename Predicates, typename OutIter>
-	size_type query_dispatch(Predicates const& pred, OutIter out_it, const std::true_type& /* is_distance_pred */) const noexcept {
-		constexpr auto bound_from_leaf = std::true_type();
-		constexpr auto bound_from_page = std::false_type();
+		// Root is the only bound not held by a parent
+		const auto root_is_leaf = root_node_ptr_->isLeaf();
+		if( root_is_leaf ) {
+			counter.test();
+		}
+		if( root_is_leaf ? not pred(root_node_ptr_->getLeafBound(), std::true_type()) :
+		                   not pred(root_node_ptr_->getBound(), std::false_type()) ) {
+			return 0;
+		}
+		if( root_is_leaf ) {
+			*out_it = root_node_ptr_->getValue();
+			++out_it;
+			counter.found(1);
+			return 1;
+		}
+
+		// Get stack for searching
+		auto& candidate_nodes = context.node_stack;
+
+		// Iterate over stack till all pages are processed
+		size_type count = 0;
+		candidate_nodes.push_back(rtree::raw(root_node_ptr_));
+		while(candidate_nodes.size() > 0){
+
+			const auto current_candidate = candidate_nodes.back();
+			candidate_nodes.pop_back();
+
+			const auto num_children = current_candidate->size();
+			counter.visit();
+			if( num_children > 0 ) {
+				const auto children_are_leafs = current_candidate->front()->isLeaf();
+				if( children_are_leafs ) {
+					counter.test(num_children);
+				}
+				auto passed = children_are_leafs ? pred(leaf_bounds_(current_candidate), num_children, std::true_type()) :
+				                                   pred(current_candidate->child_bounds(), num_children, std::false_type());
+				while( passed ) {
+					const auto i = std::countr_zero(passed);
+					passed &= (passed - 1);
+					if( children_are_leafs ) {
+						*out_it = current_candidate->child(i)->getValue();
+						++out_it;
+						++count;
+					}
+					else {
+						candidate_nodes.push_back(current_candidate->child(i));
+					}
+				}
+			}
+		}
+		counter.found(count);
+		return count;
+	}
+
+
+	template<typename Predicates, typename OutIter, typename Context>
+	size_type query_dispatch(Predicates const& pred, OutIter out_it, Context& context, const std::true_type& /* is_distance_pred */) const {
+		using node_order = typename Context::MinDistanceOnTop;
 
 		// Quick return if nothing to be done
 		if(!root_node_ptr_) return 0;
+		if(pred.count() == 0) return 0;
 
-		// Get 2 truncated stacks for searching
-		using pair_less_op       = LessPair<0>;
-		using dist_node_ptr_pair = std::pair<bound_value_type, node_pointer>;
-		std::multiset<dist_node_ptr_pair,pair_less_op>     candidate_nodes;
-		TruncatedMultiSet<dist_node_ptr_pair,pair_less_op> candidate_leafs(pred.count());
+		// Get 2 heaps for searching
+		// - candidate_nodes has the nearest Node on top
+		// - candidate_leafs has the furthest of the K nearest Leafs on top
+		auto& candidate_nodes = context.node_heap;
+		auto& candidate_leafs = context.leaf_heap;
+		candidate_leafs.reset(pred.count());
+		spatial::profile::QueryCounter counter("rtree.nearest", size_);
 
 		// Insert the Root Node into the candidate_nodes
 		auto distance_threshhold = std::numeric_limits<bound_value_type>::max();
-		auto current_candidate   = node_pointer(nullptr);
-		auto is_leaf             = root_node_ptr_->isLeaf();
-		auto dist                = pred(root_node_ptr_->getBound(), is_leaf);
-		candidate_nodes.emplace(dist,root_node_ptr_);
+		if( root_node_ptr_->isLeaf() ) {
+			candidate_nodes.emplace_back(pred(root_node_ptr_->getLeafBound(), std::true_type()), rtree::raw(root_node_ptr_));
+			counter.test();
+		}
+		else {
+			candidate_nodes.emplace_back(pred(root_node_ptr_->getBound(), std::false_type()), rtree::raw(root_node_ptr_));
+		}
 
-		// Iterate over stack till all pages are processed
+		// Iterate over heap till all possible candidates are processed
 		while(candidate_nodes.size() > 0){
 
-			auto front        = candidate_nodes.begin();
-			dist              = front->first;
-			current_candidate = front->second;
-			candidate_nodes.erase(front);
-
-			// Ensure the current_candidate is still a possible candidate
-			if( dist <= distance_threshhold ) {
-
-				// If Leaf
-				// - Place into the Leaf set
-				// - If we have K leafs then update the new distance tolerance
-				if( current_candidate->isLeaf() ) {
-					candidate_leafs.emplace(dist,current_candidate);
-					if(candidate_leafs.size() >= pred.count()) {
-						distance_threshhold = candidate_leafs.crbegin()->first;
+			std::pop_heap(candidate_nodes.begin(), candidate_nodes.end(), node_order());
+			const auto [dist, current_candidate] = candidate_nodes.back();
+			candidate_nodes.pop_back();
+
+			// Nearest remaining candidate is too far so all others are
+			if( dist > distance_threshhold ) {
+				break;
+			}
+
+			// If Leaf
+			// - Place into the Leaf heap keeping only the K nearest
+			// - If we have K leafs then update the new distance tolerance
+			if( current_candidate->isLeaf() ) {
+				if( candidate_leafs.push(std::make_pair(dist, current_candidate)) and candidate_leafs.full() ) {
+					distance_threshhold = candidate_leafs.worst().first;
+				}
+				continue;
+			}
+			counter.visit();
+			if constexpr ( rtree::has_child_bounds<node_pointer>::value ) {
+				// Measure all children at once keeping the possible candidates
+				const auto num_children = current_candidate->size();
+				if( num_children > 0 ) {
+					const auto children_are_leafs = current_candidate->front()->isLeaf();
+					if( children_are_leafs ) {
+						counter.test(num_children);
+					}
+					typename std::decay_t<decltype(current_candidate->child_bounds())>::value_array child_dist;
+					if( children_are_leafs ) {
+						pred(leaf_bounds_(current_candidate), num_children, true, child_dist);
+					}
+					else {
+						pred(current_candidate->child_bounds(), num_children, false, child_dist);
+					}
+					for(size_type i = 0; i < num_children; ++i){
+						if( child_dist[i] <= distance_threshhold ) {
+							candidate_nodes.emplace_back(child_dist[i], current_candidate->child(i));
+							std::push_heap(candidate_nodes.begin(), candidate_nodes.end(), node_order());
+						}
 					}
 				}
-				else {
-					// Loop over children into the candidates
-					for(auto& child : *current_candidate){
-						dist = pred(child->getBound(), child->isLeaf());
-						candidate_nodes.emplace(dist,child);
+			}
+			else {
+				// Loop over children into the candidates
+				for(auto const& child : *current_candidate){
+					if( child->isLeaf() ) {
+						counter.test();
+					}
+					const auto child_dist = child->isLeaf() ? pred(child->getLeafBound(), std::true_type()) :
+					                                          pred(child->getBound(), std::false_type());
+					if( child_dist <= distance_threshhold ) {
+						candidate_nodes.emplace_back(child_dist, rtree::raw(child));
+						std::push_heap(candidate_nodes.begin(), candidate_nodes.end(), node_order());
 					}
 				}
 			}
 		}
 
-		// Copy resulting values into provided output iterator
+		// Copy resulting values nearest first into provided output iterator
+		candidate_leafs.sort();
 		std::transform(std::cbegin(candidate_leafs), std::cend(candidate_leafs), out_it, [](auto& value_pair){
 			return value_pair.second->getValue();
 		});
 
+		counter.found(candidate_leafs.size());
 		return candidate_leafs.size();
 	}
+
+	/**
+	 * Distance query of a group of Morton ordered queries
+	 *
+	 * Pages are visited nearest first to the bound of the whole group
+	 * which is never further than any query within it. A Page is skipped
+	 * once it is further than the worst of the K nearest found by every
+	 * query. Leafs are measured against each query separately.
+	 *
+	 * The K nearest to query order[j] are left in leaf_heaps[j-first].
+	 */
+	void query_group(std::span<const bound_type> queries,
+	                 const size_type k,
+	                 const std::size_t first,
+	                 const std::size_t last,
+	                 batch_query_context& context) const {
+		using nearest_predicate = predicate::distance_predicate<bound_type,predicate::detail::to_nearest_tag,predicate::detail::to_nearest_tag>;
+		using node_order        = typename batch_query_context::MinDistanceOnTop;
+		constexpr auto infinite = std::numeric_limits<bound_value_type>::max();
+
+		auto& order           = context.order;
+		auto& candidate_nodes = context.node_heap;
+		auto& candidate_leafs = context.leaf_heaps;
+		const auto num_in_group = last - first;
+		spatial::profile::QueryCounter counter("rtree.batch_nearest", size_, num_in_group);
+
+		// Bound of the whole group
+		bound_type group_bound = queries[order[first].second];
+		for(std::size_t j = first; j < last; ++j) {
+			group_bound.stretch(queries[order[j].second]);
+			candidate_leafs[j - first].reset(k);
+		}
+		const nearest_predicate group_pred(group_bound, k);
+
+		// Worst distance any query within the group still accepts
+		auto group_threshold = [&](){
+			bound_value_type threshold = 0;
+			for(std::size_t m = 0; m < num_in_group; ++m) {
+				if( not candidate_leafs[m].full() ) {
+					return infinite;
+				}
+				threshold = std::max(threshold, candidate_leafs[m].worst().first);
+			}
+			return threshold;
+		};
+
+		// Root is the only Leaf not held by a Page
+		if( root_node_ptr_->isLeaf() ) {
+			for(std::size_t j = first; j < last; ++j) {
+				const nearest_predicate pred(queries[order[j].second], k);
+				candidate_leafs[j - first].emplace(pred(root_node_ptr_->getLeafBound(), std::true_type()), rtree::raw(root_node_ptr_));
+			}
+			counter.test(num_in_group);
+			counter.found(num_in_group);
+			return;
+		}
+
+		auto distance_threshhold = infinite;
+		candidate_nodes.clear();
+		candidate_nodes.emplace_back(group_pred(root_node_ptr_->getBound(), false), rtree::raw(root_node_ptr_));
+		while(candidate_nodes.size() > 0){
+
+			std::pop_heap(candidate_nodes.begin(), candidate_nodes.end(), node_order());
+			const auto [dist, current_candidate] = candidate_nodes.back();
+			candidate_nodes.pop_back();
+
+			// Nearest remaining Page is too far for every query
+			if( dist > distance_threshhold ) {
+				break;
+			}
+
+			const auto num_children = current_candidate->size();
+			if( num_children == 0 ) {
+				continue;
+			}
+			counter.visit();
+
+			// Page of Leafs
+			// - Measure the Leafs against each query the Page could improve
+			if( (*current_candidate->begin())->isLeaf() ) {
+				for(std::size_t j = first; j < last; ++j) {
+					auto& heap = candidate_leafs[j - first];
+					const nearest_predicate pred(queries[order[j].second], k);
+					if( heap.full() and not (pred(current_candidate->getBound(), false) < heap.worst().first) ) {
+						continue;
+					}
+					counter.test(num_children);
+					if constexpr ( rtree::has_child_bounds<node_pointer>::value ) {
+						typename std::decay_t<decltype(current_candidate->child_bounds())>::value_array child_dist;
+						pred(leaf_bounds_(current_candidate), num_children, true, child_dist);
+						for(size_type i = 0; i < num_children; ++i){
+							if( not heap.full() or (child_dist[i] < heap.worst().first) ) {
+								heap.emplace(child_dist[i], current_candidate->child(i));
+							}
+						}
+					}
+					else {
+						for(auto const& child : *current_candidate){
+							heap.emplace(pred(child->getLeafBound(), std::true_type()), rtree::raw(child));
+						}
+					}
+				}
+				distance_threshhold = group_threshold();
+			}
+			else if constexpr ( rtree::has_child_bounds<node_pointer>::value ) {
+				// Measure all child Pages at once against the group
+				typename std::decay_t<decltype(current_candidate->child_bounds())>::value_array child_dist;
+				group_pred(current_candidate->child_bounds(), num_children, false, child_dist);
+				for(size_type i = 0; i < num_children; ++i){
+					if( child_dist[i] <= distance_threshhold ) {
+						candidate_nodes.emplace_back(child_dist[i], current_candidate->child(i));
+						std::push_heap(candidate_nodes.begin(), candidate_nodes.end(), node_order());
+					}
+				}
+			}
+			else {
+				for(auto const& child : *current_candidate){
+					const auto child_dist = group_pred(child->getBound(), false);
+					if( child_dist <= distance_threshhold ) {
+						candidate_nodes.emplace_back(child_dist, rtree::raw(child));
+						std::push_heap(candidate_nodes.begin(), candidate_nodes.end(), node_order());
+					}
+				}
+			}
+		}
+		for(std::size_t m = 0; m < num_in_group; ++m) {
+			counter.found(candidate_leafs[m].size());
+		}
+	}
 };
 
 } /* namespace index */
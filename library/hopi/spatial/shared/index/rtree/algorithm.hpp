@@ -14,12 +14,20 @@
 
 
 #include "hopi/spatial/bound/box.hpp"
+#include "hopi/spatial/bound/box_array.hpp"
+#include "hopi/spatial/shared/index/rtree/arena.hpp"
 
 
+#include <algorithm>
 #include <cassert>
+#include <iostream>
+#include <iterator>
 #include <list>
+#include <limits>
 #include <memory>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace hopi {
 namespace spatial {
@@ -28,11 +36,20 @@ namespace index {
 namespace rtree {
 
 
+/**
+ * Insertion and removal shared by the splitting policies
+ *
+ * A SplittingType provides pick_seeds and pick_next for the split
+ * below or hides split_node and find_best_fit_in_node with its own.
+ */
 template<typename SplittingType>
 struct Algorithm {
 	static constexpr std::size_t min_children = SplittingType::min_children;
 	static constexpr std::size_t max_children = SplittingType::max_children;
 
+	/// Children evicted by forced reinsertion on insert (0 disables)
+	static constexpr std::size_t reinsert_count = 0;
+
 
 	template<typename NodePtr>
 	static
@@ -64,7 +81,6 @@ struct Algorithm {
 	static
 	std::pair<NodePtr,NodePtr>
 	split_node(NodePtr& parent_ptr) {
-		using node_type = typename NodePtr::element_type;
 		assert(parent_ptr);
 		assert(parent_ptr->isPage());
 
@@ -72,11 +88,11 @@ struct Algorithm {
 		auto children_seeds = pick_seeds(parent_ptr);
 
 		// Create two new Nodes using the seeds as first entries
-		auto a_node_ptr = std::make_shared<node_type>();
+		auto a_node_ptr = make_page(parent_ptr);
 		a_node_ptr->insert(std::get<0>(children_seeds));
 		parent_ptr->remove(std::get<0>(children_seeds), std::false_type());
 
-		auto b_node_ptr = std::make_shared<node_type>();
+		auto b_node_ptr = make_page(parent_ptr);
 		b_node_ptr->insert(std::get<1>(children_seeds));
 		parent_ptr->remove(std::get<1>(children_seeds), std::false_type());
 
@@ -143,6 +159,29 @@ struct Algorithm {
 		NodePtr best_node(nullptr);
 		auto current_minimum = std::numeric_limits<typename BBox::value_type>::max();
 
+		// Area increase of all children at once if bounds are in a BoxArray
+		if constexpr ( has_child_bounds<NodePtr>::value ) {
+			typename std::decay_t<decltype(current_node->child_bounds())>::value_array increase;
+			IncreaseToHold(current_node->child_bounds(), bounding_box, current_node->size(), increase);
+
+			for(std::size_t i = 0; i < current_node->size(); ++i){
+				if( increase[i] < current_minimum ){
+					current_minimum = increase[i];
+					best_node = current_node->child(i);
+				}
+				else if (increase[i] == current_minimum) {
+					assert(best_node);
+					auto child = current_node->child(i);
+					if( (child->area() < best_node->area()) or
+						(child->size() < best_node->size())){
+						best_node = child;
+					}
+				}
+			}
+			assert(best_node);
+			return best_node;
+		}
+
 		// Loop over all Children
 		for(const NodePtr& child : *current_node){
 
@@ -181,18 +220,17 @@ struct Algorithm {
 	 */
 	template<typename BBox, typename NodePtr>
 	static NodePtr find_best_fit_in_tree(const NodePtr& starting_node, const BBox& bounding_box){
-		using node_type = typename NodePtr::element_type;
 
 		// If the starting_node is NULL then create a new one for placement
 		if(not starting_node) {
-			return std::make_shared<node_type>();
+			return make_page(starting_node);
 		}
 
 		// Search within the Node and descend down tree
 		auto current_node = starting_node;
 		while(current_node->isPage()){
 			assert(current_node->size() > 0 );
-			current_node = find_best_fit_in_node(bounding_box,current_node);
+			current_node = SplittingType::find_best_fit_in_node(bounding_box,current_node);
 		}
 		assert(current_node->isLeaf());
 		return current_node->getParent();
@@ -208,9 +246,11 @@ struct Algorithm {
 	 */
 	template<typename NodePtr>
 	static NodePtr expand_tree(const NodePtr& starting_node){
-		using node_type = typename NodePtr::element_type;
 		assert(starting_node);
 
+		// Copy of the bound since the starting_node can be split & released
+		const auto starting_bound = starting_node->getBound();
+
 		NodePtr current_node_ptr(starting_node);
 		while(current_node_ptr->hasParent()){
 
@@ -218,16 +258,17 @@ struct Algorithm {
 
 			// Check if it needs to be split
 			if( current_node_ptr->size() > max_children ){
-				auto split_pair  = split_node(current_node_ptr);
+				auto split_pair  = SplittingType::split_node(current_node_ptr);
 				parent_node->remove(current_node_ptr, std::false_type());
 				parent_node->insert(std::get<0>(split_pair));
 				parent_node->insert(std::get<1>(split_pair));
+				release(current_node_ptr);
 			}
 			//else {
 			//	current_node_ptr->stretch(*starting_node);
 			//}
 			current_node_ptr = parent_node;
-			current_node_ptr->stretch(*starting_node);
+			current_node_ptr->stretch(starting_bound);
 		}
 
 		// At this point the current_node_ptr == root pointer
@@ -235,10 +276,11 @@ struct Algorithm {
 			assert(not current_node_ptr->hasParent());
 
 			// Split the current_node_ptr
-			auto split_pair = split_node(current_node_ptr);
+			auto split_pair = SplittingType::split_node(current_node_ptr);
 
 			// Create new root Node using one of the split Nodes
-			auto new_root_ptr = std::make_shared<node_type>();
+			auto new_root_ptr = make_page(current_node_ptr);
+			release(current_node_ptr);
 
 			// Add in the split nodes
 			new_root_ptr->insert(std::get<0>(split_pair));
@@ -271,6 +313,7 @@ struct Algorithm {
 						  current_node_ptr->end(),
 						  std::back_inserter(orphan_node_list));
 				parent_node->remove(current_node_ptr, do_not_restretch());
+				release(current_node_ptr);
 			}
 
 			current_node_ptr = parent_node;
@@ -278,14 +321,29 @@ struct Algorithm {
 		}
 
 		// Re-Insert all Orphans
-		for(NodePtr& orphan : orphan_node_list) {
-			current_node_ptr = insert(current_node_ptr,orphan);
+		// - Orphan Pages are broken into their Leafs since insert
+		//   only places at the level holding Leafs
+		while( not orphan_node_list.empty() ) {
+			NodePtr orphan = orphan_node_list.front();
+			orphan_node_list.pop_front();
+			if( orphan->isLeaf() and (current_node_ptr->size() == 0) ) {
+				current_node_ptr->insert(orphan);
+			}
+			else if( orphan->isLeaf() ) {
+				current_node_ptr = insert(current_node_ptr,orphan);
+			}
+			else {
+				std::copy(orphan->begin(), orphan->end(), std::back_inserter(orphan_node_list));
+				release(orphan);
+			}
 		}
 
 		// If the root only has one child then make that the root
 		if( (current_node_ptr->size() == 1) and (not current_node_ptr->front()->isLeaf()) ){
+			auto old_root_ptr = current_node_ptr;
 			current_node_ptr = current_node_ptr->front();
 			current_node_ptr->setParent(nullptr);
+			release(old_root_ptr);
 		}
 
 		return current_node_ptr;
@@ -316,62 +374,162 @@ struct Algorithm {
 	}
 
 	/**
-	 * Remove an existing Node within the tree under starting_node
+	 * Place a Leaf within the tree with R* style forced reinsertion
 	 *
-	 * Removes all nodes which have the same properties (box & data)
-	 * as the provided remove_node pointer. It does not attempt to match
-	 * the location pointed at by the shared_ptr.
+	 * If the Page receiving the Leaf overflows then up to count of its
+	 * children furthest from its center are removed and placed again
+	 * from the root before a split is considered. Reinsertion is only
+	 * forced once per call so the evicted Leafs are placed normally.
 	 *
-	 * @param starting_node[in] Pointer to the Node to place the inserted Node under
-	 * @param remove_node[in] Pointer to the Node that is properties of Nodes to remove
+	 * @param starting_node[in] Pointer to the root Node
+	 * @param place_node[in] Pointer to the Leaf that is being inserted
+	 * @param count[in] Maximum number of children to reinsert
 	 *
-	 * @returns Pointer to new starting Node (if needed to shrink)
+	 * @returns Pointer to new root Node
 	 */
 	template<typename NodePtr>
-	static NodePtr remove(const NodePtr& starting_node, const NodePtr& remove_node){
+	static NodePtr reinsert(const NodePtr& starting_node, NodePtr& place_node, const std::size_t count){
+		assert(place_node->isLeaf());
 
-		/**
-		NodePtr new_root(nullptr);
+		auto best_node_ptr = find_best_fit_in_tree(starting_node,place_node->getBound());
+		best_node_ptr->insert(place_node);
 
-		// Get list of all nodes with a matching bounding_box
-		auto matching_list = matches(remove_node->getBound(),starting_node);
+		const auto num_children = best_node_ptr->size();
+		if( (num_children <= max_children) or (not best_node_ptr->hasParent()) ) {
+			return expand_tree(best_node_ptr);
+		}
+		const auto num_evict = std::min(count, num_children - min_children);
+		if( num_evict == 0 ) {
+			return expand_tree(best_node_ptr);
+		}
 
-		for(NodePtr& match : matching_list){
-			if(remove_node->data() == match->data()) {
-				match->getParent()->remove(remove_node);
-				new_root = condense_tree(match);
+		// Order children furthest from the center first
+		using bound_value_type = typename std::decay_t<decltype(best_node_ptr->getBound())>::value_type;
+		const auto& page_bound = best_node_ptr->getBound();
+		std::vector<std::pair<bound_value_type,NodePtr>> distance;
+		distance.reserve(num_children);
+		for(const NodePtr& child : *best_node_ptr){
+			const auto& child_bound = child->getBound();
+			bound_value_type dist = 0;
+			for(std::size_t d = 0; d < page_bound.ndim; ++d){
+				const auto diff = child_bound.center(d) - page_bound.center(d);
+				dist += diff * diff;
 			}
+			distance.emplace_back(dist, child);
 		}
-		**/
+		std::partial_sort(distance.begin(), distance.begin() + num_evict, distance.end(),
+		                  [](const auto& a, const auto& b){ return a.first > b.first; });
 
-		// Find the node where it should live
-		// - new pointer if starting_node == nullptr
-		// - existing node if starting_node != nullptr
-		auto best_node_ptr = find_best_fit_in_tree(starting_node,remove_node->getBound());
-		assert(best_node_ptr);
-
-		// Search all children for matching properties and remove
-		std::list<NodePtr> matching_node_list;
-		for(NodePtr& child : *best_node_ptr){
-			assert(child->isLeaf());
-			if( (child->getBound()  == remove_node->getBound()) and
-				(child->data() == remove_node->data())  ) {
-				matching_node_list.push_front(child);
-			}
+		// Evict and shrink the Pages up to the root
+		for(std::size_t i = 0; i < num_evict; ++i){
+			best_node_ptr->remove(distance[i].second, std::false_type());
+		}
+		NodePtr current_node_ptr(best_node_ptr);
+		current_node_ptr->restretch();
+		while(current_node_ptr->hasParent()){
+			current_node_ptr = current_node_ptr->getParent();
+			current_node_ptr->restretch();
 		}
 
-		// Remove all matching Nodes + ReStretch
-		using restretch_node = std::false_type;
-		for(NodePtr& match : matching_node_list){
-			best_node_ptr->remove(match, restretch_node());
+		// Place the evicted nearest first
+		for(std::size_t i = num_evict; i-- > 0;){
+			current_node_ptr = insert(current_node_ptr, distance[i].second);
 		}
-		best_node_ptr->restretch();
+		return current_node_ptr;
+	}
 
-		// Non-Recursively ascend tree adjusting boxes
-		// - assigns into root for case where new root was eliminated
-		return condense_tree(best_node_ptr);
+	/**
+	 * Search the tree for a Leaf
+	 *
+	 * Descends every Page which contains the bound since the Leaf
+	 * need not be within the Page that is the best fit for it.
+	 *
+	 * @param starting_node[in] Pointer to top level Node to start search from
+	 * @param bounding_box[in] Bound of the Leaf being searched for
+	 * @param match[in] Returns true for the Leaf being searched for
+	 *
+	 * @returns Pointer to the first matching Leaf or a null pointer
+	 */
+	template<typename NodePtr, typename BBox, typename MatchOp>
+	static NodePtr find_leaf(const NodePtr& starting_node, const BBox& bounding_box, MatchOp&& match){
+		using spatial::bound::Contains;
+		if(not starting_node) {
+			return NodePtr(nullptr);
+		}
+
+		std::vector<NodePtr> candidate_nodes;
+		candidate_nodes.push_back(starting_node);
+		while(candidate_nodes.size() > 0){
+			NodePtr current_node = candidate_nodes.back();
+			candidate_nodes.pop_back();
+			if( current_node->isLeaf() ) {
+				if( match(current_node) ) {
+					return current_node;
+				}
+			}
+			else if( Contains(current_node->getBound(), bounding_box) ) {
+				for(const NodePtr& child : *current_node){
+					if( child->isLeaf() or Contains(child->getBound(), bounding_box) ) {
+						candidate_nodes.push_back(child);
+					}
+				}
+			}
+		}
+		return NodePtr(nullptr);
+	}
+
+	/**
+	 * Detach a Leaf from the tree
+	 *
+	 * The Leaf is not released so it can be placed again.
+	 *
+	 * @param leaf_node[in] Pointer to the Leaf within a Page
+	 *
+	 * @returns Pointer to new root Node
+	 */
+	template<typename NodePtr>
+	static NodePtr detach(const NodePtr& leaf_node){
+		assert(leaf_node->isLeaf());
+		assert(leaf_node->hasParent());
+
+		NodePtr parent_node(leaf_node->getParent());
+		parent_node->remove(leaf_node, std::false_type());
+		leaf_node->setParent(NodePtr(nullptr));
+		parent_node->restretch();
+		return condense_tree(parent_node);
 	}
 
+	/**
+	 * Remove an existing Node within the tree under starting_node
+	 *
+	 * Removes all Leafs with the same bound and value as the provided
+	 * remove_node. It does not attempt to match the location pointed
+	 * at by the pointer.
+	 *
+	 * @param starting_node[in] Pointer to the Node to place the inserted Node under
+	 * @param remove_node[in] Pointer to the Node that is properties of Nodes to remove
+	 *
+	 * @returns Pointer to new starting Node (if needed to shrink)
+	 */
+	template<typename NodePtr>
+	static NodePtr remove(const NodePtr& starting_node, const NodePtr& remove_node){
+		auto matches = [&](const NodePtr& leaf){
+			return (leaf != remove_node) and
+			       (leaf->getBound() == remove_node->getBound()) and
+			       (leaf->getValue() == remove_node->getValue());
+		};
+
+		NodePtr current_node_ptr(starting_node);
+		while( current_node_ptr and current_node_ptr->isPage() ) {
+			auto match = find_leaf(current_node_ptr, remove_node->getBound(), matches);
+			if( not match ) {
+				break;
+			}
+			current_node_ptr = detach(match);
+			release(match);
+		}
+		return current_node_ptr;
+	}
 
 	template<typename NodePtr>
 	static void Diagnostics(const NodePtr& starting_node){
@@ -393,7 +551,7 @@ struct Algorithm {
 			else {
 				++page_count;
 				child_count[child->size()] += 1;
-				for(auto& grand_child : *child ){
+				for(auto const& grand_child : *child ){
 					node_list.push_back(grand_child);
 				}
 			}
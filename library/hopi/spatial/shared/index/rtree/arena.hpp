@@ -0,0 +1,959 @@
+/// @file arena.cpp
+/*
+ * Project:         HOPI
+ * File:            arena.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/spatial/bound/box_array.hpp"
+#include "hopi/spatial/shared/index/rtree/leaf.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hopi {
+namespace spatial {
+namespace shared {
+namespace index {
+namespace rtree {
+
+/**
+ * Allocator which selects Arena storage for the RTree
+ *
+ * Passing this as the Allocator of an RTree replaces the
+ * individually allocated (std::shared_ptr) Nodes with
+ * pointer free Pages and Leafs stored within an Arena
+ * and addressed by 32-bit indices.
+ */
+template<typename T>
+struct ArenaAllocator : public std::allocator<T> {
+	using std::allocator<T>::allocator;
+};
+
+
+/**
+ * Growable pool of objects addressed by index
+ *
+ * Objects are placed within fixed size blocks so references
+ * to objects remain valid while the pool grows. Clearing
+ * the pool keeps the blocks for re-use and is O(1) for
+ * trivially destructible types.
+ *
+ * A pool can also view objects held contiguously elsewhere
+ * (ie. a mapped snapshot) in which case the blocks point into
+ * that memory. The objects are copied into blocks of the pool
+ * before the first object is added.
+ */
+template<typename T, std::size_t BlockBits = 12>
+class Pool {
+
+	//-------------------------------------------------------------------------
+	// Types & Constants
+	//-------------------------------------------------------------------------
+public:
+	using value_type = T;
+	using index_type = std::uint32_t;
+
+private:
+	static constexpr index_type block_size = index_type(1) << BlockBits;
+	static constexpr index_type block_mask = block_size - 1;
+
+	struct alignas(T) slot_type {
+		std::byte data[sizeof(T)];
+	};
+	using block_type = std::unique_ptr<slot_type[]>;
+	using owner_type = std::shared_ptr<const void>;
+
+	//-------------------------------------------------------------------------
+	// Constructors
+	//-------------------------------------------------------------------------
+public:
+
+	Pool() = default;
+
+	Pool(const Pool& other) : size_(0) {
+		this->reserve(other.size_);
+		for(index_type i = 0; i < other.size_; ++i) {
+			this->push_back(other[i]);
+		}
+	}
+
+	Pool(Pool&& other) noexcept :
+		owned_(std::move(other.owned_)),
+		blocks_(std::move(other.blocks_)),
+		owner_(std::move(other.owner_)),
+		size_(other.size_) {
+		other.size_ = 0;
+	}
+
+	~Pool() {
+		this->destroy_();
+	}
+
+	//-------------------------------------------------------------------------
+	// Assignment Operators
+	//-------------------------------------------------------------------------
+
+	Pool& operator=(const Pool& other) {
+		if( this != &other ) {
+			this->clear();
+			this->reserve(other.size_);
+			for(index_type i = 0; i < other.size_; ++i) {
+				this->push_back(other[i]);
+			}
+		}
+		return *this;
+	}
+
+	Pool& operator=(Pool&& other) noexcept {
+		if( this != &other ) {
+			this->destroy_();
+			owned_      = std::move(other.owned_);
+			blocks_     = std::move(other.blocks_);
+			owner_      = std::move(other.owner_);
+			size_       = other.size_;
+			other.size_ = 0;
+		}
+		return *this;
+	}
+
+	//-------------------------------------------------------------------------
+	// Element Access
+	//-------------------------------------------------------------------------
+
+	T& operator[](const index_type i) noexcept {
+		assert(i < size_);
+		return *std::launder(reinterpret_cast<T*>(blocks_[i >> BlockBits][i & block_mask].data));
+	}
+
+	T const& operator[](const index_type i) const noexcept {
+		assert(i < size_);
+		return *std::launder(reinterpret_cast<T const*>(blocks_[i >> BlockBits][i & block_mask].data));
+	}
+
+	//-------------------------------------------------------------------------
+	// Capacity
+	//-------------------------------------------------------------------------
+
+	index_type size() const noexcept {
+		return size_;
+	}
+
+	bool empty() const noexcept {
+		return (size_ == 0);
+	}
+
+	void reserve(const std::size_t count) {
+		assert(count < std::numeric_limits<index_type>::max());
+		while(blocks_.size() * block_size < count) {
+			owned_.emplace_back(new slot_type[block_size]);
+			blocks_.push_back(owned_.back().get());
+		}
+	}
+
+	/**
+	 * Test if the objects are viewed from memory held elsewhere
+	 */
+	bool viewing() const noexcept {
+		return static_cast<bool>(owner_);
+	}
+
+	/**
+	 * Bytes of the objects within each block in order
+	 *
+	 * Calls function(data, bytes) once per block so the objects
+	 * are visited the same way whether owned or viewed.
+	 */
+	template<typename Function>
+	void for_each_block(Function&& function) const {
+		for(index_type first = 0; first < size_; first += block_size) {
+			const auto count = std::min<index_type>(block_size, size_ - first);
+			function(static_cast<const void*>(blocks_[first >> BlockBits]), std::size_t(count) * sizeof(T));
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	// Modifiers
+	//-------------------------------------------------------------------------
+
+	/**
+	 * Replace the objects by a view of count objects at data
+	 *
+	 * The owner keeps the memory alive for as long as it is viewed.
+	 */
+	void view(owner_type owner, T* data, const std::size_t count) {
+		static_assert(std::is_trivially_copy_constructible_v<T> and std::is_trivially_destructible_v<T>,
+		              "Only trivially copyable objects can be viewed");
+		assert(count < std::numeric_limits<index_type>::max());
+		this->destroy_();
+		for(std::size_t first = 0; first < count; first += block_size) {
+			blocks_.push_back(reinterpret_cast<slot_type*>(data + first));
+		}
+		owner_ = std::move(owner);
+		size_  = index_type(count);
+	}
+
+	template<typename... Args>
+	index_type push_back(Args&&... args) {
+		if( owner_ ) {
+			this->detach_();
+		}
+		this->reserve(std::size_t(size_) + 1);
+		auto& slot = blocks_[size_ >> BlockBits][size_ & block_mask];
+		::new (static_cast<void*>(slot.data)) T(std::forward<Args>(args)...);
+		return size_++;
+	}
+
+	void clear() noexcept {
+		if constexpr (not std::is_trivially_destructible_v<T>) {
+			for(index_type i = 0; i < size_; ++i) {
+				(*this)[i].~T();
+			}
+		}
+		size_ = 0;
+		if( owner_ ) {
+			blocks_.clear();
+			owned_.clear();
+			owner_.reset();
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	// Data [Private]
+	//-------------------------------------------------------------------------
+private:
+	std::vector<block_type> owned_;   // Blocks allocated by the pool
+	std::vector<slot_type*> blocks_;  // Every block whether owned or viewed
+	owner_type              owner_;   // Keeps viewed memory alive
+	index_type              size_ = 0;
+
+	void destroy_() noexcept {
+		this->clear();
+		blocks_.clear();
+		owned_.clear();
+	}
+
+	/**
+	 * Copy viewed objects into blocks of the pool
+	 */
+	void detach_() {
+		auto viewed = std::move(blocks_);
+		auto owned  = std::move(owned_);
+		blocks_.clear();
+		owned_.clear();
+		this->reserve(size_);
+		for(index_type first = 0; first < size_; first += block_size) {
+			const auto count = std::min<index_type>(block_size, size_ - first);
+			std::memcpy(static_cast<void*>(blocks_[first >> BlockBits]), viewed[first >> BlockBits], std::size_t(count) * sizeof(slot_type));
+		}
+		owner_.reset();
+	}
+};
+
+
+template<typename ArenaType>
+class ArenaNodePtr;
+
+/**
+ * Test if the Node pointer provides the bounds of all children
+ * within a BoxArray (ie. child_bounds())
+ */
+template<typename NodePtr>
+struct has_child_bounds : public std::false_type {
+};
+
+template<typename ArenaType>
+struct has_child_bounds<ArenaNodePtr<ArenaType>> : public std::true_type {
+};
+
+
+/**
+ * Arena holding all Pages and Leafs of an RTree
+ *
+ * Pages hold their own bound, the indices of each child in
+ * a fixed capacity array and a copy of every child bound in
+ * Structure of Arrays layout so a Page can test all children
+ * at once. Leafs hold the value stored within the tree. Both record the
+ * index of their parent Page. Released records are kept
+ * on a free list and handed out before the pools grow.
+ */
+template<typename Value, typename BoundExtractor, std::size_t Capacity>
+class Arena {
+
+	//-------------------------------------------------------------------------
+	// Types & Constants
+	//-------------------------------------------------------------------------
+public:
+	using self_type        = Arena<Value,BoundExtractor,Capacity>;
+	using value_type       = Value;
+	using index_type       = std::uint32_t;
+	using size_type        = std::size_t;
+	using node_pointer     = ArenaNodePtr<self_type>;
+	using bound_extractor  = BoundExtractor;
+	using leaf_bound       = LeafBound<BoundExtractor>;
+	using leaf_bound_type  = typename leaf_bound::leaf_bound_type;
+	using bound_type       = typename leaf_bound::bound_type;
+	using bound_reference  = typename leaf_bound::bound_reference;
+	using bound_value_type = typename bound_type::value_type;
+	using bound_array_type = spatial::bound::BoxArray<bound_value_type, bound_type::ndim, Capacity>;
+
+	static constexpr size_type  capacity = Capacity;
+	static constexpr index_type npos     = std::numeric_limits<index_type>::max();
+	static constexpr index_type leaf_bit = index_type(1) << (8 * sizeof(index_type) - 1);
+
+	struct PageRecord {
+		bound_array_type                  child_bound;
+		bound_type                        bound;
+		index_type                        parent;
+		index_type                        size;
+		std::array<index_type, Capacity> child;
+	};
+
+	struct LeafRecord {
+		value_type value;
+		index_type parent;
+	};
+
+	//-------------------------------------------------------------------------
+	// Constructors
+	//-------------------------------------------------------------------------
+
+	Arena() = default;
+
+	Arena(const Arena& other) = default;
+
+	Arena(Arena&& other) = default;
+
+	~Arena() = default;
+
+	//-------------------------------------------------------------------------
+	// Assignment Operators
+	//-------------------------------------------------------------------------
+
+	Arena& operator=(const Arena& other) = default;
+
+	Arena& operator=(Arena&& other) = default;
+
+	//-------------------------------------------------------------------------
+	// Modifiers
+	//-------------------------------------------------------------------------
+
+	/**
+	 * Create a new empty Page
+	 */
+	node_pointer new_page() {
+		index_type index;
+		if( free_pages_.empty() ) {
+			index = pages_.push_back();
+		}
+		else {
+			index = free_pages_.back();
+			free_pages_.pop_back();
+		}
+		auto& record  = pages_[index];
+		record.bound.reset();
+		record.parent = npos;
+		record.size   = 0;
+		assert(index < leaf_bit);
+		return node_pointer(this, index);
+	}
+
+	/**
+	 * Create a new Leaf holding value
+	 */
+	node_pointer new_leaf(value_type const& value) {
+		index_type index;
+		if( free_leafs_.empty() ) {
+			index = leafs_.push_back(LeafRecord{value, npos});
+		}
+		else {
+			index = free_leafs_.back();
+			free_leafs_.pop_back();
+			leafs_[index] = LeafRecord{value, npos};
+		}
+		assert(index < leaf_bit);
+		return node_pointer(this, index | leaf_bit);
+	}
+
+	/**
+	 * Return a Page or Leaf to the Arena for re-use
+	 */
+	void release(index_type const index) {
+		assert(index != npos);
+		if( index & leaf_bit ) {
+			free_leafs_.push_back(index & ~leaf_bit);
+		}
+		else {
+			free_pages_.push_back(index);
+		}
+	}
+
+	/**
+	 * Remove everything from the Arena
+	 *
+	 * Memory is kept to be re-used by the next tree
+	 * built within the Arena.
+	 */
+	void clear() noexcept {
+		pages_.clear();
+		leafs_.clear();
+		free_pages_.clear();
+		free_leafs_.clear();
+	}
+
+	//-------------------------------------------------------------------------
+	// Element Access
+	//-------------------------------------------------------------------------
+
+	PageRecord& page(index_type const index) noexcept {
+		assert(not (index & leaf_bit));
+		return pages_[index];
+	}
+
+	PageRecord const& page(index_type const index) const noexcept {
+		assert(not (index & leaf_bit));
+		return pages_[index];
+	}
+
+	LeafRecord& leaf(index_type const index) noexcept {
+		assert(index & leaf_bit);
+		return leafs_[index & ~leaf_bit];
+	}
+
+	LeafRecord const& leaf(index_type const index) const noexcept {
+		assert(index & leaf_bit);
+		return leafs_[index & ~leaf_bit];
+	}
+
+	//-------------------------------------------------------------------------
+	// Capacity
+	//-------------------------------------------------------------------------
+
+	size_type page_count() const noexcept {
+		return pages_.size() - free_pages_.size();
+	}
+
+	size_type leaf_count() const noexcept {
+		return leafs_.size() - free_leafs_.size();
+	}
+
+	//-------------------------------------------------------------------------
+	// Snapshots
+	//-------------------------------------------------------------------------
+
+	/**
+	 * Write the Pages, Leafs and both free lists as four sections
+	 */
+	template<typename Writer>
+	void save(Writer& writer) const {
+		auto write_pool = [&](auto const& pool) {
+			writer.begin_section();
+			pool.for_each_block([&](const void* data, const std::size_t bytes) {
+				writer.write(data, bytes);
+			});
+			writer.end_section();
+		};
+		write_pool(pages_);
+		write_pool(leafs_);
+		writer.write_section(std::span<const index_type>(free_pages_));
+		writer.write_section(std::span<const index_type>(free_leafs_));
+	}
+
+	/**
+	 * View the four sections written by save starting at first
+	 *
+	 * The Pages and Leafs are used in place within the mapping
+	 * which is kept alive for as long as they are viewed.
+	 */
+	template<typename Mapping>
+	void view(std::shared_ptr<const Mapping> const& mapping, const std::size_t first) {
+		const auto pages      = mapping->template section_as<PageRecord>(first);
+		const auto leafs      = mapping->template section_as<LeafRecord>(first + 1);
+		const auto free_pages = mapping->template section_as<const index_type>(first + 2);
+		const auto free_leafs = mapping->template section_as<const index_type>(first + 3);
+		pages_.view(mapping, pages.data(), pages.size());
+		leafs_.view(mapping, leafs.data(), leafs.size());
+		free_pages_.assign(free_pages.begin(), free_pages.end());
+		free_leafs_.assign(free_leafs.begin(), free_leafs.end());
+	}
+
+	//-------------------------------------------------------------------------
+	// Data [Private]
+	//-------------------------------------------------------------------------
+private:
+	Pool<PageRecord>        pages_;
+	Pool<LeafRecord>        leafs_;
+	std::vector<index_type> free_pages_;
+	std::vector<index_type> free_leafs_;
+};
+
+
+/**
+ * Handle to a Page or Leaf within an Arena
+ *
+ * The handle provides the same interface as a
+ * std::shared_ptr<Node> so the tree algorithms can
+ * be used with either storage. The handle is both the
+ * pointer and the pointed to Node (ie. operator-> returns
+ * itself) and is cheap to copy. Like a pointer the Node
+ * can be modified through a const handle.
+ */
+template<typename ArenaType>
+class ArenaNodePtr {
+
+	//-------------------------------------------------------------------------
+	// Types & Constants
+	//-------------------------------------------------------------------------
+private:
+	using arena_type = ArenaType;
+	using index_type = typename arena_type::index_type;
+
+	static constexpr index_type npos     = arena_type::npos;
+	static constexpr index_type leaf_bit = arena_type::leaf_bit;
+
+public:
+	using element_type     = ArenaNodePtr<ArenaType>;
+	using node_pointer     = ArenaNodePtr<ArenaType>;
+	using value_type       = typename arena_type::value_type;
+	using size_type        = typename arena_type::size_type;
+	using bound_extractor  = typename arena_type::bound_extractor;
+	using leaf_bound_type  = typename arena_type::leaf_bound_type;
+	using bound_type       = typename arena_type::bound_type;
+	using bound_reference  = typename arena_type::bound_reference;
+	using bound_value_type = typename arena_type::bound_value_type;
+	using bound_array_type = typename arena_type::bound_array_type;
+
+	class child_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = ArenaNodePtr<ArenaType>;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = void;
+		using reference         = value_type;
+
+		child_iterator() = default;
+		child_iterator(arena_type* arena, index_type const* pos) : arena_(arena), pos_(pos) {
+		}
+
+		reference operator*() const noexcept {
+			return value_type(arena_, *pos_);
+		}
+
+		child_iterator& operator++() noexcept {
+			++pos_;
+			return *this;
+		}
+
+		child_iterator operator++(int) noexcept {
+			auto ans = *this;
+			++pos_;
+			return ans;
+		}
+
+		bool operator==(child_iterator const& other) const noexcept {
+			return (pos_ == other.pos_);
+		}
+
+		bool operator!=(child_iterator const& other) const noexcept {
+			return (pos_ != other.pos_);
+		}
+
+	private:
+		arena_type*       arena_ = nullptr;
+		index_type const* pos_   = nullptr;
+	};
+	using const_child_iterator = child_iterator;
+
+	//-------------------------------------------------------------------------
+	// Constructors
+	//-------------------------------------------------------------------------
+
+	ArenaNodePtr() = default;
+
+	ArenaNodePtr(std::nullptr_t) : arena_(nullptr), index_(npos) {
+	}
+
+	ArenaNodePtr(arena_type* arena, index_type const index) : arena_(arena), index_(index) {
+	}
+
+	ArenaNodePtr(const ArenaNodePtr& other) = default;
+
+	ArenaNodePtr(ArenaNodePtr&& other) = default;
+
+	~ArenaNodePtr() = default;
+
+	//-------------------------------------------------------------------------
+	// Assignment Operators
+	//-------------------------------------------------------------------------
+
+	ArenaNodePtr& operator=(const ArenaNodePtr& other) = default;
+
+	ArenaNodePtr& operator=(ArenaNodePtr&& other) = default;
+
+	//-------------------------------------------------------------------------
+	// Pointer Interface
+	//-------------------------------------------------------------------------
+
+	explicit operator bool() const noexcept {
+		return (index_ != npos);
+	}
+
+	ArenaNodePtr* operator->() noexcept {
+		return this;
+	}
+
+	ArenaNodePtr const* operator->() const noexcept {
+		return this;
+	}
+
+	ArenaNodePtr& operator*() noexcept {
+		return *this;
+	}
+
+	ArenaNodePtr const& operator*() const noexcept {
+		return *this;
+	}
+
+	ArenaNodePtr* get() noexcept {
+		return this;
+	}
+
+	ArenaNodePtr const* get() const noexcept {
+		return this;
+	}
+
+	bool operator==(ArenaNodePtr const& other) const noexcept {
+		return (index_ == other.index_);
+	}
+
+	bool operator!=(ArenaNodePtr const& other) const noexcept {
+		return (index_ != other.index_);
+	}
+
+	arena_type* arena() const noexcept {
+		return arena_;
+	}
+
+	index_type index() const noexcept {
+		return index_;
+	}
+
+	//-------------------------------------------------------------------------
+	// Modifiers
+	//-------------------------------------------------------------------------
+
+	void clear() const noexcept {
+		assert(this->isPage());
+		page_().size = 0;
+	}
+
+	void setParent(node_pointer const& parent) const noexcept {
+		if( this->isLeaf() ) {
+			leaf_().parent = parent.index_;
+		}
+		else {
+			page_().parent = parent.index_;
+		}
+	}
+
+	void insert(node_pointer const& child_ptr) const noexcept {
+		assert(this->isPage());
+		auto& record = page_();
+		assert(record.size < arena_type::capacity);
+		child_ptr->setParent(*this);
+		record.child_bound.set(record.size, child_ptr->getBound());
+		record.child[record.size++] = child_ptr.index_;
+		record.bound.stretch(child_ptr->getBound());
+		this->update_parent_();
+	}
+
+	void remove(node_pointer const& child_ptr, const bool re_stretch = true) const noexcept {
+		if( re_stretch ) {
+			this->remove(child_ptr, std::true_type());
+		}
+		else {
+			this->remove(child_ptr, std::false_type());
+		}
+	}
+
+	void remove(node_pointer const& child_ptr, std::true_type /* re-stretch */) const noexcept {
+		this->remove(child_ptr, std::false_type());
+		this->restretch();
+	}
+
+	void remove(node_pointer const& child_ptr, std::false_type /* re-stretch */) const noexcept {
+		assert(this->isPage());
+		auto& record = page_();
+		for(index_type i = 0; i < record.size; ++i) {
+			if( record.child[i] == child_ptr.index_ ) {
+				--record.size;
+				record.child[i] = record.child[record.size];
+				record.child_bound.copy(i, record.size);
+				return;
+			}
+		}
+	}
+
+	void stretch(node_pointer const& other) const noexcept {
+		assert(this->isPage());
+		page_().bound.stretch(other->getBound());
+		this->update_parent_();
+	}
+
+	void stretch(bound_type const& other_bound) const noexcept {
+		assert(this->isPage());
+		page_().bound.stretch(other_bound);
+		this->update_parent_();
+	}
+
+	void restretch() const noexcept {
+		assert(this->isPage());
+		auto& record = page_();
+		record.bound.reset();
+		for(index_type i = 0; i < record.size; ++i) {
+			record.bound.stretch(node_pointer(arena_, record.child[i]).getBound());
+		}
+		this->update_parent_();
+	}
+
+	/**
+	 * Replace the value held by this Leaf
+	 *
+	 * The copy of the bound held by the parent is updated
+	 * but the bound of the parent itself is not.
+	 */
+	void setValue(value_type const& value) const noexcept {
+		assert(this->isLeaf());
+		leaf_().value = value;
+		this->update_parent_();
+	}
+
+	//-------------------------------------------------------------------------
+	// Element Access
+	//-------------------------------------------------------------------------
+
+	bool hasParent() const noexcept {
+		return (this->parent_index_() != npos);
+	}
+
+	const node_pointer getParent() const noexcept {
+		return node_pointer(arena_, this->parent_index_());
+	}
+
+	value_type const& getValue() const noexcept {
+		assert(this->isLeaf());
+		return leaf_().value;
+	}
+
+	node_pointer front() const noexcept {
+		assert(this->isPage());
+		assert(page_().size > 0);
+		return node_pointer(arena_, page_().child[0]);
+	}
+
+	node_pointer back() const noexcept {
+		assert(this->isPage());
+		assert(page_().size > 0);
+		return node_pointer(arena_, page_().child[page_().size - 1]);
+	}
+
+	/**
+	 * Get the i'th child of this Page
+	 *
+	 * Children are in the same order as the child_bounds()
+	 */
+	node_pointer child(const size_type i) const noexcept {
+		assert(this->isPage());
+		assert(i < page_().size);
+		return node_pointer(arena_, page_().child[i]);
+	}
+
+	/**
+	 * Get the bounds of all children within a BoxArray
+	 */
+	bound_array_type const& child_bounds() const noexcept {
+		assert(this->isPage());
+		return page_().child_bound;
+	}
+
+	//-------------------------------------------------------------------------
+	// Iterators
+	//-------------------------------------------------------------------------
+
+	child_iterator begin() const noexcept {
+		assert(this->isPage());
+		return child_iterator(arena_, page_().child.data());
+	}
+
+	child_iterator cbegin() const noexcept {
+		return this->begin();
+	}
+
+	child_iterator end() const noexcept {
+		assert(this->isPage());
+		return child_iterator(arena_, page_().child.data() + page_().size);
+	}
+
+	child_iterator cend() const noexcept {
+		return this->end();
+	}
+
+	//-------------------------------------------------------------------------
+	// Capacity
+	//-------------------------------------------------------------------------
+
+	bool isLeaf() const noexcept {
+		return (index_ & leaf_bit);
+	}
+
+	bool isPage() const noexcept {
+		return not this->isLeaf();
+	}
+
+	bool empty() const noexcept {
+		assert(this->isPage());
+		return (page_().size == 0);
+	}
+
+	size_type size() const noexcept {
+		if( this->isLeaf() ) {
+			return 0;
+		}
+		return page_().size;
+	}
+
+	size_type max_size() const noexcept {
+		return arena_type::capacity;
+	}
+
+	bound_value_type area() const noexcept {
+		return this->getBound().area();
+	}
+
+	//-------------------------------------------------------------------------
+	// Indexing
+	//-------------------------------------------------------------------------
+
+	bound_reference getBound() const noexcept {
+		if( this->isLeaf() ) {
+			return arena_type::leaf_bound::bound(leaf_().value);
+		}
+		return page_().bound;
+	}
+
+	const leaf_bound_type& getLeafBound() const noexcept {
+		assert(this->isLeaf());
+		return bound_extractor()(leaf_().value);
+	}
+
+	//-------------------------------------------------------------------------
+	// Data [Private]
+	//-------------------------------------------------------------------------
+private:
+	arena_type* arena_ = nullptr;
+	index_type  index_ = npos;
+
+	auto& page_() const noexcept {
+		return arena_->page(index_);
+	}
+
+	auto& leaf_() const noexcept {
+		return arena_->leaf(index_);
+	}
+
+	index_type parent_index_() const noexcept {
+		if( this->isLeaf() ) {
+			return leaf_().parent;
+		}
+		return page_().parent;
+	}
+
+	/**
+	 * Copy the bound of this Page or Leaf into the child bounds of the parent
+	 */
+	void update_parent_() const noexcept {
+		const auto parent = this->parent_index_();
+		if( parent == npos ) {
+			return;
+		}
+		auto& parent_record = arena_->page(parent);
+		for(index_type i = 0; i < parent_record.size; ++i) {
+			if( parent_record.child[i] == index_ ) {
+				parent_record.child_bound.set(i, this->getBound());
+				return;
+			}
+		}
+	}
+};
+
+
+//-------------------------------------------------------------------------
+// Node Factories for Arena Storage
+//-------------------------------------------------------------------------
+
+/**
+ * Create a new Page within the same Arena as the hint
+ */
+template<typename ArenaType>
+ArenaNodePtr<ArenaType>
+make_page(ArenaNodePtr<ArenaType> const& hint) {
+	assert(hint.arena());
+	return hint.arena()->new_page();
+}
+
+/**
+ * Create a new Leaf within the same Arena as the hint
+ */
+template<typename ArenaType>
+ArenaNodePtr<ArenaType>
+make_leaf(ArenaNodePtr<ArenaType> const& hint, typename ArenaType::value_type const& value) {
+	assert(hint.arena());
+	return hint.arena()->new_leaf(value);
+}
+
+/**
+ * Raw pointer to a Node used while traversing the tree
+ *
+ * The handle is already a raw pointer so it is returned as is.
+ */
+template<typename ArenaType>
+ArenaNodePtr<ArenaType>
+raw(ArenaNodePtr<ArenaType> const& node_ptr) noexcept {
+	return node_ptr;
+}
+
+/**
+ * Return a Node which is no longer part of the tree to the Arena
+ */
+template<typename ArenaType>
+void
+release(ArenaNodePtr<ArenaType> const& node_ptr) {
+	assert(node_ptr);
+	node_ptr.arena()->release(node_ptr.index());
+}
+
+
+} /* namespace rtree */
+} /* namespace index */
+} /* namespace shared */
+} /* namespace spatial */
+} /* namespace hopi */
@@ -0,0 +1,256 @@
+/// @file bulk_load.cpp
+/*
+ * Project:         HOPI
+ * File:            bulk_load.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/spatial/common/space_filling_curve.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hopi {
+namespace spatial {
+namespace shared {
+namespace index {
+namespace rtree {
+
+/**
+ * Tag to bulk load using Sort-Tile-Recursive packing
+ *
+ * Leutenegger, Lopez, Edgington (1997) "STR: A Simple and
+ * Efficient Algorithm for R-Tree Packing"
+ */
+struct STRPacking final {};
+
+/**
+ * Tag to bulk load using Hilbert curve packing
+ *
+ * Kamel, Faloutsos (1993) "On Packing R-trees"
+ */
+struct HilbertPacking final {};
+
+
+/**
+ * Build a fully packed tree from the bottom up
+ *
+ * Each level of the tree is built by ordering the nodes of the
+ * level below with the packing policy and cutting the ordered
+ * nodes into groups which become the pages of the next level.
+ * The number of pages at every level is the minimum needed
+ * to hold the children (ie. ceil(n/max_children)) and children
+ * are spread evenly so every page is (nearly) full and no page
+ * falls below the minimum allowed children.
+ */
+template<typename Parameters>
+struct BulkLoad {
+	static constexpr std::size_t min_children = Parameters::min_children;
+	static constexpr std::size_t max_children = Parameters::max_children;
+
+	/** Build a packed tree from a range of values
+	 *
+	 *  @param[in] hint  Node pointer used to create new Nodes from (can be empty)
+	 *  @param[in] first Iterator to first value to place into tree
+	 *  @param[in] last  Iterator to one past the last value
+	 *
+	 *  @returns Pointer to the root Node of the new tree (empty hint if no values)
+	 */
+	template<typename NodePtr, typename Iterator, typename PackingTag>
+	static NodePtr build(NodePtr const& hint, Iterator first, Iterator last, PackingTag tag) {
+
+		// Wrap every value within a leaf Node
+		std::vector<NodePtr> level;
+		level.reserve(std::distance(first, last));
+		while(first != last) {
+			level.push_back(make_leaf(hint, *first));
+			++first;
+		}
+		if( level.empty() ) {
+			return hint;
+		}
+
+		// Pack each level until only the root remains
+		// - The root is always a page even with only one value
+		do {
+			level = pack_level(level, tag);
+		} while(level.size() > 1);
+
+		return level.front();
+	}
+
+private:
+
+	template<typename NodePtr>
+	struct Entry {
+		using node_type  = typename NodePtr::element_type;
+		using bound_type = typename node_type::bound_type;
+		using point_type = typename bound_type::array_type;
+
+		Entry(NodePtr const& node) : center(), node_ptr(node) {
+			for(std::size_t i = 0; i < bound_type::ndim; ++i) {
+				center[i] = node->getBound().center(i);
+			}
+		}
+
+		point_type center;
+		NodePtr    node_ptr;
+	};
+
+	/** Number of pages needed to hold n children
+	 */
+	static std::size_t pages_needed(const std::size_t n) noexcept {
+		return (n + max_children - 1) / max_children;
+	}
+
+	/** Location of the split between groups when n items are spread across pages
+	 *
+	 *  Returns the number of items contained within the first "count"
+	 *  of "pages" groups without overflow of n*count.
+	 */
+	static std::size_t even_split(const std::size_t n, const std::size_t count, const std::size_t pages) noexcept {
+		return (n / pages) * count + ((n % pages) * count) / pages;
+	}
+
+	/** Create pages from consecutive groups of entries
+	 */
+	template<typename NodePtr>
+	static std::vector<NodePtr> make_pages(std::vector<Entry<NodePtr>>& entries, std::vector<std::size_t> const& group_sizes) {
+		std::vector<NodePtr> pages;
+		pages.reserve(group_sizes.size());
+
+		std::size_t offset = 0;
+		for(auto group_size : group_sizes) {
+			assert(group_size > 0);
+			assert(group_size <= max_children);
+			auto page_ptr = make_page(entries[offset].node_ptr);
+			for(std::size_t i = offset; i < offset + group_size; ++i) {
+				page_ptr->insert(entries[i].node_ptr);
+			}
+			pages.push_back(std::move(page_ptr));
+			offset += group_size;
+		}
+		assert(offset == entries.size());
+		return pages;
+	}
+
+	/** Sort-Tile-Recursive ordering of entries into page groups
+	 *
+	 *  Entries are sorted along dimension "dim" and cut into
+	 *  slabs which each hold an equal share of the pages.
+	 *  Each slab is then recursively tiled along the next dimension.
+	 */
+	template<typename EntryIter>
+	static void tile(EntryIter first, EntryIter last, const std::size_t pages, const std::size_t dim, std::vector<std::size_t>& group_sizes) {
+		using entry_type = typename std::iterator_traits<EntryIter>::value_type;
+		constexpr std::size_t ndim = std::tuple_size<typename entry_type::point_type>::value;
+
+		const std::size_t n = std::distance(first, last);
+		if( pages == 1 ) {
+			group_sizes.push_back(n);
+			return;
+		}
+
+		std::sort(first, last, [dim](auto const& a, auto const& b){
+			return a.center[dim] < b.center[dim];
+		});
+
+		// Last dimension cuts directly into pages
+		if( dim + 1 == ndim ) {
+			for(std::size_t p = 0; p < pages; ++p) {
+				group_sizes.push_back(even_split(n, p+1, pages) - even_split(n, p, pages));
+			}
+			return;
+		}
+
+		// Cut into slabs which each get an equal share of pages
+		const auto remaining_dims = static_cast<double>(ndim - dim);
+		auto slabs = static_cast<std::size_t>(std::ceil(std::pow(static_cast<double>(pages), 1.0/remaining_dims) - 1.0e-9));
+		slabs = std::clamp<std::size_t>(slabs, 1, pages);
+
+		std::size_t page_offset = 0;
+		for(std::size_t s = 0; s < slabs; ++s) {
+			const std::size_t slab_pages = pages / slabs + ((s < pages % slabs) ? 1 : 0);
+			const auto slab_first = std::next(first, even_split(n, page_offset, pages));
+			const auto slab_last  = std::next(first, even_split(n, page_offset + slab_pages, pages));
+			tile(slab_first, slab_last, slab_pages, dim + 1, group_sizes);
+			page_offset += slab_pages;
+		}
+	}
+
+	template<typename NodePtr>
+	static std::vector<NodePtr> pack_level(std::vector<NodePtr> const& level, STRPacking) {
+		std::vector<Entry<NodePtr>> entries(std::begin(level), std::end(level));
+
+		std::vector<std::size_t> group_sizes;
+		group_sizes.reserve(pages_needed(entries.size()));
+		tile(std::begin(entries), std::end(entries), pages_needed(entries.size()), 0, group_sizes);
+
+		return make_pages(entries, group_sizes);
+	}
+
+	template<typename NodePtr>
+	static std::vector<NodePtr> pack_level(std::vector<NodePtr> const& level, HilbertPacking) {
+		using entry_type = Entry<NodePtr>;
+		using point_type = typename entry_type::point_type;
+		using key_type   = spatial::sfc::key_type;
+
+		std::vector<entry_type> entries(std::begin(level), std::end(level));
+
+		// Domain of all centers to calculate keys within
+		point_type min_corner = entries.front().center;
+		point_type max_corner = entries.front().center;
+		for(auto const& entry : entries) {
+			for(std::size_t i = 0; i < min_corner.size(); ++i) {
+				min_corner[i] = std::min(min_corner[i], entry.center[i]);
+				max_corner[i] = std::max(max_corner[i], entry.center[i]);
+			}
+		}
+
+		// Sort entries along the Hilbert curve
+		std::vector<std::pair<key_type, std::size_t>> keys;
+		keys.reserve(entries.size());
+		for(std::size_t i = 0; i < entries.size(); ++i) {
+			keys.emplace_back(spatial::sfc::key(entries[i].center, min_corner, max_corner, spatial::sfc::hilbert_tag()), i);
+		}
+		std::sort(std::begin(keys), std::end(keys));
+
+		std::vector<entry_type> sorted_entries;
+		sorted_entries.reserve(entries.size());
+		for(auto const& key_index : keys) {
+			sorted_entries.push_back(std::move(entries[key_index.second]));
+		}
+
+		// Cut the curve evenly into pages
+		const auto n     = sorted_entries.size();
+		const auto pages = pages_needed(n);
+		std::vector<std::size_t> group_sizes;
+		group_sizes.reserve(pages);
+		for(std::size_t p = 0; p < pages; ++p) {
+			group_sizes.push_back(even_split(n, p+1, pages) - even_split(n, p, pages));
+		}
+
+		return make_pages(sorted_entries, group_sizes);
+	}
+
+};
+
+
+} /* namespace rtree */
+} /* namespace index */
+} /* namespace shared */
+} /* namespace spatial */
+} /* namespace hopi */
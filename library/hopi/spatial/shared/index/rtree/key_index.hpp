@@ -0,0 +1,144 @@
+/// @file key_index.cpp
+/*
+ * Project:         HOPI
+ * File:            key_index.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hopi {
+namespace spatial {
+namespace shared {
+namespace index {
+namespace rtree {
+
+/**
+ * Detect a BoundExtractor which can also return the key of a value
+ */
+template<typename Value, typename BoundExtractor>
+concept has_key_extractor = requires(BoundExtractor const& extractor, Value const& value) {
+	extractor.key(value);
+};
+
+/**
+ * Back index from the key of a value to the Leaf holding it
+ *
+ * Without a key extractor every lookup fails so the RTree
+ * falls back to searching the tree.
+ */
+template<typename Value, typename BoundExtractor, typename NodePtr>
+struct KeyIndex {
+	static constexpr bool enabled = false;
+
+	bool valid() const noexcept {
+		return false;
+	}
+
+	void invalidate() noexcept {
+	}
+
+	void build(NodePtr const& /* root */) {
+	}
+
+	void insert(NodePtr const& /* leaf */) {
+	}
+
+	void erase(NodePtr const& /* leaf */) {
+	}
+};
+
+/**
+ * Back index for values with a key
+ *
+ * The index is built on first use and afterwards kept up to date by
+ * every single value insert and remove. Leafs keep their location
+ * within storage when moved between Pages, but a bulk load, copy or
+ * move creates new Leafs so the index is invalidated and rebuilt
+ * when next needed. Keys are expected to be unique within the tree.
+ */
+template<typename Value, typename BoundExtractor, typename NodePtr>
+requires has_key_extractor<Value,BoundExtractor>
+struct KeyIndex<Value,BoundExtractor,NodePtr> {
+	static constexpr bool enabled = true;
+
+	using key_type = std::decay_t<decltype(std::declval<BoundExtractor const&>().key(std::declval<Value const&>()))>;
+
+	bool valid() const noexcept {
+		return valid_;
+	}
+
+	void invalidate() noexcept {
+		map_.clear();
+		valid_ = false;
+	}
+
+	/**
+	 * Index every Leaf under the root
+	 */
+	void build(NodePtr const& root) {
+		map_.clear();
+		valid_ = true;
+		if( not root ) {
+			return;
+		}
+		std::vector<NodePtr> candidate_nodes;
+		candidate_nodes.push_back(root);
+		while(candidate_nodes.size() > 0){
+			NodePtr current_node = candidate_nodes.back();
+			candidate_nodes.pop_back();
+			if( current_node->isLeaf() ) {
+				this->insert(current_node);
+			}
+			else {
+				for(const NodePtr& child : *current_node){
+					candidate_nodes.push_back(child);
+				}
+			}
+		}
+	}
+
+	void insert(NodePtr const& leaf) {
+		if( valid_ ) {
+			map_.insert_or_assign(BoundExtractor().key(leaf->getValue()), leaf);
+		}
+	}
+
+	void erase(NodePtr const& leaf) {
+		if( valid_ ) {
+			auto it = map_.find(BoundExtractor().key(leaf->getValue()));
+			if( (it != map_.end()) and (it->second == leaf) ) {
+				map_.erase(it);
+			}
+		}
+	}
+
+	/**
+	 * Leaf holding the key or a null pointer
+	 */
+	NodePtr find(key_type const& key) const {
+		auto it = map_.find(key);
+		return (it == map_.end()) ? NodePtr(nullptr) : it->second;
+	}
+
+private:
+	std::unordered_map<key_type, NodePtr> map_;
+	bool                                  valid_ = false;
+};
+
+} /* namespace rtree */
+} /* namespace index */
+} /* namespace shared */
+} /* namespace spatial */
+} /* namespace hopi */
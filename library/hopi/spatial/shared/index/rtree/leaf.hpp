@@ -12,6 +12,11 @@
  */
 #pragma once
 
+#include "hopi/spatial/bound/box.hpp"
+
+#include <array>
+#include <cstddef>
+
 namespace hopi {
 namespace spatial {
 namespace shared {
@@ -19,6 +24,45 @@ namespace index {
 namespace rtree {
 
 
+/**
+ * Bound of the Leafs holding values of a BoundExtractor
+ *
+ * The BoundExtractor returns either a Box or for point values
+ * the coordinates within a std::array. Leafs holding points
+ * only store the coordinates and build the degenerate Box
+ * whenever the tree needs their bound. Predicates instead test
+ * the point itself using the point kernels of bound/point.hpp.
+ */
+template<typename BoundExtractor, typename ExtractedType = typename BoundExtractor::bound_type>
+struct LeafBound {
+	using leaf_bound_type = ExtractedType;
+	using bound_type      = ExtractedType;
+	using bound_reference = bound_type const&;
+
+	static constexpr bool is_point = false;
+
+	template<typename Value>
+	static bound_reference bound(Value const& value) noexcept {
+		return BoundExtractor()(value);
+	}
+};
+
+template<typename BoundExtractor, typename T, std::size_t N>
+struct LeafBound<BoundExtractor, std::array<T,N>> {
+	using leaf_bound_type = std::array<T,N>;
+	using bound_type      = spatial::bound::Box<T,N>;
+	using bound_reference = bound_type;
+
+	static constexpr bool is_point = true;
+
+	template<typename Value>
+	static bound_reference bound(Value const& value) noexcept {
+		const auto& point = BoundExtractor()(value);
+		return bound_type(point, point);
+	}
+};
+
+
 template<typename Value, typename BoundExtractor>
 class Leaf {
 
@@ -31,7 +75,10 @@ private:
 public:
 	using value_type       = Value;
 	using bound_extractor  = BoundExtractor;
-	using bound_type       = typename bound_extractor::bound_type;
+	using leaf_bound       = LeafBound<BoundExtractor>;
+	using leaf_bound_type  = typename leaf_bound::leaf_bound_type;
+	using bound_type       = typename leaf_bound::bound_type;
+	using bound_reference  = typename leaf_bound::bound_reference;
 	using bound_value_type = typename bound_type::value_type;
 
 
@@ -62,6 +109,10 @@ public:
 	// Modifiers
 	//-------------------------------------------------------------------------
 
+	void setValue(value_type const& value) {
+		value_ = value;
+	}
+
 	//-------------------------------------------------------------------------
 	// Element Access
 	//-------------------------------------------------------------------------
@@ -84,9 +135,15 @@ public:
 	// Indexing
 	//-------------------------------------------------------------------------
 
-	const bound_type& getBound() const noexcept {
-		static const bound_extractor extract;
-		return extract(value_);
+	bound_reference getBound() const noexcept {
+		return leaf_bound::bound(value_);
+	}
+
+	/**
+	 * Bound tested by predicates (ie. the Point of point values)
+	 */
+	const leaf_bound_type& getLeafBound() const noexcept {
+		return bound_extractor()(value_);
 	}
 
 	//-------------------------------------------------------------------------
@@ -42,7 +42,9 @@ private:
 public:
 	using value_type           = Value;
 	using size_type            = typename page_type::size_type;
-	using bound_type           = typename bound_extractor::bound_type;
+	using leaf_bound_type      = typename leaf_type::leaf_bound_type;
+	using bound_type           = typename leaf_type::bound_type;
+	using bound_reference      = typename leaf_type::bound_reference;
 	using bound_value_type     = typename bound_type::value_type;
 	using node_pointer         = std::shared_ptr<self_type>;
 	using child_iterator       = typename page_type::iterator;
@@ -54,7 +56,7 @@ public:
 	//-------------------------------------------------------------------------
 
 	//Node() = default;
-	Node() : parent_ptr_(nullptr) {
+	Node() : parent_ptr_() {
 		std::get<page_type>(data_).restretch();
 	}
 
@@ -70,7 +72,7 @@ public:
 	//	this->insert(child_b_ptr);
 	//}
 
-	Node(value_type const& value) : parent_ptr_(nullptr), data_(value) {
+	Node(value_type const& value) : data_(value), parent_ptr_() {
 	}
 
 
@@ -103,7 +105,7 @@ public:
 	/**
 	 * Add a child Node to this Node
 	 */
-	void insert(node_pointer& child_ptr) {
+	void insert(node_pointer const& child_ptr) {
 		assert(this->isPage());
 
 		// Set myself as child parent
@@ -116,7 +118,7 @@ public:
 	/**
 	 * Remove a child Node to from this Node
 	 */
-	void remove(node_pointer& child_ptr, const bool re_stretch = true) {
+	void remove(node_pointer const& child_ptr, const bool re_stretch = true) {
 		assert(this->isPage());
 		if(re_stretch) {
 			std::get<page_type>(data_).remove(child_ptr, std::true_type());
@@ -124,12 +126,12 @@ public:
 		std::get<page_type>(data_).remove(child_ptr, std::false_type());
 	}
 
-	void remove(node_pointer& child_ptr, std::true_type /* re-stretch */) {
+	void remove(node_pointer const& child_ptr, std::true_type /* re-stretch */) {
 		assert(this->isPage());
 		std::get<page_type>(data_).remove(child_ptr, std::true_type());
 	}
 
-	void remove(node_pointer& child_ptr, std::false_type /* re-stretch */) {
+	void remove(node_pointer const& child_ptr, std::false_type /* re-stretch */) {
 		assert(this->isPage());
 		std::get<page_type>(data_).remove(child_ptr, std::false_type());
 	}
@@ -140,12 +142,27 @@ public:
 		std::get<page_type>(data_).stretch(other.getBound());
 	}
 
+	void stretch(bound_type const& other_bound) noexcept {
+		assert(this->isPage());
+		std::get<page_type>(data_).stretch(other_bound);
+	}
+
 
 	void restretch() noexcept {
 		assert(this->isPage());
 		std::get<page_type>(data_).restretch();
 	}
 
+	/**
+	 * Replace the value held by this Leaf
+	 *
+	 * The bounds of the parents are not updated.
+	 */
+	void setValue(value_type const& value) {
+		assert(this->isLeaf());
+		std::get<leaf_type>(data_).setValue(value);
+	}
+
 	//-------------------------------------------------------------------------
 	// Element Access
 	//-------------------------------------------------------------------------
@@ -153,14 +170,14 @@ public:
 	/** Test if Node has a Parent
 	 */
 	bool hasParent() const noexcept {
-		return (parent_ptr_.get());
+		return (not parent_ptr_.expired());
 	}
 
 	/**
 	 *	Get the parent of this Node
 	 */
 	const node_pointer getParent() const noexcept {
-		return parent_ptr_;
+		return parent_ptr_.lock();
 	}
 
 	value_type const& getValue() const noexcept {
@@ -264,19 +281,24 @@ public:
 	// Indexing
 	//-------------------------------------------------------------------------
 
-	const bound_type& getBound() const noexcept {
+	bound_reference getBound() const noexcept {
 		if(this->isLeaf()){
 			return std::get<leaf_type>(data_).getBound();
 		}
 		return std::get<page_type>(data_).getBound();
 	}
 
+	const leaf_bound_type& getLeafBound() const noexcept {
+		assert(this->isLeaf());
+		return std::get<leaf_type>(data_).getLeafBound();
+	}
+
 	//-------------------------------------------------------------------------
 	// Data [Private]
 	//-------------------------------------------------------------------------
 private:
-	variant_type data_;
-	node_pointer parent_ptr_;
+	variant_type             data_;
+	std::weak_ptr<self_type> parent_ptr_; // weak to not form a cycle with children
 
 	//-------------------------------------------------------------------------
 	// Internal Functions [Private]
@@ -288,6 +310,50 @@ private:
 };
 
 
+//-------------------------------------------------------------------------
+// Node Factories for Shared Storage
+//-------------------------------------------------------------------------
+
+/**
+ * Create a new Page
+ */
+template<typename Value, typename BoundExtractor>
+std::shared_ptr<Node<Value,BoundExtractor>>
+make_page(std::shared_ptr<Node<Value,BoundExtractor>> const& /* hint */) {
+	return std::make_shared<Node<Value,BoundExtractor>>();
+}
+
+/**
+ * Create a new Leaf holding value
+ */
+template<typename Value, typename BoundExtractor>
+std::shared_ptr<Node<Value,BoundExtractor>>
+make_leaf(std::shared_ptr<Node<Value,BoundExtractor>> const& /* hint */, Value const& value) {
+	return std::make_shared<Node<Value,BoundExtractor>>(value);
+}
+
+/**
+ * Raw pointer to a Node used while traversing the tree
+ *
+ * Avoids the reference counting of the shared_ptr for
+ * pointers which only live during a query.
+ */
+template<typename Value, typename BoundExtractor>
+Node<Value,BoundExtractor> const*
+raw(std::shared_ptr<Node<Value,BoundExtractor>> const& node_ptr) noexcept {
+	return node_ptr.get();
+}
+
+/**
+ * Release a Node which is no longer part of the tree
+ *
+ * Nothing to do since the memory is released with the last
+ * reference to the Node.
+ */
+template<typename Value, typename BoundExtractor>
+void
+release(std::shared_ptr<Node<Value,BoundExtractor>> const& /* node_ptr */) {
+}
 
 
 } /* namespace rtree */
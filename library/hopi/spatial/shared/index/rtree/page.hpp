@@ -12,6 +12,7 @@
  */
 #pragma once
 
+#include "hopi/spatial/shared/index/rtree/leaf.hpp"
 
 #include <list>
 #include <memory>
@@ -53,7 +54,7 @@ public:
 	using const_reference  = typename list_type::const_reference;
 
 	using bound_extractor  = BoundExtractor;
-	using bound_type       = typename bound_extractor::bound_type;
+	using bound_type       = typename LeafBound<BoundExtractor>::bound_type;
 	using bound_value_type = typename bound_type::value_type;
 
 
@@ -99,7 +100,7 @@ public:
 	/**
 	 * Add a child Node to this Node
 	 */
-	void insert(node_pointer& child_ptr) {
+	void insert(node_pointer const& child_ptr) {
 		this->nodes_.push_back(child_ptr);
 		this->stretch(child_ptr->getBound());
 	}
@@ -107,19 +108,19 @@ public:
 	/**
 	 * Remove a child Node to from this Node
 	 */
-	void remove(node_pointer& child_ptr, const bool re_stretch = true) {
+	void remove(node_pointer const& child_ptr, const bool re_stretch = true) {
 		if(re_stretch) {
 			this->remove(child_ptr, std::true_type());
 		}
 		this->remove(child_ptr, std::false_type());
 	}
 
-	void remove(node_pointer& child_ptr, std::true_type /* re_stretch */) {
+	void remove(node_pointer const& child_ptr, std::true_type /* re_stretch */) {
 		this->nodes_.remove(child_ptr);
 		this->restretch();
 	}
 
-	void remove(node_pointer& child_ptr, std::false_type /* re_stretch */) {
+	void remove(node_pointer const& child_ptr, std::false_type /* re_stretch */) {
 		this->nodes_.remove(child_ptr);
 	}
 
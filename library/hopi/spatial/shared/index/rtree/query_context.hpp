@@ -0,0 +1,103 @@
+/// @file query_context.cpp
+/*
+ * Project:         HOPI
+ * File:            query_context.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/spatial/common/bounded_heap.hpp"
+#include "hopi/spatial/common/space_filling_curve.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace hopi {
+namespace spatial {
+namespace shared {
+namespace index {
+namespace rtree {
+
+/**
+ * Reusable working memory for RTree queries
+ *
+ * Holds the traversal stack and heaps used while searching
+ * the tree. The containers are cleared (not released) at the
+ * start of each query so once they have grown to the size
+ * needed by the tree no further allocations take place.
+ *
+ * The context stores raw Node pointers which are only valid
+ * during a query and must not be shared between threads.
+ *
+ * LeafCount fixes the number of nearest Leafs which can be
+ * kept by distance queries at compile time.
+ */
+template<typename RawNodePtr, typename DistanceType, std::size_t LeafCount = dynamic_count>
+struct QueryContext {
+	using raw_pointer        = RawNodePtr;
+	using distance_type      = DistanceType;
+	using distance_node_pair = std::pair<distance_type, raw_pointer>;
+
+	/**
+	 * Order pairs so the smallest distance is at the front of a heap
+	 */
+	struct MinDistanceOnTop {
+		bool operator()(distance_node_pair const& a, distance_node_pair const& b) const noexcept {
+			return a.first > b.first;
+		}
+	};
+
+	std::vector<raw_pointer>        node_stack; ///< Pages still to visit (spatial queries)
+	std::vector<distance_node_pair> node_heap;  ///< Min-heap of Nodes still to visit (distance queries)
+
+	BoundedHeap<distance_node_pair,LeafCount,LessPair<0>> leaf_heap; ///< Nearest Leafs found (distance queries)
+
+	void clear() noexcept {
+		node_stack.clear();
+		node_heap.clear();
+		leaf_heap.clear();
+	}
+};
+
+/**
+ * Reusable working memory for batched RTree distance queries
+ *
+ * Holds the Morton ordering of the queries, the heap of Nodes
+ * shared by a group of queries and a Leaf heap for each query
+ * within the group.
+ */
+template<typename RawNodePtr, typename DistanceType>
+struct BatchQueryContext {
+	using raw_pointer        = RawNodePtr;
+	using distance_type      = DistanceType;
+	using distance_node_pair = std::pair<distance_type, raw_pointer>;
+	using key_index_pair     = std::pair<sfc::key_type, std::size_t>;
+	using leaf_heap_type     = BoundedHeap<distance_node_pair,dynamic_count,LessPair<0>>;
+	using MinDistanceOnTop   = typename QueryContext<RawNodePtr,DistanceType>::MinDistanceOnTop;
+
+	std::vector<key_index_pair>     order;      ///< Morton key and index of each query
+	std::vector<distance_node_pair> node_heap;  ///< Min-heap of Nodes still to visit by the group
+	std::vector<leaf_heap_type>     leaf_heaps; ///< Nearest Leafs found for each query of the group
+
+	void clear() noexcept {
+		order.clear();
+		node_heap.clear();
+		for(auto& heap : leaf_heaps) {
+			heap.clear();
+		}
+	}
+};
+
+
+} /* namespace rtree */
+} /* namespace index */
+} /* namespace shared */
+} /* namespace spatial */
+} /* namespace hopi */
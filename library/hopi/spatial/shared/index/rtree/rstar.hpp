@@ -0,0 +1,253 @@
+/// @file rstar.hpp
+/*
+ * Project:         HOPI
+ * File:            rstar.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/spatial/bound/box.hpp"  // spatial::bound::OverlapArea
+#include "hopi/spatial/shared/index/rtree/algorithm.hpp"
+
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace hopi {
+namespace spatial {
+namespace shared {
+namespace index {
+namespace rtree {
+
+
+/** R* Tree Splitting
+ *
+ *  Splits along the axis with the smallest summed margin of all
+ *  allowed distributions and takes the distribution of least
+ *  overlap. Pages holding Leafs are chosen by the smallest increase
+ *  in overlap with their siblings and an overflowing Page first
+ *  evicts reinsert_count children to be placed again.
+ *
+ *  Beckmann, N., et al. "The R*-tree: An Efficient and Robust
+ *  Access Method for Points and Rectangles", SIGMOD 1990
+ */
+template<std::size_t MaxChildren, std::size_t MinChildren = (2*MaxChildren)/5>
+struct RStar final : public Algorithm<RStar<MaxChildren,MinChildren>> {
+	static_assert((MinChildren > 1) && (MinChildren <= MaxChildren/2));
+
+	static constexpr std::size_t max_children   = MaxChildren;
+	static constexpr std::size_t min_children   = MinChildren;
+	static constexpr std::size_t reinsert_count = std::max<std::size_t>(1, (3*MaxChildren)/10);
+
+
+	/** Split a single Node into two minimum entry Nodes
+	 *
+	 *  Children are sorted along each axis by their lower and then
+	 *  upper bound. The axis is chosen with the smallest sum of margins
+	 *  over every distribution of both sorts and within it the
+	 *  distribution with the least overlap (then area) is used.
+	 *
+	 *  @param[in] parent_ptr Pointer to the overflowing Node
+	 *
+	 *	@returns Pair of Node pointers to the new Nodes
+	 */
+	template<typename NodePtr>
+	static
+	std::pair<NodePtr,NodePtr>
+	split_node(NodePtr& parent_ptr) {
+		using node_type  = typename NodePtr::element_type;
+		using bound_type = typename node_type::bound_type;
+		using value_type = typename bound_type::value_type;
+		using spatial::bound::OverlapArea;
+		using spatial::bound::Union;
+		constexpr std::size_t capacity = max_children + 1;
+		assert(parent_ptr);
+		assert(parent_ptr->isPage());
+		assert(parent_ptr->size() <= capacity);
+
+		// Copy the children once since both are visited many times
+		const std::size_t num = parent_ptr->size();
+		std::array<NodePtr,capacity>    child;
+		std::array<bound_type,capacity> bound;
+		{
+			std::size_t i = 0;
+			for(const NodePtr& node : *parent_ptr){
+				child[i] = node;
+				bound[i] = node->getBound();
+				++i;
+			}
+		}
+
+		// Order children by lower (or upper) bound of an axis
+		std::array<std::size_t,capacity> order;
+		auto sort_children = [&](const std::size_t axis, const bool by_upper){
+			std::iota(order.begin(), order.begin() + num, std::size_t(0));
+			std::sort(order.begin(), order.begin() + num, [&](const std::size_t a, const std::size_t b){
+				return by_upper ?
+					std::make_pair(bound[a].max(axis), bound[a].min(axis)) < std::make_pair(bound[b].max(axis), bound[b].min(axis)) :
+					std::make_pair(bound[a].min(axis), bound[a].max(axis)) < std::make_pair(bound[b].min(axis), bound[b].max(axis));
+			});
+		};
+
+		// Bound of the first k and the last (num - k) ordered children
+		std::array<bound_type,capacity> lower;
+		std::array<bound_type,capacity> upper;
+		auto group_bounds = [&](){
+			lower[0] = bound[order[0]];
+			for(std::size_t i = 1; i < num; ++i){
+				lower[i] = Union(lower[i-1], bound[order[i]]);
+			}
+			upper[num-1] = bound[order[num-1]];
+			for(std::size_t i = num-1; i-- > 0;){
+				upper[i] = Union(upper[i+1], bound[order[i]]);
+			}
+		};
+
+		// Search every sort of every axis
+		// - First group is order[0,k) and second is order[k,num)
+		struct Distribution {
+			value_type  overlap = std::numeric_limits<value_type>::max();
+			value_type  area    = std::numeric_limits<value_type>::max();
+			std::size_t axis    = 0;
+			bool        upper   = false;
+			std::size_t k       = 0;
+		};
+		Distribution best;
+		auto best_margin = std::numeric_limits<value_type>::max();
+		for(std::size_t axis = 0; axis < bound_type::ndim; ++axis){
+			value_type   margin = 0;
+			Distribution best_of_axis;
+			for(const bool by_upper : {false, true}){
+				sort_children(axis, by_upper);
+				group_bounds();
+				for(std::size_t k = min_children; k <= num - min_children; ++k){
+					const auto& a = lower[k-1];
+					const auto& b = upper[k];
+					margin += a.margin() + b.margin();
+
+					const auto overlap = OverlapArea(a, b);
+					const auto area    = a.area() + b.area();
+					if( (overlap < best_of_axis.overlap) or
+						((overlap == best_of_axis.overlap) and (area < best_of_axis.area)) ){
+						best_of_axis = Distribution{overlap, area, axis, by_upper, k};
+					}
+				}
+			}
+			if( margin < best_margin ){
+				best_margin = margin;
+				best        = best_of_axis;
+			}
+		}
+		assert(best.k >= min_children);
+
+		// Move the children into two new Nodes
+		sort_children(best.axis, best.upper);
+		auto a_node_ptr = make_page(parent_ptr);
+		auto b_node_ptr = make_page(parent_ptr);
+		parent_ptr->clear();
+		for(std::size_t i = 0; i < best.k; ++i){
+			a_node_ptr->insert(child[order[i]]);
+		}
+		for(std::size_t i = best.k; i < num; ++i){
+			b_node_ptr->insert(child[order[i]]);
+		}
+
+		assert(a_node_ptr->size() >= min_children);
+		assert(b_node_ptr->size() >= min_children);
+		assert(a_node_ptr->size() <= max_children);
+		assert(b_node_ptr->size() <= max_children);
+		return std::make_pair<NodePtr,NodePtr>(std::move(a_node_ptr),std::move(b_node_ptr));
+	}
+
+	/**
+	 *  Search the current node for best fit
+	 *
+	 *  Above the Pages holding Leafs this is the least area
+	 *  enlargement of Algorithm. Among Pages holding Leafs the child
+	 *  is chosen whose enlarged bound gains the least overlap with
+	 *  its siblings, then the least area enlargement, then least area.
+	 *
+	 *  @param bounding_box[in] Bounding object to use for search
+	 *  @param current_node[in] Pointer to the Node to search within
+	 *
+	 *  @return Pointer to the child which is the best geometric fit
+	 */
+	template<typename BBox, typename NodePtr>
+	static NodePtr find_best_fit_in_node(const BBox& bounding_box, const NodePtr& current_node) {
+		using value_type = typename BBox::value_type;
+		using spatial::bound::OverlapArea;
+		using spatial::bound::Union;
+		assert(current_node);
+		assert(current_node->size() > 0);
+		assert(current_node->size() <= max_children);
+
+		// Quick Return if children are leafs
+		if( current_node->front()->isLeaf() ) {
+			return current_node->front();
+		}
+		if( not current_node->front()->front()->isLeaf() ) {
+			return Algorithm<RStar>::find_best_fit_in_node(bounding_box, current_node);
+		}
+
+		const std::size_t num = current_node->size();
+		std::array<NodePtr,max_children> child;
+		std::array<BBox,max_children>    bound;
+		{
+			std::size_t i = 0;
+			for(const NodePtr& node : *current_node){
+				child[i] = node;
+				bound[i] = node->getBound();
+				++i;
+			}
+		}
+
+		NodePtr best_node(nullptr);
+		auto best_overlap  = std::numeric_limits<value_type>::max();
+		auto best_increase = std::numeric_limits<value_type>::max();
+		auto best_area     = std::numeric_limits<value_type>::max();
+		for(std::size_t i = 0; i < num; ++i){
+			const auto enlarged = Union(bound[i], bounding_box);
+			const auto area     = bound[i].area();
+			const auto increase = enlarged.area() - area;
+
+			value_type overlap = 0;
+			if( increase > 0 ) {
+				for(std::size_t j = 0; j < num; ++j){
+					if( j != i ) {
+						overlap += OverlapArea(enlarged, bound[j]) - OverlapArea(bound[i], bound[j]);
+					}
+				}
+			}
+
+			if( (overlap < best_overlap) or
+				((overlap == best_overlap) and (increase < best_increase)) or
+				((overlap == best_overlap) and (increase == best_increase) and (area < best_area)) ){
+				best_overlap  = overlap;
+				best_increase = increase;
+				best_area     = area;
+				best_node     = child[i];
+			}
+		}
+		assert(best_node);
+		return best_node;
+	}
+
+};
+
+
+
+} /* namespace rtree */
+} /* namespace index */
+} /* namespace shared */
+} /* namespace spatial */
+} /* namespace hopi */
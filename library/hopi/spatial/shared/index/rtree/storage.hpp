@@ -0,0 +1,98 @@
+/// @file storage.cpp
+/*
+ * Project:         HOPI
+ * File:            storage.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/spatial/shared/index/rtree/arena.hpp"
+#include "hopi/spatial/shared/index/rtree/node.hpp"
+
+#include <memory>
+#include <type_traits>
+
+namespace hopi {
+namespace spatial {
+namespace shared {
+namespace index {
+namespace rtree {
+
+/**
+ * Storage of the Nodes within an RTree
+ *
+ * Selected by the Allocator of the RTree. The default
+ * stores each Node within a std::shared_ptr.
+ *
+ * The only Node pointer held by the RTree is the root so
+ * it is re-bound to the storage whenever the storage is
+ * copied or moved.
+ */
+template<typename Value, typename BoundExtractor, typename Parameters, typename Allocator>
+struct Storage {
+	using node_type    = Node<Value,BoundExtractor>;
+	using node_pointer = std::shared_ptr<node_type>;
+
+	node_pointer null_node() noexcept {
+		return node_pointer(nullptr);
+	}
+
+	node_pointer rebind(node_pointer const& node_ptr) noexcept {
+		return node_ptr;
+	}
+
+	void clear() noexcept {
+	}
+};
+
+/**
+ * Arena Storage of the Nodes within an RTree
+ *
+ * Pages hold one more than the maximum children so a
+ * Page can overflow before being split.
+ */
+template<typename Value, typename BoundExtractor, typename Parameters, typename T>
+struct Storage<Value,BoundExtractor,Parameters,ArenaAllocator<T>> {
+	using arena_type   = Arena<Value,BoundExtractor,Parameters::max_children+1>;
+	using node_pointer = typename arena_type::node_pointer;
+	using node_type    = typename node_pointer::element_type;
+
+	node_pointer null_node() noexcept {
+		return node_pointer(&arena, arena_type::npos);
+	}
+
+	node_pointer rebind(node_pointer const& node_ptr) noexcept {
+		return node_pointer(&arena, node_ptr.index());
+	}
+
+	void clear() noexcept {
+		arena.clear();
+	}
+
+	arena_type arena;
+};
+
+
+/**
+ * Test if the Storage holds the Nodes within an Arena
+ */
+template<typename StorageType>
+struct is_arena_storage : public std::false_type {
+};
+
+template<typename Value, typename BoundExtractor, typename Parameters, typename T>
+struct is_arena_storage<Storage<Value,BoundExtractor,Parameters,ArenaAllocator<T>>> : public std::true_type {
+};
+
+
+} /* namespace rtree */
+} /* namespace index */
+} /* namespace shared */
+} /* namespace spatial */
+} /* namespace hopi */
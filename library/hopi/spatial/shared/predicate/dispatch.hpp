@@ -9,8 +9,12 @@
 
 
 #include "hopi/spatial/bound/box.hpp"
+#include "hopi/spatial/bound/box_array.hpp"
+#include "hopi/spatial/bound/point.hpp"
 #include "hopi/spatial/shared/predicate/tags.hpp"
 
+#include <cstdint>
+
 namespace hopi {
 namespace spatial {
 namespace shared {
@@ -29,86 +33,138 @@ struct dispatch{
 
 //-------------------------------------------------------------------------
 // Spatial Proximity Type Dispatches
+// - The first bound is a Box, a Point (std::array) of a Leaf or
+//   the BoxArray (PointArray) of the children of a Page
 //-------------------------------------------------------------------------
 
 template<>
 struct dispatch<detail::disjoint_tag> {
-	template<typename BoundType>
-	static bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static bool apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Disjoint(a,b);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& a, const BoundType& b, const std::size_t count) noexcept {
+		return hopi::spatial::bound::Disjoint(a,b,count);
+	}
 };
 
 template<>
 struct dispatch<detail::intersects_tag> {
-	template<typename BoundType>
-	static bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static bool apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Intersects(a,b);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& a, const BoundType& b, const std::size_t count) noexcept {
+		return hopi::spatial::bound::Intersects(a,b,count);
+	}
 };
 
 template<>
 struct dispatch<detail::overlaps_tag> {
-	template<typename BoundType>
-	static bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static bool apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Overlaps(a,b);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& a, const BoundType& b, const std::size_t count) noexcept {
+		return hopi::spatial::bound::Overlaps(a,b,count);
+	}
 };
 
 template<>
 struct dispatch<detail::contains_tag> {
-	template<typename BoundType>
-	static bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static bool apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Contains(a,b);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& a, const BoundType& b, const std::size_t count) noexcept {
+		return hopi::spatial::bound::Contains(a,b,count);
+	}
 };
 
 template<>
 struct dispatch<detail::contained_by_tag> {
-	template<typename BoundType>
-	static bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static bool apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Contains(b,a);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& a, const BoundType& b, const std::size_t count) noexcept {
+		return hopi::spatial::bound::Contains(b,a,count);
+	}
 };
 
 template<>
 struct dispatch<detail::contained_ni_by_tag> {
-	template<typename BoundType>
-	static bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static bool apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::ContainsNonInclusive(b,a);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& a, const BoundType& b, const std::size_t count) noexcept {
+		return hopi::spatial::bound::ContainsNonInclusive(b,a,count);
+	}
 };
 
 template<>
 struct dispatch<detail::covers_tag> {
-	template<typename BoundType>
-	static bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static bool apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Covers(a,b);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& a, const BoundType& b, const std::size_t count) noexcept {
+		return hopi::spatial::bound::Covers(a,b,count);
+	}
 };
 
 template<>
 struct dispatch<detail::covered_by_tag> {
-	template<typename BoundType>
-	static bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static bool apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Covers(b,a);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& a, const BoundType& b, const std::size_t count) noexcept {
+		return hopi::spatial::bound::Covers(b,a,count);
+	}
 };
 
 template<>
 struct dispatch<detail::equals_tag> {
-	template<typename BoundType>
-	static bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static bool apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Equals(a,b);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& a, const BoundType& b, const std::size_t count) noexcept {
+		return hopi::spatial::bound::Equals(a,b,count);
+	}
 };
 
 template<>
 struct dispatch<detail::all_tag> {
-	template<typename BoundType>
-	static constexpr bool apply(const BoundType& a, const BoundType& b) noexcept {
+	template<typename LeafType, typename BoundType>
+	static constexpr bool apply(const LeafType& /* a */, const BoundType& /* b */) noexcept {
 		return true;
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static std::uint64_t apply(const BoundArrayType& /* a */, const BoundType& /* b */, const std::size_t count) noexcept {
+		return hopi::spatial::bound::detail::first_lanes(count);
+	}
 };
 
 
@@ -119,29 +175,44 @@ struct dispatch<detail::all_tag> {
 
 template<>
 struct dispatch<detail::to_nearest_tag> {
-	template<typename BoundType>
+	template<typename LeafType, typename BoundType>
 	static typename BoundType::value_type
-	apply(const BoundType& a, const BoundType& b) noexcept {
+	apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Nearest(a,b);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static void apply(const BoundArrayType& a, const BoundType& b, const std::size_t count, typename BoundArrayType::value_array& out) noexcept {
+		hopi::spatial::bound::Nearest(a,b,count,out);
+	}
 };
 
 template<>
 struct dispatch<detail::to_centroid_tag> {
-	template<typename BoundType>
+	template<typename LeafType, typename BoundType>
 	static typename BoundType::value_type
-	apply(const BoundType& a, const BoundType& b) noexcept {
+	apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Centroid(a,b);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static void apply(const BoundArrayType& a, const BoundType& b, const std::size_t count, typename BoundArrayType::value_array& out) noexcept {
+		hopi::spatial::bound::Centroid(a,b,count,out);
+	}
 };
 
 template<>
 struct dispatch<detail::to_furthest_tag> {
-	template<typename BoundType>
+	template<typename LeafType, typename BoundType>
 	static typename BoundType::value_type
-	apply(const BoundType& a, const BoundType& b) noexcept {
+	apply(const LeafType& a, const BoundType& b) noexcept {
 		return hopi::spatial::bound::Furthest(a,b);
 	}
+
+	template<typename BoundArrayType, typename BoundType>
+	static void apply(const BoundArrayType& a, const BoundType& b, const std::size_t count, typename BoundArrayType::value_array& out) noexcept {
+		hopi::spatial::bound::Furthest(a,b,count,out);
+	}
 };
 
 } /* namespace detail */
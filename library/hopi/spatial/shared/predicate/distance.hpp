@@ -8,6 +8,7 @@
 
 #include "hopi/spatial/shared/predicate/dispatch.hpp"
 
+#include <cstddef>
 #include <type_traits>
 
 namespace hopi {
@@ -43,6 +44,13 @@ public:
 		return detail::dispatch<NodeOpTag>::apply(bound,_bound);
 	}
 
+	/**
+	 * Measure the Point of a Leaf holding a point value
+	 */
+	value_type operator()(const typename BoundType::array_type& point, const std::true_type /* is_leaf */) const noexcept {
+		return detail::dispatch<LeafOpTag>::apply(point,_bound);
+	}
+
 	value_type operator()(const BoundType& bound, const bool is_leaf) const noexcept {
 		if( is_leaf ) {
 			return this->operator()(bound,std::true_type());
@@ -50,6 +58,19 @@ public:
 		return this->operator()(bound,std::false_type());
 	}
 
+	/**
+	 * Measure the first count bounds of a BoxArray at once
+	 */
+	template<typename BoundArrayType>
+	void operator()(const BoundArrayType& bounds, const std::size_t count, const bool is_leaf, typename BoundArrayType::value_array& out) const noexcept {
+		if( is_leaf ) {
+			detail::dispatch<LeafOpTag>::apply(bounds,_bound,count,out);
+		}
+		else {
+			detail::dispatch<NodeOpTag>::apply(bounds,_bound,count,out);
+		}
+	}
+
 	size_type count() const noexcept {
 		return _count;
 	}
@@ -8,6 +8,8 @@
 
 #include "hopi/spatial/shared/predicate/dispatch.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace hopi {
@@ -41,6 +43,13 @@ public:
 		return detail::dispatch<NodeOpTag>::apply(bound,_bound);
 	}
 
+	/**
+	 * Test the Point of a Leaf holding a point value
+	 */
+	bool operator()(const typename BoundType::array_type& point, const std::true_type /* is_leaf */) const noexcept {
+		return detail::dispatch<LeafOpTag>::apply(point,_bound);
+	}
+
 	bool operator()(const BoundType& bound, const bool is_leaf) const noexcept {
 		if( is_leaf ) {
 			return this->operator()(bound,std::true_type());
@@ -48,6 +57,29 @@ public:
 		return this->operator()(bound,std::false_type());
 	}
 
+	/**
+	 * Test the first count bounds of a BoxArray at once
+	 *
+	 * Bit i of the returned mask is set if bound i passes
+	 */
+	template<typename BoundArrayType>
+	std::uint64_t operator()(const BoundArrayType& bounds, const std::size_t count, const std::true_type /* is_leaf */) const noexcept {
+		return detail::dispatch<LeafOpTag>::apply(bounds,_bound,count);
+	}
+
+	template<typename BoundArrayType>
+	std::uint64_t operator()(const BoundArrayType& bounds, const std::size_t count, const std::false_type /* is_leaf */) const noexcept {
+		return detail::dispatch<NodeOpTag>::apply(bounds,_bound,count);
+	}
+
+	template<typename BoundArrayType>
+	std::uint64_t operator()(const BoundArrayType& bounds, const std::size_t count, const bool is_leaf) const noexcept {
+		if( is_leaf ) {
+			return this->operator()(bounds,count,std::true_type());
+		}
+		return this->operator()(bounds,count,std::false_type());
+	}
+
 
 protected:
 	BoundType _bound;
@@ -0,0 +1,113 @@
+/// @file ascii_targets.cpp
+/*
+ * Project:         HOPI
+ * File:            ascii_targets.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/ascii_targets.hpp"
+#include "test_common.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+/**
+ * Write a target file with the shortest exact text of every value
+ */
+void
+write_exact(const std::string& file_name, const std::vector<double>& xyz, const std::string& separator)
+{
+    std::ofstream out(file_name);
+    out << "  " << UserTypes::NDim << separator << xyz.size() / UserTypes::NDim << "\n";
+    for (std::size_t i = 0; i < xyz.size(); ++i) {
+        char buffer[64];
+        *std::to_chars(buffer, buffer + sizeof(buffer), xyz[i]).ptr = '\0';
+        out << (((i % 2) and (xyz[i] > 0)) ? "+" : "") << buffer << (((i + 1) % UserTypes::NDim) ? separator : "\n");
+    }
+}
+
+}  // namespace
+
+TEST_CASE("ASCII target files read back exactly", "[io]")
+{
+    constexpr std::size_t npoints = 4000;
+    const TempFile        file("hopi_unit_ascii_targets.txt");
+    const auto            xyz = random_xyz(npoints, 11, -1e3, 1e3);
+
+    for (const std::string separator : { " ", "\t", "  \t " }) {
+        write_exact(file.name(), xyz, separator);
+
+        std::size_t         ndim    = 0;
+        std::size_t         count   = 0;
+        std::vector<double> read_xyz;
+        hopi::read_target_file(file.name(), ndim, count, read_xyz);
+        CHECK(ndim == UserTypes::NDim);
+        CHECK(count == npoints);
+        CHECK(read_xyz == xyz);
+
+        std::vector<float> read_float;
+        hopi::read_target_file(file.name(), ndim, count, read_float);
+        REQUIRE(read_float.size() == xyz.size());
+        for (std::size_t i = 0; i < xyz.size(); ++i) {
+            CHECK(read_float[i] == float(xyz[i]));
+        }
+    }
+}
+
+TEST_CASE("ASCII result files hold the values written", "[io]")
+{
+    constexpr std::size_t ndim    = UserTypes::NDim;
+    constexpr std::size_t npoints = 3000;
+    constexpr std::size_t nvar    = 3;
+    const TempFile        file("hopi_unit_ascii_results.txt");
+
+    // Nine significant digits give back every float exactly
+    const auto xyz = random_xyz<float>(npoints, 12);
+    const auto var = random_xyz(npoints, 13, -1e6, 1e6);
+    hopi::write_target_file(file.name(), ndim, npoints, xyz, nvar, var);
+
+    std::ifstream in(file.name());
+    std::size_t   file_ndim    = 0;
+    std::size_t   file_npoints = 0;
+    std::size_t   file_nvar    = 0;
+    in >> file_ndim >> file_npoints >> file_nvar;
+    CHECK(file_ndim == ndim);
+    CHECK(file_npoints == npoints);
+    CHECK(file_nvar == nvar);
+
+    std::size_t num_lines = 0;
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line)) {
+        std::istringstream row(line);
+        for (std::size_t d = 0; d < ndim; ++d) {
+            float value = 0;
+            row >> value;
+            CHECK(value == xyz[num_lines * ndim + d]);
+        }
+        for (std::size_t v = 0; v < nvar; ++v) {
+            double value = 0;
+            row >> value;
+            const double expected = var[num_lines * nvar + v];
+            CHECK(std::abs(value - expected) <= 1e-8 * std::abs(expected));
+        }
+        CHECK(row);
+        ++num_lines;
+    }
+    CHECK(num_lines == npoints);
+}
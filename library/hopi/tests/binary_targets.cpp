@@ -0,0 +1,137 @@
+/// @file binary_targets.cpp
+/*
+ * Project:         HOPI
+ * File:            binary_targets.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/binary_targets.hpp"
+#include "test_common.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+/**
+ * Check every block of the mapped file against the interleaved values
+ */
+template<typename T>
+void
+check_mapped(const hopi::MappedTargetFile& mapped,
+             const std::size_t             npoints,
+             const std::vector<T>&         xyz,
+             const std::size_t             nvar,
+             const std::vector<T>&         var)
+{
+    constexpr std::size_t ndim = UserTypes::NDim;
+    REQUIRE(mapped.ndim() == ndim);
+    REQUIRE(mapped.npoints() == npoints);
+    REQUIRE(mapped.nvar() == nvar);
+    REQUIRE(mapped.value_bytes() == sizeof(T));
+
+    for (std::size_t d = 0; d < ndim; ++d) {
+        const T* block = mapped.template coordinate<T>(d);
+        REQUIRE(block != nullptr);
+        CHECK(reinterpret_cast<std::uintptr_t>(block) % hopi::BinaryTargetHeader::alignment_value == 0);
+        for (std::size_t i = 0; i < npoints; ++i) {
+            CHECK(block[i] == xyz[i * ndim + d]);
+        }
+    }
+    for (std::size_t v = 0; v < nvar; ++v) {
+        const T* block = mapped.template variable<T>(v);
+        REQUIRE(block != nullptr);
+        CHECK(reinterpret_cast<std::uintptr_t>(block) % hopi::BinaryTargetHeader::alignment_value == 0);
+        for (std::size_t i = 0; i < npoints; ++i) {
+            CHECK(block[i] == var[i * nvar + v]);
+        }
+    }
+    CHECK(mapped.template coordinate<T>(ndim) == nullptr);
+    CHECK(mapped.template variable<T>(nvar) == nullptr);
+}
+
+}  // namespace
+
+TEST_CASE("Binary target files map back the values written", "[io]")
+{
+    constexpr std::size_t npoints = 1500;
+    constexpr std::size_t nvar    = 3;
+    const TempFile        file("hopi_unit_binary_targets.bin");
+
+    SECTION("Double values")
+    {
+        const auto xyz = random_xyz(npoints, 3);
+        const auto var = random_xyz(npoints, 4);
+        hopi::write_binary_target_file(file.name(), UserTypes::NDim, npoints, xyz, nvar, var);
+
+        const hopi::MappedTargetFile mapped(file.name());
+        check_mapped(mapped, npoints, xyz, nvar, var);
+        CHECK(mapped.coordinate<float>(0) == nullptr);
+    }
+
+    SECTION("Float values")
+    {
+        const auto xyz = random_xyz<float>(npoints, 5);
+        const auto var = random_xyz<float>(npoints, 6);
+        hopi::write_binary_target_file(file.name(), UserTypes::NDim, npoints, xyz, nvar, var);
+
+        const hopi::MappedTargetFile mapped(file.name());
+        check_mapped(mapped, npoints, xyz, nvar, var);
+        CHECK(mapped.variable<double>(0) == nullptr);
+    }
+
+    SECTION("No points")
+    {
+        hopi::write_binary_target_file(file.name(), UserTypes::NDim, 0, std::vector<double>(), 0, std::vector<double>());
+
+        const hopi::MappedTargetFile mapped(file.name());
+        CHECK(mapped.npoints() == 0);
+        CHECK(mapped.nvar() == 0);
+    }
+}
+
+TEST_CASE("ASCII target files convert to binary", "[io]")
+{
+    constexpr std::size_t npoints = 700;
+    const TempFile        ascii_file("hopi_unit_convert_targets.txt");
+    const TempFile        binary_file("hopi_unit_convert_targets.bin");
+
+    // Values exact in float so both precisions convert exactly
+    const auto          xyz = random_xyz<float>(npoints, 7);
+    std::vector<double> xyz_double(xyz.begin(), xyz.end());
+    {
+        std::ofstream out(ascii_file.name());
+        out << UserTypes::NDim << " " << npoints << "\n";
+        for (const auto x : xyz_double) {
+            char buffer[64];
+            *std::to_chars(buffer, buffer + sizeof(buffer), x).ptr = '\0';
+            out << buffer << "\n";
+        }
+    }
+
+    SECTION("Double values")
+    {
+        hopi::convert_target_file(ascii_file.name(), binary_file.name(), sizeof(double));
+        const hopi::MappedTargetFile mapped(binary_file.name());
+        check_mapped(mapped, npoints, xyz_double, 0, std::vector<double>());
+    }
+
+    SECTION("Float values")
+    {
+        hopi::convert_target_file(ascii_file.name(), binary_file.name(), sizeof(float));
+        const hopi::MappedTargetFile mapped(binary_file.name());
+        check_mapped(mapped, npoints, xyz, 0, std::vector<float>());
+    }
+}
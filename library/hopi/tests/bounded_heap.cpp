@@ -0,0 +1,143 @@
+/// @file bounded_heap.cpp
+/*
+ * Project:         HOPI
+ * File:            bounded_heap.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/spatial/common/bounded_heap.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+/**
+ * Shuffled values 0 to n-1
+ */
+std::vector<int>
+shuffled(const int n)
+{
+    std::vector<int> values(n);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), std::default_random_engine(5));
+    return values;
+}
+
+/**
+ * Heap contents after sort()
+ */
+template<typename Heap>
+std::vector<int>
+sorted(Heap& heap)
+{
+    heap.sort();
+    return std::vector<int>(heap.begin(), heap.end());
+}
+
+}  // namespace
+
+TEST_CASE("BoundedHeap keeps the best values", "[heap]")
+{
+    const auto values = shuffled(1000);
+
+    SECTION("Fixed count")
+    {
+        hopi::spatial::BoundedHeap<int, 16> heap;
+        for (const auto v : values) {
+            heap.push(v);
+        }
+        REQUIRE(heap.full());
+        CHECK(heap.worst() == 15);
+        std::vector<int> expected(16);
+        std::iota(expected.begin(), expected.end(), 0);
+        CHECK(sorted(heap) == expected);
+    }
+
+    SECTION("Dynamic count reused with smaller counts")
+    {
+        hopi::spatial::BoundedHeap<int> heap(100);
+        for (const auto v : values) {
+            heap.push(v);
+        }
+        CHECK(heap.size() == 100);
+        CHECK(heap.worst() == 99);
+
+        heap.reset(3);
+        for (const auto v : values) {
+            heap.emplace(v);
+        }
+        CHECK(sorted(heap) == std::vector<int>{ 0, 1, 2 });
+    }
+
+    SECTION("Count of zero keeps nothing")
+    {
+        hopi::spatial::BoundedHeap<int> heap(0);
+        CHECK(heap.full());
+        CHECK(heap.empty());
+        CHECK_FALSE(heap.push(1));
+        CHECK(heap.size() == 0);
+    }
+
+    SECTION("Count larger than the values pushed")
+    {
+        hopi::spatial::BoundedHeap<int> heap(2000);
+        for (const auto v : values) {
+            CHECK(heap.push(v));
+        }
+        CHECK_FALSE(heap.full());
+        std::vector<int> expected(1000);
+        std::iota(expected.begin(), expected.end(), 0);
+        CHECK(sorted(heap) == expected);
+    }
+}
+
+TEST_CASE("Nearest queries for none or more than every value", "[heap][rtree]")
+{
+    namespace predicate = hopi::spatial::shared::predicate;
+    using Exhaustive    = hopi::spatial::shared::index::Exhaustive<index_type, extractor>;
+    using tree_type     = hopi::spatial::RTree<index_type>;
+
+    const auto indices = random_indices(300, 13);
+    Exhaustive exhaustive;
+    exhaustive.insert(indices.begin(), indices.end());
+    tree_type tree;
+    tree.insert(indices.begin(), indices.end());
+
+    const point_type        center = { 0.5, 0.5, 0.5 };
+    const box_type          query(center, center);
+    std::vector<index_type> found;
+
+    SECTION("k = 0")
+    {
+        CHECK(exhaustive.query(predicate::Nearest(query, 0), std::back_inserter(found)) == 0);
+        CHECK(tree.query(predicate::Nearest(query, 0), std::back_inserter(found)) == 0);
+        CHECK(found.empty());
+    }
+
+    SECTION("k > size")
+    {
+        CHECK(exhaustive.query(predicate::Nearest(query, 1000), std::back_inserter(found)) == indices.size());
+        REQUIRE(found.size() == indices.size());
+
+        // Nearest first
+        for (std::size_t i = 1; i < found.size(); ++i) {
+            CHECK(hopi::spatial::bound::Nearest(found[i - 1].first, query) <= hopi::spatial::bound::Nearest(found[i].first, query));
+        }
+        CHECK(query_keys(tree, predicate::Nearest(query, 1000)) == query_keys(exhaustive, predicate::Nearest(query, 1000)));
+    }
+}
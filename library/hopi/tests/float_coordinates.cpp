@@ -0,0 +1,139 @@
+/// @file float_coordinates.cpp
+/*
+ * Project:         HOPI
+ * File:            float_coordinates.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/rbf_interpolator.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+using float_box   = hopi::spatial::BoundBox<float, 3>;
+using float_index = hopi::spatial::TreeIndex<float_box, std::size_t>;
+
+/**
+ * Frozen tree of point shaped boxes in the precision of the Box
+ */
+template<typename Box, typename T>
+hopi::spatial::FrozenRTree<hopi::spatial::TreeIndex<Box, std::size_t>>
+make_frozen(const std::vector<T>& xyz)
+{
+    using index = hopi::spatial::TreeIndex<Box, std::size_t>;
+    std::vector<index> indices;
+    for (std::size_t i = 0; i < xyz.size() / 3; ++i) {
+        const typename Box::array_type point = { xyz[i * 3], xyz[i * 3 + 1], xyz[i * 3 + 2] };
+        indices.emplace_back(Box(point, point), i);
+    }
+    hopi::spatial::RTree<index> tree;
+    tree.insert(indices.begin(), indices.end(), hopi::spatial::STRPacking());
+    return hopi::spatial::FrozenRTree<index>(std::move(tree));
+}
+
+/**
+ * Sorted keys of the CSR results of every query
+ */
+template<typename Index>
+std::vector<std::vector<std::size_t>>
+batch_keys(const std::vector<std::size_t>& offsets, const std::vector<Index>& neighbors)
+{
+    std::vector<std::vector<std::size_t>> keys(offsets.size() - 1);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        for (auto n = offsets[i]; n < offsets[i + 1]; ++n) {
+            keys[i].push_back(neighbors[n].second);
+        }
+        std::sort(keys[i].begin(), keys[i].end());
+    }
+    return keys;
+}
+
+}  // namespace
+
+TEST_CASE("Float trees find the same nearest values as double trees", "[rtree][float]")
+{
+    constexpr std::size_t k = 12;
+
+    // Shells of points about each query at distances which round to ties in float
+    // - Background points stop the search from finding only a shell
+    const auto                       query_xyz = random_xyz<float>(500, 73);
+    auto                             xyz       = random_xyz<float>(5000, 71);
+    std::default_random_engine       re(79);
+    std::normal_distribution<double> normal(0, 1);
+    for (std::size_t q = 0; q < query_xyz.size() / 3; ++q) {
+        for (std::size_t n = 0; n < 40; ++n) {
+            const double direction[3] = { normal(re), normal(re), normal(re) };
+            const double scale        = 0.01 / std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+            for (std::size_t d = 0; d < 3; ++d) {
+                xyz.push_back(float(query_xyz[q * 3 + d] + scale * direction[d]));
+            }
+        }
+    }
+    const std::vector<double> xyz_double(xyz.begin(), xyz.end());
+
+    std::vector<float_box> float_queries;
+    std::vector<box_type>  double_queries;
+    for (std::size_t q = 0; q < query_xyz.size() / 3; ++q) {
+        const float_box::array_type point = { query_xyz[q * 3], query_xyz[q * 3 + 1], query_xyz[q * 3 + 2] };
+        float_queries.emplace_back(point, point);
+        double_queries.emplace_back(point_type{ point[0], point[1], point[2] }, point_type{ point[0], point[1], point[2] });
+    }
+
+    const auto float_tree  = make_frozen<float_box>(xyz);
+    const auto double_tree = make_frozen<box_type>(xyz_double);
+
+    std::vector<std::size_t> double_offsets, float_offsets;
+    std::vector<index_type>  double_neighbors;
+    std::vector<float_index> float_neighbors;
+    double_tree.parallel_query_batch(double_queries, k, double_offsets, double_neighbors);
+    float_tree.parallel_query_batch_exact(float_queries, k, float_offsets, float_neighbors, 8);
+    REQUIRE(float_offsets == double_offsets);
+    CHECK(batch_keys(float_offsets, float_neighbors) == batch_keys(double_offsets, double_neighbors));
+}
+
+TEST_CASE("Float coordinates interpolate as double coordinates", "[rbf][float]")
+{
+    using FloatTypes = BasicUserTypes<float>;
+
+    // Values exact in float so both interpolators see the same points
+    const auto                sources = random_xyz<float>(3000, 75);
+    const auto                targets = random_xyz<float>(800, 77);
+    const std::vector<double> sources_double(sources.begin(), sources.end());
+    const std::vector<double> targets_double(targets.begin(), targets.end());
+    const std::size_t         Ns = sources.size() / 3;
+    const std::size_t         Nt = targets.size() / 3;
+
+    hopi::RBFInterpolator<FloatTypes> float_interpolator;
+    float_interpolator.setup(Ns, sources.data(), 3, sources.data() + 1, 3, sources.data() + 2, 3,
+                             Nt, targets.data(), 3, targets.data() + 1, 3, targets.data() + 2, 3);
+    hopi::RBFInterpolator<UserTypes> double_interpolator;
+    double_interpolator.setup(Ns, sources_double.data(), 3, sources_double.data() + 1, 3, sources_double.data() + 2, 3,
+                              Nt, targets_double.data(), 3, targets_double.data() + 1, 3, targets_double.data() + 2, 3);
+
+    std::vector<double> field(Ns);
+    for (std::size_t i = 0; i < Ns; ++i) {
+        field[i] = std::sin(3 * sources_double[i * 3]) * std::cos(2 * sources_double[i * 3 + 1]) + sources_double[i * 3 + 2];
+    }
+    std::vector<double> float_result(Nt);
+    std::vector<double> double_result(Nt);
+    float_interpolator.apply(field.data(), 1, float_result.data(), 1);
+    double_interpolator.apply(field.data(), 1, double_result.data(), 1);
+    for (std::size_t i = 0; i < Nt; ++i) {
+        CHECK(std::abs(float_result[i] - double_result[i]) <= 1e-12 * (1 + std::abs(double_result[i])));
+    }
+}
@@ -0,0 +1,187 @@
+/// @file offload.cpp
+/*
+ * Project:         HOPI
+ * File:            offload.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/offload.hpp"
+#include "hopi/rbf_interpolator.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+using point_array = std::array<double, 3>;
+using point_index = hopi::spatial::TreeIndex<point_array, std::size_t>;
+using point_tree  = hopi::spatial::RTree<point_index>;
+using device_tree = hopi::OffloadTree<double, 3>;
+
+/**
+ * Tree of point values as built by RBFInterpolator
+ */
+point_tree
+make_tree(const std::vector<double>& xyz)
+{
+    std::vector<point_index> indices;
+    for (std::size_t i = 0; i < xyz.size() / 3; ++i) {
+        indices.emplace_back(point_array{ xyz[i * 3], xyz[i * 3 + 1], xyz[i * 3 + 2] }, i);
+    }
+    return point_tree(indices.begin(), indices.end(), hopi::spatial::STRPacking());
+}
+
+double
+distance2(const std::vector<double>& xyz, const std::size_t i, const double* target)
+{
+    double sum = 0;
+    for (std::size_t d = 0; d < 3; ++d) {
+        sum += (xyz[i * 3 + d] - target[d]) * (xyz[i * 3 + d] - target[d]);
+    }
+    return sum;
+}
+
+}  // namespace
+
+TEST_CASE("OffloadTree finds the same nearest points as the RTree", "[offload]")
+{
+    namespace predicate = hopi::spatial::shared::predicate;
+
+    const auto        sources = random_xyz(3000, 91);
+    const auto        targets = random_xyz(700, 93, -1.2, 1.2);
+    const std::size_t Nt      = targets.size() / 3;
+    const auto        tree    = make_tree(sources);
+    const device_tree device(tree);
+    CHECK(device.num_points() == tree.size());
+
+    for (const std::size_t k : { std::size_t(1), std::size_t(17), device_tree::max_neighbors }) {
+        std::vector<std::size_t> offsets, columns;
+        device.query_batch(Nt, targets.data(), k, offsets, columns);
+        REQUIRE(offsets.size() == Nt + 1);
+        REQUIRE(offsets.back() == Nt * k);
+        for (std::size_t t = 0; t < Nt; ++t) {
+            const double*            target = targets.data() + t * 3;
+            const box_type           query(point_type{ target[0], target[1], target[2] }, point_type{ target[0], target[1], target[2] });
+            std::vector<std::size_t> found(columns.begin() + offsets[t], columns.begin() + offsets[t + 1]);
+
+            // Nearest first
+            for (std::size_t n = 1; n < found.size(); ++n) {
+                CHECK(distance2(sources, found[n - 1], target) <= distance2(sources, found[n], target));
+            }
+            std::sort(found.begin(), found.end());
+            CHECK(found == query_keys(tree, predicate::Nearest(query, k)));
+        }
+    }
+
+    SECTION("Fewer points than neighbors")
+    {
+        const auto               few        = random_xyz(5, 95);
+        const auto               small_tree = make_tree(few);
+        const device_tree        small(small_tree);
+        std::vector<std::size_t> offsets, columns;
+        small.query_batch(Nt, targets.data(), 10, offsets, columns);
+        REQUIRE(offsets.back() == Nt * 5);
+        for (std::size_t t = 0; t < Nt; ++t) {
+            std::vector<std::size_t> found(columns.begin() + offsets[t], columns.begin() + offsets[t + 1]);
+            std::sort(found.begin(), found.end());
+            CHECK(found == std::vector<std::size_t>{ 0, 1, 2, 3, 4 });
+        }
+    }
+
+    SECTION("Empty tree")
+    {
+        const point_tree         empty_tree;
+        const device_tree        empty(empty_tree);
+        std::vector<std::size_t> offsets, columns;
+        empty.query_batch(Nt, targets.data(), 10, offsets, columns);
+        CHECK(offsets == std::vector<std::size_t>(Nt + 1, 0));
+        CHECK(columns.empty());
+    }
+}
+
+TEST_CASE("OffloadMatrix applies the CSR weights", "[offload]")
+{
+    constexpr std::size_t num_rows    = 300;
+    constexpr std::size_t num_columns = 1000;
+    constexpr std::size_t nvar        = 3;
+
+    std::default_random_engine                 re(97);
+    std::uniform_int_distribution<std::size_t> row_size(0, 20);
+    std::uniform_int_distribution<std::size_t> column(0, num_columns - 1);
+    std::uniform_real_distribution<double>     unif(-1, 1);
+    std::vector<std::size_t>                   offsets = { 0 };
+    std::vector<std::size_t>                   columns;
+    std::vector<double>                        weights;
+    for (std::size_t r = 0; r < num_rows; ++r) {
+        const auto n = row_size(re);
+        for (std::size_t j = 0; j < n; ++j) {
+            columns.push_back(column(re));
+            weights.push_back(unif(re));
+        }
+        offsets.push_back(columns.size());
+    }
+    const hopi::OffloadMatrix matrix(offsets, columns, weights, num_columns);
+    CHECK(matrix.num_rows() == num_rows);
+    CHECK(matrix.num_columns() == num_columns);
+
+    // Variables interleaved in the sources and blocked in the targets
+    std::vector<double> sources(num_columns * nvar);
+    for (auto& value : sources) {
+        value = unif(re);
+    }
+    std::vector<double> targets(num_rows * nvar, NAN);
+    matrix.apply(nvar, sources.data(), nvar, 1, targets.data(), 1, num_rows);
+    for (std::size_t r = 0; r < num_rows; ++r) {
+        for (std::size_t v = 0; v < nvar; ++v) {
+            double expected = 0;
+            for (auto n = offsets[r]; n < offsets[r + 1]; ++n) {
+                expected += weights[n] * sources[columns[n] * nvar + v];
+            }
+            CHECK(std::abs(targets[v * num_rows + r] - expected) <= 1e-13);
+        }
+    }
+}
+
+TEST_CASE("RBFInterpolator gives the same results offloaded", "[offload][rbf]")
+{
+    const auto        sources = random_xyz(2500, 99);
+    const auto        targets = random_xyz(600, 101);
+    const std::size_t Ns      = sources.size() / 3;
+    const std::size_t Nt      = targets.size() / 3;
+
+    hopi::RBFOptions options;
+    options.neighbors = 30;
+    hopi::RBFInterpolator<UserTypes> host(options);
+    options.offload = true;
+    hopi::RBFInterpolator<UserTypes> offloaded(options);
+    for (auto* interpolator : { &host, &offloaded }) {
+        interpolator->setup(Ns, sources.data(), 3, sources.data() + 1, 3, sources.data() + 2, 3,
+                            Nt, targets.data(), 3, targets.data() + 1, 3, targets.data() + 2, 3);
+    }
+
+    std::vector<double> field(Ns);
+    for (std::size_t i = 0; i < Ns; ++i) {
+        field[i] = std::exp(sources[i * 3]) * std::sin(4 * sources[i * 3 + 1]) - sources[i * 3 + 2];
+    }
+    std::vector<double> host_result(Nt);
+    std::vector<double> offloaded_result(Nt);
+    host.apply(field.data(), 1, host_result.data(), 1);
+    offloaded.apply(field.data(), 1, offloaded_result.data(), 1);
+    for (std::size_t i = 0; i < Nt; ++i) {
+        CHECK(std::abs(offloaded_result[i] - host_result[i]) <= 1e-12 * (1 + std::abs(host_result[i])));
+    }
+}
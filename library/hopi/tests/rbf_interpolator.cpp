@@ -0,0 +1,204 @@
+/// @file rbf_interpolator.cpp
+/*
+ * Project:         HOPI
+ * File:            rbf_interpolator.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/rbf_interpolator.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using hopi::test::random_xyz;
+using hopi::test::UserTypes;
+
+double
+linear_field(const double x, const double y, const double z)
+{
+    return 3 + x + 2 * y - z;
+}
+
+/**
+ * Largest error interpolating the linear field from the sources to the targets
+ */
+double
+linear_error(const hopi::RBFOptions& options, const std::vector<double>& sources, const std::vector<double>& targets)
+{
+    constexpr std::size_t ND = UserTypes::NDim;
+    const std::size_t     Ns = sources.size() / ND;
+    const std::size_t     Nt = targets.size() / ND;
+
+    hopi::RBFInterpolator<UserTypes> interpolator(options);
+    interpolator.setup(Ns, sources.data(), ND, sources.data() + 1, ND, sources.data() + 2, ND,
+                       Nt, targets.data(), ND, targets.data() + 1, ND, targets.data() + 2, ND);
+
+    std::vector<double> source_field(Ns);
+    for (std::size_t i = 0; i < Ns; ++i) {
+        source_field[i] = linear_field(sources[i * ND], sources[i * ND + 1], sources[i * ND + 2]);
+    }
+    std::vector<double> target_field(Nt);
+    interpolator.apply(source_field.data(), 1, target_field.data(), 1);
+
+    double error = 0;
+    for (std::size_t i = 0; i < Nt; ++i) {
+        const double exact = linear_field(targets[i * ND], targets[i * ND + 1], targets[i * ND + 2]);
+        error              = std::max(error, std::abs(target_field[i] - exact));
+    }
+    return error;
+}
+
+}  // namespace
+
+TEST_CASE("RBFInterpolator reproduces linear fields exactly", "[rbf]")
+{
+    const auto sources = random_xyz(2000, 3);
+    const auto targets = random_xyz(500, 5);
+
+    hopi::RBFOptions options;
+    options.degree = 1;
+
+    SECTION("Thin Plate Spline")
+    {
+        options.kernel = hopi::RBFKernel::ThinPlateSpline;
+        CHECK(linear_error(options, sources, targets) < 1.0e-10);
+    }
+
+    SECTION("Cubic")
+    {
+        options.kernel = hopi::RBFKernel::Cubic;
+        CHECK(linear_error(options, sources, targets) < 1.0e-10);
+    }
+
+    SECTION("Linear")
+    {
+        options.kernel = hopi::RBFKernel::Linear;
+        CHECK(linear_error(options, sources, targets) < 1.0e-10);
+    }
+
+    SECTION("Small stencils")
+    {
+        options.neighbors = 10;
+        CHECK(linear_error(options, sources, targets) < 1.0e-10);
+    }
+
+    SECTION("Targets on sources")
+    {
+        CHECK(linear_error(options, sources, sources) < 1.0e-10);
+    }
+}
+
+TEST_CASE("RBFInterpolator weights form a partition of unity", "[rbf]")
+{
+    constexpr std::size_t ND      = UserTypes::NDim;
+    const auto            sources = random_xyz(1000, 7);
+    const auto            targets = random_xyz(200, 11);
+
+    hopi::RBFInterpolator<UserTypes> interpolator;
+    interpolator.setup(sources.size() / ND, sources.data(), ND, sources.data() + 1, ND, sources.data() + 2, ND,
+                       targets.size() / ND, targets.data(), ND, targets.data() + 1, ND, targets.data() + 2, ND);
+
+    const auto& offsets = interpolator.offsets();
+    const auto& weights = interpolator.weights();
+    REQUIRE(interpolator.num_targets() == targets.size() / ND);
+    for (std::size_t t = 0; t < interpolator.num_targets(); ++t) {
+        double sum = 0;
+        for (auto k = offsets[t]; k < offsets[t + 1]; ++k) {
+            sum += weights[k];
+        }
+        CHECK(std::abs(sum - 1) < 1.0e-10);
+    }
+}
+
+TEST_CASE("Batched Cholesky matches pivoted LU and flags bad systems", "[rbf]")
+{
+    constexpr std::size_t W  = 4;
+    constexpr std::size_t s  = 6;  // Sources
+    constexpr std::size_t np = 4;  // Constant and linear terms
+    constexpr std::size_t n  = s + np;
+    constexpr std::size_t ND = UserTypes::NDim;
+
+    // Gaussian kernel systems augmented by a linear polynomial
+    std::vector<double> A(n * n * W, 0.0);
+    std::vector<double> b(n * W, 0.0);
+    for (std::size_t l = 0; l < W; ++l) {
+        const auto xyz = random_xyz(s, 30 + unsigned(l));
+        for (std::size_t i = 0; i < s; ++i) {
+            for (std::size_t j = 0; j < s; ++j) {
+                double r2 = 0;
+                for (std::size_t d = 0; d < ND; ++d) {
+                    r2 += (xyz[i * ND + d] - xyz[j * ND + d]) * (xyz[i * ND + d] - xyz[j * ND + d]);
+                }
+                A[(i * n + j) * W + l] = std::exp(-r2);
+            }
+            const std::array<double, np> p = { 1, xyz[i * ND], xyz[i * ND + 1], xyz[i * ND + 2] };
+            for (std::size_t k = 0; k < np; ++k) {
+                A[(i * n + s + k) * W + l]   = p[k];
+                A[((s + k) * n + i) * W + l] = p[k];
+            }
+            b[i * W + l] = double(i + l) - 2.5;
+        }
+        b[s * W + l] = 1;
+    }
+
+    // Each system solved by itself
+    auto dense = [&](const std::size_t l) {
+        std::vector<double> Al(n * n);
+        std::vector<double> bl(n);
+        for (std::size_t i = 0; i < n * n; ++i) {
+            Al[i] = A[i * W + l];
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            bl[i] = b[i * W + l];
+        }
+        bool ok = false;
+        hopi::DenseLUSolver::solve(n, np, 1, Al.data(), bl.data(), &ok);
+        REQUIRE(ok);
+        return bl;
+    };
+
+    SECTION("Full and partial batches")
+    {
+        for (const std::size_t count : { W, W - 1 }) {
+            auto                Ab = A;
+            auto                bb = b;
+            std::array<bool, W> ok;
+            ok.fill(false);
+            hopi::BatchedCholeskySolver<W>::solve(n, np, count, Ab.data(), bb.data(), ok.data());
+            for (std::size_t l = 0; l < count; ++l) {
+                CHECK(ok[l]);
+                const auto expected = dense(l);
+                for (std::size_t i = 0; i < s; ++i) {
+                    CHECK(std::abs(bb[i * W + l] - expected[i]) < 1.0e-8 * (1 + std::abs(expected[i])));
+                }
+            }
+        }
+    }
+
+    SECTION("A system with a weight which is not finite")
+    {
+        auto Ab             = A;
+        auto bb             = b;
+        bb[(s - 1) * W + 2] = std::numeric_limits<double>::infinity();
+        std::array<bool, W> ok;
+        hopi::BatchedCholeskySolver<W>::solve(n, np, W, Ab.data(), bb.data(), ok.data());
+        CHECK(ok[0]);
+        CHECK(ok[1]);
+        CHECK_FALSE(ok[2]);
+        CHECK(ok[3]);
+    }
+}
@@ -0,0 +1,94 @@
+/// @file rtree_arena.cpp
+/*
+ * Project:         HOPI
+ * File:            rtree_arena.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_common.hpp"
+
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+using ArenaTree  = hopi::spatial::RTree<index_type, hopi::spatial::ArenaAllocator<index_type>>;
+using SharedTree = hopi::spatial::RTree<index_type>;
+using Exhaustive = hopi::spatial::shared::index::Exhaustive<index_type, extractor>;
+
+/**
+ * Check each index against the Exhaustive search of the same values
+ */
+template<typename Index>
+void
+check_queries(const Exhaustive& exhaustive, const Index& index)
+{
+    namespace predicate = hopi::spatial::shared::predicate;
+
+    for (const auto& query : random_indices(64, 29)) {
+        const auto search   = make_box(query.first.min_corner(), 0.1);
+        const auto nearest  = box_type(query.first.min_corner(), query.first.min_corner());
+        const auto expected = query_keys(exhaustive, predicate::Intersects(search));
+        CHECK(query_keys(index, predicate::Intersects(search)) == expected);
+
+        const auto contained = query_keys(exhaustive, predicate::ContainedBy(search));
+        CHECK(query_keys(index, predicate::ContainedBy(search)) == contained);
+
+        const auto near = query_keys(exhaustive, predicate::Nearest(nearest, 10));
+        REQUIRE(near.size() == 10);
+        CHECK(query_keys(index, predicate::Nearest(nearest, 10)) == near);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Arena and pointer based RTrees return the same query results", "[rtree]")
+{
+    const auto indices = random_indices(5000, 17);
+
+    Exhaustive exhaustive;
+    exhaustive.insert(indices.begin(), indices.end());
+
+    SECTION("Inserted one value at a time")
+    {
+        ArenaTree  arena;
+        SharedTree shared;
+        arena.insert(indices.begin(), indices.end());
+        shared.insert(indices.begin(), indices.end());
+        REQUIRE(arena.size() == indices.size());
+        REQUIRE(shared.size() == indices.size());
+        check_queries(exhaustive, arena);
+        check_queries(exhaustive, shared);
+    }
+
+    SECTION("Copies of an Arena tree")
+    {
+        ArenaTree arena;
+        arena.insert(indices.begin(), indices.end());
+        const ArenaTree copy(arena);
+        ArenaTree       moved(std::move(arena));
+        REQUIRE(copy.size() == indices.size());
+        REQUIRE(moved.size() == indices.size());
+        check_queries(exhaustive, copy);
+        check_queries(exhaustive, moved);
+    }
+
+    SECTION("Cleared and refilled")
+    {
+        ArenaTree arena;
+        arena.insert(indices.begin(), indices.end());
+        arena.clear();
+        REQUIRE(arena.empty());
+        arena.insert(indices.begin(), indices.end());
+        check_queries(exhaustive, arena);
+    }
+}
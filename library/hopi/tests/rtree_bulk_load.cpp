@@ -0,0 +1,96 @@
+/// @file rtree_bulk_load.cpp
+/*
+ * Project:         HOPI
+ * File:            rtree_bulk_load.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_common.hpp"
+
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+using tree_type  = hopi::spatial::RTree<index_type, hopi::spatial::ArenaAllocator<index_type>>;
+using Exhaustive = hopi::spatial::shared::index::Exhaustive<index_type, extractor>;
+
+/**
+ * Check a packed tree against an Exhaustive search of the same values
+ */
+void
+check_packed(const tree_type& tree, const std::vector<index_type>& indices)
+{
+    namespace predicate = hopi::spatial::shared::predicate;
+
+    Exhaustive exhaustive;
+    exhaustive.insert(indices.begin(), indices.end());
+    REQUIRE(tree.size() == indices.size());
+
+    box_type bounds;
+    bounds.reset();
+    for (const auto& index : indices) {
+        bounds.stretch(index.first);
+    }
+    CHECK(tree.bounds() == bounds);
+
+    const auto k = std::min<std::size_t>(7, indices.size());
+    for (const auto& query : random_indices(32, 53)) {
+        const auto search  = make_box(query.first.min_corner(), 0.2);
+        const auto nearest = box_type(query.first.min_corner(), query.first.min_corner());
+        CHECK(query_keys(tree, predicate::Intersects(search)) == query_keys(exhaustive, predicate::Intersects(search)));
+        CHECK(query_keys(tree, predicate::Nearest(nearest, k)) == query_keys(exhaustive, predicate::Nearest(nearest, k)));
+    }
+}
+
+}  // namespace
+
+TEST_CASE("STR and Hilbert packed RTrees hold every value", "[rtree]")
+{
+    // Sizes around the capacity of a Page
+    for (const std::size_t n : { 1, 9, 10, 11, 101, 4000 }) {
+        const auto indices = random_indices(n, 59);
+
+        const tree_type str(indices.begin(), indices.end(), hopi::spatial::STRPacking());
+        check_packed(str, indices);
+
+        const tree_type hilbert(indices.begin(), indices.end(), hopi::spatial::HilbertPacking());
+        check_packed(hilbert, indices);
+    }
+}
+
+TEST_CASE("Bulk loading packs values already within the tree", "[rtree]")
+{
+    const auto indices = random_indices(3000, 61);
+    const auto middle  = std::next(indices.begin(), 1000);
+
+    tree_type tree;
+    tree.insert(indices.begin(), middle);
+    tree.insert(middle, indices.end(), hopi::spatial::STRPacking());
+    check_packed(tree, indices);
+
+    tree.rebuild(hopi::spatial::HilbertPacking());
+    check_packed(tree, indices);
+}
+
+TEST_CASE("Packed RTrees overlap less than inserted ones", "[rtree]")
+{
+    const auto indices = random_indices(20000, 67, 0);
+
+    tree_type inserted;
+    inserted.insert(indices.begin(), indices.end());
+    const tree_type str(indices.begin(), indices.end(), hopi::spatial::STRPacking());
+    const tree_type hilbert(indices.begin(), indices.end(), hopi::spatial::HilbertPacking());
+
+    CHECK(str.leaf_margin_ratio() < inserted.leaf_margin_ratio());
+    CHECK(hilbert.leaf_margin_ratio() < inserted.leaf_margin_ratio());
+}
@@ -0,0 +1,96 @@
+/// @file rtree_frozen.cpp
+/*
+ * Project:         HOPI
+ * File:            rtree_frozen.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+using tree_type   = hopi::spatial::RTree<index_type>;
+using frozen_type = hopi::spatial::FrozenRTree<index_type>;
+
+/**
+ * Sorted keys of the CSR results of query i
+ */
+std::vector<std::size_t>
+batch_keys(const std::vector<std::size_t>& offsets, const std::vector<index_type>& neighbors, const std::size_t i)
+{
+    std::vector<std::size_t> keys;
+    for (auto n = offsets[i]; n < offsets[i + 1]; ++n) {
+        keys.push_back(neighbors[n].second);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+}  // namespace
+
+TEST_CASE("Frozen RTree matches the index it was built from", "[rtree]")
+{
+    namespace predicate = hopi::spatial::shared::predicate;
+
+    const auto indices = random_indices(5000, 43, 0);
+    tree_type  tree;
+    tree.insert(indices.begin(), indices.end(), hopi::spatial::STRPacking());
+    const tree_type   original(tree);
+    const frozen_type frozen(std::move(tree));
+    const frozen_type shared(frozen);
+
+    std::vector<box_type> queries;
+    for (const auto& query : random_indices(3000, 47, 0)) {
+        queries.push_back(query.first);
+    }
+
+    SECTION("Single queries")
+    {
+        for (std::size_t q = 0; q < 64; ++q) {
+            const auto search = make_box(queries[q].min_corner(), 0.1);
+            CHECK(query_keys(frozen, predicate::Intersects(search)) == query_keys(original, predicate::Intersects(search)));
+            CHECK(query_keys(shared, predicate::Nearest(queries[q], 9)) == query_keys(original, predicate::Nearest(queries[q], 9)));
+        }
+    }
+
+    SECTION("Parallel batches match serial batches and single queries")
+    {
+        constexpr std::size_t    k = 9;
+        std::vector<std::size_t> offsets, parallel_offsets, exact_offsets;
+        std::vector<index_type>  neighbors, parallel_neighbors, exact_neighbors;
+        frozen.query_batch(queries, k, offsets, neighbors);
+        frozen.parallel_query_batch(queries, k, parallel_offsets, parallel_neighbors, 8, 97);
+        frozen.parallel_query_batch_exact(queries, k, exact_offsets, exact_neighbors, 4, 8, 97);
+        REQUIRE(offsets.size() == queries.size() + 1);
+        REQUIRE(parallel_offsets == offsets);
+        REQUIRE(exact_offsets == offsets);
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            const auto expected = query_keys(original, predicate::Nearest(queries[q], k));
+            CHECK(batch_keys(offsets, neighbors, q) == expected);
+            CHECK(batch_keys(parallel_offsets, parallel_neighbors, q) == expected);
+            CHECK(batch_keys(exact_offsets, exact_neighbors, q) == expected);
+        }
+    }
+
+    SECTION("Empty batch")
+    {
+        std::vector<std::size_t> offsets;
+        std::vector<index_type>  neighbors;
+        frozen.parallel_query_batch({}, 4, offsets, neighbors);
+        CHECK(offsets.size() == 1);
+        CHECK(neighbors.empty());
+    }
+}
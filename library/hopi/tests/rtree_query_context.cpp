@@ -0,0 +1,82 @@
+/// @file rtree_query_context.cpp
+/*
+ * Project:         HOPI
+ * File:            rtree_query_context.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+using tree_type = hopi::spatial::RTree<index_type, hopi::spatial::ArenaAllocator<index_type>>;
+
+/**
+ * Sorted keys of the values found using a caller provided context
+ */
+template<typename Predicate, typename Context>
+std::vector<std::size_t>
+context_keys(const tree_type& tree, const Predicate& pred, Context& context)
+{
+    std::vector<index_type> found;
+    tree.query(pred, std::back_inserter(found), context);
+    std::vector<std::size_t> keys;
+    for (const auto& value : found) {
+        keys.push_back(value.second);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+}  // namespace
+
+TEST_CASE("RTree queries reusing a context match fresh queries", "[rtree]")
+{
+    namespace predicate = hopi::spatial::shared::predicate;
+
+    const auto indices = random_indices(5000, 23);
+    tree_type  tree;
+    tree.insert(indices.begin(), indices.end());
+
+    SECTION("One context for mixed spatial and distance queries")
+    {
+        tree_type::query_context context;
+        for (const auto& query : random_indices(64, 31)) {
+            const auto search  = make_box(query.first.min_corner(), 0.1);
+            const auto nearest = box_type(query.first.min_corner(), query.first.min_corner());
+            CHECK(context_keys(tree, predicate::Intersects(search), context) == query_keys(tree, predicate::Intersects(search)));
+            CHECK(context_keys(tree, predicate::Nearest(nearest, 12), context) == query_keys(tree, predicate::Nearest(nearest, 12)));
+        }
+    }
+
+    SECTION("Context grows to hold every value")
+    {
+        tree_type::query_context context;
+        const auto               everything = make_box({ -1, -1, -1 }, 3);
+        CHECK(context_keys(tree, predicate::Intersects(everything), context).size() == indices.size());
+        CHECK(context_keys(tree, predicate::Nearest(everything, indices.size() + 10), context).size() == indices.size());
+    }
+
+    SECTION("Fixed size context")
+    {
+        tree_type::fixed_query_context<16> context;
+        for (const auto& query : random_indices(64, 37)) {
+            const auto nearest = box_type(query.first.min_corner(), query.first.min_corner());
+            CHECK(context_keys(tree, predicate::Nearest(nearest, 16), context) == query_keys(tree, predicate::Nearest(nearest, 16)));
+        }
+    }
+}
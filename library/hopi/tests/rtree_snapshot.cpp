@@ -0,0 +1,95 @@
+/// @file rtree_snapshot.cpp
+/*
+ * Project:         HOPI
+ * File:            rtree_snapshot.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+using tree_type   = hopi::spatial::RTree<index_type, hopi::spatial::ArenaAllocator<index_type>>;
+using frozen_type = hopi::spatial::FrozenRTree<index_type, hopi::spatial::ArenaAllocator<index_type>>;
+
+/**
+ * Check spatial and nearest queries against a reference tree
+ */
+template<typename Tree, typename Reference>
+void
+check_queries(const Tree& tree, const Reference& reference, const std::vector<index_type>& queries)
+{
+    namespace predicate = hopi::spatial::shared::predicate;
+    for (const auto& query : queries) {
+        const auto search = make_box(query.first.min_corner(), 0.1);
+        CHECK(query_keys(tree, predicate::Intersects(search)) == query_keys(reference, predicate::Intersects(search)));
+        CHECK(query_keys(tree, predicate::Nearest(query.first, 7)) == query_keys(reference, predicate::Nearest(query.first, 7)));
+    }
+}
+
+}  // namespace
+
+TEST_CASE("RTree snapshots load back the same tree", "[rtree][snapshot]")
+{
+    const TempFile file("hopi_unit_rtree.snap");
+    const auto     indices = random_indices(4000, 53);
+    const auto     queries = random_indices(100, 59);
+
+    tree_type tree(indices.begin(), indices.end(), hopi::spatial::STRPacking());
+    hopi::spatial::save_snapshot(tree, file.name());
+
+    SECTION("Loaded in place")
+    {
+        tree_type loaded;
+        hopi::spatial::load_snapshot(loaded, file.name());
+        CHECK(loaded.size() == tree.size());
+        CHECK(loaded.bounds() == tree.bounds());
+        check_queries(loaded, tree, queries);
+    }
+
+    SECTION("Loaded tree copies out of the mapping once modified")
+    {
+        tree_type loaded;
+        hopi::spatial::load_snapshot(loaded, file.name());
+        const auto more = random_indices(500, 61);
+        std::vector<index_type> renumbered;
+        for (const auto& value : more) {
+            renumbered.emplace_back(value.first, value.second + indices.size());
+        }
+        loaded.insert(renumbered.begin(), renumbered.end());
+        tree.insert(renumbered.begin(), renumbered.end());
+        CHECK(loaded.size() == tree.size());
+        check_queries(loaded, tree, queries);
+
+        // The file still holds the tree as saved
+        tree_type reloaded;
+        hopi::spatial::load_snapshot(reloaded, file.name());
+        CHECK(reloaded.size() == indices.size());
+    }
+
+    SECTION("Frozen tree queried within the mapping")
+    {
+        const auto frozen = hopi::spatial::load_frozen_snapshot<frozen_type>(file.name());
+        check_queries(frozen, tree, queries);
+
+        // Saved again from the Frozen tree
+        const TempFile copy("hopi_unit_rtree_copy.snap");
+        hopi::spatial::save_snapshot(frozen, copy.name());
+        tree_type loaded;
+        hopi::spatial::load_snapshot(loaded, copy.name());
+        check_queries(loaded, tree, queries);
+    }
+}
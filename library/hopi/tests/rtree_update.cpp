@@ -0,0 +1,131 @@
+/// @file rtree_update.cpp
+/*
+ * Project:         HOPI
+ * File:            rtree_update.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace hopi::test;
+
+namespace {
+
+using tree_type = hopi::spatial::RTree<index_type, hopi::spatial::ArenaAllocator<index_type>, hopi::spatial::RStar<10>>;
+
+/**
+ * Point shaped box at a random location within the unit cube
+ */
+box_type
+random_box(std::default_random_engine& re)
+{
+    std::uniform_real_distribution<double> unif(0, 1);
+    const point_type                       p = { unif(re), unif(re), unif(re) };
+    return box_type(p, p);
+}
+
+/**
+ * Compare tree against one rebuilt from the live values
+ */
+void
+check_against_rebuilt(const tree_type& tree, const std::vector<index_type>& values, std::default_random_engine& re)
+{
+    namespace predicate = hopi::spatial::shared::predicate;
+
+    tree_type rebuilt;
+    rebuilt.insert(values.begin(), values.end(), hopi::spatial::STRPacking());
+    REQUIRE(tree.size() == rebuilt.size());
+
+    for (std::size_t q = 0; q < 64; ++q) {
+        const point_type lo = random_box(re).min_corner();
+        const box_type   search = make_box(lo, 0.15);
+        CHECK(query_keys(tree, predicate::Intersects(search)) == query_keys(rebuilt, predicate::Intersects(search)));
+        CHECK(query_keys(tree, predicate::Nearest(box_type(lo, lo), 8)) == query_keys(rebuilt, predicate::Nearest(box_type(lo, lo), 8)));
+    }
+}
+
+}  // namespace
+
+TEST_CASE("RTree update and erase match a rebuilt tree", "[rtree]")
+{
+    std::default_random_engine re(41);
+    std::vector<index_type>    values;
+    for (std::size_t i = 0; i < 4000; ++i) {
+        values.emplace_back(random_box(re), i);
+    }
+
+    tree_type tree;
+    tree.insert(values.begin(), values.end(), hopi::spatial::STRPacking());
+
+    SECTION("Update values one at a time")
+    {
+        for (std::size_t i = 0; i < values.size(); i += 7) {
+            values[i].first = random_box(re);
+            REQUIRE(tree.update(values[i]));
+        }
+        check_against_rebuilt(tree, values, re);
+    }
+
+    SECTION("Update by key and bound")
+    {
+        for (std::size_t i = 0; i < values.size(); i += 11) {
+            values[i].first = random_box(re);
+            REQUIRE(tree.update(values[i].second, values[i].first));
+        }
+        check_against_rebuilt(tree, values, re);
+    }
+
+    SECTION("Update a range repacks the tree")
+    {
+        std::vector<index_type> moved;
+        for (std::size_t i = 0; i < values.size(); i += 2) {
+            values[i].first = random_box(re);
+            moved.push_back(values[i]);
+        }
+        REQUIRE(tree.update(moved.begin(), moved.end()) == moved.size());
+        check_against_rebuilt(tree, values, re);
+    }
+
+    SECTION("Erase by key")
+    {
+        std::vector<index_type> kept;
+        for (const auto& value : values) {
+            if (value.second % 3 == 0) {
+                REQUIRE(tree.erase(value.second));
+            }
+            else {
+                kept.push_back(value);
+            }
+        }
+        REQUIRE_FALSE(tree.erase(std::size_t(0)));
+        check_against_rebuilt(tree, kept, re);
+    }
+
+    SECTION("Erase and update interleaved")
+    {
+        std::vector<index_type> kept;
+        for (auto& value : values) {
+            if (value.second % 5 == 0) {
+                REQUIRE(tree.erase(value.second));
+                continue;
+            }
+            if (value.second % 5 == 1) {
+                value.first = random_box(re);
+                REQUIRE(tree.update(value));
+            }
+            kept.push_back(value);
+        }
+        check_against_rebuilt(tree, kept, re);
+    }
+}
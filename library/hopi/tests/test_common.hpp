@@ -0,0 +1,150 @@
+/// @file test_common.hpp
+/*
+ * Project:         HOPI
+ * File:            test_common.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/rtree.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace hopi {
+namespace test {
+
+/**
+ * Types used by the tests in the precision of T
+ */
+template<typename T>
+struct BasicUserTypes {
+    static constexpr std::size_t NDim = 3;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using coordinate_type = T;
+    using rank_type       = int;
+    using weight_type     = double;
+};
+
+using UserTypes = BasicUserTypes<double>;
+
+/**
+ * Generate n points interleaved as x,y,z uniform within [lo,hi)
+ */
+template<typename T = double>
+std::vector<T>
+random_xyz(const std::size_t n, const unsigned seed, const double lo = -1, const double hi = 1)
+{
+    std::default_random_engine             re(seed);
+    std::uniform_real_distribution<double> unif(lo, hi);
+    std::vector<T>                         xyz(n * UserTypes::NDim);
+    for (auto& x : xyz) {
+        x = T(unif(re));
+    }
+    return xyz;
+}
+
+/**
+ * Generate n points interleaved as x,y,z normal about mean
+ */
+template<typename T = double>
+std::vector<T>
+normal_xyz(const std::size_t n, const unsigned seed, const double mean, const double stddev)
+{
+    std::default_random_engine       re(seed);
+    std::normal_distribution<double> normal(mean, stddev);
+    std::vector<T>                   xyz(n * UserTypes::NDim);
+    for (auto& x : xyz) {
+        x = T(normal(re));
+    }
+    return xyz;
+}
+
+using box_type   = hopi::spatial::BoundBox<double, 3>;
+using point_type = hopi::spatial::Point<double, 3>;
+using index_type = hopi::spatial::TreeIndex<box_type, std::size_t>;
+using extractor  = hopi::spatial::IndexExtractor<index_type>;
+
+/**
+ * Random boxes within the unit cube keyed by their position
+ *
+ * A max_size of zero gives point shaped boxes.
+ */
+inline std::vector<index_type>
+random_indices(const std::size_t n, const unsigned seed, const double max_size = 0.02)
+{
+    std::default_random_engine             re(seed);
+    std::uniform_real_distribution<double> unif(0, 1);
+    std::uniform_real_distribution<double> size(0, max_size);
+    std::vector<index_type>                indices;
+    indices.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const point_type lo = { unif(re), unif(re), unif(re) };
+        const point_type hi = { lo[0] + size(re), lo[1] + size(re), lo[2] + size(re) };
+        indices.emplace_back(box_type(lo, hi), i);
+    }
+    return indices;
+}
+
+/**
+ * Cube with lower corner at point and sides of length
+ */
+inline box_type
+make_box(const point_type& point, const double length)
+{
+    return box_type(point, { point[0] + length, point[1] + length, point[2] + length });
+}
+
+/**
+ * Sorted keys of the values found by a query
+ */
+template<typename Index, typename Predicate>
+std::vector<std::size_t>
+query_keys(const Index& index, const Predicate& pred)
+{
+    std::vector<typename Index::value_type> found;
+    index.query(pred, std::back_inserter(found));
+    std::vector<std::size_t> keys;
+    keys.reserve(found.size());
+    for (const auto& value : found) {
+        keys.push_back(value.second);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+/**
+ * Path of a scratch file which is removed when it goes out of scope
+ */
+class TempFile final {
+   public:
+    explicit TempFile(const std::string& name) : m_path(std::filesystem::temp_directory_path() / name) {}
+    TempFile(const TempFile& other)            = delete;
+    TempFile& operator=(const TempFile& other) = delete;
+    ~TempFile()
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+
+    std::string name() const { return m_path.string(); }
+
+   private:
+    std::filesystem::path m_path;
+};
+
+}  // namespace test
+}  // namespace hopi
@@ -0,0 +1,171 @@
+/// @file unique.cpp
+/*
+ * Project:         HOPI
+ * File:            unique.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/unique.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+using namespace hopi::test;
+
+namespace {
+
+constexpr std::size_t ND = UserTypes::NDim;
+
+using Unique = hopi::Unique<UserTypes>;
+
+/**
+ * Unique points of interleaved coordinates
+ */
+Unique
+make_unique(const std::vector<double>& xyz, const double tolerance = 0)
+{
+    Unique unique(hopi::UniqueOptions{ tolerance });
+    unique.setup(xyz.size() / ND, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND);
+    return unique;
+}
+
+/**
+ * Copies of every point in a shuffled order along with the original of each copy
+ */
+std::vector<double>
+with_copies(const std::vector<double>& xyz, const std::size_t copies, std::vector<std::size_t>& original)
+{
+    const std::size_t n = xyz.size() / ND;
+    original.resize(n * copies);
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        original[i] = i % n;
+    }
+    std::shuffle(original.begin(), original.end(), std::default_random_engine(17));
+
+    std::vector<double> out;
+    out.reserve(original.size() * ND);
+    for (const auto i : original) {
+        out.insert(out.end(), xyz.begin() + i * ND, xyz.begin() + (i + 1) * ND);
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST_CASE("Unique removes exact duplicates keeping the first", "[unique]")
+{
+    std::vector<std::size_t> original;
+    const auto               xyz    = with_copies(random_xyz(500, 41), 4, original);
+    const auto               unique = make_unique(xyz);
+
+    REQUIRE(unique.num_total() == original.size());
+    REQUIRE(unique.num_unique() == 500);
+
+    // Kept points are the first copy of each original in increasing order
+    std::vector<bool>        seen(500, false);
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        if (not seen[original[i]]) {
+            seen[original[i]] = true;
+            expected.push_back(i);
+        }
+    }
+    CHECK(unique.unique_index() == expected);
+
+    // Every point maps to the kept copy of its original
+    const auto& index   = unique.unique_index();
+    const auto& scatter = unique.scatter_map();
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        CHECK(original[index[scatter[i]]] == original[i]);
+    }
+
+    // Values reduce to the unique points and expand back to every copy
+    std::vector<double> value(original.begin(), original.end());
+    std::vector<double> reduced(unique.num_unique());
+    std::vector<double> expanded(unique.num_total());
+    unique.reduce_to_unique(value.data(), 1, reduced.data(), 1);
+    unique.expand_to_non_unique(reduced.data(), 1, expanded.data(), 1);
+    CHECK(expanded == value);
+}
+
+TEST_CASE("Unique treats signed zeros as equal", "[unique]")
+{
+    const std::vector<double> xyz = { 0.0, 1.0, -0.0, -0.0, 1.0, 0.0, 0.0, 1.0, 1e-300 };
+    const auto                unique = make_unique(xyz);
+    CHECK(unique.unique_index() == std::vector<std::size_t>{ 0, 2 });
+    CHECK(unique.scatter_map() == std::vector<std::size_t>{ 0, 0, 1 });
+}
+
+TEST_CASE("Unique within a tolerance merges nearby points", "[unique]")
+{
+    constexpr double tolerance = 1e-6;
+
+    // Points on a lattice much coarser than the tolerance
+    // - Copies differ by up to half the tolerance in each coordinate
+    std::vector<double> lattice;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            for (int k = 0; k < 10; ++k) {
+                lattice.insert(lattice.end(), { 0.1 * i - 0.5, 0.1 * j - 0.5, 0.1 * k - 0.5 });
+            }
+        }
+    }
+    std::vector<std::size_t>               original;
+    auto                                   xyz = with_copies(lattice, 3, original);
+    std::default_random_engine             re(19);
+    std::uniform_real_distribution<double> jitter(-tolerance / 4, tolerance / 4);
+    for (auto& x : xyz) {
+        x += jitter(re);
+    }
+
+    const auto unique = make_unique(xyz, tolerance);
+    CHECK(unique.num_unique() == 1000);
+    const auto& index   = unique.unique_index();
+    const auto& scatter = unique.scatter_map();
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        CHECK(original[index[scatter[i]]] == original[i]);
+    }
+
+    SECTION("Points further apart than the tolerance are kept")
+    {
+        const std::vector<double> pair = { 0, 0, 0, 0, 0, 2.5 * tolerance };
+        CHECK(make_unique(pair, tolerance).num_unique() == 2);
+        CHECK(make_unique(pair, 3 * tolerance).num_unique() == 1);
+    }
+
+    SECTION("Points within tolerance only in some coordinates are kept")
+    {
+        const std::vector<double> pair = { 0, 0, 0, tolerance / 2, tolerance / 2, 1 };
+        CHECK(make_unique(pair, tolerance).num_unique() == 2);
+    }
+
+#if defined(_OPENMP)
+    SECTION("Result does not depend on the number of threads")
+    {
+        const auto random = random_xyz(20000, 43, 0, 1e-3);
+        const int  saved  = omp_get_max_threads();
+        omp_set_num_threads(1);
+        const auto serial = make_unique(random, 2e-5);
+        omp_set_num_threads(std::max(saved, 4));
+        const auto threaded = make_unique(random, 2e-5);
+        omp_set_num_threads(saved);
+        CHECK(serial.num_unique() < random.size() / ND);
+        CHECK(threaded.unique_index() == serial.unique_index());
+        CHECK(threaded.scatter_map() == serial.scatter_map());
+    }
+#endif
+}
@@ -0,0 +1,19 @@
+/// @file unique.cpp
+/*
+ * Project:         HOPI
+ * File:            unique.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "hopi/unique.hpp"
+
+namespace hopi {
+
+
+} /* namespace hopi */
\ No newline at end of file
@@ -0,0 +1,489 @@
+/// @file unique.hpp
+/*
+ * Project:         HOPI
+ * File:            unique.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace hopi {
+
+/**
+ * Options controlling which points Unique treats as duplicates
+ *
+ * - tolerance = 0 : Points must have identical coordinates (-0 == +0)
+ * - tolerance > 0 : Points within tolerance of a kept point in every
+ *                   coordinate are duplicates of it
+ */
+struct UniqueOptions {
+    double tolerance = 0;  ///< Largest difference in any coordinate or 0 for exact matches
+};
+
+/**
+ * Removal of duplicated points
+ *
+ * Points are hashed on their quantized coordinates into open addressing
+ * tables so no node is allocated per point.
+ *
+ * Exact matches shard the tables by hash across threads and scan each
+ * shard in index order, so the first occurrence of every point is kept.
+ * Near matches hash voxels of edge 2*tolerance and check the (at most
+ * 2^NDim) voxels within tolerance of each point. Threads own slabs of
+ * voxels along the first dimension and process even then odd slabs, so
+ * the result only depends on the points and not on the thread count.
+ *
+ * Partition places identical coordinates on the same Rank so calling
+ * setup on each Rank after Partition::redistribute removes duplicates
+ * across all Ranks without further communication.
+ *
+ * Near matches are only found on the same Rank. Points within tolerance
+ * of each other but on opposite sides of a split plane are owned by
+ * different Ranks and are both kept.
+ */
+template<typename InputAdaptor>
+class Unique final {
+    // ----------------------------------------------------------
+    // Types
+    // ----------------------------------------------------------
+    static constexpr auto NDim = InputAdaptor::NDim;
+
+   public:
+    using size_type       = typename InputAdaptor::size_type;
+    using difference_type = typename InputAdaptor::difference_type;
+    using coordinate_type = typename InputAdaptor::coordinate_type;
+
+    // ----------------------------------------------------------
+    // Constructors and Operators
+    // ----------------------------------------------------------
+   public:
+    Unique(const Unique& other) = default;
+    Unique(Unique&& other)      = default;
+    ~Unique()                   = default;
+    Unique& operator=(const Unique& other) = default;
+    Unique& operator=(Unique&& other)      = default;
+
+    explicit Unique(const UniqueOptions& options = UniqueOptions());
+
+    // ----------------------------------------------------------
+    // Methods
+    // ----------------------------------------------------------
+   public:
+    /**
+     * Find the unique points
+     */
+    void setup(const size_type        local_count,
+               const coordinate_type* x,
+               const difference_type  xinc,
+               const coordinate_type* y,
+               const difference_type  yinc,
+               const coordinate_type* z,
+               const difference_type  zinc);
+
+    /**
+     * Number of points given to setup
+     */
+    size_type num_total() const noexcept;
+
+    /**
+     * Number of unique points
+     */
+    size_type num_unique() const noexcept;
+
+    /**
+     * Index of each unique point within the points given to setup
+     *
+     * Indices are increasing.
+     */
+    const std::vector<size_type>& unique_index() const noexcept;
+
+    /**
+     * Position within unique_index of every point given to setup
+     */
+    const std::vector<size_type>& scatter_map() const noexcept;
+
+    /**
+     * Copy the values of the unique points
+     *
+     * out must hold num_unique() values.
+     */
+    template<typename T>
+    void reduce_to_unique(const T* in, const difference_type in_inc, T* out, const difference_type out_inc) const;
+
+    /**
+     * Copy the value of each unique point to all its duplicates
+     *
+     * out must hold num_total() values.
+     */
+    template<typename T>
+    void expand_to_non_unique(const T* in, const difference_type in_inc, T* out, const difference_type out_inc) const;
+
+    // ----------------------------------------------------------
+    // [PRIVATE]
+    // ----------------------------------------------------------
+   private:
+    using key_type   = std::array<std::uint64_t, NDim>;
+    using point_type = std::array<coordinate_type, NDim>;
+
+    static constexpr size_type empty_slot = std::numeric_limits<size_type>::max();
+
+    static std::uint64_t hash(const key_type& key) noexcept;
+
+    void find_exact(const std::vector<point_type>& points, std::vector<size_type>& first_of) const;
+    void find_within_tolerance(const std::vector<point_type>& points, std::vector<size_type>& first_of) const;
+
+    UniqueOptions          m_options;
+    std::vector<size_type> m_unique;   ///< Index of each unique point
+    std::vector<size_type> m_scatter;  ///< Unique position of every point
+};
+
+template<typename A>
+Unique<A>::Unique(const UniqueOptions& options) : m_options(options)
+{
+}
+
+template<typename A>
+std::uint64_t
+Unique<A>::hash(const key_type& key) noexcept
+{
+    // Mix every word through a splitmix64 finalizer so regular lattices
+    // do not fall into a few clusters of the table
+    std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+    for (const auto word : key) {
+        h ^= word + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+template<typename A>
+void
+Unique<A>::setup(const size_type        local_count,
+                 const coordinate_type* x,
+                 const difference_type  xinc,
+                 const coordinate_type* y,
+                 const difference_type  yinc,
+                 const coordinate_type* z,
+                 const difference_type  zinc)
+{
+    const std::array<const coordinate_type*, 3> coord = { x, y, z };
+    const std::array<difference_type, 3>        inc   = { xinc, yinc, zinc };
+
+    std::vector<point_type> points(local_count);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_type i = 0; i < local_count; ++i) {
+        for (size_type d = 0; d < NDim; ++d) {
+            points[i][d] = coord[d][i * inc[d]];
+        }
+    }
+
+    // Index of the kept point each point duplicates
+    std::vector<size_type> first_of(local_count);
+    if (m_options.tolerance > 0) {
+        this->find_within_tolerance(points, first_of);
+    }
+    else {
+        this->find_exact(points, first_of);
+    }
+
+    // Number the unique points in index order
+    // - A kept point may follow its duplicates when matched within tolerance
+    m_unique.clear();
+    m_scatter.resize(local_count);
+    for (size_type i = 0; i < local_count; ++i) {
+        if (first_of[i] == i) {
+            m_scatter[i] = m_unique.size();
+            m_unique.push_back(i);
+        }
+    }
+    for (size_type i = 0; i < local_count; ++i) {
+        m_scatter[i] = m_scatter[first_of[i]];
+    }
+}
+
+template<typename A>
+void
+Unique<A>::find_exact(const std::vector<point_type>& points, std::vector<size_type>& first_of) const
+{
+    const size_type local_count = points.size();
+
+    // Hash the bits of every point
+    std::vector<key_type>      keys(local_count);
+    std::vector<std::uint64_t> hashes(local_count);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_type i = 0; i < local_count; ++i) {
+        for (size_type d = 0; d < NDim; ++d) {
+            const double value = (points[i][d] == 0) ? 0.0 : double(points[i][d]);  // Merge -0 and +0
+            keys[i][d]         = std::bit_cast<std::uint64_t>(value);
+        }
+        hashes[i] = hash(keys[i]);
+    }
+
+    // Shard points by hash
+    // - Equal keys always share a shard
+    // - Each shard keeps its points in index order
+    size_type num_shards = 1;
+#if defined(_OPENMP)
+    num_shards = size_type(omp_get_max_threads());
+#endif
+    std::vector<size_type> shard_offset(num_shards + 1, 0);
+    for (size_type i = 0; i < local_count; ++i) {
+        ++shard_offset[(hashes[i] >> 32) % num_shards + 1];
+    }
+    for (size_type s = 0; s < num_shards; ++s) {
+        shard_offset[s + 1] += shard_offset[s];
+    }
+    std::vector<size_type> shard_points(local_count);
+    {
+        std::vector<size_type> next(shard_offset.begin(), shard_offset.end() - 1);
+        for (size_type i = 0; i < local_count; ++i) {
+            shard_points[next[(hashes[i] >> 32) % num_shards]++] = i;
+        }
+    }
+
+    // Find the first occurrence of every point within each shard
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (size_type s = 0; s < num_shards; ++s) {
+        const size_type shard_size = shard_offset[s + 1] - shard_offset[s];
+        size_type       table_size = 16;
+        while (table_size < 2 * shard_size) {
+            table_size *= 2;
+        }
+        std::vector<size_type> table(table_size, empty_slot);
+        const size_type        mask = table_size - 1;
+
+        for (size_type n = shard_offset[s]; n < shard_offset[s + 1]; ++n) {
+            const auto i    = shard_points[n];
+            size_type  slot = size_type(hashes[i]) & mask;
+            while (true) {
+                const auto j = table[slot];
+                if (j == empty_slot) {
+                    table[slot] = i;
+                    first_of[i] = i;
+                    break;
+                }
+                if ((hashes[j] == hashes[i]) and (keys[j] == keys[i])) {
+                    first_of[i] = j;
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
+        }
+    }
+}
+
+template<typename A>
+void
+Unique<A>::find_within_tolerance(const std::vector<point_type>& points, std::vector<size_type>& first_of) const
+{
+    constexpr size_type target_slabs = 64;
+    const size_type     local_count  = points.size();
+    const double        tolerance    = m_options.tolerance;
+    const double        edge         = 2 * tolerance;
+    if (local_count == 0) {
+        return;
+    }
+
+    // Voxel of every point
+    auto voxel_of = [edge](const double value) { return std::int64_t(std::floor(value / edge)); };
+    std::vector<key_type> keys(local_count);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_type i = 0; i < local_count; ++i) {
+        for (size_type d = 0; d < NDim; ++d) {
+            keys[i][d] = std::uint64_t(voxel_of(double(points[i][d])));
+        }
+    }
+
+    // Slabs of whole voxels along the first dimension
+    // - Width only depends on the points so results do not depend on threads
+    std::int64_t min_voxel = std::numeric_limits<std::int64_t>::max();
+    std::int64_t max_voxel = std::numeric_limits<std::int64_t>::lowest();
+    for (size_type i = 0; i < local_count; ++i) {
+        min_voxel = std::min(min_voxel, std::int64_t(keys[i][0]));
+        max_voxel = std::max(max_voxel, std::int64_t(keys[i][0]));
+    }
+    const std::int64_t slab_width = std::max<std::int64_t>(1, (max_voxel - min_voxel) / std::int64_t(target_slabs) + 1);
+    auto slab_of = [&](const std::int64_t voxel) { return size_type((voxel - min_voxel) / slab_width); };
+    const size_type num_slabs = slab_of(max_voxel) + 1;
+
+    std::vector<size_type> slab_offset(num_slabs + 1, 0);
+    for (size_type i = 0; i < local_count; ++i) {
+        ++slab_offset[slab_of(std::int64_t(keys[i][0])) + 1];
+    }
+    for (size_type s = 0; s < num_slabs; ++s) {
+        slab_offset[s + 1] += slab_offset[s];
+    }
+    std::vector<size_type> slab_points(local_count);
+    {
+        std::vector<size_type> next(slab_offset.begin(), slab_offset.end() - 1);
+        for (size_type i = 0; i < local_count; ++i) {
+            slab_points[next[slab_of(std::int64_t(keys[i][0]))]++] = i;
+        }
+    }
+
+    // Table of kept points per slab
+    // - A voxel may hold several kept points so keys repeat
+    std::vector<std::vector<size_type>> tables(num_slabs);
+    for (size_type s = 0; s < num_slabs; ++s) {
+        size_type table_size = 16;
+        while (table_size < 2 * (slab_offset[s + 1] - slab_offset[s])) {
+            table_size *= 2;
+        }
+        tables[s].assign(table_size, empty_slot);
+    }
+
+    // Even slabs then odd slabs
+    // - Neighboring slabs are never written at the same time
+    for (size_type parity = 0; parity < 2; ++parity) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (size_type s = parity; s < num_slabs; s += 2) {
+            for (size_type n = slab_offset[s]; n < slab_offset[s + 1]; ++n) {
+                const auto i = slab_points[n];
+
+                // Voxels within tolerance of the point in each dimension
+                std::array<std::int64_t, NDim> lo;
+                std::array<std::int64_t, NDim> hi;
+                for (size_type d = 0; d < NDim; ++d) {
+                    lo[d] = voxel_of(double(points[i][d]) - tolerance);
+                    hi[d] = voxel_of(double(points[i][d]) + tolerance);
+                }
+
+                // Search each voxel for a kept point within tolerance
+                size_type match = empty_slot;
+                key_type  voxel;
+                for (size_type corner = 0; (corner < (size_type(1) << NDim)) and (match == empty_slot); ++corner) {
+                    bool repeated = false;
+                    for (size_type d = 0; d < NDim; ++d) {
+                        const bool use_hi = (corner >> d) & 1;
+                        repeated          = repeated or (use_hi and (hi[d] == lo[d]));
+                        voxel[d]          = std::uint64_t(use_hi ? hi[d] : lo[d]);
+                    }
+                    const auto voxel_slab = std::int64_t(voxel[0]);
+                    if (repeated or (voxel_slab < min_voxel) or (voxel_slab > max_voxel)) {
+                        continue;
+                    }
+
+                    const auto&     table = tables[slab_of(voxel_slab)];
+                    const size_type mask  = table.size() - 1;
+                    for (size_type slot = size_type(hash(voxel)) & mask; table[slot] != empty_slot; slot = (slot + 1) & mask) {
+                        const auto j = table[slot];
+                        if (keys[j] != voxel) {
+                            continue;
+                        }
+                        bool close = true;
+                        for (size_type d = 0; d < NDim; ++d) {
+                            close = close and (std::abs(double(points[i][d]) - double(points[j][d])) <= tolerance);
+                        }
+                        if (close) {
+                            match = j;
+                            break;
+                        }
+                    }
+                }
+
+                // Keep this point if nothing matched
+                if (match == empty_slot) {
+                    auto&           table = tables[s];
+                    const size_type mask  = table.size() - 1;
+                    size_type       slot  = size_type(hash(keys[i])) & mask;
+                    while (table[slot] != empty_slot) {
+                        slot = (slot + 1) & mask;
+                    }
+                    table[slot] = i;
+                    match       = i;
+                }
+                first_of[i] = match;
+            }
+        }
+    }
+}
+
+template<typename A>
+typename Unique<A>::size_type
+Unique<A>::num_total() const noexcept
+{
+    return m_scatter.size();
+}
+
+template<typename A>
+typename Unique<A>::size_type
+Unique<A>::num_unique() const noexcept
+{
+    return m_unique.size();
+}
+
+template<typename A>
+const std::vector<typename Unique<A>::size_type>&
+Unique<A>::unique_index() const noexcept
+{
+    return m_unique;
+}
+
+template<typename A>
+const std::vector<typename Unique<A>::size_type>&
+Unique<A>::scatter_map() const noexcept
+{
+    return m_scatter;
+}
+
+template<typename A>
+template<typename T>
+void
+Unique<A>::reduce_to_unique(const T* in, const difference_type in_inc, T* out, const difference_type out_inc) const
+{
+    const size_type num = m_unique.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_type n = 0; n < num; ++n) {
+        out[n * out_inc] = in[m_unique[n] * in_inc];
+    }
+}
+
+template<typename A>
+template<typename T>
+void
+Unique<A>::expand_to_non_unique(const T* in, const difference_type in_inc, T* out, const difference_type out_inc) const
+{
+    const size_type num = m_scatter.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (size_type i = 0; i < num; ++i) {
+        out[i * out_inc] = in[m_scatter[i] * in_inc];
+    }
+}
+
+} /* namespace hopi */
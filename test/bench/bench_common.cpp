@@ -0,0 +1,113 @@
+/// @file bench_common.cpp
+/*
+ * Project:         HOPI
+ * File:            bench_common.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "bench_common.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+
+namespace hopi {
+namespace bench {
+
+const char*
+data_set_name(const int data_set)
+{
+    switch (data_set) {
+        case Uniform:
+            return "uniform";
+        case Clustered:
+            return "clustered";
+        case Lattice:
+            return "lattice";
+    }
+    return "unknown";
+}
+
+std::vector<point_type>
+make_points(const DataSet data_set, const std::size_t n, const unsigned seed)
+{
+    std::mt19937_64                        re(seed);
+    std::uniform_real_distribution<double> unif(0, 1);
+    std::vector<point_type>                points(n);
+
+    switch (data_set) {
+        case Uniform: {
+            for (auto& p : points) {
+                p = { unif(re), unif(re), unif(re) };
+            }
+        } break;
+        case Clustered: {
+            constexpr std::size_t            num_clusters = 16;
+            std::normal_distribution<double> norm(0, 0.02);
+            std::vector<point_type>          center(num_clusters);
+            for (auto& c : center) {
+                c = { unif(re), unif(re), unif(re) };
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto& c = center[re() % num_clusters];
+                points[i]     = { c[0] + norm(re), c[1] + norm(re), c[2] + norm(re) };
+            }
+        } break;
+        case Lattice: {
+            // Grid of unique points followed by their copies
+            const std::size_t num_unique = std::max<std::size_t>(1, n / (lattice_duplicates + 1));
+            const auto        num_side   = std::size_t(std::ceil(std::cbrt(double(num_unique))));
+            const double      dx         = 1.0 / double(num_side);
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto u = i % num_unique;
+                points[i]    = { dx * double(u % num_side), dx * double((u / num_side) % num_side), dx * double(u / (num_side * num_side)) };
+            }
+        } break;
+    }
+    return points;
+}
+
+std::vector<double>
+make_coordinates(const DataSet data_set, const std::size_t n, const unsigned seed)
+{
+    const auto          points = make_points(data_set, n, seed);
+    std::vector<double> xyz(3 * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t d = 0; d < 3; ++d) {
+            xyz[i * 3 + d] = points[i][d];
+        }
+    }
+    return xyz;
+}
+
+bool
+serial_rank(benchmark::State& state)
+{
+    const mpixx::communicator world;
+    if (world.rank() != 0) {
+        state.SkipWithError("Serial benchmark only runs on rank 0");
+        return false;
+    }
+    return true;
+}
+
+void
+quiet_barrier(const mpixx::communicator& comm)
+{
+    MPI_Request request;
+    BOOST_MPI_CHECK_RESULT(MPI_Ibarrier, (MPI_Comm(comm), &request));
+    mpixx::irequest barrier(request);
+    while (not barrier.test()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} /* namespace bench */
+} /* namespace hopi */
@@ -0,0 +1,81 @@
+/// @file bench_common.hpp
+/*
+ * Project:         HOPI
+ * File:            bench_common.hpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+#pragma once
+
+#include "hopi/mpixx.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace hopi {
+namespace bench {
+
+/**
+ * Types used by the Partition benchmarks
+ */
+struct UserTypes {
+    static constexpr std::size_t NDim = 3;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using coordinate_type = double;
+    using rank_type       = int;
+    using weight_type     = double;
+};
+
+using point_type = std::array<double, 3>;
+
+/**
+ * Distribution of the generated points
+ *
+ * - Uniform   random within the unit cube
+ * - Clustered normal about a few random centers
+ * - Lattice   regular grid where every point is repeated (as duplicate_vector)
+ */
+enum DataSet : int { Uniform = 0, Clustered = 1, Lattice = 2 };
+
+/// Number of copies of each Lattice point after the first
+inline constexpr std::size_t lattice_duplicates = 3;
+
+/// Label of a data set for the benchmark output
+const char* data_set_name(const int data_set);
+
+/// Generate n points of a data set (the same for each seed)
+std::vector<point_type> make_points(const DataSet data_set, const std::size_t n, const unsigned seed = 42);
+
+/// Generate n points interleaved as x,y,z
+std::vector<double> make_coordinates(const DataSet data_set, const std::size_t n, const unsigned seed = 42);
+
+/**
+ * Skip a serial benchmark on every rank except 0
+ *
+ * Returns true if the calling rank should run it.
+ */
+bool serial_rank(benchmark::State& state);
+
+/**
+ * Barrier which sleeps while waiting
+ *
+ * Ranks waiting on rank 0 to finish the serial benchmarks
+ * do not spin and steal cores from it.
+ */
+void quiet_barrier(const mpixx::communicator& comm);
+
+/// Register the Partition benchmarks for the ranks of world
+void register_partition_benchmarks(const mpixx::communicator& world);
+
+} /* namespace bench */
+} /* namespace hopi */
@@ -0,0 +1,170 @@
+/// @file bench_io.cpp
+/*
+ * Project:         HOPI
+ * File:            bench_io.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "bench_common.hpp"
+
+#include "hopi/ascii_targets.hpp"
+#include "hopi/binary_targets.hpp"
+#include "hopi/rtree.hpp"
+
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+namespace {
+
+using namespace hopi::bench;
+
+constexpr std::size_t ndim = 3;  ///< Dimensions of every file
+constexpr std::size_t nvar = 2;  ///< Variables written with the coordinates
+
+/**
+ * Temporary file removed when the benchmark ends
+ */
+class ScratchFile final {
+   public:
+    explicit ScratchFile(const std::string& suffix)
+        : m_path(std::filesystem::temp_directory_path() / ("hopi_bench_" + std::to_string(::getpid()) + suffix))
+    {
+    }
+    ScratchFile(const ScratchFile& other)            = delete;
+    ScratchFile& operator=(const ScratchFile& other) = delete;
+    ~ScratchFile() { std::filesystem::remove(m_path); }
+
+    std::string name() const { return m_path.string(); }
+    std::size_t bytes() const { return std::filesystem::file_size(m_path); }
+
+   private:
+    std::filesystem::path m_path;
+};
+
+struct AsciiFormat {
+    static constexpr const char* suffix = ".txt";
+
+    static void write(const std::string& file_name, const std::size_t n, const std::vector<double>& xyz, const std::vector<double>& var)
+    {
+        hopi::write_target_file(file_name, ndim, n, xyz, nvar, var);
+    }
+
+    static double read(const std::string& file_name)
+    {
+        std::size_t         file_ndim    = 0;
+        std::size_t         file_npoints = 0;
+        std::vector<double> xyz;
+        hopi::read_target_file(file_name, file_ndim, file_npoints, xyz);
+        return xyz.back();
+    }
+};
+
+struct BinaryFormat {
+    static constexpr const char* suffix = ".hopi";
+
+    static void write(const std::string& file_name, const std::size_t n, const std::vector<double>& xyz, const std::vector<double>& var)
+    {
+        hopi::write_binary_target_file(file_name, ndim, n, xyz, nvar, var);
+    }
+
+    // Touch every coordinate since pages are mapped lazily
+    static double read(const std::string& file_name)
+    {
+        const hopi::MappedTargetFile file(file_name);
+        double                       sum = 0;
+        for (std::size_t d = 0; d < file.ndim(); ++d) {
+            const double* x = file.coordinate(d);
+            for (std::size_t i = 0; i < file.npoints(); ++i) {
+                sum += x[i];
+            }
+        }
+        return sum;
+    }
+};
+
+template<typename Format>
+void
+BM_Write(benchmark::State& state)
+{
+    if (not serial_rank(state)) {
+        return;
+    }
+    const auto              n   = std::size_t(state.range(0));
+    const auto              xyz = make_coordinates(Uniform, n);
+    const std::vector<double> var(nvar * n, 1.0);
+    const ScratchFile       file(Format::suffix);
+    for (auto _ : state) {
+        Format::write(file.name(), n, xyz, var);
+    }
+    state.SetBytesProcessed(state.iterations() * std::int64_t(file.bytes()));
+}
+
+template<typename Format>
+void
+BM_Read(benchmark::State& state)
+{
+    if (not serial_rank(state)) {
+        return;
+    }
+    const auto              n   = std::size_t(state.range(0));
+    const auto              xyz = make_coordinates(Uniform, n);
+    const std::vector<double> var(nvar * n, 1.0);
+    const ScratchFile       file(Format::suffix);
+    Format::write(file.name(), n, xyz, var);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Format::read(file.name()));
+    }
+    state.SetBytesProcessed(state.iterations() * std::int64_t(file.bytes()));
+}
+
+/**
+ * Map a snapshot of a packed tree and run a single query
+ *
+ * Compare with BM_BulkLoad which builds the same tree.
+ */
+void
+BM_SnapshotLoad(benchmark::State& state)
+{
+    if (not serial_rank(state)) {
+        return;
+    }
+    using index_type = hopi::spatial::TreeIndex<point_type, std::size_t>;
+    using tree_type  = hopi::spatial::FrozenRTree<index_type, hopi::spatial::ArenaAllocator<index_type>>;
+
+    const auto              n      = std::size_t(state.range(0));
+    const auto              points = make_points(Uniform, n);
+    std::vector<index_type> indices;
+    indices.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        indices.emplace_back(points[i], i);
+    }
+    const ScratchFile file(".snap");
+    hopi::spatial::save_snapshot(hopi::spatial::RTree<index_type, hopi::spatial::ArenaAllocator<index_type>>(
+                                     indices.begin(), indices.end(), hopi::spatial::STRPacking()),
+                                 file.name());
+
+    const auto center = hopi::spatial::BoundBox<double, 3>(points[n / 2], points[n / 2]);
+    for (auto _ : state) {
+        const auto              tree = hopi::spatial::load_frozen_snapshot<tree_type>(file.name());
+        std::vector<index_type> found;
+        tree.query(hopi::spatial::shared::predicate::Nearest(center, 8), std::back_inserter(found));
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetBytesProcessed(state.iterations() * std::int64_t(file.bytes()));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Write, AsciiFormat)->ArgName("n")->Arg(1 << 14)->Arg(1 << 18)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Write, BinaryFormat)->ArgName("n")->Arg(1 << 14)->Arg(1 << 18)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Read, AsciiFormat)->ArgName("n")->Arg(1 << 14)->Arg(1 << 18)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Read, BinaryFormat)->ArgName("n")->Arg(1 << 14)->Arg(1 << 18)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SnapshotLoad)->ArgName("n")->Arg(1 << 14)->Arg(1 << 18)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,80 @@
+/// @file bench_main.cpp
+/*
+ * Project:         HOPI
+ * File:            bench_main.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "bench_common.hpp"
+
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+/**
+ * Reporter used by every rank except 0
+ */
+class NullReporter final : public benchmark::BenchmarkReporter {
+   public:
+    bool ReportContext(const Context& /* context */) override { return true; }
+    void ReportRuns(const std::vector<Run>& /* report */) override {}
+};
+
+}  // namespace
+
+/**
+ * Run all HOPI benchmarks
+ *
+ * Results are written as JSON unless another --benchmark_format
+ * is given. Run under mpirun to include the Partition scaling
+ * benchmarks for 1, 2, 4, ... ranks up to the size of the job:
+ *
+ * > mpirun -np 8 hopi_bench --benchmark_out=hopi.json
+ *
+ * Only rank 0 reports and the serial benchmarks only run on rank 0.
+ */
+int
+main(int argc, char* argv[])
+{
+    mpixx::environment  env(argc, argv);
+    mpixx::communicator world;
+
+    // JSON first so it can be overridden
+    // - Only rank 0 writes the --benchmark_out file
+    static char        json_format[] = "--benchmark_format=json";
+    std::vector<char*> args          = { argv[0], json_format };
+    for (int i = 1; i < argc; ++i) {
+        if ((world.rank() != 0) and std::string_view(argv[i]).starts_with("--benchmark_out")) {
+            continue;
+        }
+        args.push_back(argv[i]);
+    }
+    int num_args = int(args.size());
+    args.push_back(nullptr);
+
+    benchmark::Initialize(&num_args, args.data());
+    if (benchmark::ReportUnrecognizedArguments(num_args, args.data())) {
+        return EXIT_FAILURE;
+    }
+    hopi::bench::register_partition_benchmarks(world);
+
+    if (world.rank() == 0) {
+        benchmark::RunSpecifiedBenchmarks();
+    }
+    else {
+        NullReporter null_reporter;
+        benchmark::RunSpecifiedBenchmarks(&null_reporter);
+    }
+    benchmark::Shutdown();
+
+    hopi::bench::quiet_barrier(world);
+    return EXIT_SUCCESS;
+}
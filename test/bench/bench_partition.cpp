@@ -0,0 +1,109 @@
+/// @file bench_partition.cpp
+/*
+ * Project:         HOPI
+ * File:            bench_partition.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "bench_common.hpp"
+
+#include "hopi/partition.hpp"
+#include "hopi/sfc_partition.hpp"
+
+#include <chrono>
+#include <string>
+
+namespace {
+
+using namespace hopi::bench;
+
+constexpr std::int64_t strong_points = 1 << 20;  ///< Points across all ranks for strong scaling
+constexpr std::int64_t weak_points   = 1 << 16;  ///< Points on each rank for weak scaling
+constexpr std::int64_t iterations    = 10;       ///< Fixed so every rank runs the same collectives
+
+/**
+ * Time PartitionType::init on the first "ranks" ranks of world
+ *
+ * The time of the slowest rank is reported. Ranks outside the
+ * partition only step through the iterations.
+ */
+template<typename PartitionType>
+void
+BM_PartitionInit(benchmark::State& state, const bool weak)
+{
+    const auto num_ranks = int(state.range(0));
+    const auto num_total = std::size_t(state.range(1));
+    const auto data_set  = DataSet(state.range(2));
+
+    const mpixx::communicator world;
+    quiet_barrier(world);
+    const bool member = (world.rank() < num_ranks);
+    const auto comm   = world.split(member ? 0 : 1);
+
+    // Points of this rank
+    const std::size_t my_rank = comm.rank();
+    const std::size_t count   = weak ? num_total : (num_total * (my_rank + 1)) / num_ranks - (num_total * my_rank) / num_ranks;
+    const auto        xyz     = make_coordinates(data_set, count, 42 + unsigned(my_rank));
+
+    PartitionType partition(comm);
+    for (auto _ : state) {
+        double seconds = 0;
+        if (member) {
+            comm.barrier();
+            const auto start = std::chrono::steady_clock::now();
+            partition.init(count, xyz.data(), 3, xyz.data() + 1, 3, xyz.data() + 2, 3, nullptr, 1);
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            seconds = mpixx::all_reduce(comm, elapsed.count(), MPI_MAX);
+        }
+        state.SetIterationTime(seconds);
+    }
+    const auto num_points = weak ? num_total * num_ranks : num_total;
+    state.SetItemsProcessed(state.iterations() * std::int64_t(num_points));
+    state.SetLabel(data_set_name(data_set));
+}
+
+}  // namespace
+
+namespace hopi {
+namespace bench {
+
+/**
+ * Strong and weak scaling of Partition::init and SFCPartition::init
+ *
+ * Registered at run time for 1, 2, 4, ... ranks up to (and
+ * including) the size of world.
+ */
+void
+register_partition_benchmarks(const mpixx::communicator& world)
+{
+    std::vector<std::int64_t> ranks;
+    for (int p = 1; p < world.size(); p *= 2) {
+        ranks.push_back(p);
+    }
+    ranks.push_back(world.size());
+
+    auto register_scaling = [&](const std::string& prefix, auto function) {
+        for (const bool weak : { false, true }) {
+            const std::string name = prefix + (weak ? "/weak" : "/strong");
+            auto*             b    = benchmark::RegisterBenchmark(name.c_str(), function, weak);
+            b->ArgNames({ "ranks", "n", "data" });
+            for (const auto p : ranks) {
+                for (const int data_set : { Uniform, Clustered, Lattice }) {
+                    b->Args({ p, weak ? weak_points : strong_points, data_set });
+                }
+            }
+            b->Iterations(iterations)->UseManualTime()->Unit(benchmark::kMillisecond);
+        }
+    };
+    register_scaling("BM_PartitionInit", BM_PartitionInit<hopi::Partition<UserTypes>>);
+    register_scaling("BM_SFCPartitionInit", BM_PartitionInit<hopi::SFCPartition<UserTypes>>);
+}
+
+} /* namespace bench */
+} /* namespace hopi */
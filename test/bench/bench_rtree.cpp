@@ -0,0 +1,256 @@
+/// @file bench_rtree.cpp
+/*
+ * Project:         HOPI
+ * File:            bench_rtree.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include "bench_common.hpp"
+
+#include "hopi/rtree.hpp"
+
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+using namespace hopi::bench;
+
+using box_type   = hopi::spatial::BoundBox<double, 3>;
+using index_type = hopi::spatial::TreeIndex<box_type, std::size_t>;
+using extractor  = hopi::spatial::IndexExtractor<index_type>;
+
+template<std::size_t Max, std::size_t Min>
+using Quadratic = hopi::spatial::shared::index::rtree::Quadratic<Max, Min>;
+
+template<std::size_t Max, std::size_t Min>
+using Linear = hopi::spatial::shared::index::rtree::Linear<Max, Min>;
+
+template<std::size_t Max, std::size_t Min>
+using RStar = hopi::spatial::shared::index::rtree::RStar<Max, Min>;
+
+template<typename Policy>
+using ArenaTree = hopi::spatial::shared::index::
+    RTree<index_type, extractor, Policy, std::equal_to<index_type>, hopi::spatial::ArenaAllocator<index_type>>;
+
+using DefaultTree = ArenaTree<Quadratic<10, 4>>;
+using Exhaustive  = hopi::spatial::shared::index::Exhaustive<index_type, extractor>;
+
+constexpr std::size_t num_queries  = 256;  ///< Queries cycled through by each query benchmark
+constexpr std::size_t query_count  = 8;    ///< Values found by each Nearest query
+constexpr double      query_values = 32;   ///< Expected values within a uniform box query
+
+std::vector<index_type>
+make_indices(const int data_set, const std::size_t n)
+{
+    const auto              points = make_points(DataSet(data_set), n);
+    std::vector<index_type> indices;
+    indices.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        indices.emplace_back(box_type(points[i], points[i]), i);
+    }
+    return indices;
+}
+
+template<typename Index>
+Index
+make_index(const std::vector<index_type>& indices)
+{
+    Index index;
+    if constexpr (requires { index.insert(indices.begin(), indices.end(), hopi::spatial::STRPacking()); }) {
+        index.insert(indices.begin(), indices.end(), hopi::spatial::STRPacking());
+    }
+    else {
+        index.insert(indices.begin(), indices.end());
+    }
+    return index;
+}
+
+/**
+ * Query Bounds centered on points of the same data set
+ */
+std::vector<box_type>
+make_query_boxes(const int data_set, const std::size_t n)
+{
+    const auto            centers = make_points(DataSet(data_set), num_queries, 7);
+    const double          half    = 0.5 * std::cbrt(query_values / double(n));
+    std::vector<box_type> boxes;
+    for (const auto& c : centers) {
+        boxes.emplace_back(point_type{ c[0] - half, c[1] - half, c[2] - half }, point_type{ c[0] + half, c[1] + half, c[2] + half });
+    }
+    return boxes;
+}
+
+struct ContainedQuery {
+    static auto make(const box_type& box) { return hopi::spatial::shared::predicate::ContainedByNonInclusive(box); }
+};
+
+struct IntersectsQuery {
+    static auto make(const box_type& box) { return hopi::spatial::shared::predicate::Intersects(box); }
+};
+
+struct NearestQuery {
+    static auto make(const box_type& box)
+    {
+        const point_type c = { box.center(0), box.center(1), box.center(2) };
+        return hopi::spatial::shared::predicate::Nearest(box_type(c, c), query_count);
+    }
+};
+
+void
+sizes_and_data_sets(benchmark::internal::Benchmark* b, const std::vector<std::int64_t>& sizes)
+{
+    b->ArgNames({ "n", "data" });
+    for (const auto n : sizes) {
+        for (const int data_set : { Uniform, Clustered, Lattice }) {
+            b->Args({ n, data_set });
+        }
+    }
+}
+
+void
+large_sizes(benchmark::internal::Benchmark* b)
+{
+    sizes_and_data_sets(b, { 1 << 10, 1 << 14, 1 << 17 });
+}
+
+void
+small_sizes(benchmark::internal::Benchmark* b)
+{
+    sizes_and_data_sets(b, { 1 << 10, 1 << 14 });
+}
+
+// ----------------------------------------------------------
+// Construction
+// ----------------------------------------------------------
+
+template<typename Tree>
+void
+BM_Insert(benchmark::State& state)
+{
+    if (not serial_rank(state)) {
+        return;
+    }
+    const auto indices = make_indices(int(state.range(1)), std::size_t(state.range(0)));
+    for (auto _ : state) {
+        Tree tree;
+        tree.insert(indices.begin(), indices.end());
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(data_set_name(int(state.range(1))));
+}
+
+template<typename Tree, typename PackingTag>
+void
+BM_BulkLoad(benchmark::State& state)
+{
+    if (not serial_rank(state)) {
+        return;
+    }
+    const auto indices = make_indices(int(state.range(1)), std::size_t(state.range(0)));
+    for (auto _ : state) {
+        Tree tree(indices.begin(), indices.end(), PackingTag());
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(data_set_name(int(state.range(1))));
+}
+
+// ----------------------------------------------------------
+// Queries
+// ----------------------------------------------------------
+
+template<typename Index, typename Query>
+void
+run_queries(benchmark::State& state, const Index& index, const std::vector<box_type>& boxes)
+{
+    std::vector<index_type> found;
+    std::size_t             num_found = 0;
+    std::size_t             q         = 0;
+    for (auto _ : state) {
+        found.clear();
+        num_found += index.query(Query::make(boxes[q]), std::back_inserter(found));
+        benchmark::DoNotOptimize(found.data());
+        q = (q + 1) % boxes.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["found"] = benchmark::Counter(double(num_found), benchmark::Counter::kAvgIterations);
+    state.SetLabel(data_set_name(int(state.range(1))));
+}
+
+template<typename Index, typename Query>
+void
+BM_Query(benchmark::State& state)
+{
+    if (not serial_rank(state)) {
+        return;
+    }
+    const auto indices = make_indices(int(state.range(1)), std::size_t(state.range(0)));
+    const auto index   = make_index<Index>(indices);
+    run_queries<Index, Query>(state, index, make_query_boxes(int(state.range(1)), std::size_t(state.range(0))));
+}
+
+// ----------------------------------------------------------
+// Splitting Policies
+// - Bulk loading does not split so the trees are built by insert
+// ----------------------------------------------------------
+
+template<typename Policy>
+void
+BM_SplitQuery(benchmark::State& state)
+{
+    if (not serial_rank(state)) {
+        return;
+    }
+    const auto        indices = make_indices(int(state.range(1)), std::size_t(state.range(0)));
+    ArenaTree<Policy> tree;
+    tree.insert(indices.begin(), indices.end());
+    run_queries<ArenaTree<Policy>, IntersectsQuery>(state, tree, make_query_boxes(int(state.range(1)), std::size_t(state.range(0))));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Insert, DefaultTree)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BulkLoad, DefaultTree, hopi::spatial::STRPacking)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BulkLoad, DefaultTree, hopi::spatial::HilbertPacking)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Query, DefaultTree, ContainedQuery)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_Query, DefaultTree, IntersectsQuery)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_Query, DefaultTree, NearestQuery)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_Query, Exhaustive, ContainedQuery)->Apply(small_sizes);
+BENCHMARK_TEMPLATE(BM_Query, Exhaustive, IntersectsQuery)->Apply(small_sizes);
+BENCHMARK_TEMPLATE(BM_Query, Exhaustive, NearestQuery)->Apply(small_sizes);
+
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<Quadratic<8, 3>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<Quadratic<16, 6>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<Quadratic<32, 12>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<Linear<8, 3>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<Linear<10, 4>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<Linear<16, 6>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<Linear<32, 12>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<RStar<8, 3>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<RStar<10, 4>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<RStar<16, 6>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Insert, ArenaTree<RStar<32, 12>>)->Apply(large_sizes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_SplitQuery, Quadratic<8, 3>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, Quadratic<10, 4>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, Quadratic<16, 6>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, Quadratic<32, 12>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, Linear<8, 3>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, Linear<10, 4>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, Linear<16, 6>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, Linear<32, 12>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, RStar<8, 3>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, RStar<10, 4>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, RStar<16, 6>)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_SplitQuery, RStar<32, 12>)->Apply(large_sizes);
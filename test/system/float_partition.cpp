@@ -0,0 +1,68 @@
+/// @file float_partition.cpp
+/*
+ * Project:         HOPI
+ * File:            float_partition.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/mpixx.hpp"
+#include "hopi/partition.hpp"
+#include "test_common.hpp"
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace {
+
+using hopi::test::normal_xyz;
+
+using FloatTypes = hopi::test::BasicUserTypes<float>;
+using Partition  = hopi::Partition<FloatTypes>;
+
+}  // namespace
+
+TEST_CASE("Partition of float coordinates redistributes and reverses", "[partition][float][mpi]")
+{
+    constexpr std::size_t ND = FloatTypes::NDim;
+    mpixx::communicator   world;
+    const auto            my_rank = world.rank();
+
+    const std::size_t N   = 700 + 91 * my_rank;
+    const auto        xyz = normal_xyz<float>(N, 600 + my_rank, my_rank, 1);
+
+    Partition partition(world);
+    partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+    const auto owned = partition.redistribute(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+    const auto Nr    = owned.weight.size();
+
+    // Coordinates travel as float and arrive at their owner
+    REQUIRE(owned.xyz.size() == Nr * ND);
+    REQUIRE(mpixx::all_reduce(world, Nr, std::plus<std::size_t>()) == mpixx::all_reduce(world, N, std::plus<std::size_t>()));
+    for (std::size_t n = 0; n < Nr; ++n) {
+        const std::array<float, ND> point = { owned.xyz[n * ND], owned.xyz[n * ND + 1], owned.xyz[n * ND + 2] };
+        CHECK(partition.owner(point) == my_rank);
+        CHECK(hopi::spatial::bound::Contains(partition.bounds()[my_rank], Partition::box_type(point, point)));
+    }
+
+    // Reverse returns every coordinate exactly
+    for (std::size_t d = 0; d < ND; ++d) {
+        std::vector<float> received(Nr);
+        for (std::size_t n = 0; n < Nr; ++n) {
+            received[n] = owned.xyz[n * ND + d];
+        }
+        std::vector<float> returned(N);
+        partition.reverse(owned.plan, received.data(), returned.data());
+        for (std::size_t i = 0; i < N; ++i) {
+            CHECK(returned[i] == xyz[i * ND + d]);
+        }
+    }
+}
@@ -0,0 +1,186 @@
+/// @file halo_exchange.cpp
+/*
+ * Project:         HOPI
+ * File:            halo_exchange.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/halo.hpp"
+#include "hopi/mpixx.hpp"
+#include "hopi/partition.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <vector>
+
+namespace {
+
+using hopi::test::random_xyz;
+using hopi::test::UserTypes;
+
+using Partition  = hopi::Partition<UserTypes>;
+using Halo       = hopi::Halo<UserTypes>;
+using box_type   = Partition::box_type;
+using box_array  = Partition::box_array;
+using index_type = hopi::spatial::TreeIndex<box_type, long>;
+using tree_type  = hopi::spatial::RTree<index_type>;
+
+constexpr std::size_t ND = UserTypes::NDim;
+
+/**
+ * Sources of a rank after redistribute tagged with their global id
+ */
+struct Owned {
+    std::vector<double> xyz;
+    std::vector<long>   id;
+};
+
+Owned
+owned_sources(const mpixx::communicator& world, const Partition& partition, const std::vector<double>& xyz)
+{
+    const std::size_t N     = xyz.size() / ND;
+    const std::size_t first = mpixx::scan(world, N, std::plus<std::size_t>()) - N;
+    std::vector<long> id(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        id[i] = long(first + i);
+    }
+    const std::vector<Partition::Payload> payload = { { id.data(), sizeof(long), 1 } };
+    const auto moved = partition.redistribute(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1, payload);
+
+    Owned owned;
+    owned.xyz = moved.xyz;
+    owned.id.resize(moved.weight.size());
+    std::memcpy(owned.id.data(), moved.payload[0].data(), owned.id.size() * sizeof(long));
+    return owned;
+}
+
+/**
+ * Tree of the points with ids
+ */
+std::vector<index_type>
+make_indices(const std::vector<double>& xyz, const std::vector<long>& id)
+{
+    std::vector<index_type> indices;
+    for (std::size_t i = 0; i < id.size(); ++i) {
+        const box_array point = { xyz[i * ND], xyz[i * ND + 1], xyz[i * ND + 2] };
+        indices.emplace_back(box_type(point, point), id[i]);
+    }
+    return indices;
+}
+
+/**
+ * Ghost ids are unique, not owned by me and owned by the rank they came from
+ */
+void
+check_ghosts(const Partition& partition, const Owned& owned, const Halo::Ghosts& ghosts, const int my_rank)
+{
+    std::vector<long> ghost_id(ghosts.size());
+    std::memcpy(ghost_id.data(), ghosts.payload[0].data(), ghost_id.size() * sizeof(long));
+
+    const std::set<long> unique_ids(ghost_id.begin(), ghost_id.end());
+    CHECK(unique_ids.size() == ghost_id.size());
+    for (const auto id : owned.id) {
+        CHECK(unique_ids.count(id) == 0);
+    }
+    for (std::size_t n = 0; n < ghosts.size(); ++n) {
+        const box_array point = { ghosts.xyz[n * ND], ghosts.xyz[n * ND + 1], ghosts.xyz[n * ND + 2] };
+        CHECK(ghosts.rank[n] != my_rank);
+        CHECK(partition.owner(point) == ghosts.rank[n]);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Halo ghosts are unique and complete the stencils", "[halo][mpi]")
+{
+    namespace predicate = hopi::spatial::shared::predicate;
+
+    mpixx::communicator world;
+    const auto          my_rank = world.rank();
+
+    // Targets decide the partition and sources are sparser
+    const auto targets = random_xyz(2000, 400 + my_rank);
+    const auto sources = random_xyz(400, 500 + my_rank);
+
+    Partition partition(world);
+    partition.init(targets.size() / ND, targets.data(), ND, targets.data() + 1, ND, targets.data() + 2, ND, nullptr, 1);
+    const auto owned_targets = partition.redistribute(targets.size() / ND, targets.data(), ND, targets.data() + 1, ND, targets.data() + 2, ND, nullptr, 1);
+    const auto owned         = owned_sources(world, partition, sources);
+    const auto Nt            = owned_targets.weight.size();
+    const auto Ns            = owned.id.size();
+
+    const std::vector<Partition::Payload> payload = { { owned.id.data(), sizeof(long), 1 } };
+
+    // Every source on every rank
+    std::vector<std::vector<double>> xyz_by_rank;
+    std::vector<std::vector<long>>   id_by_rank;
+    mpixx::all_gather(world, owned.xyz, xyz_by_rank);
+    mpixx::all_gather(world, owned.id, id_by_rank);
+
+    SECTION("Fixed radius receives every foreign source within it")
+    {
+        constexpr double radius = 0.2;
+        Halo             halo(partition);
+        const auto       ghosts = halo.exchange(Ns, owned.xyz.data(), ND, owned.xyz.data() + 1, ND, owned.xyz.data() + 2, ND, payload, radius);
+        check_ghosts(partition, owned, ghosts, my_rank);
+
+        box_array lo = partition.bounds()[my_rank].min_corner();
+        box_array hi = partition.bounds()[my_rank].max_corner();
+        for (std::size_t d = 0; d < ND; ++d) {
+            lo[d] -= radius;
+            hi[d] += radius;
+        }
+        std::size_t expected = 0;
+        for (int r = 0; r < world.size(); ++r) {
+            if (r == my_rank) {
+                continue;
+            }
+            const auto indices = make_indices(xyz_by_rank[r], id_by_rank[r]);
+            for (const auto& index : indices) {
+                expected += hopi::spatial::bound::Intersects(box_type(lo, hi), index.first) ? 1 : 0;
+            }
+        }
+        CHECK(ghosts.size() == expected);
+    }
+
+    SECTION("Adaptive radius finds the same K nearest as a global search")
+    {
+        constexpr std::size_t k = 30;
+        Halo                  halo(partition);
+        const auto            ghosts = halo.exchange_adaptive(Nt, owned_targets.xyz.data(), ND, owned_targets.xyz.data() + 1, ND, owned_targets.xyz.data() + 2, ND,
+                                                   Ns, owned.xyz.data(), ND, owned.xyz.data() + 1, ND, owned.xyz.data() + 2, ND,
+                                                   payload, k, 0);
+        check_ghosts(partition, owned, ghosts, my_rank);
+
+        std::vector<long> ghost_id(ghosts.size());
+        std::memcpy(ghost_id.data(), ghosts.payload[0].data(), ghost_id.size() * sizeof(long));
+        auto local = make_indices(owned.xyz, owned.id);
+        for (const auto& index : make_indices(ghosts.xyz, ghost_id)) {
+            local.push_back(index);
+        }
+        std::vector<index_type> global;
+        for (int r = 0; r < world.size(); ++r) {
+            const auto indices = make_indices(xyz_by_rank[r], id_by_rank[r]);
+            global.insert(global.end(), indices.begin(), indices.end());
+        }
+        const tree_type local_tree(local.begin(), local.end(), hopi::spatial::STRPacking());
+        const tree_type global_tree(global.begin(), global.end(), hopi::spatial::STRPacking());
+        for (std::size_t t = 0; t < Nt; ++t) {
+            const box_array point = { owned_targets.xyz[t * ND], owned_targets.xyz[t * ND + 1], owned_targets.xyz[t * ND + 2] };
+            const box_type  query(point, point);
+            CHECK(hopi::test::query_keys(local_tree, predicate::Nearest(query, k)) == hopi::test::query_keys(global_tree, predicate::Nearest(query, k)));
+        }
+    }
+}
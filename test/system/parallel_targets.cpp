@@ -0,0 +1,149 @@
+/// @file parallel_targets.cpp
+/*
+ * Project:         HOPI
+ * File:            parallel_targets.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/binary_targets.hpp"
+#include "hopi/mpixx.hpp"
+#include "hopi/parallel_targets.hpp"
+#include "test_common.hpp"
+
+#include <vector>
+
+namespace {
+
+using hopi::test::random_xyz;
+using hopi::test::TempFile;
+using hopi::test::UserTypes;
+
+/**
+ * Check a rank's slice against the interleaved values of the whole file
+ */
+template<typename T, typename V>
+void
+check_slice(const hopi::TargetSlice<T>& slice, const std::vector<V>& xyz, const std::size_t nvar, const std::vector<V>& var)
+{
+    constexpr std::size_t ND = UserTypes::NDim;
+    for (std::size_t d = 0; d < ND; ++d) {
+        const T* block = slice.coordinate(d);
+        REQUIRE(block != nullptr);
+        for (std::size_t n = 0; n < slice.count; ++n) {
+            CHECK(block[n] == T(xyz[(slice.first + n) * ND + d]));
+        }
+    }
+    for (std::size_t v = 0; v < nvar; ++v) {
+        const T* block = slice.variable(v);
+        REQUIRE(block != nullptr);
+        for (std::size_t n = 0; n < slice.count; ++n) {
+            CHECK(block[n] == T(var[(slice.first + n) * nvar + v]));
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Parallel reads return each rank its slice of the file", "[io][mpi]")
+{
+    constexpr std::size_t ND   = UserTypes::NDim;
+    constexpr std::size_t N    = 2011;
+    constexpr std::size_t nvar = 3;
+    mpixx::communicator   world;
+    const TempFile        file("hopi_system_read_targets.bin");
+    world.barrier();  // Every rank removed the file of the previous section
+
+    // Values exact in float so either precision reads exactly
+    const auto xyz = random_xyz<float>(N, 21);
+    const auto var = random_xyz<float>(N, 22);
+
+    SECTION("Stored as double")
+    {
+        if (world.rank() == 0) {
+            const std::vector<double> xyz_double(xyz.begin(), xyz.end());
+            const std::vector<double> var_double(var.begin(), var.end());
+            hopi::write_binary_target_file(file.name(), ND, N, xyz_double, nvar, var_double);
+        }
+        world.barrier();
+
+        const auto slice = hopi::read_targets_parallel<double>(world, file.name());
+        CHECK(slice.header.npoints == N);
+        CHECK(mpixx::all_reduce(world, slice.count, MPI_SUM) == N);
+        check_slice(slice, xyz, nvar, var);
+
+        const auto converted = hopi::read_targets_parallel<float>(world, file.name());
+        CHECK(converted.first == slice.first);
+        CHECK(converted.count == slice.count);
+        check_slice(converted, xyz, nvar, var);
+        world.barrier();
+    }
+
+    SECTION("Stored as float")
+    {
+        if (world.rank() == 0) {
+            hopi::write_binary_target_file(file.name(), ND, N, xyz, nvar, var);
+        }
+        world.barrier();
+
+        check_slice(hopi::read_targets_parallel<float>(world, file.name()), xyz, nvar, var);
+        check_slice(hopi::read_targets_parallel<double>(world, file.name()), xyz, nvar, var);
+        world.barrier();
+    }
+}
+
+TEST_CASE("Parallel writes place every point by its global index", "[io][mpi]")
+{
+    constexpr std::size_t ND   = UserTypes::NDim;
+    constexpr std::size_t N    = 1703;
+    constexpr std::size_t nvar = 3;
+    mpixx::communicator   world;
+    const std::size_t     num_ranks = world.size();
+    const std::size_t     my_rank   = world.rank();
+    const TempFile        file("hopi_system_write_results.bin");
+
+    const auto xyz = random_xyz(N, 31);
+    const auto var = random_xyz(N, 32);
+
+    // Every rank holds a strided set of the points in reverse order
+    std::vector<std::size_t> global_index;
+    std::vector<double>      my_xyz;
+    std::vector<double>      my_var;
+    for (std::size_t i = N; i-- > 0;) {
+        if (i % num_ranks == my_rank) {
+            global_index.push_back(i);
+            my_xyz.insert(my_xyz.end(), xyz.begin() + i * ND, xyz.begin() + (i + 1) * ND);
+            my_var.insert(my_var.end(), var.begin() + i * nvar, var.begin() + (i + 1) * nvar);
+        }
+    }
+    hopi::write_results_parallel(world, file.name(), N, global_index, ND, my_xyz, nvar, my_var);
+    world.barrier();
+
+    // The file matches one written serially
+    if (my_rank == 0) {
+        const hopi::MappedTargetFile mapped(file.name());
+        REQUIRE(mapped.npoints() == N);
+        REQUIRE(mapped.nvar() == nvar);
+        for (std::size_t d = 0; d < ND; ++d) {
+            for (std::size_t i = 0; i < N; ++i) {
+                CHECK(mapped.coordinate(d)[i] == xyz[i * ND + d]);
+            }
+        }
+        for (std::size_t v = 0; v < nvar; ++v) {
+            for (std::size_t i = 0; i < N; ++i) {
+                CHECK(mapped.variable(v)[i] == var[i * nvar + v]);
+            }
+        }
+    }
+
+    // Reading back gives each rank its contiguous slice
+    check_slice(hopi::read_targets_parallel<double>(world, file.name()), xyz, nvar, var);
+    world.barrier();
+}
@@ -0,0 +1,102 @@
+/// @file partition_exchange.cpp
+/*
+ * Project:         HOPI
+ * File:            partition_exchange.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/mpixx.hpp"
+#include "hopi/partition.hpp"
+#include "test_common.hpp"
+
+#include <array>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace {
+
+using hopi::test::normal_xyz;
+using hopi::test::UserTypes;
+
+using Partition = hopi::Partition<UserTypes>;
+
+}  // namespace
+
+TEST_CASE("Partition redistribute followed by reverse round-trips", "[partition][mpi]")
+{
+    constexpr std::size_t ND = UserTypes::NDim;
+    mpixx::communicator   world;
+    const auto            my_rank = world.rank();
+
+    const std::size_t   N   = 500 + 137 * my_rank;
+    const auto          xyz = normal_xyz(N, 100 + my_rank, my_rank, 1 + my_rank);
+    std::vector<double> weight(N);
+    std::vector<long>   global_id(N);
+    const std::size_t   first = mpixx::scan(world, N, std::plus<std::size_t>()) - N;
+    for (std::size_t i = 0; i < N; ++i) {
+        weight[i]    = 1 + (i % 3);
+        global_id[i] = long(first + i);
+    }
+
+    Partition partition(world);
+    partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, weight.data(), 1);
+
+    const std::vector<Partition::Payload> payload = { { global_id.data(), sizeof(long), 1 } };
+    const auto owned = partition.redistribute(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, weight.data(), 1, payload);
+    const auto Nr    = owned.weight.size();
+
+    SECTION("Every point arrives at its owner once")
+    {
+        REQUIRE(owned.plan.send_size() == N);
+        REQUIRE(owned.plan.recv_size() == Nr);
+        REQUIRE(owned.xyz.size() == Nr * ND);
+        REQUIRE(mpixx::all_reduce(world, Nr, std::plus<std::size_t>()) == mpixx::all_reduce(world, N, std::plus<std::size_t>()));
+        for (std::size_t n = 0; n < Nr; ++n) {
+            const std::array<double, ND> point = { owned.xyz[n * ND], owned.xyz[n * ND + 1], owned.xyz[n * ND + 2] };
+            CHECK(partition.owner(point) == my_rank);
+        }
+    }
+
+    SECTION("Reverse returns each value to its original index")
+    {
+        std::vector<long> received_id(Nr);
+        std::memcpy(received_id.data(), owned.payload[0].data(), Nr * sizeof(long));
+        std::vector<long> returned_id(N, -1);
+        partition.reverse(owned.plan, received_id.data(), returned_id.data());
+        CHECK(returned_id == global_id);
+
+        std::vector<double> returned_weight(N, 0);
+        partition.reverse(owned.plan, owned.weight.data(), returned_weight.data());
+        CHECK(returned_weight == weight);
+
+        for (std::size_t d = 0; d < ND; ++d) {
+            std::vector<double> received(Nr);
+            for (std::size_t n = 0; n < Nr; ++n) {
+                received[n] = owned.xyz[n * ND + d];
+            }
+            std::vector<double> returned(N);
+            partition.reverse(owned.plan, received.data(), returned.data());
+            for (std::size_t i = 0; i < N; ++i) {
+                CHECK(returned[i] == xyz[i * ND + d]);
+            }
+        }
+    }
+
+    SECTION("Exchange plan matches the plan of redistribute")
+    {
+        const auto plan = partition.exchange_plan(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND);
+        CHECK(plan.send_counts == owned.plan.send_counts);
+        CHECK(plan.recv_counts == owned.plan.recv_counts);
+        CHECK(plan.recv_displs == owned.plan.recv_displs);
+        CHECK(plan.send_index == owned.plan.send_index);
+    }
+}
@@ -0,0 +1,143 @@
+/// @file partition_rebalance.cpp
+/*
+ * Project:         HOPI
+ * File:            partition_rebalance.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/mpixx.hpp"
+#include "hopi/partition.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using hopi::test::normal_xyz;
+using hopi::test::UserTypes;
+
+using Partition = hopi::Partition<UserTypes>;
+
+constexpr std::size_t ND = UserTypes::NDim;
+
+/**
+ * Maximum over mean of the weight owned by each rank
+ */
+double
+imbalance(const mpixx::communicator& world, const Partition& partition, const std::vector<double>& xyz, const std::vector<double>& weight)
+{
+    const std::size_t   num_ranks = world.size();
+    std::vector<double> local_weight(num_ranks, 0);
+    for (std::size_t i = 0; i < weight.size(); ++i) {
+        local_weight[partition.owner(Partition::box_array{ xyz[i * ND], xyz[i * ND + 1], xyz[i * ND + 2] })] += weight[i];
+    }
+    std::vector<double> rank_weight(num_ranks);
+    mpixx::all_reduce(world, local_weight.data(), int(num_ranks), rank_weight.data(), MPI_SUM);
+    double total = 0;
+    for (const auto value : rank_weight) {
+        total += value;
+    }
+    return *std::max_element(rank_weight.begin(), rank_weight.end()) * double(num_ranks) / total;
+}
+
+/**
+ * Every point lies within the bound of its owner and the bounds do not overlap
+ */
+void
+check_bounds(const Partition& partition, const std::vector<double>& xyz)
+{
+    const auto& bounds = partition.bounds();
+    for (std::size_t i = 0; i < xyz.size() / ND; ++i) {
+        const Partition::box_array point = { xyz[i * ND], xyz[i * ND + 1], xyz[i * ND + 2] };
+        CHECK(hopi::spatial::bound::Contains(bounds[partition.owner(point)], Partition::box_type(point, point)));
+    }
+    for (std::size_t a = 0; a < bounds.size(); ++a) {
+        for (std::size_t b = a + 1; b < bounds.size(); ++b) {
+            double overlap = 1;
+            for (std::size_t d = 0; d < ND; ++d) {
+                overlap *= std::max(0.0, std::min(bounds[a].max(d), bounds[b].max(d)) - std::max(bounds[a].min(d), bounds[b].min(d)));
+            }
+            CHECK(overlap == 0);
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Partition rebalance moves the splits to the measured cost", "[partition][rebalance][mpi]")
+{
+    mpixx::communicator world;
+    const auto          my_rank = world.rank();
+
+    const std::size_t   N   = 4000 + 300 * my_rank;
+    const auto          xyz = normal_xyz(N, 700 + my_rank, 0.2 * my_rank, 1);
+    std::vector<double> unit(N, 1);
+
+    SECTION("Skewed cost is balanced")
+    {
+        // Points within one octant cost more so no split starts balanced
+        std::vector<double> cost(N);
+        for (std::size_t i = 0; i < N; ++i) {
+            const bool costly = (xyz[i * ND] > 0.5) and (xyz[i * ND + 1] > 0.5) and (xyz[i * ND + 2] > 0.5);
+            cost[i]           = costly ? 20 : 1;
+        }
+
+        // Balance of every option of the splits
+        for (const auto method : { hopi::SplitMethod::Histogram, hopi::SplitMethod::MedianAverage }) {
+            hopi::PartitionOptions options;
+            options.method = method;
+            Partition partition(world, options);
+            partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+            const double before = imbalance(world, partition, xyz, cost);
+
+            const bool moved = partition.rebalance(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, cost.data(), 1);
+            CHECK(moved == (world.size() > 1));
+            check_bounds(partition, xyz);
+            if (world.size() > 1) {
+                CHECK(before > options.rebalance_threshold);
+                if (method == hopi::SplitMethod::Histogram) {
+                    CHECK(imbalance(world, partition, xyz, cost) < 1.01);
+                }
+                else {
+                    CHECK(imbalance(world, partition, xyz, cost) < before);
+                }
+            }
+        }
+    }
+
+    SECTION("Balanced cost leaves the splits alone")
+    {
+        Partition partition(world);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+        const auto bounds = partition.bounds();
+        CHECK_FALSE(partition.rebalance(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, unit.data(), 1));
+        REQUIRE(partition.bounds().size() == bounds.size());
+        for (std::size_t r = 0; r < bounds.size(); ++r) {
+            CHECK(partition.bounds()[r] == bounds[r]);
+        }
+    }
+
+    SECTION("Points of another distribution are balanced")
+    {
+        // Splits of one set of points moved to balance a shifted set
+        Partition partition(world);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+        const auto shifted = normal_xyz(N, 800 + my_rank, 1.5, 0.5);
+        const bool moved   = partition.rebalance(N, shifted.data(), ND, shifted.data() + 1, ND, shifted.data() + 2, ND, unit.data(), 1);
+        CHECK(moved == (world.size() > 1));
+        check_bounds(partition, shifted);
+        check_bounds(partition, xyz);
+        if (world.size() > 1) {
+            CHECK(imbalance(world, partition, shifted, unit) < 1.01);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/// @file partition_snapshot.cpp
+/*
+ * Project:         HOPI
+ * File:            partition_snapshot.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/mpixx.hpp"
+#include "hopi/partition.hpp"
+#include "test_common.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace {
+
+using hopi::test::normal_xyz;
+using hopi::test::random_xyz;
+using hopi::test::TempFile;
+using hopi::test::UserTypes;
+
+using Partition = hopi::Partition<UserTypes>;
+
+}  // namespace
+
+TEST_CASE("Partition snapshots load back the same splits and plan", "[partition][snapshot][mpi]")
+{
+    constexpr std::size_t ND = UserTypes::NDim;
+    mpixx::communicator   world;
+    const auto            my_rank = world.rank();
+
+    const std::size_t N   = 800 + 53 * my_rank;
+    const auto        xyz = normal_xyz(N, 200 + my_rank, 0.5 * my_rank, 1);
+
+    Partition partition(world);
+    partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+    const auto owned = partition.redistribute(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+
+    // Each rank writes its own file
+    const TempFile file("hopi_system_partition_" + std::to_string(my_rank) + ".snap");
+    partition.save(file.name(), owned.plan);
+
+    Partition  loaded(world);
+    const auto plan = loaded.load(file.name());
+    REQUIRE(loaded.bounds().size() == partition.bounds().size());
+    for (std::size_t r = 0; r < partition.bounds().size(); ++r) {
+        CHECK(loaded.bounds()[r] == partition.bounds()[r]);
+    }
+
+    SECTION("Owner of any point is unchanged")
+    {
+        const auto probe = random_xyz(2000, 300 + my_rank, -4, 4 + my_rank);
+        for (std::size_t i = 0; i < probe.size() / ND; ++i) {
+            const std::array<double, ND> point = { probe[i * ND], probe[i * ND + 1], probe[i * ND + 2] };
+            CHECK(loaded.owner(point) == partition.owner(point));
+        }
+    }
+
+    SECTION("Saved plan reverses the original redistribute")
+    {
+        CHECK(plan.send_counts == owned.plan.send_counts);
+        CHECK(plan.send_displs == owned.plan.send_displs);
+        CHECK(plan.recv_counts == owned.plan.recv_counts);
+        CHECK(plan.recv_displs == owned.plan.recv_displs);
+        CHECK(plan.send_index == owned.plan.send_index);
+
+        const std::size_t   Nr = owned.weight.size();
+        std::vector<double> received(Nr);
+        for (std::size_t n = 0; n < Nr; ++n) {
+            received[n] = owned.xyz[n * ND];
+        }
+        std::vector<double> returned(N);
+        loaded.reverse(plan, received.data(), returned.data());
+        for (std::size_t i = 0; i < N; ++i) {
+            CHECK(returned[i] == xyz[i * ND]);
+        }
+    }
+}
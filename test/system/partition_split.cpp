@@ -0,0 +1,128 @@
+/// @file partition_split.cpp
+/*
+ * Project:         HOPI
+ * File:            partition_split.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/mpixx.hpp"
+#include "hopi/partition.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+using hopi::test::normal_xyz;
+using hopi::test::UserTypes;
+
+using Partition = hopi::Partition<UserTypes>;
+
+/**
+ * Maximum over mean of the weight owned by each rank
+ */
+double
+imbalance(const mpixx::communicator& world, const Partition& partition, const std::vector<double>& xyz, const std::vector<double>& weight)
+{
+    constexpr std::size_t ND    = UserTypes::NDim;
+    const std::size_t     N     = weight.size();
+    const auto            owned = partition.redistribute(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, weight.data(), 1);
+    const double          mine  = std::accumulate(owned.weight.begin(), owned.weight.end(), 0.0);
+    const double          most  = mpixx::all_reduce(world, mine, mpixx::maximum<double>());
+    const double          total = mpixx::all_reduce(world, mine, std::plus<double>());
+    return most * world.size() / total;
+}
+
+/**
+ * Every point lies within the bound of its owner and the bounds do not overlap
+ */
+void
+check_bounds(const Partition& partition, const std::vector<double>& xyz)
+{
+    constexpr std::size_t ND     = UserTypes::NDim;
+    const auto&           bounds = partition.bounds();
+    for (std::size_t i = 0; i < xyz.size() / ND; ++i) {
+        const Partition::box_array point = { xyz[i * ND], xyz[i * ND + 1], xyz[i * ND + 2] };
+        const auto                 owner = partition.owner(point);
+        REQUIRE(owner >= 0);
+        REQUIRE(owner < int(bounds.size()));
+        CHECK(hopi::spatial::bound::Contains(bounds[owner], Partition::box_type(point, point)));
+    }
+    for (std::size_t a = 0; a < bounds.size(); ++a) {
+        for (std::size_t b = a + 1; b < bounds.size(); ++b) {
+            double overlap = 1;
+            for (std::size_t d = 0; d < ND; ++d) {
+                overlap *= std::max(0.0, std::min(bounds[a].max(d), bounds[b].max(d)) - std::max(bounds[a].min(d), bounds[b].min(d)));
+            }
+            CHECK(overlap == 0);
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Partition splits balance the weight of each rank", "[partition][mpi]")
+{
+    constexpr std::size_t ND = UserTypes::NDim;
+    mpixx::communicator   world;
+    const auto            my_rank = world.rank();
+
+    // Clustered points with a different count and center on each rank
+    const std::size_t   N   = 3000 + 500 * my_rank;
+    const auto          xyz = normal_xyz(N, 200 + my_rank, 0.3 * my_rank, 1);
+    std::vector<double> unit(N, 1);
+    std::vector<double> weight(N);
+    std::default_random_engine             re(300 + my_rank);
+    std::uniform_real_distribution<double> unif(1, 10);
+    for (auto& w : weight) {
+        w = unif(re);
+    }
+
+    SECTION("Histogram splits of equal weights")
+    {
+        Partition partition(world);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+        check_bounds(partition, xyz);
+        CHECK(imbalance(world, partition, xyz, unit) < 1.01);
+    }
+
+    SECTION("Histogram splits of random weights")
+    {
+        Partition partition(world);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, weight.data(), 1);
+        check_bounds(partition, xyz);
+        CHECK(imbalance(world, partition, xyz, weight) < 1.01);
+    }
+
+    SECTION("Histogram splits within a single round")
+    {
+        hopi::PartitionOptions options;
+        options.max_rounds = 1;
+        options.num_bins   = 256;
+        Partition partition(world, options);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+        check_bounds(partition, xyz);
+        CHECK(imbalance(world, partition, xyz, unit) < 1.1);
+    }
+
+    SECTION("Median average splits")
+    {
+        hopi::PartitionOptions options;
+        options.method = hopi::SplitMethod::MedianAverage;
+        Partition partition(world, options);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+        check_bounds(partition, xyz);
+    }
+}
@@ -0,0 +1,124 @@
+/// @file sfc_partition.cpp
+/*
+ * Project:         HOPI
+ * File:            sfc_partition.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/mpixx.hpp"
+#include "hopi/sfc_partition.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+using hopi::test::normal_xyz;
+using hopi::test::UserTypes;
+
+using SFCPartition = hopi::SFCPartition<UserTypes>;
+
+/**
+ * Every point is owned, lies within the bound of its owner and
+ * the ranks hold an equal share of the weight
+ */
+void
+check_partition(const mpixx::communicator& world, const SFCPartition& partition, const std::vector<double>& xyz, const std::vector<double>& weight)
+{
+    constexpr std::size_t ND        = UserTypes::NDim;
+    const std::size_t     N         = weight.size();
+    const std::size_t     num_ranks = world.size();
+    const auto&           bounds    = partition.bounds();
+    const auto&           splitters = partition.splitters();
+    REQUIRE(bounds.size() == num_ranks);
+    REQUIRE(splitters.size() == num_ranks - 1);
+    CHECK(std::is_sorted(splitters.begin(), splitters.end()));
+    REQUIRE(partition.keys().size() == N);
+
+    std::vector<double> local_weight(num_ranks, 0);
+    for (std::size_t i = 0; i < N; ++i) {
+        const SFCPartition::box_array point = { xyz[i * ND], xyz[i * ND + 1], xyz[i * ND + 2] };
+        const auto                    owner = partition.owner(point);
+        REQUIRE(owner >= 0);
+        REQUIRE(owner < int(num_ranks));
+        CHECK(partition.keys()[i] == partition.key(point));
+        CHECK(hopi::spatial::bound::Contains(bounds[owner], SFCPartition::box_type(point, point)));
+        local_weight[owner] += weight[i];
+    }
+
+    std::vector<double> rank_weight(num_ranks);
+    mpixx::all_reduce(world, local_weight.data(), int(num_ranks), rank_weight.data(), MPI_SUM);
+    const double total = std::accumulate(rank_weight.begin(), rank_weight.end(), 0.0);
+    const double most  = *std::max_element(rank_weight.begin(), rank_weight.end());
+    CHECK(most * num_ranks / total < 1.01);
+}
+
+}  // namespace
+
+TEST_CASE("SFCPartition splits balance the weight of each rank", "[partition][sfc][mpi]")
+{
+    constexpr std::size_t ND = UserTypes::NDim;
+    mpixx::communicator   world;
+    const auto            my_rank = world.rank();
+
+    // Clustered points with a different count and center on each rank
+    const std::size_t   N   = 3000 + 500 * my_rank;
+    const auto          xyz = normal_xyz(N, 400 + my_rank, 0.3 * my_rank, 1);
+    std::vector<double> unit(N, 1);
+    std::vector<double> weight(N);
+    std::default_random_engine             re(500 + my_rank);
+    std::uniform_real_distribution<double> unif(1, 10);
+    for (auto& w : weight) {
+        w = unif(re);
+    }
+
+    SECTION("Hilbert curve with equal weights")
+    {
+        SFCPartition partition(world);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+        check_partition(world, partition, xyz, unit);
+    }
+
+    SECTION("Hilbert curve with random weights")
+    {
+        SFCPartition partition(world);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, weight.data(), 1);
+        check_partition(world, partition, xyz, weight);
+    }
+
+    SECTION("Morton curve with random weights")
+    {
+        hopi::SFCPartitionOptions options;
+        options.curve = hopi::SFCCurve::Morton;
+        SFCPartition partition(world, options);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, weight.data(), 1);
+        check_partition(world, partition, xyz, weight);
+    }
+
+    SECTION("Order visits every point by increasing key")
+    {
+        SFCPartition partition(world);
+        partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+        const auto order = partition.order();
+        REQUIRE(order.size() == N);
+        auto sorted = order;
+        std::sort(sorted.begin(), sorted.end());
+        for (std::size_t i = 0; i < N; ++i) {
+            REQUIRE(sorted[i] == i);
+        }
+        for (std::size_t n = 1; n < N; ++n) {
+            CHECK(partition.keys()[order[n - 1]] <= partition.keys()[order[n]]);
+        }
+    }
+}
@@ -0,0 +1,27 @@
+/// @file system_main.cpp
+/*
+ * Project:         HOPI
+ * File:            system_main.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_session.hpp>
+
+#include "hopi/mpixx.hpp"
+
+int
+main(int argc, char* argv[])
+{
+    mpixx::environment  env(argc, argv);
+    mpixx::communicator world;
+
+    // Every rank runs the same tests so a failure on any rank fails all
+    const int failed = Catch::Session().run(argc, argv);
+    return mpixx::all_reduce(world, failed, mpixx::maximum<int>());
+}
@@ -0,0 +1,158 @@
+/// @file target_pipeline.cpp
+/*
+ * Project:         HOPI
+ * File:            target_pipeline.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/binary_targets.hpp"
+#include "hopi/halo.hpp"
+#include "hopi/mpixx.hpp"
+#include "hopi/parallel_targets.hpp"
+#include "hopi/partition.hpp"
+#include "hopi/pipeline.hpp"
+#include "hopi/rbf_interpolator.hpp"
+#include "test_common.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using hopi::test::random_xyz;
+using hopi::test::TempFile;
+using hopi::test::UserTypes;
+
+using Partition = hopi::Partition<UserTypes>;
+
+constexpr std::size_t ND = UserTypes::NDim;
+
+double
+smooth_field(const double x, const double y, const double z)
+{
+    return std::sin(2 * x) * std::cos(3 * y) + z * z;
+}
+
+}  // namespace
+
+TEST_CASE("TargetPipeline results match interpolating in memory", "[pipeline][mpi]")
+{
+    constexpr std::size_t Ntg  = 5003;
+    constexpr std::size_t nvar = 2;
+    mpixx::communicator   world;
+    const std::size_t     num_ranks = world.size();
+    const std::size_t     my_rank   = world.rank();
+    const TempFile        target_file("hopi_system_pipeline_targets.bin");
+    const TempFile        result_file("hopi_system_pipeline_results.bin");
+    world.barrier();  // Every rank removed the files of the previous section
+
+    // Every rank knows all targets and rank 0 writes them
+    const auto target_xyz = random_xyz(Ntg, 81);
+    if (my_rank == 0) {
+        hopi::write_binary_target_file(target_file.name(), ND, Ntg, target_xyz, 0, std::vector<double>());
+    }
+
+    // Partition of my slice of the targets with the sources of every stencil
+    const std::size_t   first = Ntg * my_rank / num_ranks;
+    const std::size_t   Nt    = Ntg * (my_rank + 1) / num_ranks - first;
+    const double*       xyz   = target_xyz.data() + first * ND;
+    std::vector<double> global_id(Nt);
+    for (std::size_t i = 0; i < Nt; ++i) {
+        global_id[i] = double(first + i);
+    }
+    Partition partition(world);
+    partition.init(Nt, xyz, ND, xyz + 1, ND, xyz + 2, ND, nullptr, 1);
+    const std::vector<Partition::Payload> payload = { { global_id.data(), sizeof(double), 1 } };
+    const auto targets = partition.redistribute(Nt, xyz, ND, xyz + 1, ND, xyz + 2, ND, nullptr, 1, payload);
+    const auto Nto     = targets.weight.size();
+
+    const hopi::RBFOptions rbf_options;
+    const auto             source_xyz = random_xyz(1500, 83 + my_rank);
+    const auto             sources    = partition.redistribute(1500, source_xyz.data(), ND, source_xyz.data() + 1, ND, source_xyz.data() + 2, ND, nullptr, 1);
+    const auto             ghosts     = hopi::Halo<UserTypes>(partition).exchange_adaptive(Nto, targets.xyz.data(), ND, targets.xyz.data() + 1, ND, targets.xyz.data() + 2, ND,
+                                                                            sources.weight.size(), sources.xyz.data(), ND, sources.xyz.data() + 1, ND, sources.xyz.data() + 2, ND,
+                                                                            {}, rbf_options.neighbors, 0);
+    std::vector<double> local_xyz(sources.xyz);
+    local_xyz.insert(local_xyz.end(), ghosts.xyz.begin(), ghosts.xyz.end());
+    const std::size_t Nsl = local_xyz.size() / ND;
+
+    std::vector<double> source_values(Nsl * nvar);
+    for (std::size_t i = 0; i < Nsl; ++i) {
+        const double value        = smooth_field(local_xyz[i * ND], local_xyz[i * ND + 1], local_xyz[i * ND + 2]);
+        source_values[i * nvar]     = value;
+        source_values[i * nvar + 1] = -2 * value + 1;
+    }
+
+    hopi::RBFInterpolator<UserTypes> interpolator(rbf_options);
+    interpolator.set_sources(Nsl, local_xyz.data(), ND, local_xyz.data() + 1, ND, local_xyz.data() + 2, ND);
+
+    // Interpolated in memory and shared by global index
+    interpolator.set_targets(Nto, targets.xyz.data(), ND, targets.xyz.data() + 1, ND, targets.xyz.data() + 2, ND);
+    std::vector<double> my_values(Nto * nvar);
+    interpolator.apply(nvar, source_values.data(), nvar, 1, my_values.data(), nvar, 1);
+    std::vector<double> my_ids(Nto);
+    std::memcpy(my_ids.data(), targets.payload[0].data(), Nto * sizeof(double));
+    std::vector<std::vector<double>> ids_by_rank;
+    std::vector<std::vector<double>> values_by_rank;
+    mpixx::all_gather(world, my_ids, ids_by_rank);
+    mpixx::all_gather(world, my_values, values_by_rank);
+    std::vector<double> expected(Ntg * nvar, NAN);
+    for (std::size_t r = 0; r < num_ranks; ++r) {
+        for (std::size_t n = 0; n < ids_by_rank[r].size(); ++n) {
+            const auto i = std::size_t(ids_by_rank[r][n]);
+            for (std::size_t v = 0; v < nvar; ++v) {
+                expected[i * nvar + v] = values_by_rank[r][n * nvar + v];
+            }
+        }
+    }
+
+    // Many small blocks so every stage has a block in flight
+    hopi::PipelineOptions options;
+    options.block_points = 97;
+    hopi::TargetPipeline<UserTypes> pipeline(partition, interpolator, options);
+
+    SECTION("Results stored as double")
+    {
+        pipeline.run(target_file.name(), nvar, source_values.data(), result_file.name());
+        const auto results = hopi::read_targets_parallel<double>(world, result_file.name());
+        REQUIRE(results.header.npoints == Ntg);
+        REQUIRE(results.header.nvar == nvar);
+        for (std::size_t n = 0; n < results.count; ++n) {
+            const auto i = results.first + n;
+            for (std::size_t d = 0; d < ND; ++d) {
+                CHECK(results.coordinate(d)[n] == target_xyz[i * ND + d]);
+            }
+            for (std::size_t v = 0; v < nvar; ++v) {
+                CHECK(std::abs(results.variable(v)[n] - expected[i * nvar + v]) <= 1e-12);
+            }
+        }
+        world.barrier();
+    }
+
+    SECTION("Results stored as float")
+    {
+        const std::vector<float> float_values(source_values.begin(), source_values.end());
+        pipeline.run(target_file.name(), nvar, float_values.data(), result_file.name());
+        const auto results = hopi::read_targets_parallel<float>(world, result_file.name());
+        REQUIRE(results.header.npoints == Ntg);
+        for (std::size_t n = 0; n < results.count; ++n) {
+            const auto i = results.first + n;
+            for (std::size_t d = 0; d < ND; ++d) {
+                CHECK(results.coordinate(d)[n] == float(target_xyz[i * ND + d]));
+            }
+            for (std::size_t v = 0; v < nvar; ++v) {
+                CHECK(std::abs(results.variable(v)[n] - expected[i * nvar + v]) <= 1e-5 * (1 + std::abs(expected[i * nvar + v])));
+            }
+        }
+        world.barrier();
+    }
+}
@@ -0,0 +1,58 @@
+/// @file unique_redistribute.cpp
+/*
+ * Project:         HOPI
+ * File:            unique_redistribute.cpp
+ * Date:            Oct 14, 2026
+ * Author:          Bryan Flynt
+ * -----
+ * Last Modified:   Oct 14, 2026
+ * Modified By:     Bryan Flynt
+ * -----
+ * Copyright:       See LICENSE file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "hopi/mpixx.hpp"
+#include "hopi/partition.hpp"
+#include "hopi/unique.hpp"
+#include "test_common.hpp"
+
+#include <vector>
+
+namespace {
+
+using hopi::test::random_xyz;
+using hopi::test::UserTypes;
+
+using Partition = hopi::Partition<UserTypes>;
+
+}  // namespace
+
+TEST_CASE("Unique after redistribute removes duplicates across ranks", "[unique][mpi]")
+{
+    constexpr std::size_t ND = UserTypes::NDim;
+    constexpr std::size_t M  = 3000;
+    mpixx::communicator   world;
+    const std::size_t     num_ranks = world.size();
+    const std::size_t     my_rank   = world.rank();
+
+    // Every rank holds an overlapping window of the same points
+    // - Point i is held by ranks i % P and (i + 1) % P
+    const auto          all_xyz = random_xyz(M, 61);
+    std::vector<double> xyz;
+    for (std::size_t i = 0; i < M; ++i) {
+        if ((i % num_ranks == my_rank) or ((i + 1) % num_ranks == my_rank)) {
+            xyz.insert(xyz.end(), all_xyz.begin() + i * ND, all_xyz.begin() + (i + 1) * ND);
+        }
+    }
+    const std::size_t N = xyz.size() / ND;
+
+    Partition partition(world);
+    partition.init(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+    const auto owned = partition.redistribute(N, xyz.data(), ND, xyz.data() + 1, ND, xyz.data() + 2, ND, nullptr, 1);
+
+    hopi::Unique<UserTypes> unique;
+    unique.setup(owned.weight.size(), owned.xyz.data(), ND, owned.xyz.data() + 1, ND, owned.xyz.data() + 2, ND);
+    CHECK(mpixx::all_reduce(world, unique.num_unique(), MPI_SUM) == M);
+}